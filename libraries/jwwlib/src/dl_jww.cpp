@@ -670,7 +670,25 @@ void DL_Jww::CreateBlock(DL_CreationInterface* /*creationInterface*/, CDataBlock
 bool DL_Jww::in(const string& file, DL_CreationInterface* creationInterface) {
 	//JWWファイル読み取り
 	string ofile("");
-	JWWDocument* jwdoc = new JWWDocument((std::string&)file, ofile);
+	JWWDocument jwdoc((std::string&)file, ofile);
+	return in(&jwdoc, creationInterface);
+}
+
+/**
+ * @brief Reads the given stream buffer (memory, pipe...) like a file.
+ *
+ * @param source Input, owned by the caller
+ * @param creationInterface
+ *		Pointer to the class which takes care of the entities in the file.
+ *
+ * @retval true If \p source holds a JWW drawing.
+ */
+bool DL_Jww::in(std::streambuf* source, DL_CreationInterface* creationInterface) {
+	JWWDocument jwdoc(source, NULL);
+	return in(&jwdoc, creationInterface);
+}
+
+bool DL_Jww::in(JWWDocument* jwdoc, DL_CreationInterface* creationInterface) {
 	if(!jwdoc->Read())
 		return false;
 	//DXF変数設定
@@ -697,7 +715,6 @@ bool DL_Jww::in(const string& file, DL_CreationInterface* creationInterface) {
 	//部品
     for(unsigned int i=0 ; i < jwdoc->vBlock.size(); i++)
 		CreateBlock(creationInterface, jwdoc->vBlock[i]);
-	delete jwdoc;
 
 	return true;
 }
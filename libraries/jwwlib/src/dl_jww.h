@@ -100,6 +100,8 @@ public:
 
     bool in(const string& file,
             DL_CreationInterface* creationInterface);
+    bool in(std::streambuf* source,
+            DL_CreationInterface* creationInterface);
     bool readJwwGroups(FILE* fp,
                        DL_CreationInterface* creationInterface,
 					   int* errorCounter = NULL);
@@ -335,6 +337,8 @@ public:
 	void CreateBlock(DL_CreationInterface* creationInterface, CDataBlock& DBlock);
 
 private:
+    bool in(JWWDocument* jwdoc, DL_CreationInterface* creationInterface);
+
     DL_Codes::version version;
     unsigned long styleHandleStd;
 
@@ -939,6 +939,23 @@ public:
 		pList = new JWWList();
 		pBlockList = new JWWBlockList();
 	}
+	//ファイルの代わりにストリームバッファ(メモリ、パイプ等)で入出力する
+	//バッファは呼び出し側が所有する。ifstream/ofstreamのままバッファだけ
+	//差し替えるので、バイナリ入出力の演算子はそのまま使える
+	JWWDocument(std::streambuf* iBuf, std::streambuf* oBuf){
+		ifs = NULL;
+		if(iBuf){
+			ifs = new ifstream();
+			ifs->std::ios::rdbuf(iBuf);
+		}
+		ofs = NULL;
+		if(oBuf){
+			ofs = new ofstream();
+			ofs->std::ios::rdbuf(oBuf);
+		}
+		pList = new JWWList();
+		pBlockList = new JWWBlockList();
+	}
 	~JWWDocument(){
 		delete pList;
 		delete pBlockList;
@@ -24,6 +24,10 @@ include(../../common.pri)
 QT -= svg
 
 # DEFINES += DRW_DBG
+# compile out the debug output of setDebug()
+# DEFINES += DRW_NO_DBG
+# .dxf.gz / .dxf.zst support, the application must link zlib / libzstd
+# DEFINES += DRW_HAVE_ZLIB DRW_HAVE_ZSTD
 
 SOURCES += \
     src/libdxfrw.cpp \
@@ -39,6 +43,8 @@ SOURCES += \
     src/intern/dwgreader.cpp \
     src/intern/dwgbuffer.cpp \
     src/intern/drw_dbg.cpp \
+    src/intern/drw_mmap.cpp \
+    src/intern/drw_zstream.cpp \
     src/intern/dwgreader21.cpp \
     src/intern/dwgreader18.cpp \
     src/intern/dwgreader15.cpp \
@@ -67,6 +73,8 @@ HEADERS += \
     src/intern/drw_cptable936.h \
     src/intern/drw_cptable932.h \
     src/intern/drw_dbg.h \
+    src/intern/drw_mmap.h \
+    src/intern/drw_zstream.h \
     src/intern/dwgreader21.h \
     src/intern/dwgreader18.h \
     src/intern/dwgreader15.h \
@@ -13,7 +13,70 @@
 #include "drw_base.h"
 #include "intern/drw_dbg.h"
 
+#include <algorithm>
+#include <cstddef>
+
 void DRW::setCustomDebugPrinter(DebugPrinter *printer)
 {
   DRW_dbg::getInstance()->setCustomDebugPrinter(std::unique_ptr<DebugPrinter>(printer));
 }
+
+namespace {
+//first chunk in nodes, each next chunk is twice as large up to the cap
+const size_t ARENA_FIRST_NODES = 64;
+const size_t ARENA_MAX_NODES = 4096;
+} // namespace
+
+void DRW_VariantArena::release() {
+    bool unused;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        released = true;
+        unused = live == 0;
+    }
+    if (unused)
+        delete this;
+}
+
+void *DRW_VariantArena::allocate(size_t bytes) {
+    const size_t align = alignof(std::max_align_t);
+    size_t rounded = (bytes + align - 1) / align * align;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (nodeSize == 0)
+        nodeSize = rounded;
+    if (rounded != nodeSize)
+        return ::operator new(bytes);
+    ++live;
+    if (freeList != nullptr) {
+        void *p = freeList;
+        freeList = *static_cast<void**>(p);
+        return p;
+    }
+    if (next == end) {
+        size_t nodes = chunks.empty() ? ARENA_FIRST_NODES
+                     : std::min(ARENA_MAX_NODES, 2 * static_cast<size_t>(end - chunks.back().get()) / nodeSize);
+        chunks.emplace_back(new unsigned char[nodes * nodeSize]);
+        next = chunks.back().get();
+        end = next + nodes * nodeSize;
+    }
+    void *p = next;
+    next += nodeSize;
+    return p;
+}
+
+void DRW_VariantArena::deallocate(void *p, size_t bytes) {
+    const size_t align = alignof(std::max_align_t);
+    bool unused;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if ((bytes + align - 1) / align * align != nodeSize) {
+            ::operator delete(p);
+            return;
+        }
+        *static_cast<void**>(p) = freeList;
+        freeList = p;
+        unused = --live == 0 && released;
+    }
+    if (unused)
+        delete this;
+}
@@ -18,7 +18,15 @@
 
 #include <string>
 #include <cmath>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 class dxfReader;
 
@@ -259,6 +267,167 @@ public:
     double bulge=0.;             /*!< bulge, code 42 */
 };
 
+//! Contiguous list of vertices or points
+/*!
+*  Stores the elements by value in one flat array, so a polyline or spline
+*  with a million vertices costs one allocation instead of a million
+*  allocations and reference counts. data() and values() give direct
+*  access to the array.
+*  The list keeps the pointer API of the former vector<shared_ptr<T>>:
+*  at(), operator[], iteration, front() and back() hand out a Ptr that is
+*  used with -> and get(), and converts to a non-owning std::shared_ptr.
+*  Both stay valid until the list grows, is cleared or is destroyed.
+*/
+template <typename T>
+class DRW_PackedList {
+public:
+    //! Pointer-like handle to an element of the list
+    /*!
+    *  It does not own the element: it dangles once the list grows past its
+    *  capacity, is cleared or is destroyed. Copy the element to keep it.
+    */
+    class Ptr {
+    public:
+        Ptr(T *p = nullptr): ptr(p) {}
+        T *operator->() const {return ptr;}
+        T &operator*() const {return *ptr;}
+        T *get() const {return ptr;}
+        explicit operator bool() const {return ptr != nullptr;}
+        //! non-owning shared_ptr for the former shared_ptr API, as short-lived as the Ptr
+        explicit operator std::shared_ptr<T>() const {return std::shared_ptr<T>(std::shared_ptr<T>(), ptr);}
+        bool operator==(const Ptr &rhs) const {return ptr == rhs.ptr;}
+        bool operator!=(const Ptr &rhs) const {return ptr != rhs.ptr;}
+    private:
+        T *ptr;
+    };
+
+    //! Iterator handing out a Ptr for each element, like the former shared_ptr list
+    /*!
+    *  The Ptr is the iterator position itself, so `auto &v: list` works as it
+    *  did. The reference *it is only valid until the iterator moves on or is
+    *  destroyed, and it then refers to another element: copy the Ptr to keep
+    *  it, e.g. `auto v = *it`.
+    */
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Ptr;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Ptr*;
+        using reference = const Ptr&;
+
+        iterator(T *p = nullptr): cur(p) {}
+        const Ptr &operator*() const {return cur;}
+        const Ptr *operator->() const {return &cur;}
+        Ptr operator[](difference_type n) const {return Ptr(pos() + n);}
+        iterator &operator++() {cur = Ptr(pos() + 1); return *this;}
+        iterator operator++(int) {iterator it = *this; ++*this; return it;}
+        iterator &operator--() {cur = Ptr(pos() - 1); return *this;}
+        iterator operator--(int) {iterator it = *this; --*this; return it;}
+        iterator &operator+=(difference_type n) {cur = Ptr(pos() + n); return *this;}
+        iterator &operator-=(difference_type n) {cur = Ptr(pos() - n); return *this;}
+        iterator operator+(difference_type n) const {return iterator(pos() + n);}
+        iterator operator-(difference_type n) const {return iterator(pos() - n);}
+        difference_type operator-(const iterator &rhs) const {return pos() - rhs.pos();}
+        bool operator==(const iterator &rhs) const {return pos() == rhs.pos();}
+        bool operator!=(const iterator &rhs) const {return pos() != rhs.pos();}
+        bool operator<(const iterator &rhs) const {return pos() < rhs.pos();}
+        bool operator>(const iterator &rhs) const {return pos() > rhs.pos();}
+        bool operator<=(const iterator &rhs) const {return pos() <= rhs.pos();}
+        bool operator>=(const iterator &rhs) const {return pos() >= rhs.pos();}
+    private:
+        T *pos() const {return cur.get();}
+        Ptr cur;
+    };
+    //like a const vector<shared_ptr<T>>, a const list still hands out mutable elements
+    typedef iterator const_iterator;
+
+    size_t size() const {return items.size();}
+    bool empty() const {return items.empty();}
+    size_t capacity() const {return items.capacity();}
+    void reserve(size_t n) {items.reserve(n);}
+    void clear() {items.clear();}
+
+    Ptr at(size_t i) const {return Ptr(mut(&items.at(i)));}
+    Ptr operator[](size_t i) const {return Ptr(mut(&items[i]));}
+    Ptr front() const {return (*this)[0];}
+    Ptr back() const {return (*this)[items.size() - 1];}
+    iterator begin() const {return iterator(mut(items.data()));}
+    iterator end() const {return iterator(mut(items.data() + items.size()));}
+
+    //! appends a copy of the value, the list does not share ownership of v
+    void push_back(const std::shared_ptr<T> &v) {items.push_back(*v);}
+    void push_back(const T &v) {items.push_back(v);}
+    void push_back(T &&v) {items.push_back(std::move(v));}
+    template <typename... Args>
+    T &emplace_back(Args&&... args) {
+        items.emplace_back(std::forward<Args>(args)...);
+        return items.back();
+    }
+
+    T *data() {return items.data();}
+    const T *data() const {return items.data();}
+    std::vector<T> &values() {return items;}
+    const std::vector<T> &values() const {return items;}
+
+private:
+    static T *mut(const T *p) {return const_cast<T*>(p);}
+    std::vector<T> items;
+};
+
+//! Interning table for layer, line type and other table names
+/*!
+*  Hands out a dense 32-bit id per distinct name, so a drawing with
+*  millions of entities on a few dozen layers keeps a few dozen strings.
+*  The ids of "", "0" and "BYLAYER" are fixed, they are the defaults of
+*  DRW_Entity::layerId and lineTypeId.
+*  Not thread safe: a table is filled by one reader at a time.
+*/
+class DRW_NameTable {
+public:
+    enum : duint32 {
+        EmptyId = 0,      /*!< "" */
+        LayerZeroId = 1,  /*!< "0" */
+        ByLayerId = 2     /*!< "BYLAYER" */
+    };
+
+    DRW_NameTable() {
+        intern("");
+        intern("0");
+        intern("BYLAYER");
+    }
+    DRW_NameTable(const DRW_NameTable&) = delete;
+    DRW_NameTable &operator=(const DRW_NameTable&) = delete;
+    DRW_NameTable(DRW_NameTable&&) = default;
+    DRW_NameTable &operator=(DRW_NameTable&&) = default;
+
+    //! id of s, added to the table if not there yet
+    duint32 intern(std::string_view s) {
+        auto it = ids.find(s);
+        if (it != ids.end())
+            return it->second;
+        duint32 id = static_cast<duint32>(names.size());
+        names.emplace_back(s);
+        ids.emplace(names.back(), id);
+        return id;
+    }
+    //! true and the id in *id if s is in the table
+    bool find(std::string_view s, duint32 *id) const {
+        auto it = ids.find(s);
+        if (it == ids.end())
+            return false;
+        *id = it->second;
+        return true;
+    }
+    const std::string &operator[](duint32 id) const {return names[id];}
+    size_t size() const {return names.size();}
+
+private:
+    //a deque keeps the strings in place, the views used as keys stay valid
+    std::deque<std::string> names;
+    std::unordered_map<std::string_view, duint32> ids;
+};
+
 
 //! Class to handle header vars
 /*!
@@ -283,7 +452,7 @@ public:
 
     DRW_Variant(int c, double d): sdata(std::string()), vdata(), content(d), vType(DOUBLE), vCode(c) {}
 
-    DRW_Variant(int c, UTF8STRING s): sdata(s), vdata(), content(&sdata), vType(STRING), vCode(c) {}
+    DRW_Variant(int c, UTF8STRING s): sdata(std::move(s)), vdata(), content(&sdata), vType(STRING), vCode(c) {}
 
     DRW_Variant(int c, DRW_Coord crd): sdata(std::string()), vdata(crd), content(&vdata), vType(COORD), vCode(c) {}
 
@@ -332,6 +501,65 @@ private:
 
 };
 
+//! Per-read pool for XDATA items
+/*!
+*  Hands out the nodes of the shared DRW_Variant items of
+*  DRW_Entity::extData from chunks that only grow and takes released
+*  nodes back, so parsing XDATA does not go to the heap once the pool is
+*  warm. Items may outlive the reader and be released from any thread;
+*  the pool is freed when its owner called release() and the last item
+*  allocated from it is gone.
+*/
+class DRW_VariantArena {
+public:
+    struct Releaser {
+        void operator()(DRW_VariantArena *a) const {a->release();}
+    };
+    //! owner of a pool, releases it when destroyed
+    typedef std::unique_ptr<DRW_VariantArena, Releaser> Ptr;
+
+    static Ptr create() {return Ptr(new DRW_VariantArena);}
+    DRW_VariantArena(const DRW_VariantArena&) = delete;
+    DRW_VariantArena &operator=(const DRW_VariantArena&) = delete;
+    //! the owner is done with the pool, it is freed with the last item
+    void release();
+
+    template <class... Args>
+    std::shared_ptr<DRW_Variant> make(Args&&... args) {
+        return std::allocate_shared<DRW_Variant>(Allocator<DRW_Variant>(this), std::forward<Args>(args)...);
+    }
+
+private:
+    template <class T>
+    struct Allocator {
+        using value_type = T;
+        explicit Allocator(DRW_VariantArena *a): arena(a) {}
+        template <class U>
+        Allocator(const Allocator<U> &other): arena(other.arena) {}
+        T *allocate(size_t n) {return static_cast<T*>(arena->allocate(n * sizeof(T)));}
+        void deallocate(T *p, size_t n) {arena->deallocate(p, n * sizeof(T));}
+        template <class U>
+        bool operator==(const Allocator<U> &other) const {return arena == other.arena;}
+        template <class U>
+        bool operator!=(const Allocator<U> &other) const {return arena != other.arena;}
+        DRW_VariantArena *arena;
+    };
+
+    DRW_VariantArena() = default;
+    ~DRW_VariantArena() = default;
+    void *allocate(size_t bytes);
+    void deallocate(void *p, size_t bytes);
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<unsigned char[]>> chunks;
+    void *freeList = nullptr;
+    unsigned char *next = nullptr;
+    unsigned char *end = nullptr;
+    size_t nodeSize = 0;        //every item has the same control block and variant
+    size_t live = 0;
+    bool released = false;
+};
+
 //! Class to handle dwg handles
 /*!
 *  Class to handle dwg handles
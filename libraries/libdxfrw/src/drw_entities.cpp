@@ -18,6 +18,16 @@
 #include "intern/drw_dbg.h"
 #include "intern/drw_reserve.h"
 
+namespace {
+//XDATA item, from the arena of the reader when it has one
+template <class... Args>
+std::shared_ptr<DRW_Variant> newVariant(dxfReader *reader, Args&&... args) {
+    if (DRW_VariantArena *arena = reader->getVariantArena())
+        return arena->make(std::forward<Args>(args)...);
+    return std::make_shared<DRW_Variant>(std::forward<Args>(args)...);
+}
+} // namespace
+
 //! Calculate arbitrary axis
 /*!
 *   Calculate arbitrary axis for apply extrusions
@@ -77,9 +87,13 @@ bool DRW_Entity::parseCode(int code, dxfReader *reader){
         break;
     case 8:
         layer = reader->getUtf8String();
+        if (reader->getNameTable())
+            layerId = reader->getNameTable()->intern(layer);
         break;
     case 6:
         lineType = reader->getUtf8String();
+        if (reader->getNameTable())
+            lineTypeId = reader->getNameTable()->intern(lineType);
         break;
     case 62:
         color = reader->getInt32();
@@ -111,13 +125,13 @@ bool DRW_Entity::parseCode(int code, dxfReader *reader){
     case 1003:
     case 1004:
     case 1005:
-		extData.push_back(std::make_shared<DRW_Variant>(code, reader->getString()));
+		extData.push_back(newVariant(reader, code, reader->getString()));
         break;
     case 1010:
     case 1011:
     case 1012:
     case 1013:
-		curr =std::make_shared<DRW_Variant>(code, DRW_Coord(reader->getDouble(), 0.0, 0.0));
+		curr = newVariant(reader, code, DRW_Coord(reader->getDouble(), 0.0, 0.0));
         extData.push_back(curr);
         break;
     case 1020:
@@ -139,11 +153,11 @@ bool DRW_Entity::parseCode(int code, dxfReader *reader){
     case 1040:
     case 1041:
     case 1042:
-		extData.push_back(std::make_shared<DRW_Variant>(code, reader->getDouble() ));
+		extData.push_back(newVariant(reader, code, reader->getDouble() ));
         break;
     case 1070:
     case 1071:
-		extData.push_back(std::make_shared<DRW_Variant>(code, reader->getInt32() ));
+		extData.push_back(newVariant(reader, code, reader->getInt32() ));
         break;
     default:
         break;
@@ -813,6 +827,8 @@ void DRW_Ellipse::toPolyline(DRW_Polyline *pol, int parts){
     }
     pol->layer = this->layer;
     pol->lineType = this->lineType;
+    pol->layerId = this->layerId;
+    pol->lineTypeId = this->lineTypeId;
     pol->color = this->color;
     pol->lWeight = this->lWeight;
     pol->extPoint = this->extPoint;
@@ -1173,12 +1189,11 @@ bool DRW_Tolerance::parseDwg([[maybe_unused]]DRW::Version v, [[maybe_unused]]dwg
 void DRW_LWPolyline::applyExtrusion(){
     if (haveExtrusion) {
         calculateAxis(extPoint);
-        for (unsigned int i=0; i<vertlist.size(); i++) {
-			auto& vert = vertlist.at(i);
-            DRW_Coord v(vert->x, vert->y, elevation);
+        for (DRW_Vertex2D &vert: vertlist.values()) {
+            DRW_Coord v(vert.x, vert.y, elevation);
             extrudePoint(extPoint, &v);
-            vert->x = v.x;
-            vert->y = v.y;
+            vert.x = v.x;
+            vert.y = v.y;
         }
     }
 }
@@ -1186,8 +1201,7 @@ void DRW_LWPolyline::applyExtrusion(){
 bool DRW_LWPolyline::parseCode(int code, dxfReader *reader){
     switch (code) {
     case 10: {
-		vertex = std::make_shared<DRW_Vertex2D>();
-        vertlist.push_back(vertex);
+        vertex = &vertlist.emplace_back();
         vertex->x = reader->getDouble();
         break; }
     case 20:
@@ -1280,29 +1294,27 @@ bool DRW_LWPolyline::parseDwg(DRW::Version version, dwgBuffer *buf, duint32 bs){
 
     if (vertexnum > 0) { //verify if is lwpol without vertex (empty)
         // add vertexes
-		vertex = std::make_shared<DRW_Vertex2D>();
-        vertex->x = buf->getRawDouble();
-        vertex->y = buf->getRawDouble();
-        vertlist.push_back(vertex);
-		auto pv = vertex;
+        std::vector<DRW_Vertex2D> &verts = vertlist.values();
+        DRW_Vertex2D pv;
+        pv.x = buf->getRawDouble();
+        pv.y = buf->getRawDouble();
+        verts.push_back(pv);
         for (int i = 1; i< vertexnum; i++){
-			vertex = std::make_shared<DRW_Vertex2D>();
 			if (version < DRW::AC1015) {//14-
-                vertex->x = buf->getRawDouble();
-                vertex->y = buf->getRawDouble();
+                pv.x = buf->getRawDouble();
+                pv.y = buf->getRawDouble();
             } else {
-//                DRW_Vertex2D *pv = vertlist.back();
-                vertex->x = buf->getDefaultDouble(pv->x);
-                vertex->y = buf->getDefaultDouble(pv->y);
+                pv.x = buf->getDefaultDouble(pv.x);
+                pv.y = buf->getDefaultDouble(pv.y);
             }
-            pv = vertex;
-            vertlist.push_back(std::move(vertex));
+            verts.push_back(pv);
         }
+        vertex = &verts.back();
         //add bulges
         for (unsigned int i = 0; i < bulgesnum; i++){
             double bulge = buf->getBitDouble();
-            if (vertlist.size()> i)
-                vertlist.at(i)->bulge = bulge;
+            if (verts.size()> i)
+                verts[i].bulge = bulge;
         }
         //add vertexId
         if (version > DRW::AC1021) {//2010+
@@ -1318,9 +1330,9 @@ bool DRW_LWPolyline::parseDwg(DRW::Version version, dwgBuffer *buf, duint32 bs){
         for (unsigned int i = 0; i < widthsnum; i++){
             double staW = buf->getBitDouble();
             double endW = buf->getBitDouble();
-            if (i < vertlist.size()) {
-                vertlist.at(i)->stawidth = staW;
-                vertlist.at(i)->endwidth = endW;
+            if (i < verts.size()) {
+                verts[i].stawidth = staW;
+                verts[i].endwidth = endW;
             }
         }
     }
@@ -1747,7 +1759,7 @@ bool DRW_Vertex::parseDwg(DRW::Version version, dwgBuffer *buf, duint32 bs, doub
             endwidth = buf->getBitDouble();
         bulge = buf->getBitDouble();
         if (version > DRW::AC1021) { //2010+
-            DRW_DBG("Vertex ID: "); DRW_DBG(buf->getBitLong());
+            DRW_DBG("Vertex ID: "); DRW_DBGR(buf->getBitLong());
         }
         tgdir = buf->getBitDouble();
     } else if (oType == 0x0B || oType == 0x0C || oType == 0x0D) { //PFACE
@@ -1796,7 +1808,7 @@ bool DRW_Hatch::parseCode(int code, dxfReader *reader){
     case 10:
         if (pt) pt->basePoint.x = reader->getDouble();
         else if (pline) {
-            plvert = pline->addVertex();
+            plvert = pline->addVertex().get();
             plvert->x = reader->getDouble();
         }
         break;
@@ -1974,10 +1986,9 @@ bool DRW_Hatch::parseDwg(DRW::Version version, dwgBuffer *buf, duint32 bs){
                         spline->knotslist.push_back (buf->getBitDouble());
                     }
                     for (dint32 j = 0; j < spline->ncontrol;++j){
-                        std::shared_ptr<DRW_Coord> crd = std::make_shared<DRW_Coord>(buf->get2RawDouble());
+                        DRW_Coord &crd = spline->controllist.emplace_back(buf->get2RawDouble());
                         if(isRational)
-                            crd->z =  buf->getBitDouble(); //RLZ: investigate how store weight
-                        spline->controllist.push_back(crd);
+                            crd.z =  buf->getBitDouble(); //RLZ: investigate how store weight
                     }
                     if (version > DRW::AC1021) { //2010+
                         spline->nfit = buf->getBitLong();
@@ -1985,8 +1996,7 @@ bool DRW_Hatch::parseDwg(DRW::Version version, dwgBuffer *buf, duint32 bs){
                             return false;
                         }
                         for (dint32 j = 0; j < spline->nfit;++j){
-                            std::shared_ptr<DRW_Coord> crd = std::make_shared<DRW_Coord>(buf->get2RawDouble());
-                            spline->fitlist.push_back(crd);
+                            spline->fitlist.emplace_back(buf->get2RawDouble());
                         }
                         spline->tgStart = buf->get2RawDouble();
                         spline->tgEnd = buf->get2RawDouble();
@@ -2122,8 +2132,7 @@ bool DRW_Spline::parseCode(int code, dxfReader *reader){
         tolfit = reader->getDouble();
         break;
     case 10: {
-        controlpoint = std::make_shared<DRW_Coord>();
-        controllist.push_back(controlpoint);
+        controlpoint = &controllist.emplace_back();
         controlpoint->x = reader->getDouble();
         break; }
     case 20:
@@ -2135,8 +2144,7 @@ bool DRW_Spline::parseCode(int code, dxfReader *reader){
             controlpoint->z = reader->getDouble();
         break;
     case 11: {
-        fitpoint = std::make_shared<DRW_Coord>();
-        fitlist.push_back(fitpoint);
+        fitpoint = &fitlist.emplace_back();
         fitpoint->x = reader->getDouble();
         break; }
     case 21:
@@ -2219,17 +2227,17 @@ bool DRW_Spline::parseDwg(DRW::Version version, dwgBuffer *buf, duint32 bs){
         return false;
     }
     for (dint32 i= 0; i<ncontrol; ++i){
-        controllist.push_back(std::make_shared<DRW_Coord>(buf->get3BitDouble()));
+        controllist.emplace_back(buf->get3BitDouble());
         if (weight) {
             DRW_DBG("\n w: ");
-            DRW_DBG(buf->getBitDouble()); //RLZ Warning: D (BD or RD)
+            DRW_DBGR(buf->getBitDouble()); //RLZ Warning: D (BD or RD)
         }
     }
     if (!DRW::reserve( fitlist, nfit)) {
         return false;
     }
     for (dint32 i= 0; i<nfit; ++i)
-        fitlist.push_back(std::make_shared<DRW_Coord>(buf->get3BitDouble()));
+        fitlist.emplace_back(buf->get3BitDouble());
 
     if (DRW_DBGGL == DRW_dbg::Level::Debug) {
         DRW_DBG("\nknots list: ");
@@ -2513,8 +2521,8 @@ bool DRW_Dimension::parseDwg(DRW::Version version, dwgBuffer *buf, dwgBuffer *sB
     extPoint = buf->getExtrusion(version > DRW::AC1014);
     DRW_DBG("\nextPoint: "); DRW_DBGPT(extPoint.x, extPoint.y, extPoint.z);
     if (version > DRW::AC1014) { //2000+
-        DRW_DBG("\nFive unknown bits: "); DRW_DBG(buf->getBit()); DRW_DBG(buf->getBit());
-        DRW_DBG(buf->getBit()); DRW_DBG(buf->getBit()); DRW_DBG(buf->getBit());
+        DRW_DBG("\nFive unknown bits: "); DRW_DBGR(buf->getBit()); DRW_DBGR(buf->getBit());
+        DRW_DBGR(buf->getBit()); DRW_DBGR(buf->getBit()); DRW_DBGR(buf->getBit());
     }
     textPoint.x = buf->getRawDouble();
     textPoint.y = buf->getRawDouble();
@@ -2806,8 +2814,7 @@ bool DRW_Leader::parseCode(int code, dxfReader *reader){
         textwidth = reader->getDouble();
         break;
     case 10:
-        vertexpoint= std::make_shared<DRW_Coord>();
-        vertexlist.push_back(vertexpoint);
+        vertexpoint = &vertexlist.emplace_back();
         vertexpoint->x = reader->getDouble();
         break;
     case 20:
@@ -2874,16 +2881,16 @@ bool DRW_Leader::parseDwg(DRW::Version version, dwgBuffer *buf, duint32 bs){
     if (!ret)
         return ret;
     DRW_DBG("\n***************************** parsing leader *********************************************\n");
-    DRW_DBG("unknown bit "); DRW_DBG(buf->getBit());
-    DRW_DBG(" annot type "); DRW_DBG(buf->getBitShort());
-    DRW_DBG(" Path type "); DRW_DBG(buf->getBitShort());
+    DRW_DBG("unknown bit "); DRW_DBGR(buf->getBit());
+    DRW_DBG(" annot type "); DRW_DBGR(buf->getBitShort());
+    DRW_DBG(" Path type "); DRW_DBGR(buf->getBitShort());
     dint32 nPt = buf->getBitLong();
     DRW_DBG(" Num pts "); DRW_DBG(nPt);
 
     // add vertexes
     for (int i = 0; i< nPt; i++){
         DRW_Coord vertex = buf->get3BitDouble();
-        vertexlist.push_back(std::make_shared<DRW_Coord>(vertex));
+        vertexlist.push_back(vertex);
         DRW_DBG("\nvertex "); DRW_DBGPT(vertex.x, vertex.y, vertex.z);
     }
     DRW_Coord Endptproj = buf->get3BitDouble();
@@ -2891,8 +2898,8 @@ bool DRW_Leader::parseDwg(DRW::Version version, dwgBuffer *buf, duint32 bs){
     extrusionPoint = buf->getExtrusion(version > DRW::AC1014);
     DRW_DBG("\nextrusionPoint "); DRW_DBGPT(extrusionPoint.x, extrusionPoint.y, extrusionPoint.z);
     if (version > DRW::AC1014) { //2000+
-        DRW_DBG("\nFive unknown bits: "); DRW_DBG(buf->getBit()); DRW_DBG(buf->getBit());
-        DRW_DBG(buf->getBit()); DRW_DBG(buf->getBit()); DRW_DBG(buf->getBit());
+        DRW_DBG("\nFive unknown bits: "); DRW_DBGR(buf->getBit()); DRW_DBGR(buf->getBit());
+        DRW_DBGR(buf->getBit()); DRW_DBGR(buf->getBit()); DRW_DBGR(buf->getBit());
     }
     horizdir = buf->get3BitDouble();
     DRW_DBG("\nhorizdir "); DRW_DBGPT(horizdir.x, horizdir.y, horizdir.z);
@@ -2903,7 +2910,7 @@ bool DRW_Leader::parseDwg(DRW::Version version, dwgBuffer *buf, duint32 bs){
         DRW_DBG("\nunknown "); DRW_DBGPT(unk.x, unk.y, unk.z);
     }
     if (version < DRW::AC1015) { //R14 -
-        DRW_DBG("\ndimgap "); DRW_DBG(buf->getBitDouble());
+        DRW_DBG("\ndimgap "); DRW_DBGR(buf->getBitDouble());
     }
     if (version < DRW::AC1024) { //2010-
         textheight = buf->getBitDouble();
@@ -2915,18 +2922,18 @@ bool DRW_Leader::parseDwg(DRW::Version version, dwgBuffer *buf, duint32 bs){
     DRW_DBG(" hookline "); DRW_DBG(hookline); DRW_DBG(" arrow flag "); DRW_DBG(arrow);
 
     if (version < DRW::AC1015) { //R14 -
-        DRW_DBG("\nArrow head type "); DRW_DBG(buf->getBitShort());
-        DRW_DBG("dimasz "); DRW_DBG(buf->getBitDouble());
-        DRW_DBG("\nunk bit "); DRW_DBG(buf->getBit());
-        DRW_DBG(" unk bit "); DRW_DBG(buf->getBit());
-        DRW_DBG(" unk short "); DRW_DBG(buf->getBitShort());
-        DRW_DBG(" byBlock color "); DRW_DBG(buf->getBitShort());
-        DRW_DBG(" unk bit "); DRW_DBG(buf->getBit());
-        DRW_DBG(" unk bit "); DRW_DBG(buf->getBit());
+        DRW_DBG("\nArrow head type "); DRW_DBGR(buf->getBitShort());
+        DRW_DBG("dimasz "); DRW_DBGR(buf->getBitDouble());
+        DRW_DBG("\nunk bit "); DRW_DBGR(buf->getBit());
+        DRW_DBG(" unk bit "); DRW_DBGR(buf->getBit());
+        DRW_DBG(" unk short "); DRW_DBGR(buf->getBitShort());
+        DRW_DBG(" byBlock color "); DRW_DBGR(buf->getBitShort());
+        DRW_DBG(" unk bit "); DRW_DBGR(buf->getBit());
+        DRW_DBG(" unk bit "); DRW_DBGR(buf->getBit());
     } else { //R2000+
-        DRW_DBG("\nunk short "); DRW_DBG(buf->getBitShort());
-        DRW_DBG(" unk bit "); DRW_DBG(buf->getBit());
-        DRW_DBG(" unk bit "); DRW_DBG(buf->getBit());
+        DRW_DBG("\nunk short "); DRW_DBGR(buf->getBitShort());
+        DRW_DBG(" unk bit "); DRW_DBGR(buf->getBit());
+        DRW_DBG(" unk bit "); DRW_DBGR(buf->getBit());
     }
     DRW_DBG("\n");
     ret = DRW_Entity::parseDwgEntHandle(version, buf);
@@ -3019,37 +3026,37 @@ bool DRW_Viewport::parseDwg(DRW::Version version, dwgBuffer *buf, duint32 bs){
         snapSpPY = buf->getRawDouble();
         DRW_DBG("\nSnap spacing X: "); DRW_DBG(snapSpPX); DRW_DBG(", Y: "); DRW_DBG(snapSpPY);
         //RLZ: need to complete
-        DRW_DBG("\nGrid spacing X: "); DRW_DBG(buf->getRawDouble()); DRW_DBG(", Y: "); DRW_DBG(buf->getRawDouble());DRW_DBG("\n");
-        DRW_DBG("Circle zoom?: "); DRW_DBG(buf->getBitShort()); DRW_DBG("\n");
+        DRW_DBG("\nGrid spacing X: "); DRW_DBGR(buf->getRawDouble()); DRW_DBG(", Y: "); DRW_DBGR(buf->getRawDouble());DRW_DBG("\n");
+        DRW_DBG("Circle zoom?: "); DRW_DBGR(buf->getBitShort()); DRW_DBG("\n");
     }
     if (version > DRW::AC1018) {//2007+
-        DRW_DBG("Grid major?: "); DRW_DBG(buf->getBitShort()); DRW_DBG("\n");
+        DRW_DBG("Grid major?: "); DRW_DBGR(buf->getBitShort()); DRW_DBG("\n");
     }
     if (version > DRW::AC1014) {//2000+
         frozenLyCount = buf->getBitLong();
         DRW_DBG("Frozen Layer count?: "); DRW_DBG(frozenLyCount); DRW_DBG("\n");
-        DRW_DBG("Status Flags?: "); DRW_DBG(buf->getBitLong()); DRW_DBG("\n");
+        DRW_DBG("Status Flags?: "); DRW_DBGR(buf->getBitLong()); DRW_DBG("\n");
         //RLZ: Warning needed separate string buffer
-        DRW_DBG("Style sheet?: "); DRW_DBG(sBuf->getVariableText(version, false)); DRW_DBG("\n");
-        DRW_DBG("Render mode?: "); DRW_DBG(buf->getRawChar8()); DRW_DBG("\n");
-        DRW_DBG("UCS OMore...: "); DRW_DBG(buf->getBit()); DRW_DBG("\n");
-        DRW_DBG("UCS VMore...: "); DRW_DBG(buf->getBit()); DRW_DBG("\n");
-        DRW_DBG("UCS OMore...: "); DRW_DBGPT(buf->getBitDouble(), buf->getBitDouble(), buf->getBitDouble()); DRW_DBG("\n");
-        DRW_DBG("ucs XAMore...: "); DRW_DBGPT(buf->getBitDouble(), buf->getBitDouble(), buf->getBitDouble()); DRW_DBG("\n");
-        DRW_DBG("UCS YMore....: "); DRW_DBGPT(buf->getBitDouble(), buf->getBitDouble(), buf->getBitDouble()); DRW_DBG("\n");
-        DRW_DBG("UCS EMore...: "); DRW_DBG(buf->getBitDouble()); DRW_DBG("\n");
-        DRW_DBG("UCS OVMore...: "); DRW_DBG(buf->getBitShort()); DRW_DBG("\n");
+        DRW_DBG("Style sheet?: "); DRW_DBGR(sBuf->getVariableText(version, false)); DRW_DBG("\n");
+        DRW_DBG("Render mode?: "); DRW_DBGR(buf->getRawChar8()); DRW_DBG("\n");
+        DRW_DBG("UCS OMore...: "); DRW_DBGR(buf->getBit()); DRW_DBG("\n");
+        DRW_DBG("UCS VMore...: "); DRW_DBGR(buf->getBit()); DRW_DBG("\n");
+        DRW_DBG("UCS OMore...: "); DRW_DBGPTR(buf->getBitDouble(), buf->getBitDouble(), buf->getBitDouble()); DRW_DBG("\n");
+        DRW_DBG("ucs XAMore...: "); DRW_DBGPTR(buf->getBitDouble(), buf->getBitDouble(), buf->getBitDouble()); DRW_DBG("\n");
+        DRW_DBG("UCS YMore....: "); DRW_DBGPTR(buf->getBitDouble(), buf->getBitDouble(), buf->getBitDouble()); DRW_DBG("\n");
+        DRW_DBG("UCS EMore...: "); DRW_DBGR(buf->getBitDouble()); DRW_DBG("\n");
+        DRW_DBG("UCS OVMore...: "); DRW_DBGR(buf->getBitShort()); DRW_DBG("\n");
     }
     if (version > DRW::AC1015) {//2004+
-        DRW_DBG("ShadePlot Mode...: "); DRW_DBG(buf->getBitShort()); DRW_DBG("\n");
+        DRW_DBG("ShadePlot Mode...: "); DRW_DBGR(buf->getBitShort()); DRW_DBG("\n");
     }
     if (version > DRW::AC1018) {//2007+
-        DRW_DBG("Use def Light...: "); DRW_DBG(buf->getBit()); DRW_DBG("\n");
-        DRW_DBG("Def light type?: "); DRW_DBG(buf->getRawChar8()); DRW_DBG("\n");
-        DRW_DBG("Brightness: "); DRW_DBG(buf->getBitDouble()); DRW_DBG("\n");
-        DRW_DBG("Contrast: "); DRW_DBG(buf->getBitDouble()); DRW_DBG("\n");
+        DRW_DBG("Use def Light...: "); DRW_DBGR(buf->getBit()); DRW_DBG("\n");
+        DRW_DBG("Def light type?: "); DRW_DBGR(buf->getRawChar8()); DRW_DBG("\n");
+        DRW_DBG("Brightness: "); DRW_DBGR(buf->getBitDouble()); DRW_DBG("\n");
+        DRW_DBG("Contrast: "); DRW_DBGR(buf->getBitDouble()); DRW_DBG("\n");
 //        DRW_DBG("Ambient Cmc or Enc: "); DRW_DBG(buf->getCmColor(version)); DRW_DBG("\n");
-        DRW_DBG("Ambient (Cmc or Enc?), Enc: "); DRW_DBG(buf->getEnColor(version)); DRW_DBG("\n");
+        DRW_DBG("Ambient (Cmc or Enc?), Enc: "); DRW_DBGR(buf->getEnColor(version)); DRW_DBG("\n");
     }
     ret = DRW_Entity::parseDwgEntHandle(version, buf);
 
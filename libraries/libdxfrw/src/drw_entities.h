@@ -104,9 +104,14 @@ public:
 	DRW_Entity() = default;
 	virtual ~DRW_Entity() = default;
 
-	//removed copy/move ctors
 	// looks like the potential issue is the "curr" pointer is reset in previous
 	// versions during copy ctor
+	// moves are declared so entities kept by value in a DRW_PackedList
+	// (polyline vertices) are moved, not copied, when the list grows
+	DRW_Entity(const DRW_Entity&) = default;
+	DRW_Entity(DRW_Entity&&) = default;
+	DRW_Entity& operator=(const DRW_Entity&) = default;
+	DRW_Entity& operator=(DRW_Entity&&) = default;
 
 	void reset() {
 		extData.clear();
@@ -139,6 +144,8 @@ public:
 	DRW::Space space = DRW::ModelSpace;          /*!< space indicator, code 67*/
 	UTF8STRING layer = "0";          /*!< layer name, code 8 */
 	UTF8STRING lineType = "BYLAYER";       /*!< line type, code 6 */
+	duint32 layerId = DRW_NameTable::LayerZeroId;   /*!< interned layer, set when the reader has a DRW_NameTable */
+	duint32 lineTypeId = DRW_NameTable::ByLayerId;  /*!< interned line type, set when the reader has a DRW_NameTable */
 	duint32 material = DRW::MaterialByLayer;          /*!< hard pointer id to material object, code 347 */
 	int color = DRW::ColorByLayer;                 /*!< entity color, code 62 */
 	enum DRW_LW_Conv::lineWidth lWeight = DRW_LW_Conv::widthByLayer; /*!< entity lineweight, code 370 */
@@ -541,6 +548,8 @@ public:
         this->xAxisDirectionVector = p.xAxisDirectionVector;
         this->extPoint = p.extPoint;
     }
+    //! copies every member, resets a reused entity to a default one
+    DRW_Tolerance &operator=(const DRW_Tolerance&) = default;
     void applyExtrusion() override {}
 protected:
     bool parseCode(int code, dxfReader *reader) override;
@@ -577,25 +586,19 @@ public:
         this->width = p.width;
         this->flags = p.flags;
 		this->extPoint = p.extPoint;
-        for (unsigned i=0; i<p.vertlist.size(); i++)// RLZ ok or new
-		  this->vertlist.push_back(
-					std::make_shared<DRW_Vertex2D>(*p.vertlist.at(i))
-					);
+        this->vertlist = p.vertlist;
     }
+    //! copies every member, resets a reused entity to a default one
+    DRW_LWPolyline &operator=(const DRW_LWPolyline&) = default;
 	// TODO rule of 5
 
     void applyExtrusion() override;
     void addVertex (DRW_Vertex2D v) {
-		std::shared_ptr<DRW_Vertex2D> vert = std::make_shared<DRW_Vertex2D>(v);
-        vertlist.push_back(vert);
+        vertlist.push_back(v);
     }
-	std::shared_ptr<DRW_Vertex2D> addVertex () {
-		std::shared_ptr<DRW_Vertex2D> vert = std::make_shared<DRW_Vertex2D>();
-        vert->stawidth = 0;
-        vert->endwidth = 0;
-        vert->bulge = 0;
-        vertlist.push_back(vert);
-        return vert;
+    //! the returned vertex is valid until the next vertex is added
+    DRW_PackedList<DRW_Vertex2D>::Ptr addVertex () {
+        return &vertlist.emplace_back();
     }
 
 protected:
@@ -609,8 +612,8 @@ public:
     double elevation;         /*!< elevation, code 38 */
     double thickness;         /*!< thickness, code 39 */
     DRW_Coord extPoint;       /*!<  Dir extrusion normal vector, code 210, 220 & 230 */
-	std::shared_ptr<DRW_Vertex2D> vertex;       /*!< current vertex to add data */
-	std::vector<std::shared_ptr<DRW_Vertex2D>> vertlist;  /*!< vertex list */
+    DRW_Vertex2D *vertex = nullptr;       /*!< current vertex to add data */
+    DRW_PackedList<DRW_Vertex2D> vertlist;  /*!< vertex list */
 };
 
 //! Class to handle insert entries
@@ -763,18 +766,18 @@ public:
         smoothM = smoothN = curvetype = 0;
     }
     void addVertex (DRW_Vertex v) {
-        std::shared_ptr<DRW_Vertex> vert = std::make_shared<DRW_Vertex>();
-        vert->basePoint.x = v.basePoint.x;
-        vert->basePoint.y = v.basePoint.y;
-        vert->basePoint.z = v.basePoint.z;
-        vert->stawidth = v.stawidth;
-        vert->endwidth = v.endwidth;
-        vert->bulge = v.bulge;
-        vertlist.push_back(vert);
+        DRW_Vertex &vert = vertlist.emplace_back();
+        vert.basePoint = v.basePoint;
+        vert.stawidth = v.stawidth;
+        vert.endwidth = v.endwidth;
+        vert.bulge = v.bulge;
     }
     void appendVertex (std::shared_ptr<DRW_Vertex> const& v) {
         vertlist.push_back(v);
     }
+    void appendVertex (DRW_Vertex &&v) {
+        vertlist.push_back(std::move(v));
+    }
 
 protected:
     bool parseCode(int code, dxfReader *reader) override;
@@ -790,7 +793,7 @@ public:
     int smoothN;             /*!< smooth surface M density, code 74, default 0 */
     int curvetype;           /*!< curves & smooth surface type, code 75, default 0 */
 
-    std::vector<std::shared_ptr<DRW_Vertex>> vertlist;  /*!< vertex list */
+    DRW_PackedList<DRW_Vertex> vertlist;  /*!< vertex list */
 
 private:
     std::list<duint32>hadlesList; //list of handles, only in 2004+
@@ -844,12 +847,12 @@ public:
 
     std::vector<double> knotslist;           /*!< knots list, code 40 */
     std::vector<double> weightlist;          /*!< weight list, code 41 */
-    std::vector<std::shared_ptr<DRW_Coord>> controllist;  /*!< control points list, code 10, 20 & 30 */
-    std::vector<std::shared_ptr<DRW_Coord>> fitlist;      /*!< fit points list, code 11, 21 & 31 */
+    DRW_PackedList<DRW_Coord> controllist;  /*!< control points list, code 10, 20 & 30 */
+    DRW_PackedList<DRW_Coord> fitlist;      /*!< fit points list, code 11, 21 & 31 */
 
 private:
-    std::shared_ptr<DRW_Coord> controlpoint;   /*!< current control point to add data */
-    std::shared_ptr<DRW_Coord> fitpoint;       /*!< current fit point to add data */
+    DRW_Coord *controlpoint = nullptr;   /*!< current control point to add data */
+    DRW_Coord *fitpoint = nullptr;       /*!< current fit point to add data */
 };
 
 //! Class to handle hatch loop
@@ -925,7 +928,7 @@ private:
         arc.reset();
         ellipse.reset();
         spline.reset();
-        plvert.reset();
+        plvert = nullptr;
     }
 
     void addLine() {
@@ -968,7 +971,7 @@ private:
     std::shared_ptr<DRW_Spline> spline;
     std::shared_ptr<DRW_LWPolyline> pline;
     std::shared_ptr<DRW_Point> pt;
-    std::shared_ptr<DRW_Vertex2D> plvert;
+    DRW_Vertex2D *plvert = nullptr;
     bool ispol;
 };
 
@@ -1054,6 +1057,8 @@ public:
         flipArrow1 = d.flipArrow1;
         flipArrow2 = d.flipArrow2;
     }
+    //! copies every member, resets a reused entity to a default one
+    DRW_Dimension &operator=(const DRW_Dimension&) = default;
     virtual ~DRW_Dimension() {}
 
     void applyExtrusion() override {}
@@ -1408,10 +1413,10 @@ public:
     DRW_Coord offsetblock;     /*!< Offset of last leader vertex from block, code 212, 222 & 232 */
     DRW_Coord offsettext;      /*!< Offset of last leader vertex from annotation, code 213, 223 & 233 */
 
-    std::vector<std::shared_ptr<DRW_Coord>> vertexlist;  /*!< vertex points list, code 10, 20 & 30 */
+    DRW_PackedList<DRW_Coord> vertexlist;  /*!< vertex points list, code 10, 20 & 30 */
 
 private:
-    std::shared_ptr<DRW_Coord> vertexpoint;   /*!< current control point to add data */
+    DRW_Coord *vertexpoint = nullptr;   /*!< current control point to add data */
     dwgHandle dimStyleH;
     dwgHandle AnnotH;
 };
@@ -17,6 +17,187 @@
 #include "intern/drw_dbg.h"
 #include "intern/dwgbuffer.h"
 
+namespace {
+/** names of the header variables read and written by libdxfrw, without '$' */
+const char *const knownVarNames[] = {
+    "3DDWFPREC", "ACADMAINTVER", "ACADVER", "ANGBASE", "ANGDIR", "ATTDIA",
+    "ATTMODE", "ATTREQ", "AUNITS", "AUPREC", "AUTHOR", "BLIPMODE", "CAMERADISPLAY",
+    "CAMERAHEIGHT", "CECOLOR", "CELTSCALE", "CELTYPE", "CELWEIGHT", "CEPSNTYPE",
+    "CHAMFERA", "CHAMFERB", "CHAMFERC", "CHAMFERD", "CLAYER", "CMLJUST",
+    "CMLSCALE", "CMLSTYLE", "COMMENTS", "COORDS", "CSHADOW", "DELOBJ", "DGNFRAME",
+    "DIAMDEC", "DIMADEC", "DIMALT", "DIMALTD", "DIMALTF", "DIMALTMZF", "DIMALTMZS",
+    "DIMALTRND", "DIMALTTD", "DIMALTTZ", "DIMALTU", "DIMALTZ", "DIMAPOST",
+    "DIMARCSYM", "DIMASO", "DIMASSOC", "DIMASZ", "DIMATFIT", "DIMAUNIT", "DIMAZIN",
+    "DIMBLK", "DIMBLK1", "DIMBLK2", "DIMCEN", "DIMCLRD", "DIMCLRE", "DIMCLRT",
+    "DIMDEC", "DIMDLE", "DIMDLI", "DIMDSEP", "DIMEXE", "DIMEXO", "DIMFAC",
+    "DIMFIT", "DIMFRAC", "DIMFXL", "DIMFXLON", "DIMGAP", "DIMJOGANG", "DIMJUST",
+    "DIMLDRBLK", "DIMLFAC", "DIMLIM", "DIMLTEX1", "DIMLTEX2", "DIMLTYPE",
+    "DIMLUNIT", "DIMLWD", "DIMLWE", "DIMMZF", "DIMMZS", "DIMPOST", "DIMRND",
+    "DIMSAH", "DIMSAV", "DIMSCALE", "DIMSD1", "DIMSD2", "DIMSE1", "DIMSE2",
+    "DIMSHO", "DIMSOXD", "DIMSTYLE", "DIMTAD", "DIMTDEC", "DIMTFAC", "DIMTFILL",
+    "DIMTFILLCLR", "DIMTIH", "DIMTIX", "DIMTM", "DIMTMOVE", "DIMTOFL", "DIMTOH",
+    "DIMTOL", "DIMTOLJ", "DIMTP", "DIMTSZ", "DIMTVP", "DIMTXSTY", "DIMTXT",
+    "DIMTXTDIRECTION", "DIMTZIN", "DIMUNIT", "DIMUPT", "DIMZIN", "DISPSILH",
+    "DRAGMODE", "DWFFRAME", "DWGCODEPAGE", "ELEVATION", "ENDCAPS", "EXTMAX",
+    "EXTMIN", "EXTNAMES", "FACETRES", "FILLETRAD", "FILLMODE", "FINGERPRINTGUID",
+    "GRIDMODE", "GRIDUNIT", "HALOGAP", "HANDLING", "HANDSEED", "HIDETEXT",
+    "HYPERLINKBASE", "INDEXCTL", "INSBASE", "INSUNITS", "INTERFERECOLOR",
+    "INTERSECTIONCOLOR", "INTERSECTIONDISPLAY", "ISOLINES", "JOINSTYLE",
+    "KEYWORDS", "LATITUDE", "LENSLENGTH", "LIGHTGLYPHDISPLAY", "LIMCHECK",
+    "LIMMAX", "LIMMIN", "LOFTANG1", "LOFTANG2", "LOFTMAG1", "LOFTMAG2",
+    "LOFTNORMALS", "LOFTPARAM", "LONGITUDE", "LTSCALE", "LUNITS", "LUPREC",
+    "LWDISPLAY", "MAXACTVP", "MEASUREMENT", "MENU", "MIRRTEXT", "MODEL_SPACE",
+    "NORTHDIRECTION", "OBSCOLOR", "OBSCUREDCOLOR", "OBSCUREDLTYPE", "OBSLTYPE",
+    "OLESTARTUP", "ORTHOMODE", "OSMODE", "PAPER_SPACE", "PDMODE", "PDSIZE",
+    "PELEVATION", "PELLIPSE", "PEXTMAX", "PEXTMIN", "PICKSTYLE", "PINSBASE",
+    "PLIMCHECK", "PLIMMAX", "PLIMMIN", "PLINEGEN", "PLINEWID", "PROJECTNAME",
+    "PROXIGRAPHICS", "PROXYGRAPHICS", "PSLTSCALE", "PSOLHEIGHT", "PSOLWIDTH",
+    "PSTYLEMODE", "PSVPSCALE", "PUCSBASE", "PUCSNAME", "PUCSORG", "PUCSORGBACK",
+    "PUCSORGBOTTOM", "PUCSORGFRONT", "PUCSORGLEFT", "PUCSORGRIGHT", "PUCSORGTOP",
+    "PUCSORTHOREF", "PUCSORTHOVIEW", "PUCSXDIR", "PUCSYDIR", "QTEXTMODE",
+    "REALWORLDSCALE", "REGENMODE", "SHADEDGE", "SHADEDIF", "SHADOWPLANELOCATION",
+    "SHOWHIST", "SKETCHINC", "SKPOLY", "SNAPSTYLE", "SOLIDHIST", "SORTENTS",
+    "SPLFRAME", "SPLINESEGS", "SPLINETYPE", "STEPSIZE", "STEPSPERSEC",
+    "STYLESHEET", "SUBJECT", "SURFTAB1", "SURFTAB2", "SURFTYPE", "SURFU", "SURFV",
+    "TDCREATE", "TDINDWG", "TDUPDATE", "TDUSRTIMER", "TEXTQLTY", "TEXTSIZE",
+    "TEXTSTYLE", "THICKNESS", "TILEMODE", "TILEMODELIGHTSYNCH", "TIMEZONE",
+    "TITLE", "TRACEWID", "TREEDEPTH", "TSTACKALIGN", "TSTACKSIZE", "UCSBASE",
+    "UCSNAME", "UCSORG", "UCSORGBACK", "UCSORGBOTTOM", "UCSORGFRONT", "UCSORGLEFT",
+    "UCSORGRIGHT", "UCSORGTOP", "UCSORTHOREF", "UCSORTHOVIEW", "UCSXDIR",
+    "UCSYDIR", "UNITMODE", "USERI1", "USERI2", "USERI3", "USERI4", "USERI5",
+    "USERR1", "USERR2", "USERR3", "USERR4", "USERR5", "USRTIMER", "VERSIONGUID",
+    "VIEWCTR", "VISRETAIN", "WIREFRAME", "WORLDVIEW", "XCLIPFRAME", "XEDIT"
+};
+
+/** the known names with '$' (DXF) at 2 * i and without (DWG) at 2 * i + 1 */
+struct KnownVars {
+    std::vector<std::string> names;
+    std::unordered_map<std::string_view, int> index;
+
+    KnownVars() {
+        names.reserve(2 * std::size(knownVarNames));
+        for (const char *n : knownVarNames) {
+            names.push_back(std::string("$") + n);
+            names.push_back(n);
+        }
+        for (size_t i = 0; i < names.size(); ++i)
+            index.emplace(names[i], static_cast<int>(i));
+    }
+    int find(std::string_view key) const {
+        auto it = index.find(key);
+        return it != index.end() ? it->second : -1;
+    }
+};
+
+const KnownVars &knownVars() {
+    static const KnownVars known;
+    return known;
+}
+} // namespace
+
+DRW_HeaderVars::DRW_HeaderVars(const DRW_HeaderVars &other) {
+    for (auto it = other.begin(); it != other.end(); ++it)
+        emplace(it->first, *it->second);
+}
+
+DRW_HeaderVars &DRW_HeaderVars::operator=(const DRW_HeaderVars &other) {
+    if (this != &other) {
+        DRW_HeaderVars copy(other);
+        swap(copy);
+    }
+    return *this;
+}
+
+DRW_HeaderVars &DRW_HeaderVars::operator=(DRW_HeaderVars &&other) noexcept {
+    if (this != &other) {
+        DRW_HeaderVars taken(std::move(other));
+        swap(taken);
+    }
+    return *this;
+}
+
+void DRW_HeaderVars::swap(DRW_HeaderVars &other) noexcept {
+    slots.swap(other.slots);
+    knownSlots.swap(other.knownSlots);
+    otherSlots.swap(other.otherSlots);
+    blocks.swap(other.blocks);
+    std::swap(used, other.used);
+    std::swap(live, other.live);
+}
+
+void *DRW_HeaderVars::nextCell() {
+    if (used == blockSize) {
+        blocks.emplace_back(new Cell[blockSize]);
+        used = 0;
+    }
+    return blocks.back()[used].data;
+}
+
+int DRW_HeaderVars::slotOf(std::string_view key, int known) const {
+    if (known >= 0)
+        return static_cast<size_t>(known) < knownSlots.size() ? knownSlots[known] : -1;
+    auto it = otherSlots.find(std::string(key));
+    return it != otherSlots.end() ? it->second : -1;
+}
+
+void DRW_HeaderVars::insert(std::string_view key, DRW_Variant *var) {
+    const KnownVars &table = knownVars();
+    int known = table.find(key);
+    int slot = slotOf(key, known);
+    if (slot >= 0) {
+        if (slots[slot].var == nullptr)
+            ++live;
+        slots[slot].var = var;
+        return;
+    }
+    if (slots.empty())
+        slots.reserve(256);
+    slot = static_cast<int>(slots.size());
+    if (known >= 0) {
+        if (knownSlots.empty())
+            knownSlots.assign(table.names.size(), -1);
+        knownSlots[known] = slot;
+        slots.push_back(Slot{&table.names[known], var});
+    } else {
+        auto it = otherSlots.emplace(std::string(key), slot).first;
+        slots.push_back(Slot{&it->first, var});
+    }
+    ++live;
+}
+
+DRW_HeaderVars::const_iterator DRW_HeaderVars::find(std::string_view key) const {
+    int slot = slotOf(key, knownVars().find(key));
+    if (slot < 0 || slots[slot].var == nullptr)
+        return end();
+    return const_iterator(slots.data() + slot, slots.data() + slots.size());
+}
+
+void DRW_HeaderVars::erase(const_iterator it) {
+    if (it == end())
+        return;
+    Slot &slot = slots[it.p - slots.data()];
+    slot.var = nullptr;
+    --live;
+}
+
+void DRW_HeaderVars::clear() {
+    destroy();
+    slots.clear();
+    knownSlots.clear();
+    otherSlots.clear();
+    blocks.clear();
+    used = blockSize;
+    live = 0;
+}
+
+void DRW_HeaderVars::destroy() {
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        size_t n = b + 1 == blocks.size() ? used : blockSize;
+        for (size_t i = 0; i < n; ++i)
+            reinterpret_cast<DRW_Variant*>(blocks[b][i].data)->~DRW_Variant();
+    }
+}
+
 DRW_Header::DRW_Header() {
     linetypeCtrl = layerCtrl = styleCtrl = dimstyleCtrl = appidCtrl = 0;
     blockCtrl = viewCtrl = ucsCtrl = vportCtrl = vpEntHeaderCtrl = 0;
@@ -48,10 +229,9 @@ bool DRW_Header::parseCode(int code, dxfReader *reader){
         }
         else {
             waitingFor = VARIABLE_VALUE;
-            curr = new DRW_Variant();
             if (version < DRW::AC1015 && name == "$DIMUNIT")
                 name="$DIMLUNIT";
-            vars[name]=curr;
+            curr = vars.emplace(name);
         }
         break;
     }
@@ -71,8 +251,7 @@ bool DRW_Header::parseCode(int code, dxfReader *reader){
                 break;
             }
             case CUSTOM_VAR_VALUE: {
-                auto var = new DRW_Variant(1, value);
-                customVars[currentCustomVarName]=var;
+                customVars.emplace(currentCustomVarName, 1, value);
                 break;
             }
         }
@@ -1401,36 +1580,31 @@ void DRW_Header::write(dxfWriter *writer, DRW::Version ver){
 }
 
 void DRW_Header::addDouble(std::string key, double value, int code){
-    curr = new DRW_Variant(code, value);
-    vars[key] =curr;
+    curr = vars.emplace(key, code, value);
 }
 
 void DRW_Header::addInt(std::string key, int value, int code){
-    curr = new DRW_Variant(code, value);
-    vars[key] =curr;
+    curr = vars.emplace(key, code, value);
 }
 
 void DRW_Header::addStr(std::string key, std::string value, int code){
-    curr = new DRW_Variant(code, value);
-    vars[key] =curr;
+    curr = vars.emplace(key, code, value);
 }
 
 void DRW_Header::addCoord(std::string key, DRW_Coord value, int code){
-    curr = new DRW_Variant(code, value);
-    vars[key] =curr;
+    curr = vars.emplace(key, code, value);
 }
 
 bool DRW_Header::getDouble(std::string key, double *varDouble){
     bool result = false;
     auto it=vars.find( key);
     if (it != vars.end()) {
-        DRW_Variant *var = (*it).second;
+        DRW_Variant *var = it->second;
         if (var->type() == DRW_Variant::DOUBLE) {
             *varDouble = var->content.d;
             result = true;
         }
-        delete var;
-        vars.erase (it);
+        vars.erase(it);
     }
     return result;
 }
@@ -1439,13 +1613,12 @@ bool DRW_Header::getInt(std::string key, int *varInt){
     bool result = false;
     auto it=vars.find( key);
     if (it != vars.end()) {
-        DRW_Variant *var = (*it).second;
+        DRW_Variant *var = it->second;
         if (var->type() == DRW_Variant::INTEGER) {
             *varInt = var->content.i;
             result = true;
         }
-        delete var;
-        vars.erase (it);
+        vars.erase(it);
     }
     return result;
 }
@@ -1454,13 +1627,12 @@ bool DRW_Header::getStr(std::string key, std::string *varStr){
     bool result = false;
     auto it=vars.find( key);
     if (it != vars.end()) {
-        DRW_Variant *var = (*it).second;
+        DRW_Variant *var = it->second;
         if (var->type() == DRW_Variant::STRING) {
             *varStr = *var->content.s;
             result = true;
         }
-        delete var;
-        vars.erase (it);
+        vars.erase(it);
     }
     return result;
 }
@@ -1469,13 +1641,12 @@ bool DRW_Header::getCoord(std::string key, DRW_Coord *varCoord){
     bool result = false;
     auto it=vars.find( key);
     if (it != vars.end()) {
-        DRW_Variant *var = (*it).second;
+        DRW_Variant *var = it->second;
         if (var->type() == DRW_Variant::COORD) {
             *varCoord = *var->content.v;
             result = true;
         }
-        delete var;
-        vars.erase (it);
+        vars.erase(it);
     }
     return result;
 }
@@ -1510,167 +1681,167 @@ bool DRW_Header::parseDwg(DRW::Version version, dwgBuffer *buf, dwgBuffer *hBbuf
         duint64 requiredVersions = buf->getBitLongLong();
         DRW_DBG("\nREQUIREDVERSIONS var: "); DRW_DBG(requiredVersions);
     }
-    DRW_DBG("\nUnknown1: "); DRW_DBG(buf->getBitDouble());
-    DRW_DBG("\nUnknown2: "); DRW_DBG(buf->getBitDouble());
-    DRW_DBG("\nUnknown3: "); DRW_DBG(buf->getBitDouble());
-    DRW_DBG("\nUnknown4: "); DRW_DBG(buf->getBitDouble());
+    DRW_DBG("\nUnknown1: "); DRW_DBGR(buf->getBitDouble());
+    DRW_DBG("\nUnknown2: "); DRW_DBGR(buf->getBitDouble());
+    DRW_DBG("\nUnknown3: "); DRW_DBGR(buf->getBitDouble());
+    DRW_DBG("\nUnknown4: "); DRW_DBGR(buf->getBitDouble());
     if (version < DRW::AC1021) {//2007-
-        DRW_DBG("\nUnknown text1: "); DRW_DBG(buf->getCP8Text());
-        DRW_DBG("\nUnknown text2: "); DRW_DBG(buf->getCP8Text());
-        DRW_DBG("\nUnknown text3: "); DRW_DBG(buf->getCP8Text());
-        DRW_DBG("\nUnknown text4: "); DRW_DBG(buf->getCP8Text());
+        DRW_DBG("\nUnknown text1: "); DRW_DBGR(buf->getCP8Text());
+        DRW_DBG("\nUnknown text2: "); DRW_DBGR(buf->getCP8Text());
+        DRW_DBG("\nUnknown text3: "); DRW_DBGR(buf->getCP8Text());
+        DRW_DBG("\nUnknown text4: "); DRW_DBGR(buf->getCP8Text());
     }
-    DRW_DBG("\nUnknown long1 (24L): "); DRW_DBG(buf->getBitLong());
-    DRW_DBG("\nUnknown long2 (0L): "); DRW_DBG(buf->getBitLong());
+    DRW_DBG("\nUnknown long1 (24L): "); DRW_DBGR(buf->getBitLong());
+    DRW_DBG("\nUnknown long2 (0L): "); DRW_DBGR(buf->getBitLong());
     if (version < DRW::AC1015) {//pre 2000
-        DRW_DBG("\nUnknown short (0): "); DRW_DBG(buf->getBitShort());
+        DRW_DBG("\nUnknown short (0): "); DRW_DBGR(buf->getBitShort());
     }
     if (version < DRW::AC1018) {//pre 2004
         dwgHandle hcv = hBbuf->getHandle();
         DRW_DBG("\nhandle of current view: "); DRW_DBGHL(hcv.code, hcv.size, hcv.ref);
     }
-    vars["DIMASO"]=new DRW_Variant(70, buf->getBit());
-    vars["DIMSHO"]=new DRW_Variant(70, buf->getBit());
+    vars.emplace("DIMASO", 70, buf->getBit());
+    vars.emplace("DIMSHO", 70, buf->getBit());
     if (version < DRW::AC1015) {//pre 2000
-        vars["DIMSAV"]=new DRW_Variant(70, buf->getBit());
-    }
-    vars["PLINEGEN"]=new DRW_Variant(70, buf->getBit());
-    vars["ORTHOMODE"]=new DRW_Variant(70, buf->getBit());
-    vars["REGENMODE"]=new DRW_Variant(70, buf->getBit());
-    vars["FILLMODE"]=new DRW_Variant(70, buf->getBit());
-    vars["QTEXTMODE"]=new DRW_Variant(70, buf->getBit());
-    vars["PSLTSCALE"]=new DRW_Variant(70, buf->getBit());
-    vars["LIMCHECK"]=new DRW_Variant(70, buf->getBit());
+        vars.emplace("DIMSAV", 70, buf->getBit());
+    }
+    vars.emplace("PLINEGEN", 70, buf->getBit());
+    vars.emplace("ORTHOMODE", 70, buf->getBit());
+    vars.emplace("REGENMODE", 70, buf->getBit());
+    vars.emplace("FILLMODE", 70, buf->getBit());
+    vars.emplace("QTEXTMODE", 70, buf->getBit());
+    vars.emplace("PSLTSCALE", 70, buf->getBit());
+    vars.emplace("LIMCHECK", 70, buf->getBit());
     if (version < DRW::AC1015) {//pre 2000
-        vars["BLIPMODE"]=new DRW_Variant(70, buf->getBit());
+        vars.emplace("BLIPMODE", 70, buf->getBit());
     }
     if (version > DRW::AC1015) {//2004+
-         DRW_DBG("\nUndocumented: "); DRW_DBG(buf->getBit());
+         DRW_DBG("\nUndocumented: "); DRW_DBGR(buf->getBit());
     }
-    vars["USRTIMER"]=new DRW_Variant(70, buf->getBit());
-    vars["SKPOLY"]=new DRW_Variant(70, buf->getBit());
-    vars["ANGDIR"]=new DRW_Variant(70, buf->getBit());
-    vars["SPLFRAME"]=new DRW_Variant(70, buf->getBit());
+    vars.emplace("USRTIMER", 70, buf->getBit());
+    vars.emplace("SKPOLY", 70, buf->getBit());
+    vars.emplace("ANGDIR", 70, buf->getBit());
+    vars.emplace("SPLFRAME", 70, buf->getBit());
     if (version < DRW::AC1015) {//pre 2000
-        vars["ATTREQ"]=new DRW_Variant(70, buf->getBit());
-        vars["ATTDIA"]=new DRW_Variant(70, buf->getBit());
+        vars.emplace("ATTREQ", 70, buf->getBit());
+        vars.emplace("ATTDIA", 70, buf->getBit());
     }
-    vars["MIRRTEXT"]=new DRW_Variant(70, buf->getBit());
-    vars["WORLDVIEW"]=new DRW_Variant(70, buf->getBit());
+    vars.emplace("MIRRTEXT", 70, buf->getBit());
+    vars.emplace("WORLDVIEW", 70, buf->getBit());
     if (version < DRW::AC1015) {//pre 2000
-        vars["WIREFRAME"]=new DRW_Variant(70, buf->getBit());
+        vars.emplace("WIREFRAME", 70, buf->getBit());
     }
-    vars["TILEMODE"]=new DRW_Variant(70, buf->getBit());
-    vars["PLIMCHECK"]=new DRW_Variant(70, buf->getBit());
-    vars["VISRETAIN"]=new DRW_Variant(70, buf->getBit());
+    vars.emplace("TILEMODE", 70, buf->getBit());
+    vars.emplace("PLIMCHECK", 70, buf->getBit());
+    vars.emplace("VISRETAIN", 70, buf->getBit());
     if (version < DRW::AC1015) {//pre 2000
-        vars["DELOBJ"]=new DRW_Variant(70, buf->getBit());
+        vars.emplace("DELOBJ", 70, buf->getBit());
     }
-    vars["DISPSILH"]=new DRW_Variant(70, buf->getBit());
-    vars["PELLIPSE"]=new DRW_Variant(70, buf->getBit());
-    vars["PROXIGRAPHICS"]=new DRW_Variant(70, buf->getBitShort());//RLZ short or bit??
+    vars.emplace("DISPSILH", 70, buf->getBit());
+    vars.emplace("PELLIPSE", 70, buf->getBit());
+    vars.emplace("PROXIGRAPHICS", 70, buf->getBitShort());//RLZ short or bit??
     if (version < DRW::AC1015) {//pre 2000
-        vars["DRAGMODE"]=new DRW_Variant(70, buf->getBitShort());//RLZ short or bit??
+        vars.emplace("DRAGMODE", 70, buf->getBitShort());//RLZ short or bit??
     }
-    vars["TREEDEPTH"]=new DRW_Variant(70, buf->getBitShort());//RLZ short or bit??
-    vars["LUNITS"]=new DRW_Variant(70, buf->getBitShort());
-    vars["LUPREC"]=new DRW_Variant(70, buf->getBitShort());
-    vars["AUNITS"]=new DRW_Variant(70, buf->getBitShort());
-    vars["AUPREC"]=new DRW_Variant(70, buf->getBitShort());
+    vars.emplace("TREEDEPTH", 70, buf->getBitShort());//RLZ short or bit??
+    vars.emplace("LUNITS", 70, buf->getBitShort());
+    vars.emplace("LUPREC", 70, buf->getBitShort());
+    vars.emplace("AUNITS", 70, buf->getBitShort());
+    vars.emplace("AUPREC", 70, buf->getBitShort());
     if (version < DRW::AC1015) {//pre 2000
-        vars["OSMODE"]=new DRW_Variant(70, buf->getBitShort());
+        vars.emplace("OSMODE", 70, buf->getBitShort());
     }
-    vars["ATTMODE"]=new DRW_Variant(70, buf->getBitShort());
+    vars.emplace("ATTMODE", 70, buf->getBitShort());
     if (version < DRW::AC1015) {//pre 2000
-        vars["COORDS"]=new DRW_Variant(70, buf->getBitShort());
+        vars.emplace("COORDS", 70, buf->getBitShort());
     }
-    vars["PDMODE"]=new DRW_Variant(70, buf->getBitShort());
+    vars.emplace("PDMODE", 70, buf->getBitShort());
     if (version < DRW::AC1015) {//pre 2000
-        vars["PICKSTYLE"]=new DRW_Variant(70, buf->getBitShort());
+        vars.emplace("PICKSTYLE", 70, buf->getBitShort());
     }
     if (version > DRW::AC1015) {//2004+
-         DRW_DBG("\nUnknown long 1: "); DRW_DBG(buf->getBitLong());
-         DRW_DBG("\nUnknown long 2: "); DRW_DBG(buf->getBitLong());
-         DRW_DBG("\nUnknown long 3: "); DRW_DBG(buf->getBitLong());
-    }
-    vars["USERI1"]=new DRW_Variant(70, buf->getBitShort());
-    vars["USERI2"]=new DRW_Variant(70, buf->getBitShort());
-    vars["USERI3"]=new DRW_Variant(70, buf->getBitShort());
-    vars["USERI4"]=new DRW_Variant(70, buf->getBitShort());
-    vars["USERI5"]=new DRW_Variant(70, buf->getBitShort());
-    vars["SPLINESEGS"]=new DRW_Variant(70, buf->getBitShort());
-    vars["SURFU"]=new DRW_Variant(70, buf->getBitShort());
-    vars["SURFV"]=new DRW_Variant(70, buf->getBitShort());
-    vars["SURFTYPE"]=new DRW_Variant(70, buf->getBitShort());
-    vars["SURFTAB1"]=new DRW_Variant(70, buf->getBitShort());
-    vars["SURFTAB2"]=new DRW_Variant(70, buf->getBitShort());
-    vars["SPLINETYPE"]=new DRW_Variant(70, buf->getBitShort());
-    vars["SHADEDGE"]=new DRW_Variant(70, buf->getBitShort());
-    vars["SHADEDIF"]=new DRW_Variant(70, buf->getBitShort());
-    vars["UNITMODE"]=new DRW_Variant(70, buf->getBitShort());
-    vars["MAXACTVP"]=new DRW_Variant(70, buf->getBitShort());
-    vars["ISOLINES"]=new DRW_Variant(70, buf->getBitShort());//////////////////
-    vars["CMLJUST"]=new DRW_Variant(70, buf->getBitShort());
-    vars["TEXTQLTY"]=new DRW_Variant(70, buf->getBitShort());/////////////////////
-    vars["LTSCALE"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["TEXTSIZE"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["TRACEWID"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["SKETCHINC"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["FILLETRAD"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["THICKNESS"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["ANGBASE"]=new DRW_Variant(50, buf->getBitDouble());
-    vars["PDSIZE"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["PLINEWID"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["USERR1"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["USERR2"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["USERR3"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["USERR4"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["USERR5"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["CHAMFERA"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["CHAMFERB"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["CHAMFERC"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["CHAMFERD"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["FACETRES"]=new DRW_Variant(40, buf->getBitDouble());/////////////////////////
-    vars["CMLSCALE"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["CELTSCALE"]=new DRW_Variant(40, buf->getBitDouble());
+         DRW_DBG("\nUnknown long 1: "); DRW_DBGR(buf->getBitLong());
+         DRW_DBG("\nUnknown long 2: "); DRW_DBGR(buf->getBitLong());
+         DRW_DBG("\nUnknown long 3: "); DRW_DBGR(buf->getBitLong());
+    }
+    vars.emplace("USERI1", 70, buf->getBitShort());
+    vars.emplace("USERI2", 70, buf->getBitShort());
+    vars.emplace("USERI3", 70, buf->getBitShort());
+    vars.emplace("USERI4", 70, buf->getBitShort());
+    vars.emplace("USERI5", 70, buf->getBitShort());
+    vars.emplace("SPLINESEGS", 70, buf->getBitShort());
+    vars.emplace("SURFU", 70, buf->getBitShort());
+    vars.emplace("SURFV", 70, buf->getBitShort());
+    vars.emplace("SURFTYPE", 70, buf->getBitShort());
+    vars.emplace("SURFTAB1", 70, buf->getBitShort());
+    vars.emplace("SURFTAB2", 70, buf->getBitShort());
+    vars.emplace("SPLINETYPE", 70, buf->getBitShort());
+    vars.emplace("SHADEDGE", 70, buf->getBitShort());
+    vars.emplace("SHADEDIF", 70, buf->getBitShort());
+    vars.emplace("UNITMODE", 70, buf->getBitShort());
+    vars.emplace("MAXACTVP", 70, buf->getBitShort());
+    vars.emplace("ISOLINES", 70, buf->getBitShort());//////////////////
+    vars.emplace("CMLJUST", 70, buf->getBitShort());
+    vars.emplace("TEXTQLTY", 70, buf->getBitShort());/////////////////////
+    vars.emplace("LTSCALE", 40, buf->getBitDouble());
+    vars.emplace("TEXTSIZE", 40, buf->getBitDouble());
+    vars.emplace("TRACEWID", 40, buf->getBitDouble());
+    vars.emplace("SKETCHINC", 40, buf->getBitDouble());
+    vars.emplace("FILLETRAD", 40, buf->getBitDouble());
+    vars.emplace("THICKNESS", 40, buf->getBitDouble());
+    vars.emplace("ANGBASE", 50, buf->getBitDouble());
+    vars.emplace("PDSIZE", 40, buf->getBitDouble());
+    vars.emplace("PLINEWID", 40, buf->getBitDouble());
+    vars.emplace("USERR1", 40, buf->getBitDouble());
+    vars.emplace("USERR2", 40, buf->getBitDouble());
+    vars.emplace("USERR3", 40, buf->getBitDouble());
+    vars.emplace("USERR4", 40, buf->getBitDouble());
+    vars.emplace("USERR5", 40, buf->getBitDouble());
+    vars.emplace("CHAMFERA", 40, buf->getBitDouble());
+    vars.emplace("CHAMFERB", 40, buf->getBitDouble());
+    vars.emplace("CHAMFERC", 40, buf->getBitDouble());
+    vars.emplace("CHAMFERD", 40, buf->getBitDouble());
+    vars.emplace("FACETRES", 40, buf->getBitDouble());/////////////////////////
+    vars.emplace("CMLSCALE", 40, buf->getBitDouble());
+    vars.emplace("CELTSCALE", 40, buf->getBitDouble());
     if (version < DRW::AC1021) {//2004-
-        vars["MENU"]=new DRW_Variant(1, buf->getCP8Text());
+        vars.emplace("MENU", 1, buf->getCP8Text());
     }
     ddouble64 msec, day;
     day = buf->getBitLong();
     msec = buf->getBitLong();
     while (msec > 0)
         msec /=10;
-    vars["TDCREATE"]=new DRW_Variant(40, day+msec);//RLZ: TODO convert to day.msec
-//    vars["TDCREATE"]=new DRW_Variant(40, buf->getBitLong());//RLZ: TODO convert to day.msec
-//    vars["TDCREATE"]=new DRW_Variant(40, buf->getBitLong());
+    vars.emplace("TDCREATE", 40, day+msec);//RLZ: TODO convert to day.msec
+//    vars.emplace("TDCREATE", 40, buf->getBitLong());//RLZ: TODO convert to day.msec
+//    vars.emplace("TDCREATE", 40, buf->getBitLong());
     day = buf->getBitLong();
     msec = buf->getBitLong();
     while (msec > 0)
         msec /=10;
-    vars["TDUPDATE"]=new DRW_Variant(40, day+msec);//RLZ: TODO convert to day.msec
-//    vars["TDUPDATE"]=new DRW_Variant(40, buf->getBitLong());//RLZ: TODO convert to day.msec
-//    vars["TDUPDATE"]=new DRW_Variant(40, buf->getBitLong());
+    vars.emplace("TDUPDATE", 40, day+msec);//RLZ: TODO convert to day.msec
+//    vars.emplace("TDUPDATE", 40, buf->getBitLong());//RLZ: TODO convert to day.msec
+//    vars.emplace("TDUPDATE", 40, buf->getBitLong());
     if (version > DRW::AC1015) {//2004+
-         DRW_DBG("\nUnknown long 4: "); DRW_DBG(buf->getBitLong());
-         DRW_DBG("\nUnknown long 5: "); DRW_DBG(buf->getBitLong());
-         DRW_DBG("\nUnknown long 6: "); DRW_DBG(buf->getBitLong());
+         DRW_DBG("\nUnknown long 4: "); DRW_DBGR(buf->getBitLong());
+         DRW_DBG("\nUnknown long 5: "); DRW_DBGR(buf->getBitLong());
+         DRW_DBG("\nUnknown long 6: "); DRW_DBGR(buf->getBitLong());
     }
     day = buf->getBitLong();
     msec = buf->getBitLong();
     while (msec > 0)
         msec /=10;
-    vars["TDINDWG"]=new DRW_Variant(40, day+msec);//RLZ: TODO convert to day.msec
-//    vars["TDINDWG"]=new DRW_Variant(40, buf->getBitLong());//RLZ: TODO convert to day.msec
-//    vars["TDINDWG"]=new DRW_Variant(40, buf->getBitLong());//RLZ: TODO convert to day.msec
+    vars.emplace("TDINDWG", 40, day+msec);//RLZ: TODO convert to day.msec
+//    vars.emplace("TDINDWG", 40, buf->getBitLong());//RLZ: TODO convert to day.msec
+//    vars.emplace("TDINDWG", 40, buf->getBitLong());//RLZ: TODO convert to day.msec
     day = buf->getBitLong();
     msec = buf->getBitLong();
     while (msec > 0)
         msec /=10;
-    vars["TDUSRTIMER"]=new DRW_Variant(40, day+msec);//RLZ: TODO convert to day.msec
-//    vars["TDUSRTIMER"]=new DRW_Variant(40, buf->getBitLong());//RLZ: TODO convert to day.msec
-//    vars["TDUSRTIMER"]=new DRW_Variant(40, buf->getBitLong());//RLZ: TODO convert to day.msec
-    vars["CECOLOR"]=new DRW_Variant(62, buf->getCmColor(version));//RLZ: TODO read CMC or EMC color
+    vars.emplace("TDUSRTIMER", 40, day+msec);//RLZ: TODO convert to day.msec
+//    vars.emplace("TDUSRTIMER", 40, buf->getBitLong());//RLZ: TODO convert to day.msec
+//    vars.emplace("TDUSRTIMER", 40, buf->getBitLong());//RLZ: TODO convert to day.msec
+    vars.emplace("CECOLOR", 62, buf->getCmColor(version));//RLZ: TODO read CMC or EMC color
     dwgHandle HANDSEED = buf->getHandle();//always present in data stream
     DRW_DBG("\nHANDSEED: "); DRW_DBGHL(HANDSEED.code, HANDSEED.size, HANDSEED.ref);
     dwgHandle CLAYER = hBbuf->getHandle();
@@ -1688,177 +1859,177 @@ bool DRW_Header::parseDwg(DRW::Version version, dwgBuffer *buf, dwgBuffer *hBbuf
     dwgHandle CMLSTYLE = hBbuf->getHandle();
     DRW_DBG("\nCMLSTYLE: "); DRW_DBGHL(CMLSTYLE.code, CMLSTYLE.size, CMLSTYLE.ref);
     if (version > DRW::AC1014) {//2000+
-        vars["PSVPSCALE"]=new DRW_Variant(40, buf->getBitDouble());
-    }
-    vars["PINSBASE"]=new DRW_Variant(10, buf->get3BitDouble());
-    vars["PEXTMIN"]=new DRW_Variant(10, buf->get3BitDouble());
-    vars["PEXTMAX"]=new DRW_Variant(10, buf->get3BitDouble());
-    vars["PLIMMIN"]=new DRW_Variant(10, buf->get2RawDouble());
-    vars["PLIMMAX"]=new DRW_Variant(10, buf->get2RawDouble());
-    vars["PELEVATION"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["PUCSORG"]=new DRW_Variant(10, buf->get3BitDouble());
-    vars["PUCSXDIR"]=new DRW_Variant(10, buf->get3BitDouble());
-    vars["PUCSYDIR"]=new DRW_Variant(10, buf->get3BitDouble());
+        vars.emplace("PSVPSCALE", 40, buf->getBitDouble());
+    }
+    vars.emplace("PINSBASE", 10, buf->get3BitDouble());
+    vars.emplace("PEXTMIN", 10, buf->get3BitDouble());
+    vars.emplace("PEXTMAX", 10, buf->get3BitDouble());
+    vars.emplace("PLIMMIN", 10, buf->get2RawDouble());
+    vars.emplace("PLIMMAX", 10, buf->get2RawDouble());
+    vars.emplace("PELEVATION", 40, buf->getBitDouble());
+    vars.emplace("PUCSORG", 10, buf->get3BitDouble());
+    vars.emplace("PUCSXDIR", 10, buf->get3BitDouble());
+    vars.emplace("PUCSYDIR", 10, buf->get3BitDouble());
     dwgHandle PUCSNAME = hBbuf->getHandle();
     DRW_DBG("\nPUCSNAME: "); DRW_DBGHL(PUCSNAME.code, PUCSNAME.size, PUCSNAME.ref);
     if (version > DRW::AC1014) {//2000+
         dwgHandle PUCSORTHOREF = hBbuf->getHandle();
         DRW_DBG("\nPUCSORTHOREF: "); DRW_DBGHL(PUCSORTHOREF.code, PUCSORTHOREF.size, PUCSORTHOREF.ref);
-        vars["PUCSORTHOVIEW"]=new DRW_Variant(70, buf->getBitShort());
+        vars.emplace("PUCSORTHOVIEW", 70, buf->getBitShort());
         dwgHandle PUCSBASE = hBbuf->getHandle();
         DRW_DBG("\nPUCSBASE: "); DRW_DBGHL(PUCSBASE.code, PUCSBASE.size, PUCSBASE.ref);
-        vars["PUCSORGTOP"]=new DRW_Variant(10, buf->get3BitDouble());
-        vars["PUCSORGBOTTOM"]=new DRW_Variant(10, buf->get3BitDouble());
-        vars["PUCSORGLEFT"]=new DRW_Variant(10, buf->get3BitDouble());
-        vars["PUCSORGRIGHT"]=new DRW_Variant(10, buf->get3BitDouble());
-        vars["PUCSORGFRONT"]=new DRW_Variant(10, buf->get3BitDouble());
-        vars["PUCSORGBACK"]=new DRW_Variant(10, buf->get3BitDouble());
-    }
-    vars["INSBASE"]=new DRW_Variant(10, buf->get3BitDouble());
-    vars["EXTMIN"]=new DRW_Variant(10, buf->get3BitDouble());
-    vars["EXTMAX"]=new DRW_Variant(10, buf->get3BitDouble());
-    vars["LIMMIN"]=new DRW_Variant(10, buf->get2RawDouble());
-    vars["LIMMAX"]=new DRW_Variant(10, buf->get2RawDouble());
-    vars["ELEVATION"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["UCSORG"]=new DRW_Variant(10, buf->get3BitDouble());
-    vars["UCSXDIR"]=new DRW_Variant(10, buf->get3BitDouble());
-    vars["UCSYDIR"]=new DRW_Variant(10, buf->get3BitDouble());
+        vars.emplace("PUCSORGTOP", 10, buf->get3BitDouble());
+        vars.emplace("PUCSORGBOTTOM", 10, buf->get3BitDouble());
+        vars.emplace("PUCSORGLEFT", 10, buf->get3BitDouble());
+        vars.emplace("PUCSORGRIGHT", 10, buf->get3BitDouble());
+        vars.emplace("PUCSORGFRONT", 10, buf->get3BitDouble());
+        vars.emplace("PUCSORGBACK", 10, buf->get3BitDouble());
+    }
+    vars.emplace("INSBASE", 10, buf->get3BitDouble());
+    vars.emplace("EXTMIN", 10, buf->get3BitDouble());
+    vars.emplace("EXTMAX", 10, buf->get3BitDouble());
+    vars.emplace("LIMMIN", 10, buf->get2RawDouble());
+    vars.emplace("LIMMAX", 10, buf->get2RawDouble());
+    vars.emplace("ELEVATION", 40, buf->getBitDouble());
+    vars.emplace("UCSORG", 10, buf->get3BitDouble());
+    vars.emplace("UCSXDIR", 10, buf->get3BitDouble());
+    vars.emplace("UCSYDIR", 10, buf->get3BitDouble());
     dwgHandle UCSNAME = hBbuf->getHandle();
     DRW_DBG("\nUCSNAME: "); DRW_DBGHL(UCSNAME.code, UCSNAME.size, UCSNAME.ref);
     if (version > DRW::AC1014) {//2000+
         dwgHandle UCSORTHOREF = hBbuf->getHandle();
         DRW_DBG("\nUCSORTHOREF: "); DRW_DBGHL(UCSORTHOREF.code, UCSORTHOREF.size, UCSORTHOREF.ref);
-        vars["UCSORTHOVIEW"]=new DRW_Variant(70, buf->getBitShort());
+        vars.emplace("UCSORTHOVIEW", 70, buf->getBitShort());
         dwgHandle UCSBASE = hBbuf->getHandle();
         DRW_DBG("\nUCSBASE: "); DRW_DBGHL(UCSBASE.code, UCSBASE.size, UCSBASE.ref);
-        vars["UCSORGTOP"]=new DRW_Variant(10, buf->get3BitDouble());
-        vars["UCSORGBOTTOM"]=new DRW_Variant(10, buf->get3BitDouble());
-        vars["UCSORGLEFT"]=new DRW_Variant(10, buf->get3BitDouble());
-        vars["UCSORGRIGHT"]=new DRW_Variant(10, buf->get3BitDouble());
-        vars["UCSORGFRONT"]=new DRW_Variant(10, buf->get3BitDouble());
-        vars["UCSORGBACK"]=new DRW_Variant(10, buf->get3BitDouble());
+        vars.emplace("UCSORGTOP", 10, buf->get3BitDouble());
+        vars.emplace("UCSORGBOTTOM", 10, buf->get3BitDouble());
+        vars.emplace("UCSORGLEFT", 10, buf->get3BitDouble());
+        vars.emplace("UCSORGRIGHT", 10, buf->get3BitDouble());
+        vars.emplace("UCSORGFRONT", 10, buf->get3BitDouble());
+        vars.emplace("UCSORGBACK", 10, buf->get3BitDouble());
         if (version < DRW::AC1021) {//2004-
-            vars["DIMPOST"]=new DRW_Variant(1, buf->getCP8Text());
-            vars["DIMAPOST"]=new DRW_Variant(1, buf->getCP8Text());
+            vars.emplace("DIMPOST", 1, buf->getCP8Text());
+            vars.emplace("DIMAPOST", 1, buf->getCP8Text());
         }
     }
     if (version < DRW::AC1015) {//r14-
-        vars["DIMTOL"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMLIM"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMTIH"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMTOH"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMSE1"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMSE2"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMALT"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMTOFL"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMSAH"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMTIX"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMSOXD"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMALTD"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["DIMZIN"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["DIMSD1"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMSD2"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMTOLJ"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["DIMJUST"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["DIMFIT"]=new DRW_Variant(70, buf->getRawChar8());///////////
-        vars["DIMUPT"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMTZIN"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["DIMALTZ"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["DIMALTTZ"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["DIMTAD"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["DIMUNIT"]=new DRW_Variant(70, buf->getBitShort());///////////
-        vars["DIMAUNIT"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMDEC"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMTDEC"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMALTU"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMALTTD"]=new DRW_Variant(70, buf->getBitShort());
+        vars.emplace("DIMTOL", 70, buf->getBit());
+        vars.emplace("DIMLIM", 70, buf->getBit());
+        vars.emplace("DIMTIH", 70, buf->getBit());
+        vars.emplace("DIMTOH", 70, buf->getBit());
+        vars.emplace("DIMSE1", 70, buf->getBit());
+        vars.emplace("DIMSE2", 70, buf->getBit());
+        vars.emplace("DIMALT", 70, buf->getBit());
+        vars.emplace("DIMTOFL", 70, buf->getBit());
+        vars.emplace("DIMSAH", 70, buf->getBit());
+        vars.emplace("DIMTIX", 70, buf->getBit());
+        vars.emplace("DIMSOXD", 70, buf->getBit());
+        vars.emplace("DIMALTD", 70, buf->getRawChar8());
+        vars.emplace("DIMZIN", 70, buf->getRawChar8());
+        vars.emplace("DIMSD1", 70, buf->getBit());
+        vars.emplace("DIMSD2", 70, buf->getBit());
+        vars.emplace("DIMTOLJ", 70, buf->getRawChar8());
+        vars.emplace("DIMJUST", 70, buf->getRawChar8());
+        vars.emplace("DIMFIT", 70, buf->getRawChar8());///////////
+        vars.emplace("DIMUPT", 70, buf->getBit());
+        vars.emplace("DIMTZIN", 70, buf->getRawChar8());
+        vars.emplace("DIMALTZ", 70, buf->getRawChar8());
+        vars.emplace("DIMALTTZ", 70, buf->getRawChar8());
+        vars.emplace("DIMTAD", 70, buf->getRawChar8());
+        vars.emplace("DIMUNIT", 70, buf->getBitShort());///////////
+        vars.emplace("DIMAUNIT", 70, buf->getBitShort());
+        vars.emplace("DIMDEC", 70, buf->getBitShort());
+        vars.emplace("DIMTDEC", 70, buf->getBitShort());
+        vars.emplace("DIMALTU", 70, buf->getBitShort());
+        vars.emplace("DIMALTTD", 70, buf->getBitShort());
         dwgHandle DIMTXSTY = hBbuf->getHandle();
         DRW_DBG("\nDIMTXSTY: "); DRW_DBGHL(DIMTXSTY.code, DIMTXSTY.size, DIMTXSTY.ref);
     }
-    vars["DIMSCALE"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMASZ"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMEXO"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMDLI"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMEXE"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMRND"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMDLE"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMTP"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMTM"]=new DRW_Variant(40, buf->getBitDouble());
+    vars.emplace("DIMSCALE", 40, buf->getBitDouble());
+    vars.emplace("DIMASZ", 40, buf->getBitDouble());
+    vars.emplace("DIMEXO", 40, buf->getBitDouble());
+    vars.emplace("DIMDLI", 40, buf->getBitDouble());
+    vars.emplace("DIMEXE", 40, buf->getBitDouble());
+    vars.emplace("DIMRND", 40, buf->getBitDouble());
+    vars.emplace("DIMDLE", 40, buf->getBitDouble());
+    vars.emplace("DIMTP", 40, buf->getBitDouble());
+    vars.emplace("DIMTM", 40, buf->getBitDouble());
     if (version > DRW::AC1018) {//2007+
-        vars["DIMFXL"]=new DRW_Variant(40, buf->getBitDouble());//////////////////
-        vars["DIMJOGANG"]=new DRW_Variant(40, buf->getBitDouble());///////////////
-        vars["DIMTFILL"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMTFILLCLR"]=new DRW_Variant(62, buf->getCmColor(version));
+        vars.emplace("DIMFXL", 40, buf->getBitDouble());//////////////////
+        vars.emplace("DIMJOGANG", 40, buf->getBitDouble());///////////////
+        vars.emplace("DIMTFILL", 70, buf->getBitShort());
+        vars.emplace("DIMTFILLCLR", 62, buf->getCmColor(version));
     }
     if (version > DRW::AC1014) {//2000+
-        vars["DIMTOL"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMLIM"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMTIH"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMTOH"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMSE1"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMSE2"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMTAD"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMZIN"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMAZIN"]=new DRW_Variant(70, buf->getBitShort());
+        vars.emplace("DIMTOL", 70, buf->getBit());
+        vars.emplace("DIMLIM", 70, buf->getBit());
+        vars.emplace("DIMTIH", 70, buf->getBit());
+        vars.emplace("DIMTOH", 70, buf->getBit());
+        vars.emplace("DIMSE1", 70, buf->getBit());
+        vars.emplace("DIMSE2", 70, buf->getBit());
+        vars.emplace("DIMTAD", 70, buf->getBitShort());
+        vars.emplace("DIMZIN", 70, buf->getBitShort());
+        vars.emplace("DIMAZIN", 70, buf->getBitShort());
     }
     if (version > DRW::AC1018) {//2007+
-        vars["DIMARCSYM"]=new DRW_Variant(70, buf->getBitShort());
-    }
-    vars["DIMTXT"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMCEN"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMTSZ"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMALTF"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMLFAC"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMTVP"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMTFAC"]=new DRW_Variant(40, buf->getBitDouble());
-    vars["DIMGAP"]=new DRW_Variant(40, buf->getBitDouble());
+        vars.emplace("DIMARCSYM", 70, buf->getBitShort());
+    }
+    vars.emplace("DIMTXT", 40, buf->getBitDouble());
+    vars.emplace("DIMCEN", 40, buf->getBitDouble());
+    vars.emplace("DIMTSZ", 40, buf->getBitDouble());
+    vars.emplace("DIMALTF", 40, buf->getBitDouble());
+    vars.emplace("DIMLFAC", 40, buf->getBitDouble());
+    vars.emplace("DIMTVP", 40, buf->getBitDouble());
+    vars.emplace("DIMTFAC", 40, buf->getBitDouble());
+    vars.emplace("DIMGAP", 40, buf->getBitDouble());
     if (version < DRW::AC1015) {//r14-
-        vars["DIMPOST"]=new DRW_Variant(1, buf->getCP8Text());
-        vars["DIMAPOST"]=new DRW_Variant(1, buf->getCP8Text());
-        vars["DIMBLK"]=new DRW_Variant(1, buf->getCP8Text());
-        vars["DIMBLK1"]=new DRW_Variant(1, buf->getCP8Text());
-        vars["DIMBLK2"]=new DRW_Variant(1, buf->getCP8Text());
+        vars.emplace("DIMPOST", 1, buf->getCP8Text());
+        vars.emplace("DIMAPOST", 1, buf->getCP8Text());
+        vars.emplace("DIMBLK", 1, buf->getCP8Text());
+        vars.emplace("DIMBLK1", 1, buf->getCP8Text());
+        vars.emplace("DIMBLK2", 1, buf->getCP8Text());
     }
     if (version > DRW::AC1014) {//2000+
-        vars["DIMALTRND"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["DIMALT"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMALTD"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMTOFL"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMSAH"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMTIX"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMSOXD"]=new DRW_Variant(70, buf->getBit());
-    }
-    vars["DIMCLRD"]=new DRW_Variant(70, buf->getCmColor(version));//RLZ: TODO read CMC or EMC color
-    vars["DIMCLRE"]=new DRW_Variant(70, buf->getCmColor(version));//RLZ: TODO read CMC or EMC color
-    vars["DIMCLRT"]=new DRW_Variant(70, buf->getCmColor(version));//RLZ: TODO read CMC or EMC color
+        vars.emplace("DIMALTRND", 40, buf->getBitDouble());
+        vars.emplace("DIMALT", 70, buf->getBit());
+        vars.emplace("DIMALTD", 70, buf->getBitShort());
+        vars.emplace("DIMTOFL", 70, buf->getBit());
+        vars.emplace("DIMSAH", 70, buf->getBit());
+        vars.emplace("DIMTIX", 70, buf->getBit());
+        vars.emplace("DIMSOXD", 70, buf->getBit());
+    }
+    vars.emplace("DIMCLRD", 70, buf->getCmColor(version));//RLZ: TODO read CMC or EMC color
+    vars.emplace("DIMCLRE", 70, buf->getCmColor(version));//RLZ: TODO read CMC or EMC color
+    vars.emplace("DIMCLRT", 70, buf->getCmColor(version));//RLZ: TODO read CMC or EMC color
     if (version > DRW::AC1014) {//2000+
-        vars["DIAMDEC"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMDEC"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMTDEC"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMALTU"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMALTTD"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMAUNIT"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMFAC"]=new DRW_Variant(70, buf->getBitShort());///////////////// DIMFAC O DIMFRAC
-        vars["DIMLUNIT"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMDSEP"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMTMOVE"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMJUST"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMSD1"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMSD2"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMTOLJ"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMTZIN"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMALTZ"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMALTTZ"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMUPT"]=new DRW_Variant(70, buf->getBit());
-        vars["DIMATFIT"]=new DRW_Variant(70, buf->getBitShort());
+        vars.emplace("DIAMDEC", 70, buf->getBitShort());
+        vars.emplace("DIMDEC", 70, buf->getBitShort());
+        vars.emplace("DIMTDEC", 70, buf->getBitShort());
+        vars.emplace("DIMALTU", 70, buf->getBitShort());
+        vars.emplace("DIMALTTD", 70, buf->getBitShort());
+        vars.emplace("DIMAUNIT", 70, buf->getBitShort());
+        vars.emplace("DIMFAC", 70, buf->getBitShort());///////////////// DIMFAC O DIMFRAC
+        vars.emplace("DIMLUNIT", 70, buf->getBitShort());
+        vars.emplace("DIMDSEP", 70, buf->getBitShort());
+        vars.emplace("DIMTMOVE", 70, buf->getBitShort());
+        vars.emplace("DIMJUST", 70, buf->getBitShort());
+        vars.emplace("DIMSD1", 70, buf->getBit());
+        vars.emplace("DIMSD2", 70, buf->getBit());
+        vars.emplace("DIMTOLJ", 70, buf->getBitShort());
+        vars.emplace("DIMTZIN", 70, buf->getBitShort());
+        vars.emplace("DIMALTZ", 70, buf->getBitShort());
+        vars.emplace("DIMALTTZ", 70, buf->getBitShort());
+        vars.emplace("DIMUPT", 70, buf->getBit());
+        vars.emplace("DIMATFIT", 70, buf->getBitShort());
     }
     if (version > DRW::AC1018) {//2007+
-        vars["DIMFXLON"]=new DRW_Variant(70, buf->getBit());////////////////
+        vars.emplace("DIMFXLON", 70, buf->getBit());////////////////
     }
     if (version > DRW::AC1021) {//2010+
-        vars["DIMTXTDIRECTION"]=new DRW_Variant(70, buf->getBit());////////////////
-        vars["DIMALTMZF"]=new DRW_Variant(40, buf->getBitDouble());////////////////
-        vars["DIMMZF"]=new DRW_Variant(40, buf->getBitDouble());////////////////
+        vars.emplace("DIMTXTDIRECTION", 70, buf->getBit());////////////////
+        vars.emplace("DIMALTMZF", 40, buf->getBitDouble());////////////////
+        vars.emplace("DIMMZF", 40, buf->getBitDouble());////////////////
     }
     if (version > DRW::AC1014) {//2000+
         dwgHandle DIMTXSTY = hBbuf->getHandle();
@@ -1881,8 +2052,8 @@ bool DRW_Header::parseDwg(DRW::Version version, dwgBuffer *buf, dwgBuffer *hBbuf
         DRW_DBG("\nDIMLTEX2: "); DRW_DBGHL(DIMLTEX2.code, DIMLTEX2.size, DIMLTEX2.ref);
     }
     if (version > DRW::AC1014) {//2000+
-        vars["DIMLWD"]=new DRW_Variant(70, buf->getBitShort());
-        vars["DIMLWE"]=new DRW_Variant(70, buf->getBitShort());
+        vars.emplace("DIMLWD", 70, buf->getBitShort());
+        vars.emplace("DIMLWE", 70, buf->getBitShort());
     }
     dwgHandle CONTROL = hBbuf->getHandle();
     DRW_DBG("\nBLOCK CONTROL: "); DRW_DBGHL(CONTROL.code, CONTROL.size, CONTROL.ref);
@@ -1924,11 +2095,11 @@ bool DRW_Header::parseDwg(DRW::Version version, dwgBuffer *buf, dwgBuffer *hBbuf
     DRW_DBG("\nDICT NAMED OBJS: "); DRW_DBGHL(CONTROL.code, CONTROL.size, CONTROL.ref);
 
     if (version > DRW::AC1014) {//2000+
-        vars["TSTACKALIGN"]=new DRW_Variant(70, buf->getBitShort());
-        vars["TSTACKSIZE"]=new DRW_Variant(70, buf->getBitShort());
+        vars.emplace("TSTACKALIGN", 70, buf->getBitShort());
+        vars.emplace("TSTACKSIZE", 70, buf->getBitShort());
         if (version < DRW::AC1021) {//2004-
-            vars["HYPERLINKBASE"]=new DRW_Variant(1, buf->getCP8Text());
-            vars["STYLESHEET"]=new DRW_Variant(1, buf->getCP8Text());
+            vars.emplace("HYPERLINKBASE", 1, buf->getCP8Text());
+            vars.emplace("STYLESHEET", 1, buf->getCP8Text());
         }
         CONTROL = hBbuf->getHandle();
         DRW_DBG("\nDICT LAYOUTS: "); DRW_DBGHL(CONTROL.code, CONTROL.size, CONTROL.ref);
@@ -1952,32 +2123,32 @@ bool DRW_Header::parseDwg(DRW::Version version, dwgBuffer *buf, dwgBuffer *hBbuf
         DRW_DBG("\nUNKNOWN HANDLE: "); DRW_DBGHL(CONTROL.code, CONTROL.size, CONTROL.ref);
     }
     if (version > DRW::AC1014) {//2000+
-        DRW_DBG("\nFlags: "); DRW_DBGH(buf->getBitLong());//RLZ TODO change to 8 vars
-        vars["INSUNITS"]=new DRW_Variant(70, buf->getBitShort());
+        DRW_DBG("\nFlags: "); DRW_DBGHR(buf->getBitLong());//RLZ TODO change to 8 vars
+        vars.emplace("INSUNITS", 70, buf->getBitShort());
         duint16 cepsntype = buf->getBitShort();
-        vars["CEPSNTYPE"]=new DRW_Variant(70, cepsntype);
+        vars.emplace("CEPSNTYPE", 70, cepsntype);
         if (cepsntype == 3){
             CONTROL = hBbuf->getHandle();
             DRW_DBG("\nCPSNID HANDLE: "); DRW_DBGHL(CONTROL.code, CONTROL.size, CONTROL.ref);
         }
         if (version < DRW::AC1021) {//2004-
-            vars["FINGERPRINTGUID"]=new DRW_Variant(1, buf->getCP8Text());
-            vars["VERSIONGUID"]=new DRW_Variant(1, buf->getCP8Text());
+            vars.emplace("FINGERPRINTGUID", 1, buf->getCP8Text());
+            vars.emplace("VERSIONGUID", 1, buf->getCP8Text());
         }
     }
     if (version > DRW::AC1015) {//2004+
-        vars["SORTENTS"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["INDEXCTL"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["HIDETEXT"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["XCLIPFRAME"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["DIMASSOC"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["HALOGAP"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["OBSCUREDCOLOR"]=new DRW_Variant(70, buf->getBitShort());
-        vars["INTERSECTIONCOLOR"]=new DRW_Variant(70, buf->getBitShort());
-        vars["OBSCUREDLTYPE"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["INTERSECTIONDISPLAY"]=new DRW_Variant(70, buf->getRawChar8());
+        vars.emplace("SORTENTS", 70, buf->getRawChar8());
+        vars.emplace("INDEXCTL", 70, buf->getRawChar8());
+        vars.emplace("HIDETEXT", 70, buf->getRawChar8());
+        vars.emplace("XCLIPFRAME", 70, buf->getRawChar8());
+        vars.emplace("DIMASSOC", 70, buf->getRawChar8());
+        vars.emplace("HALOGAP", 70, buf->getRawChar8());
+        vars.emplace("OBSCUREDCOLOR", 70, buf->getBitShort());
+        vars.emplace("INTERSECTIONCOLOR", 70, buf->getBitShort());
+        vars.emplace("OBSCUREDLTYPE", 70, buf->getRawChar8());
+        vars.emplace("INTERSECTIONDISPLAY", 70, buf->getRawChar8());
         if (version < DRW::AC1021) {//2004-
-            vars["PROJECTNAME"]=new DRW_Variant(1, buf->getCP8Text());
+            vars.emplace("PROJECTNAME", 1, buf->getCP8Text());
         }
     }
     CONTROL = hBbuf->getHandle();
@@ -1991,49 +2162,49 @@ bool DRW_Header::parseDwg(DRW::Version version, dwgBuffer *buf, dwgBuffer *hBbuf
     CONTROL = hBbuf->getHandle();
     DRW_DBG("\nLTYPE CONTINUOUS: "); DRW_DBGHL(CONTROL.code, CONTROL.size, CONTROL.ref);
     if (version > DRW::AC1018) {//2007+
-        vars["CAMERADISPLAY"]=new DRW_Variant(70, buf->getBit());
-        DRW_DBG("\nUnknown 2007+ long1: "); DRW_DBG(buf->getBitLong());
-        DRW_DBG("\nUnknown 2007+ long2: "); DRW_DBG(buf->getBitLong());
-        DRW_DBG("\nUnknown 2007+ double2: "); DRW_DBG(buf->getBitDouble());
-        vars["STEPSPERSEC"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["STEPSIZE"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["3DDWFPREC"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["LENSLENGTH"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["CAMERAHEIGHT"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["SOLIDHIST"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["SHOWHIST"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["PSOLWIDTH"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["PSOLHEIGHT"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["LOFTANG1"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["LOFTANG2"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["LOFTMAG1"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["LOFTMAG2"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["LOFTPARAM"]=new DRW_Variant(70, buf->getBitShort());
-        vars["LOFTNORMALS"]=new DRW_Variant(40, buf->getRawChar8());
-        vars["LATITUDE"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["LONGITUDE"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["NORTHDIRECTION"]=new DRW_Variant(40, buf->getBitDouble());
-        vars["TIMEZONE"]=new DRW_Variant(70, buf->getBitLong());
-        vars["LIGHTGLYPHDISPLAY"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["TILEMODELIGHTSYNCH"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["DWFFRAME"]=new DRW_Variant(70, buf->getRawChar8());
-        vars["DGNFRAME"]=new DRW_Variant(70, buf->getRawChar8());
-        DRW_DBG("\nUnknown 2007+ BIT: "); DRW_DBG(buf->getBit());
-        vars["INTERFERECOLOR"]=new DRW_Variant(70, buf->getCmColor(version));
+        vars.emplace("CAMERADISPLAY", 70, buf->getBit());
+        DRW_DBG("\nUnknown 2007+ long1: "); DRW_DBGR(buf->getBitLong());
+        DRW_DBG("\nUnknown 2007+ long2: "); DRW_DBGR(buf->getBitLong());
+        DRW_DBG("\nUnknown 2007+ double2: "); DRW_DBGR(buf->getBitDouble());
+        vars.emplace("STEPSPERSEC", 40, buf->getBitDouble());
+        vars.emplace("STEPSIZE", 40, buf->getBitDouble());
+        vars.emplace("3DDWFPREC", 40, buf->getBitDouble());
+        vars.emplace("LENSLENGTH", 40, buf->getBitDouble());
+        vars.emplace("CAMERAHEIGHT", 40, buf->getBitDouble());
+        vars.emplace("SOLIDHIST", 70, buf->getRawChar8());
+        vars.emplace("SHOWHIST", 70, buf->getRawChar8());
+        vars.emplace("PSOLWIDTH", 40, buf->getBitDouble());
+        vars.emplace("PSOLHEIGHT", 40, buf->getBitDouble());
+        vars.emplace("LOFTANG1", 40, buf->getBitDouble());
+        vars.emplace("LOFTANG2", 40, buf->getBitDouble());
+        vars.emplace("LOFTMAG1", 40, buf->getBitDouble());
+        vars.emplace("LOFTMAG2", 40, buf->getBitDouble());
+        vars.emplace("LOFTPARAM", 70, buf->getBitShort());
+        vars.emplace("LOFTNORMALS", 40, buf->getRawChar8());
+        vars.emplace("LATITUDE", 40, buf->getBitDouble());
+        vars.emplace("LONGITUDE", 40, buf->getBitDouble());
+        vars.emplace("NORTHDIRECTION", 40, buf->getBitDouble());
+        vars.emplace("TIMEZONE", 70, buf->getBitLong());
+        vars.emplace("LIGHTGLYPHDISPLAY", 70, buf->getRawChar8());
+        vars.emplace("TILEMODELIGHTSYNCH", 70, buf->getRawChar8());
+        vars.emplace("DWFFRAME", 70, buf->getRawChar8());
+        vars.emplace("DGNFRAME", 70, buf->getRawChar8());
+        DRW_DBG("\nUnknown 2007+ BIT: "); DRW_DBGR(buf->getBit());
+        vars.emplace("INTERFERECOLOR", 70, buf->getCmColor(version));
         CONTROL = hBbuf->getHandle();
         DRW_DBG("\nINTERFEREOBJVS: "); DRW_DBGHL(CONTROL.code, CONTROL.size, CONTROL.ref);
         CONTROL = hBbuf->getHandle();
         DRW_DBG("\nINTERFEREVPVS: "); DRW_DBGHL(CONTROL.code, CONTROL.size, CONTROL.ref);
         CONTROL = hBbuf->getHandle();
         DRW_DBG("\nDRAGVS: "); DRW_DBGHL(CONTROL.code, CONTROL.size, CONTROL.ref);
-        vars["CSHADOW"]=new DRW_Variant(70, buf->getRawChar8());
-        DRW_DBG("\nUnknown 2007+ double2: "); DRW_DBG(buf->getBitDouble());
+        vars.emplace("CSHADOW", 70, buf->getRawChar8());
+        DRW_DBG("\nUnknown 2007+ double2: "); DRW_DBGR(buf->getBitDouble());
     }
     if (version > DRW::AC1012) {//R14+
-        DRW_DBG("\nUnknown R14+ short1: "); DRW_DBG(buf->getBitShort());
-        DRW_DBG("\nUnknown R14+ short2: "); DRW_DBG(buf->getBitShort());
-        DRW_DBG("\nUnknown R14+ short3: "); DRW_DBG(buf->getBitShort());
-        DRW_DBG("\nUnknown R14+ short4: "); DRW_DBG(buf->getBitShort());
+        DRW_DBG("\nUnknown R14+ short1: "); DRW_DBGR(buf->getBitShort());
+        DRW_DBG("\nUnknown R14+ short2: "); DRW_DBGR(buf->getBitShort());
+        DRW_DBG("\nUnknown R14+ short3: "); DRW_DBGR(buf->getBitShort());
+        DRW_DBG("\nUnknown R14+ short4: "); DRW_DBGR(buf->getBitShort());
     }
 
     DRW_DBG("\nbuf position: "); DRW_DBG(buf->getPosition());
@@ -2066,26 +2237,26 @@ bool DRW_Header::parseDwg(DRW::Version version, dwgBuffer *buf, dwgBuffer *hBbuf
             DRW_DBG("\nstring buf position: "); DRW_DBG(buf->getPosition());
             DRW_DBG("\nstring buf bit position: "); DRW_DBG(buf->getBitPos());
         }
-        DRW_DBG("\nUnknown text1: "); DRW_DBG(buf->getUCSText(false));
-        DRW_DBG("\nUnknown text2: "); DRW_DBG(buf->getUCSText(false));
-        DRW_DBG("\nUnknown text3: "); DRW_DBG(buf->getUCSText(false));
-        DRW_DBG("\nUnknown text4: "); DRW_DBG(buf->getUCSText(false));
-        vars["MENU"]=new DRW_Variant(1, buf->getUCSText(false));
-        vars["DIMPOST"]=new DRW_Variant(1, buf->getUCSText(false));
-        vars["DIMAPOST"]=new DRW_Variant(1, buf->getUCSText(false));
+        DRW_DBG("\nUnknown text1: "); DRW_DBGR(buf->getUCSText(false));
+        DRW_DBG("\nUnknown text2: "); DRW_DBGR(buf->getUCSText(false));
+        DRW_DBG("\nUnknown text3: "); DRW_DBGR(buf->getUCSText(false));
+        DRW_DBG("\nUnknown text4: "); DRW_DBGR(buf->getUCSText(false));
+        vars.emplace("MENU", 1, buf->getUCSText(false));
+        vars.emplace("DIMPOST", 1, buf->getUCSText(false));
+        vars.emplace("DIMAPOST", 1, buf->getUCSText(false));
         if (version > DRW::AC1021) {//2010+
-            vars["DIMALTMZS"]=new DRW_Variant(70, buf->getUCSText(false));//RLZ: pending to verify//////////////
-            vars["DIMMZS"]=new DRW_Variant(70, buf->getUCSText(false));//RLZ: pending to verify//////////////
+            vars.emplace("DIMALTMZS", 70, buf->getUCSText(false));//RLZ: pending to verify//////////////
+            vars.emplace("DIMMZS", 70, buf->getUCSText(false));//RLZ: pending to verify//////////////
         }
-        vars["HYPERLINKBASE"]=new DRW_Variant(1, buf->getUCSText(false));
-        vars["STYLESHEET"]=new DRW_Variant(1, buf->getUCSText(false));
-        vars["FINGERPRINTGUID"]=new DRW_Variant(1, buf->getUCSText(false));
+        vars.emplace("HYPERLINKBASE", 1, buf->getUCSText(false));
+        vars.emplace("STYLESHEET", 1, buf->getUCSText(false));
+        vars.emplace("FINGERPRINTGUID", 1, buf->getUCSText(false));
         DRW_DBG("\nstring buf position: "); DRW_DBG(buf->getPosition());
         DRW_DBG("  string buf bit position: "); DRW_DBG(buf->getBitPos());
-        vars["VERSIONGUID"]=new DRW_Variant(1, buf->getUCSText(false));
+        vars.emplace("VERSIONGUID", 1, buf->getUCSText(false));
         DRW_DBG("\nstring buf position: "); DRW_DBG(buf->getPosition());
         DRW_DBG("  string buf bit position: "); DRW_DBG(buf->getBitPos());
-        vars["PROJECTNAME"]=new DRW_Variant(1, buf->getUCSText(false));
+        vars.emplace("PROJECTNAME", 1, buf->getUCSText(false));
     }
 /***    ****/
     DRW_DBG("\nstring buf position: "); DRW_DBG(buf->getPosition());
@@ -2122,11 +2293,11 @@ bool DRW_Header::parseDwg(DRW::Version version, dwgBuffer *buf, dwgBuffer *hBbuf
         buf->getRawLong32();//advance 4 bytes (hisize)
     }
     DRW_DBG("\nsetting position to: "); DRW_DBG(buf->getPosition());
-    DRW_DBG("\nHeader CRC: "); DRW_DBGH(buf->getRawShort16());
+    DRW_DBG("\nHeader CRC: "); DRW_DBGHR(buf->getRawShort16());
     DRW_DBG("\nbuf position: "); DRW_DBG(buf->getPosition());
     DRW_DBG("\ndwg header end sentinel= ");
     for (int i=0; i<16;i++) {
-        DRW_DBGH(buf->getRawChar8()); DRW_DBG(" ");
+        DRW_DBGHR(buf->getRawChar8()); DRW_DBG(" ");
     }
 
     //temporary code to show header end sentinel
@@ -2137,7 +2308,7 @@ bool DRW_Header::parseDwg(DRW::Version version, dwgBuffer *buf, dwgBuffer *hBbuf
         DRW_DBG("\nsetting position to: "); DRW_DBG(buf->getPosition());
         DRW_DBG("\ndwg header end sentinel= ");
         for (int i=0; i<16;i++) {
-            DRW_DBGH(buf->getRawChar8()); DRW_DBG(" ");
+            DRW_DBGHR(buf->getRawChar8()); DRW_DBG(" ");
         }
     } else if (version == DRW::AC1018) {//2004
 //        sz= buf->size()-132;
@@ -2146,7 +2317,7 @@ bool DRW_Header::parseDwg(DRW::Version version, dwgBuffer *buf, dwgBuffer *hBbuf
         DRW_DBG("\nsetting position to: "); DRW_DBG(buf->getPosition());
         DRW_DBG("\ndwg header end sentinel= ");
         for (int i=0; i<16;i++) {
-            DRW_DBGH(buf->getRawChar8()); DRW_DBG(" ");
+            DRW_DBGHR(buf->getRawChar8()); DRW_DBG(" ");
         }
     } else if (version == DRW::AC1021) {//2007
         sz= buf->size()-16;
@@ -2154,7 +2325,7 @@ bool DRW_Header::parseDwg(DRW::Version version, dwgBuffer *buf, dwgBuffer *hBbuf
         DRW_DBG("\nsetting position to: "); DRW_DBG(buf->getPosition());
         DRW_DBG("\ndwg header end sentinel= ");
         for (int i=0; i<16;i++) {
-            DRW_DBGH(buf->getRawChar8()); DRW_DBG(" ");
+            DRW_DBGHR(buf->getRawChar8()); DRW_DBG(" ");
         }
     } else if (version == DRW::AC1024) {//2010
 //        sz= buf->size()-93;
@@ -2163,7 +2334,7 @@ bool DRW_Header::parseDwg(DRW::Version version, dwgBuffer *buf, dwgBuffer *hBbuf
         DRW_DBG("\nsetting position to: "); DRW_DBG(buf->getPosition());
         DRW_DBG("\ndwg header end sentinel= ");
         for (int i=0; i<16;i++) {
-            DRW_DBGH(buf->getRawChar8()); DRW_DBG(" ");
+            DRW_DBGHR(buf->getRawChar8()); DRW_DBG(" ");
         }
     } else if (version == DRW::AC1027) {//2013
 //        sz= buf->size()-76;
@@ -2172,7 +2343,7 @@ bool DRW_Header::parseDwg(DRW::Version version, dwgBuffer *buf, dwgBuffer *hBbuf
         DRW_DBG("\nsetting position to: "); DRW_DBG(buf->getPosition());
         DRW_DBG("\ndwg header end sentinel= ");
         for (int i=0; i<16;i++) {
-            DRW_DBGH(buf->getRawChar8()); DRW_DBG(" ");
+            DRW_DBGHR(buf->getRawChar8()); DRW_DBG(" ");
         }
     }
 
@@ -15,7 +15,14 @@
 #define DRW_HEADER_H
 
 
+#include <iterator>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 #include "drw_base.h"
 
 class dxfReader;
@@ -25,11 +32,106 @@ class dwgBuffer;
 #define SETHDRFRIENDS  friend class dxfRW; \
                        friend class dwgReader;
 
+//! Header variables by name
+/*!
+*  The variants are built in blocks owned by the container, so a header
+*  costs a few allocations instead of two per variable, and moving it
+*  moves the blocks. The names of the variables known to libdxfrw (with and
+*  without the DXF '$') are interned in a static table and indexed by their
+*  position in it; other names are kept in a map.
+*  Iteration is in insertion order, items have "first" (the name) and
+*  "second" (the DRW_Variant*) like the elements of a std::map.
+*/
+class DRW_HeaderVars {
+public:
+    struct value_type {
+        const std::string &first;
+        DRW_Variant *second;
+    };
+private:
+    struct Slot {
+        const std::string *key;
+        DRW_Variant *var;   //nullptr once erased
+    };
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = DRW_HeaderVars::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = value_type;
+
+        struct Arrow {
+            value_type item;
+            const value_type *operator->() const {return &item;}
+        };
+
+        value_type operator*() const {return {*p->key, p->var};}
+        Arrow operator->() const {return Arrow{**this};}
+        const_iterator &operator++() {++p; skip(); return *this;}
+        const_iterator operator++(int) {const_iterator t = *this; ++*this; return t;}
+        bool operator==(const const_iterator &o) const {return p == o.p;}
+        bool operator!=(const const_iterator &o) const {return p != o.p;}
+
+    private:
+        friend class DRW_HeaderVars;
+        const_iterator(const Slot *pos, const Slot *last): p(pos), e(last) {skip();}
+        void skip() {while (p != e && p->var == nullptr) ++p;}
+        const Slot *p;
+        const Slot *e;
+    };
+    using iterator = const_iterator;
+
+    DRW_HeaderVars() = default;
+    ~DRW_HeaderVars() {destroy();}
+    DRW_HeaderVars(const DRW_HeaderVars &other);
+    DRW_HeaderVars(DRW_HeaderVars &&other) noexcept {swap(other);}
+    DRW_HeaderVars &operator=(const DRW_HeaderVars &other);
+    DRW_HeaderVars &operator=(DRW_HeaderVars &&other) noexcept;
+
+    /** builds variable key from args, replacing a previous one */
+    template <class... Args>
+    DRW_Variant *emplace(std::string_view key, Args&&... args) {
+        DRW_Variant *var = new (nextCell()) DRW_Variant(std::forward<Args>(args)...);
+        ++used;
+        insert(key, var);
+        return var;
+    }
+    const_iterator find(std::string_view key) const;
+    size_t count(std::string_view key) const {return find(key) != end() ? 1 : 0;}
+    /** removes the variable, its variant lives until clear() */
+    void erase(const_iterator it);
+    const_iterator begin() const {return const_iterator(slots.data(), slots.data() + slots.size());}
+    const_iterator end() const {return const_iterator(slots.data() + slots.size(), slots.data() + slots.size());}
+    size_t size() const {return live;}
+    bool empty() const {return live == 0;}
+    void clear();
+    void swap(DRW_HeaderVars &other) noexcept;
+
+private:
+    struct alignas(DRW_Variant) Cell {
+        unsigned char data[sizeof(DRW_Variant)];
+    };
+    static constexpr size_t blockSize = 64;
+
+    void *nextCell();
+    void insert(std::string_view key, DRW_Variant *var);
+    int slotOf(std::string_view key, int known) const;
+    void destroy();
+
+    std::vector<Slot> slots;
+    std::vector<int> knownSlots;    //slot of each known name, -1 if absent
+    std::unordered_map<std::string, int> otherSlots;
+    std::vector<std::unique_ptr<Cell[]>> blocks;
+    size_t used {blockSize};        //cells built in the last block
+    size_t live {0};
+};
+
 //! Class to handle header entries
 /*!
-*  Class to handle header vars, to read iterate over "std::unordered_map vars"
-*  to write add a DRW_Variant* into "std::unordered_map vars" (do not delete it, are cleared in dtor)
-*  or use add* helper functions.
+*  Class to handle header vars, to read iterate over "vars"
+*  to write use vars.emplace() or the add* helper functions.
 *  @author Rallaz
 */
 class DRW_Header : public DRW_ParseableEntity{
@@ -70,29 +172,37 @@ public:
         Metric = 1,             ///< Metric drawing */
     };
 
-    DRW_Header(const DRW_Header& h){
-        this->version = h.version;
-        this->comments = h.comments;
-        for (auto it=h.vars.begin(); it!=h.vars.end(); ++it){
-            this->vars[it->first] = new DRW_Variant( *(it->second) );
-        }
-        for (auto it=h.customVars.begin(); it!=h.customVars.end(); ++it){
-            this->customVars[it->first] = new DRW_Variant( *(it->second) );
-        }
-        this->curr = nullptr;
+    DRW_Header(const DRW_Header& h)
+        : vars(h.vars)
+        , customVars(h.customVars)
+        , comments(h.comments)
+        , version(h.version) {
+    }
+    DRW_Header(DRW_Header&& h) noexcept
+        : vars(std::move(h.vars))
+        , customVars(std::move(h.customVars))
+        , comments(std::move(h.comments))
+        , version(h.version) {
+        h.curr = nullptr;
     }
     DRW_Header& operator=(const DRW_Header &h) {
        if(this != &h) {
-           clearVars();
            this->version = h.version;
            this->comments = h.comments;
-           for (auto it=h.vars.begin(); it!=h.vars.end(); ++it){
-               this->vars[it->first] = new DRW_Variant( *(it->second) );
-           }
-
-           for (auto it=h.customVars.begin(); it!=h.customVars.end(); ++it){
-               this->customVars[it->first] = new DRW_Variant( *(it->second) );
-           }
+           this->vars = h.vars;
+           this->customVars = h.customVars;
+       }
+       return *this;
+    }
+    /** takes the variables of h, which is left empty */
+    DRW_Header& operator=(DRW_Header &&h) noexcept {
+       if(this != &h) {
+           this->version = h.version;
+           this->comments = std::move(h.comments);
+           this->vars = std::move(h.vars);
+           this->customVars = std::move(h.customVars);
+           h.comments.clear();
+           h.curr = nullptr;
        }
        return *this;
     }
@@ -105,8 +215,8 @@ public:
     void write(dxfWriter *writer, DRW::Version ver);
     void addComment(std::string c);
     bool parseCode(int code, dxfReader *reader) override;
-    std::unordered_map<std::string,DRW_Variant*> vars;
-    std::unordered_map<std::string,DRW_Variant*> customVars;
+    DRW_HeaderVars vars;
+    DRW_HeaderVars customVars;
     static int measurement(const int unit);
 protected:
     void writeVar(dxfWriter* writer, std::string name, double defaultValue, int varCode = 40);
@@ -144,14 +254,7 @@ private:
     bool getCoord(std::string key, DRW_Coord *varStr);
 
     void clearVars(){
-        for (auto it=vars.begin(); it!=vars.end(); ++it)
-            delete it->second;
-
         vars.clear();
-
-        for (auto it=customVars.begin(); it!=customVars.end(); ++it)
-            delete it->second;
-
         customVars.clear();
     }
 };
@@ -14,11 +14,135 @@
 #define DRW_INTERFACE_H
 
 #include <cstring>
+#include <type_traits>
+#include <vector>
 
 #include "drw_entities.h"
 #include "drw_objects.h"
 #include "drw_header.h"
 
+/**
+ * Coordinates kept as one flat array per axis, the n-th point being
+ * (x[n], y[n], z[n]).
+ */
+class DRW_CoordColumns {
+public:
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> z;
+
+    size_t size() const {return x.size();}
+    void add(const DRW_Coord &p) {
+        x.push_back(p.x);
+        y.push_back(p.y);
+        z.push_back(p.z);
+    }
+    void clear() {
+        x.clear();
+        y.clear();
+        z.clear();
+    }
+};
+
+/**
+ * A batch of consecutive entities of the most common types, filled by
+ * dxfRW when setBatchSize() is set and handed over whole to
+ * DRW_Interface::addBatch().
+ * Each type has its own array, so a consumer can scan all the lines or
+ * all the circles of a batch in one tight loop. order holds the type of
+ * every entity in file order: the n-th LINE in order is lines[n].
+ * The coordinates of points, lines, circles and arcs are also given as
+ * flat columns, entry n belonging to the n-th entity of the type, for
+ * loops over plain doubles (bounds...) that the compiler can vectorize.
+ *
+ * @see dxfRW::setBatchSize()
+ */
+class DRW_EntityBatch {
+public:
+    std::vector<DRW::ETYPE> order;
+    std::vector<DRW_Point> points;
+    std::vector<DRW_Line> lines;
+    std::vector<DRW_Circle> circles;
+    std::vector<DRW_Arc> arcs;
+    std::vector<DRW_Ellipse> ellipses;
+    std::vector<DRW_Text> texts;
+    std::vector<DRW_LWPolyline> lwpolylines;
+    std::vector<DRW_Insert> inserts;
+
+    DRW_CoordColumns pointCoords;     //!< points[n].basePoint
+    DRW_CoordColumns lineStarts;      //!< lines[n].basePoint
+    DRW_CoordColumns lineEnds;        //!< lines[n].secPoint
+    DRW_CoordColumns circleCenters;   //!< circles[n].basePoint
+    std::vector<double> circleRadii;  //!< circles[n].radious
+    DRW_CoordColumns arcCenters;      //!< arcs[n].basePoint
+    std::vector<double> arcRadii;     //!< arcs[n].radious
+
+    size_t size() const {return order.size();}
+    bool empty() const {return order.empty();}
+    //! empties the batch, keeping the capacity of the arrays
+    void clear() {
+        order.clear();
+        points.clear();
+        lines.clear();
+        circles.clear();
+        arcs.clear();
+        ellipses.clear();
+        texts.clear();
+        lwpolylines.clear();
+        inserts.clear();
+        pointCoords.clear();
+        lineStarts.clear();
+        lineEnds.clear();
+        circleCenters.clear();
+        circleRadii.clear();
+        arcCenters.clear();
+        arcRadii.clear();
+    }
+
+    //! adds the columns of e, the entity just appended to the array of T
+    template <class T>
+    void addColumns(const T &e) {
+        //by exact type: an arc is also a circle, an ellipse or a text a line
+        if constexpr (std::is_same_v<T, DRW_Point>) {
+            pointCoords.add(e.basePoint);
+        } else if constexpr (std::is_same_v<T, DRW_Line>) {
+            lineStarts.add(e.basePoint);
+            lineEnds.add(e.secPoint);
+        } else if constexpr (std::is_same_v<T, DRW_Circle>) {
+            circleCenters.add(e.basePoint);
+            circleRadii.push_back(e.radious);
+        } else if constexpr (std::is_same_v<T, DRW_Arc>) {
+            arcCenters.add(e.basePoint);
+            arcRadii.push_back(e.radious);
+        }
+    }
+
+    //! calls f with every entity in file order, f takes each entity type
+    template <class F>
+    void forEach(F &&f) const {visit(*this, f);}
+    template <class F>
+    void forEach(F &&f) {visit(*this, f);}
+
+private:
+    template <class B, class F>
+    static void visit(B &b, F &f) {
+        size_t next[8] = {};
+        for (DRW::ETYPE t : b.order) {
+            switch (t) {
+            case DRW::POINT: f(b.points[next[0]++]); break;
+            case DRW::LINE: f(b.lines[next[1]++]); break;
+            case DRW::CIRCLE: f(b.circles[next[2]++]); break;
+            case DRW::ARC: f(b.arcs[next[3]++]); break;
+            case DRW::ELLIPSE: f(b.ellipses[next[4]++]); break;
+            case DRW::TEXT: f(b.texts[next[5]++]); break;
+            case DRW::LWPOLYLINE: f(b.lwpolylines[next[6]++]); break;
+            case DRW::INSERT: f(b.inserts[next[7]++]); break;
+            default: break;
+            }
+        }
+    }
+};
+
 /**
  * Abstract class (interface) for communicate dxfReader with the application.
  * Inherit your class which takes care of the entities in the 
@@ -36,6 +160,15 @@ public:
     /** Called when header is parsed.  */
     virtual void addHeader(const DRW_Header* data) = 0;
 
+    /**
+     * Called instead of addHeader() by the readers, which hand over their
+     * header: moving it is cheaper than a copy. A second HEADER section
+     * (not valid DXF) comes with only its own variables.
+     */
+    virtual void takeHeader(DRW_Header&& data) {
+        addHeader(&data);
+    }
+
     /** Called for every line Type.  */
     virtual void addLType(const DRW_LType& data) = 0;
     /** Called for every layer. */
@@ -52,6 +185,12 @@ public:
     virtual void addTextStyle(const DRW_Textstyle& data) = 0;
     /** Called for every AppId entry. */
     virtual void addAppId(const DRW_AppId& data) = 0;
+    /**
+     * Called by the DXF reader once the TABLES section is read: the
+     * layers and line types it defines are all known.
+     */
+    virtual void endTables() {
+    }
 
     /**
      * Called for every block. Note: all entities added after this
@@ -73,6 +212,24 @@ public:
     /** Called to end the current block */
     virtual void endBlock() = 0;
 
+    /**
+     * Called by the DXF reader once the BLOCKS section is read: every
+     * block it defines has been added.
+     */
+    virtual void endBlocks() {
+    }
+
+    /**
+     * Called instead of addPoint(), addLine(), addCircle(), addArc(),
+     * addEllipse(), addText(), addLWPolyline() and addInsert() when the
+     * reader delivers those entities in batches (dxfRW::setBatchSize()).
+     * The batch is only valid during the call. The default passes each
+     * entity in file order to its per-entity callback.
+     */
+    virtual void addBatch(const DRW_EntityBatch& batch) {
+        batch.forEach([this](const auto &e) {addBatched(e);});
+    }
+
     /** Called for every point */
     virtual void addPoint(const DRW_Point& data) = 0;
 
@@ -209,6 +366,16 @@ public:
     virtual void writeDimstyles() = 0;
     virtual void writeObjects() = 0;
     virtual void writeAppId() = 0;
+
+private:
+    void addBatched(const DRW_Point &e) {addPoint(e);}
+    void addBatched(const DRW_Line &e) {addLine(e);}
+    void addBatched(const DRW_Circle &e) {addCircle(e);}
+    void addBatched(const DRW_Arc &e) {addArc(e);}
+    void addBatched(const DRW_Ellipse &e) {addEllipse(e);}
+    void addBatched(const DRW_Text &e) {addText(e);}
+    void addBatched(const DRW_LWPolyline &e) {addLWPolyline(e);}
+    void addBatched(const DRW_Insert &e) {addInsert(e);}
 };
 
 #endif
@@ -1005,7 +1005,7 @@ bool DRW_Layer::parseDwg(DRW::Version version, dwgBuffer* buf, duint32 bs) {
     if (version < DRW::AC1021) {
         //2004-
         DRW_DBG(", xrefindex = ");
-        DRW_DBG(buf->getBitShort());
+        DRW_DBGR(buf->getBitShort());
         DRW_DBG("\n");
         //dint16 xrefindex = buf->getBitShort();
     }
@@ -1556,20 +1556,20 @@ bool DRW_Vport::parseDwg(DRW::Version version, dwgBuffer* buf, duint32 bs) {
         //2000+
         //duint8 renderMode = buf->getRawChar8();
         DRW_DBG("\n renderMode: ");
-        DRW_DBG(buf->getRawChar8());
+        DRW_DBGR(buf->getRawChar8());
         if (version > DRW::AC1018) {
             //2007+
             DRW_DBG("\n use default lights: ");
-            DRW_DBG(buf->getBit());
+            DRW_DBGR(buf->getBit());
             DRW_DBG(" default lighting type: ");
-            DRW_DBG(buf->getRawChar8());
+            DRW_DBGR(buf->getRawChar8());
             DRW_DBG(" brightness: ");
-            DRW_DBG(buf->getBitDouble());
+            DRW_DBGR(buf->getBitDouble());
             DRW_DBG("\n contrast: ");
-            DRW_DBG(buf->getBitDouble());
+            DRW_DBGR(buf->getBitDouble());
             DRW_DBG("\n");
             DRW_DBG(" ambient color CMC: ");
-            DRW_DBG(buf->getCmColor(version));
+            DRW_DBGR(buf->getCmColor(version));
         }
     }
     lowerLeft = buf->get2RawDouble();
@@ -1618,26 +1618,26 @@ bool DRW_Vport::parseDwg(DRW::Version version, dwgBuffer* buf, duint32 bs) {
     if (version > DRW::AC1014) {
         //2000+
         DRW_DBG("\n Unknown: ");
-        DRW_DBG(buf->getBit());
+        DRW_DBGR(buf->getBit());
         DRW_DBG(" UCS per Viewport: ");
-        DRW_DBG(buf->getBit());
+        DRW_DBGR(buf->getBit());
         DRW_DBG("\nUCS origin: ");
-        DRW_DBGPT(buf->getBitDouble(), buf->getBitDouble(), buf->getBitDouble());
+        DRW_DBGPTR(buf->getBitDouble(), buf->getBitDouble(), buf->getBitDouble());
         DRW_DBG("\nUCS X Axis: ");
-        DRW_DBGPT(buf->getBitDouble(), buf->getBitDouble(), buf->getBitDouble());
+        DRW_DBGPTR(buf->getBitDouble(), buf->getBitDouble(), buf->getBitDouble());
         DRW_DBG("\nUCS Y Axis: ");
-        DRW_DBGPT(buf->getBitDouble(), buf->getBitDouble(), buf->getBitDouble());
+        DRW_DBGPTR(buf->getBitDouble(), buf->getBitDouble(), buf->getBitDouble());
         DRW_DBG("\nUCS elevation: ");
-        DRW_DBG(buf->getBitDouble());
+        DRW_DBGR(buf->getBitDouble());
         DRW_DBG(" UCS Orthographic type: ");
-        DRW_DBG(buf->getBitShort());
+        DRW_DBGR(buf->getBitShort());
         if (version > DRW::AC1018) {
             //2007+
             gridBehavior = buf->getBitShort();
             DRW_DBG(" gridBehavior (flags): ");
             DRW_DBG(gridBehavior);
             DRW_DBG(" Grid major: ");
-            DRW_DBG(buf->getBitShort());
+            DRW_DBGR(buf->getBitShort());
         }
     }
 
@@ -81,14 +81,23 @@ public:
         xDictFlag {e.xDictFlag},
         numReactors {e.numReactors},
         curr {nullptr}    {
-        for (std::vector<DRW_Variant *>::const_iterator it = e.extData.begin(); it != e.extData.end(); ++it) {
-            DRW_Variant *src = *it;
-            DRW_Variant *dst = new DRW_Variant( *src);
-            extData.push_back( dst);
-            if (src == e.curr) {
-                curr = dst;
-            }
+        copyExtData(e);
+    }
+
+    //! deep copies extData like the copy constructor, the entry owns its variants
+    DRW_TableEntry &operator=(const DRW_TableEntry& e) {
+        if (this != &e) {
+            reset();
+            tType = e.tType;
+            handle = e.handle;
+            parentHandle = e.parentHandle;
+            name = e.name;
+            flags = e.flags;
+            xDictFlag = e.xDictFlag;
+            numReactors = e.numReactors;
+            copyExtData(e);
         }
+        return *this;
     }
     virtual DRW_TableEntry* newInstance() {return nullptr;}
 
@@ -124,6 +133,17 @@ protected:
     duint32 objSize {0};    //RL 32bits object data size in bits
 
 private:
+    void copyExtData(const DRW_TableEntry& e) {
+        for (std::vector<DRW_Variant *>::const_iterator it = e.extData.begin(); it != e.extData.end(); ++it) {
+            DRW_Variant *src = *it;
+            DRW_Variant *dst = new DRW_Variant( *src);
+            extData.push_back( dst);
+            if (src == e.curr) {
+                curr = dst;
+            }
+        }
+    }
+
     DRW_Variant* curr {nullptr};
 };
 
@@ -15,6 +15,7 @@
 #include "drw_dbg.h"
 
 DRW_dbg *DRW_dbg::instance{nullptr};
+std::atomic<bool> DRW_dbg::active{false};
 
 /*********private clases*************/
 
@@ -54,7 +55,12 @@ void DRW_dbg::setCustomDebugPrinter(std::unique_ptr<DRW::DebugPrinter> printer)
 }
 
 void DRW_dbg::setLevel(Level lvl){
+#ifndef DRW_NO_DBG
     level = lvl;
+    active.store(level == Level::Debug, std::memory_order_relaxed);
+#else
+    DRW_UNUSED(lvl);
+#endif
     switch (level){
     case Level::Debug:
         currentPrinter = debugPrinter.get();
@@ -13,19 +13,30 @@
 #ifndef DRW_DBG_H
 #define DRW_DBG_H
 
+#include <atomic>
 #include <string>
 #include <iostream>
 #include <memory>
 #include "../drw_base.h"
 //#include <iomanip>
 
+/*
+ * Debug output. The arguments are only evaluated when the level is Debug,
+ * so a disabled call costs one load and a predictable branch. Building with
+ * DRW_NO_DBG removes the calls altogether.
+ * Values read from a file must be consumed whether printed or not; the
+ * R variants always evaluate their arguments.
+ */
 #define DRW_DBGSL(a) DRW_dbg::getInstance()->setLevel(a)
-#define DRW_DBGGL DRW_dbg::getInstance()->getLevel()
-#define DRW_DBG(a) DRW_dbg::getInstance()->print(a)
-#define DRW_DBGH(a) DRW_dbg::getInstance()->printH(a)
-#define DRW_DBGB(a) DRW_dbg::getInstance()->printB(a)
-#define DRW_DBGHL(a, b, c) DRW_dbg::getInstance()->printHL(a, b ,c)
-#define DRW_DBGPT(a, b, c) DRW_dbg::getInstance()->printPT(a, b, c)
+#define DRW_DBGGL (DRW_dbg::enabled() ? DRW_dbg::getInstance()->getLevel() : DRW_dbg::Level::None)
+#define DRW_DBG(a) do { if (DRW_dbg::enabled()) DRW_dbg::getInstance()->print(a); } while (false)
+#define DRW_DBGH(a) do { if (DRW_dbg::enabled()) DRW_dbg::getInstance()->printH(a); } while (false)
+#define DRW_DBGB(a) do { if (DRW_dbg::enabled()) DRW_dbg::getInstance()->printB(a); } while (false)
+#define DRW_DBGHL(a, b, c) do { if (DRW_dbg::enabled()) DRW_dbg::getInstance()->printHL(a, b ,c); } while (false)
+#define DRW_DBGPT(a, b, c) do { if (DRW_dbg::enabled()) DRW_dbg::getInstance()->printPT(a, b, c); } while (false)
+#define DRW_DBGR(a) DRW_dbg::printRead(a)
+#define DRW_DBGHR(a) DRW_dbg::printReadH(a)
+#define DRW_DBGPTR(a, b, c) DRW_dbg::printReadPT(a, b, c)
 
 class DRW_dbg {
 public:
@@ -41,6 +52,16 @@ public:
     void setCustomDebugPrinter(std::unique_ptr<DRW::DebugPrinter> printer);
     Level getLevel();
     static DRW_dbg *getInstance();
+#ifdef DRW_NO_DBG
+    static constexpr bool enabled() {return false;}
+#else
+    /** true if the level is Debug */
+    static bool enabled() {return active.load(std::memory_order_relaxed);}
+#endif
+    template <class T>
+    static void printRead(T v) {if (enabled()) getInstance()->print(v);}
+    static void printReadH(long long int i) {if (enabled()) getInstance()->printH(i);}
+    static void printReadPT(double x, double y, double z) {if (enabled()) getInstance()->printPT(x, y, z);}
     void print(const std::string &s);
     void print(signed char i);
     void print(unsigned char i);
@@ -58,6 +79,7 @@ public:
 private:
     DRW_dbg();
     static DRW_dbg *instance;
+    static std::atomic<bool> active;
     Level level{Level::None};
     DRW::DebugPrinter silentDebug;
     std::unique_ptr< DRW::DebugPrinter > debugPrinter;
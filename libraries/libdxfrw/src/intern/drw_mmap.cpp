@@ -0,0 +1,103 @@
+/******************************************************************************
+**  libDXFrw - Library to read/write DXF files (ascii & binary)              **
+**                                                                           **
+**  This library is free software, licensed under the terms of the GNU       **
+**  General Public License as published by the Free Software Foundation,     **
+**  either version 2 of the License, or (at your option) any later version.  **
+**  You should have received a copy of the GNU General Public License        **
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.    **
+******************************************************************************/
+
+#include "drw_mmap.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+bool DRW_MappedFile::open(const std::string &fileName) {
+    close();
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return false;
+    }
+    mFile = file;
+    mSize = static_cast<size_t>(size.QuadPart);
+    if (mSize == 0) //empty files can not be mapped
+        return true;
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        close();
+        return false;
+    }
+    mMapping = mapping;
+    mData = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (mData == nullptr) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void DRW_MappedFile::close() {
+    if (mData)
+        UnmapViewOfFile(mData);
+    if (mMapping)
+        CloseHandle(static_cast<HANDLE>(mMapping));
+    if (mFile)
+        CloseHandle(static_cast<HANDLE>(mFile));
+    mData = nullptr;
+    mMapping = nullptr;
+    mFile = nullptr;
+    mSize = 0;
+}
+
+#else
+
+bool DRW_MappedFile::open(const std::string &fileName) {
+    close();
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+    mSize = static_cast<size_t>(st.st_size);
+    if (mSize == 0) { //empty files can not be mapped
+        ::close(fd);
+        return true;
+    }
+    void *addr = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); //the mapping keeps its own reference
+    if (addr == MAP_FAILED) {
+        mSize = 0;
+        return false;
+    }
+#ifdef MADV_SEQUENTIAL
+    madvise(addr, mSize, MADV_SEQUENTIAL);
+#endif
+    mData = static_cast<const char*>(addr);
+    return true;
+}
+
+void DRW_MappedFile::close() {
+    if (mData)
+        munmap(const_cast<char*>(mData), mSize);
+    mData = nullptr;
+    mSize = 0;
+}
+
+#endif
@@ -0,0 +1,43 @@
+/******************************************************************************
+**  libDXFrw - Library to read/write DXF files (ascii & binary)              **
+**                                                                           **
+**  This library is free software, licensed under the terms of the GNU       **
+**  General Public License as published by the Free Software Foundation,     **
+**  either version 2 of the License, or (at your option) any later version.  **
+**  You should have received a copy of the GNU General Public License        **
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.    **
+******************************************************************************/
+
+#ifndef DRW_MMAP_H
+#define DRW_MMAP_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * Read-only memory mapping of a whole file.
+ * The mapping is released when the object is destroyed or closed.
+ */
+class DRW_MappedFile {
+public:
+    DRW_MappedFile() = default;
+    ~DRW_MappedFile() { close(); }
+    DRW_MappedFile(const DRW_MappedFile&) = delete;
+    DRW_MappedFile& operator=(const DRW_MappedFile&) = delete;
+
+    bool open(const std::string &fileName);
+    void close();
+
+    const char *data() const {return mData;}
+    size_t size() const {return mSize;}
+
+private:
+    const char *mData {nullptr};
+    size_t mSize {0};
+#ifdef _WIN32
+    void *mFile {nullptr};
+    void *mMapping {nullptr};
+#endif
+};
+
+#endif // DRW_MMAP_H
@@ -47,5 +47,11 @@ namespace DRW
 
         return true;
     }
+
+    template <typename T>
+    bool reserve(DRW_PackedList<T> &list, const int size)
+    {
+        return reserve(list.values(), size);
+    }
 }
 #endif // DRW_RESERVE_H
@@ -2,7 +2,11 @@
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <functional>
+#include <map>
+#include <mutex>
 #include "../drw_base.h"
 #include "drw_cptables.h"
 #include "drw_cptable932.h"
@@ -10,6 +14,182 @@
 #include "drw_cptable949.h"
 #include "drw_cptable950.h"
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+/**
+ * Map from a code point of the basic multilingual plane to its encoding in
+ * a codepage, used by fromUtf8(). It is a two-level table: pages of 256
+ * entries are only allocated where the codepage has characters, so a lookup
+ * is two indexed loads instead of a scan of the codepage table.
+ */
+class DRW_ReverseTable {
+public:
+    /** the first encoding added for a code point is kept, as the table scan did */
+    void add(int code, int encoded) {
+        if (code < 0 || code > 0xFFFF)
+            return;
+        std::unique_ptr<duint16[]> &page = pages[code >> 8];
+        if (!page)
+            page.reset(new duint16[256]());
+        if (page[code & 0xFF] == 0)
+            page[code & 0xFF] = static_cast<duint16>(encoded);
+    }
+    /** encoding of code, 0 if the codepage has no such character */
+    int find(int code) const {
+        if (code < 0 || code > 0xFFFF)
+            return 0;
+        const std::unique_ptr<duint16[]> &page = pages[code >> 8];
+        return page ? page[code & 0xFF] : 0;
+    }
+
+private:
+    std::unique_ptr<duint16[]> pages[256];
+};
+
+/**
+ * Map from a double byte character (lead byte << 8 | trail byte) straight
+ * to its code point, used by toUtf8() of the DBCS converters.
+ */
+class DRW_DecodeTable {
+public:
+    DRW_DecodeTable() : codes(new duint16[0x10000]()) {}
+    /** the first code point added for a character is kept, as the table scan did */
+    void add(int dbcs, int code) {
+        if (dbcs >= 0 && dbcs <= 0xFFFF && codes[dbcs] == 0)
+            codes[dbcs] = static_cast<duint16>(code);
+    }
+    /** code point of the character, 0 if the codepage has none */
+    int find(int dbcs) const {return codes[dbcs & 0xFFFF];}
+
+private:
+    std::unique_ptr<duint16[]> codes;
+};
+
+namespace {
+/** table of the codepage identified by key, built once and shared by all converters */
+template <class Table>
+const Table *sharedTable(const void *key, const std::function<void(Table&)> &build) {
+    static std::mutex mutex;
+    static std::map<const void*, std::unique_ptr<Table>> tables;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unique_ptr<Table> &table = tables[key];
+    if (!table) {
+        table.reset(new Table());
+        build(*table);
+    }
+    return table.get();
+}
+
+/** adds the entries of a lead byte range that the converters searched */
+void addLeadRange(DRW_DecodeTable &d, const int dt[][2], int lead, int sta, int end) {
+    for (int k = sta; k < end; k++) {
+        if ((dt[k][0] >> 8) == lead)
+            d.add(dt[k][0], dt[k][1]);
+    }
+}
+
+/** writes c as UTF-8, c is at most 0xFFFF */
+inline char *putUtf8(char *out, int c) {
+    if (c < 0x80) {
+        *out++ = static_cast<char>(c);
+    } else if (c < 0x800) {
+        *out++ = static_cast<char>(0xC0 | (c >> 6));
+        *out++ = static_cast<char>(0x80 | (c & 0x3F));
+    } else {
+        *out++ = static_cast<char>(0xE0 | (c >> 12));
+        *out++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (c & 0x3F));
+    }
+    return out;
+}
+
+/** true if no byte of the n at p has the high bit set */
+bool isAscii(const char *p, size_t n) {
+    size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        if (_mm_movemask_epi8(v) != 0)
+            return false;
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    for (; i + 16 <= n; i += 16) {
+        if (vmaxvq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(p + i))) >= 0x80)
+            return false;
+    }
+#endif
+    for (; i + 8 <= n; i += 8) {
+        duint64 w;
+        memcpy(&w, p + i, 8);
+        if (w & 0x8080808080808080ULL)
+            return false;
+    }
+    for (; i < n; i++) {
+        if (static_cast<unsigned char>(p[i]) >= 0x80)
+            return false;
+    }
+    return true;
+}
+
+/** true if s has a \U+XXXX escape that toUtf8() replaces */
+bool hasUnicodeEscape(const std::string &s) {
+    const char *p = s.data();
+    const char *end = p + s.size();
+    while (end - p > 6) {
+        p = static_cast<const char*>(memchr(p, '\\', end - p - 6));
+        if (p == nullptr)
+            return false;
+        if (p[1] == 'U' && p[2] == '+')
+            return true;
+        ++p;
+    }
+    return false;
+}
+
+//paths a string can go through, counted for stats()
+enum CodecPath {toUtf8Ascii, toUtf8Converted, fromUtf8Ascii, fromUtf8Converted, codecPaths};
+
+//counts of all threads, relaxed as they are only statistics
+std::atomic<unsigned long long> totals[codecPaths] {};
+
+/*
+ * Counts of one thread, so parser threads converting strings at the same
+ * time do not share a cache line. They are added to the totals when the
+ * thread ends, e.g. a worker once its part of a read is done, or when it
+ * asks for stats().
+ */
+struct ThreadCounts {
+    unsigned long long counts[codecPaths] {};
+
+    ~ThreadCounts() {
+        fold();
+    }
+    void fold() {
+        for (int i = 0; i < codecPaths; ++i) {
+            if (counts[i] != 0)
+                totals[i].fetch_add(counts[i], std::memory_order_relaxed);
+            counts[i] = 0;
+        }
+    }
+};
+
+thread_local ThreadCounts threadCounts;
+
+inline void count(CodecPath path) {
+    ++threadCounts.counts[path];
+}
+
+/** appends the bytes of str */
+inline char *putString(char *out, const std::string &str) {
+    memcpy(out, str.data(), str.size());
+    return out + str.size();
+}
+} // namespace
+
 DRW_TextCodec::DRW_TextCodec()
     : version{DRW::AC1021}
     , conv( new DRW_Converter(nullptr, 0) )
@@ -87,6 +267,7 @@ void DRW_TextCodec::setVersion(const std::string &v, bool dxfFormat){
 void DRW_TextCodec::setCodePage(const std::string &c, bool dxfFormat){
     cp = correctCodePage(c);
     conv.reset();
+    asciiPass = true;
     if (version == DRW::AC1009 || version == DRW::AC1015) {
         if (cp == "ANSI_874")
             conv.reset( new DRW_ConvTable(DRW_Table874, CPLENGTHCOMMON) );
@@ -125,19 +306,73 @@ void DRW_TextCodec::setCodePage(const std::string &c, bool dxfFormat){
     } else {
         if (dxfFormat)
             conv.reset( new DRW_Converter(nullptr, 0) );//utf16 to utf8
-        else
+        else {
             conv.reset( new DRW_ConvUTF16() );//utf16 to utf8
+            asciiPass = false;
+        }
     }
 }
 
+/** ASCII is the same in every codepage, only the \U+ escapes need decoding */
+bool DRW_TextCodec::plainToUtf8(const std::string &s) const {
+    return asciiPass && isAscii(s.data(), s.size()) && !hasUnicodeEscape(s);
+}
+
+bool DRW_TextCodec::plainFromUtf8(const std::string &s) const {
+    return asciiPass && isAscii(s.data(), s.size());
+}
+
 std::string DRW_TextCodec::toUtf8(const std::string &s) {
+    if (plainToUtf8(s)) {
+        count(toUtf8Ascii);
+        return s;
+    }
+    count(toUtf8Converted);
+    return conv->toUtf8(s);
+}
+
+std::string DRW_TextCodec::toUtf8(std::string &&s) {
+    if (plainToUtf8(s)) {
+        count(toUtf8Ascii);
+        return std::move(s);
+    }
+    count(toUtf8Converted);
     return conv->toUtf8(s);
 }
 
 std::string DRW_TextCodec::fromUtf8(const std::string &s) {
+    if (plainFromUtf8(s)) {
+        count(fromUtf8Ascii);
+        return s;
+    }
+    count(fromUtf8Converted);
+    return conv->fromUtf8(s);
+}
+
+std::string DRW_TextCodec::fromUtf8(std::string &&s) {
+    if (plainFromUtf8(s)) {
+        count(fromUtf8Ascii);
+        return std::move(s);
+    }
+    count(fromUtf8Converted);
     return conv->fromUtf8(s);
 }
 
+DRW_TextCodec::Stats DRW_TextCodec::stats() {
+    threadCounts.fold();
+    return Stats{totals[toUtf8Ascii].load(std::memory_order_relaxed),
+                 totals[toUtf8Converted].load(std::memory_order_relaxed),
+                 totals[fromUtf8Ascii].load(std::memory_order_relaxed),
+                 totals[fromUtf8Converted].load(std::memory_order_relaxed)};
+}
+
+void DRW_TextCodec::resetStats() {
+    for (int i = 0; i < codecPaths; ++i) {
+        threadCounts.counts[i] = 0;
+        totals[i].store(0, std::memory_order_relaxed);
+    }
+}
+
 std::string DRW_Converter::toUtf8(const std::string &s) {
     std::string result;
     int j = 0;
@@ -164,9 +399,16 @@ std::string DRW_Converter::toUtf8(const std::string &s) {
     return result;
 }
 
+DRW_ConvTable::DRW_ConvTable(const int *t, int l)
+    :DRW_Converter(t, l) {
+    reverse = sharedTable<DRW_ReverseTable>(t, [t, l](DRW_ReverseTable &r) {
+        for (int k = 0; k < l; k++)
+            r.add(t[k], CPOFFSET + k);
+    });
+}
+
 std::string DRW_ConvTable::fromUtf8(const std::string &s) {
     std::string result;
-    bool notFound;
     int code;
 
     int j = 0;
@@ -179,15 +421,10 @@ std::string DRW_ConvTable::fromUtf8(const std::string &s) {
             code = decodeNum(part1, &l);
             j = i+l;
             i = j - 1;
-            notFound = true;
-            for (int k=0; k<cpLength; k++){
-                if(table[k] == code) {
-                    result += CPOFFSET + k; //translate from table
-                    notFound = false;
-                    break;
-                }
-            }
-            if (notFound)
+            int data = reverse->find(code);
+            if (data != 0)
+                result += static_cast<char>(data); //translate from table
+            else
                 result += decodeText(code);
         }
     }
@@ -272,36 +509,61 @@ std::string DRW_Converter::encodeNum(int c){
     return std::string(reinterpret_cast<char*>(ret));
 }
 
-/** 's' is a string with at least 4 bytes length
+/** 's' holds up to 4 bytes starting at a non-ASCII char
 ** returned 'b' is byte length of encoded char: 2,3 or 4
+** a stray or truncated sequence gives U+FFFD, 'b' covers the bytes present
 **/
 int DRW_Converter::decodeNum(const std::string &s, int *b){
     int code= 0;
     unsigned char c = s.at(0);
-    if ( (c& 0xE0)  == 0xC0) { //2 bytes
+    int len = 1;
+    if ( (c& 0xE0)  == 0xC0) //2 bytes
+        len = 2;
+    else if ( (c& 0xF0)  == 0xE0) //3 bytes
+        len = 3;
+    else if ( (c& 0xF8)  == 0xF0) //4 bytes
+        len = 4;
+    if (len == 1 || static_cast<size_t>(len) > s.length()) {
+        *b = static_cast<int>(std::min(static_cast<size_t>(len), s.length()));
+        return 0xFFFD;
+    }
+
+    if (len == 2) {
         code = ( c&0x1F)<<6;
         code = (s.at(1) &0x3F) | code;
-        *b = 2;
-    } else if ( (c& 0xF0)  == 0xE0) { //3 bytes
+    } else if (len == 3) {
         code = ( c&0x0F)<<12;
         code = ((s.at(1) &0x3F)<<6) | code;
         code = (s.at(2) &0x3F) | code;
-        *b = 3;
-    } else if ( (c& 0xF8)  == 0xF0) { //4 bytes
+    } else {
         code = ( c&0x07)<<18;
         code = ((s.at(1) &0x3F)<<12) | code;
         code = ((s.at(2) &0x3F)<<6) | code;
         code = (s.at(3) &0x3F) | code;
-        *b = 4;
     }
+    *b = len;
 
     return code;
 }
 
 
+DRW_ConvDBCSTable::DRW_ConvDBCSTable(const int *t,  const int *lt, const int dt[][2], int l)
+    :DRW_Converter(t, l)
+    ,leadTable{lt}
+    ,doubleTable{dt} {
+    reverse = sharedTable<DRW_ReverseTable>(dt, [dt, l](DRW_ReverseTable &r) {
+        for (int k = 0; k < l; k++)
+            r.add(dt[k][1], dt[k][0]);
+    });
+    decode = sharedTable<DRW_DecodeTable>(dt, [dt, lt](DRW_DecodeTable &d) {
+        //lead bytes 0x81 to 0xFE, the lead table ends with the 0xFF entry
+        for (int lead = 0x81; lead < 0xFF; lead++)
+            addLeadRange(d, dt, lead, lt[lead - 0x81], lt[lead - 0x80]);
+    });
+}
+
 std::string DRW_ConvDBCSTable::fromUtf8(const std::string &s) {
     std::string result;
-    bool notFound;
     int code;
 
     int j = 0;
@@ -314,20 +576,14 @@ std::string DRW_ConvDBCSTable::fromUtf8(const std::string &s) {
             code = decodeNum(part1, &l);
             j = i+l;
             i = j - 1;
-            notFound = true;
-                for (int k=0; k<cpLength; k++){
-                    if(doubleTable[k][1] == code) {
-                        int data = doubleTable[k][0];
-                        char d[3];
-                        d[0] = data >> 8;
-                        d[1] = data & 0xFF;
-                        d[2]= '\0';
-                        result += d; //translate from table
-                        notFound = false;
-                        break;
-                    }
-                }
-            if (notFound)
+            int data = reverse->find(code);
+            if (data != 0) {
+                char d[3];
+                d[0] = data >> 8;
+                d[1] = data & 0xFF;
+                d[2]= '\0';
+                result += d; //translate from table
+            } else
                 result += decodeText(code);
         } //direct conversion
     }
@@ -337,47 +593,46 @@ std::string DRW_ConvDBCSTable::fromUtf8(const std::string &s) {
 }
 
 std::string DRW_ConvDBCSTable::toUtf8(const std::string &s) {
-    std::string res;
-    for (auto it=s.begin() ; it < s.end(); ++it ) {
-        bool notFound = true;
-        unsigned char c = *it;
+    //a byte never gives more than 3 bytes of UTF-8
+    std::string res(s.size() * 3, '\0');
+    char *out = &res[0];
+    const size_t n = s.size();
+    for (size_t i = 0; i < n; i++) {
+        unsigned char c = s[i];
         if (c < 0x80) {
-            notFound = false;
             //check for \U+ encoded text
-            if (c == '\\') {
-                if (s.end()-it > 6 && *(it+1) == 'U' && *(it+2) == '+')  {
-                    res += encodeText(std::string(it, it+7));
-                    it +=6;
-                } else {
-                    res +=c; //no \U+ encoded text write
-                }
+            if (c == '\\' && n - i > 6 && s[i+1] == 'U' && s[i+2] == '+') {
+                out = putString(out, encodeText(s.substr(i, 7)));
+                i += 6;
             } else
-                res +=c; //c!='\' ascii char write
-        } else if(c == 0x80 ){//1 byte table
-            notFound = false;
-            res += encodeNum(0x20AC);//euro sign
+                *out++ = c; //ascii char write
+        } else if (c == 0x80) {//1 byte table
+            out = putUtf8(out, 0x20AC);//euro sign
         } else {//2 bytes
-            ++it;
-            int code = (c << 8) | static_cast<unsigned char >(*it);
-            int sta = leadTable[c-0x81];
-            int end = leadTable[c-0x80];
-            for (int k=sta; k<end; k++){
-                if(doubleTable[k][0] == code) {
-                    res += encodeNum(doubleTable[k][1]); //translate from table
-                    notFound = false;
-                    break;
-                }
-            }
+            ++i;
+            int trail = i < n ? static_cast<unsigned char>(s[i]) : 0;
+            int code = decode->find((c << 8) | trail);
+            out = putUtf8(out, code != 0 ? code : NOTFOUND936);
         }
-        //not found
-        if (notFound) res += encodeNum(NOTFOUND936);
-    } //end for
+    }
+    res.resize(out - res.data());
 
     return res;
 }
 
 DRW_Conv932Table::DRW_Conv932Table()
     :DRW_Converter(DRW_Table932, CPLENGTH932) {
+    reverse = sharedTable<DRW_ReverseTable>(DRW_DoubleTable932, [](DRW_ReverseTable &r) {
+        for (int k = 0; k < CPLENGTH932; k++)
+            r.add(DRW_DoubleTable932[k][1], DRW_DoubleTable932[k][0]);
+    });
+    decode = sharedTable<DRW_DecodeTable>(DRW_DoubleTable932, [](DRW_DecodeTable &d) {
+        //lead bytes 0x81 to 0x9F and 0xE0 to 0xFC
+        for (int lead = 0x81; lead < 0xA0; lead++)
+            addLeadRange(d, DRW_DoubleTable932, lead, DRW_LeadTable932[lead - 0x81], DRW_LeadTable932[lead - 0x80]);
+        for (int lead = 0xE0; lead < 0xFD; lead++)
+            addLeadRange(d, DRW_DoubleTable932, lead, DRW_LeadTable932[lead - 0xC1], DRW_LeadTable932[lead - 0xC0]);
+    });
 }
 
 std::string DRW_Conv932Table::fromUtf8(const std::string &s) {
@@ -403,17 +658,14 @@ std::string DRW_Conv932Table::fromUtf8(const std::string &s) {
             }
             if (notFound && ( code<0xF8 || (code>0x390 && code<0x542) ||
                     (code>0x200F && code<0x9FA1) || code>0xF928 )) {
-                for (int k=0; k<cpLength; k++){
-                    if(DRW_DoubleTable932[k][1] == code) {
-                        int data = DRW_DoubleTable932[k][0];
-                        char d[3];
-                        d[0] = data >> 8;
-                        d[1] = data & 0xFF;
-                        d[2]= '\0';
-                        result += d; //translate from table
-                        notFound = false;
-                        break;
-                    }
+                int data = reverse->find(code);
+                if (data != 0) {
+                    char d[3];
+                    d[0] = data >> 8;
+                    d[1] = data & 0xFF;
+                    d[2]= '\0';
+                    result += d; //translate from table
+                    notFound = false;
                 }
             }
             if (notFound)
@@ -426,50 +678,29 @@ std::string DRW_Conv932Table::fromUtf8(const std::string &s) {
 }
 
 std::string DRW_Conv932Table::toUtf8(const std::string &s) {
-    std::string res;
-    for (auto it=s.begin() ; it < s.end(); ++it ) {
-        bool notFound = true;
-        unsigned char c = *it;
+    //a byte never gives more than 3 bytes of UTF-8
+    std::string res(s.size() * 3, '\0');
+    char *out = &res[0];
+    const size_t n = s.size();
+    for (size_t i = 0; i < n; i++) {
+        unsigned char c = s[i];
         if (c < 0x80) {
-            notFound = false;
             //check for \U+ encoded text
-            if (c == '\\') {
-                if (s.end()-it > 6 && *(it+1) == 'U' && *(it+2) == '+')  {
-                    res += encodeText(std::string(it, it+7));
-                    it +=6;
-                } else {
-                    res +=c; //no \U+ encoded text write
-                }
+            if (c == '\\' && n - i > 6 && s[i+1] == 'U' && s[i+2] == '+') {
+                out = putString(out, encodeText(s.substr(i, 7)));
+                i += 6;
             } else
-                res +=c; //c!='\' ascii char write
+                *out++ = c; //ascii char write
         } else if(c > 0xA0 && c < 0xE0 ){//1 byte table
-            notFound = false;
-            res += encodeNum(c + CPOFFSET932); //translate from table
+            out = putUtf8(out, c + CPOFFSET932); //translate from table
         } else {//2 bytes
-            ++it;
-            int code = (c << 8) | static_cast<unsigned char>(*it);
-            int sta=0;
-            int end=0;
-            if (c > 0x80 && c < 0xA0) {
-                sta = DRW_LeadTable932[c-0x81];
-                end = DRW_LeadTable932[c-0x80];
-            } else if (c > 0xDF && c < 0xFD){
-                sta = DRW_LeadTable932[c-0xC1];
-                end = DRW_LeadTable932[c-0xC0];
-            }
-            if (end > 0) {
-                for (int k=sta; k<end; k++){
-                    if(DRW_DoubleTable932[k][0] == code) {
-                        res += encodeNum(DRW_DoubleTable932[k][1]); //translate from table
-                        notFound = false;
-                        break;
-                    }
-                }
-            }
+            ++i;
+            int trail = i < n ? static_cast<unsigned char>(s[i]) : 0;
+            int code = decode->find((c << 8) | trail);
+            out = putUtf8(out, code != 0 ? code : NOTFOUND932);
         }
-        //not found
-        if (notFound) res += encodeNum(NOTFOUND932);
-    } //end for
+    }
+    res.resize(out - res.data());
 
     return res;
 }
@@ -6,27 +6,53 @@
 #include "../drw_base.h"
 
 class DRW_Converter;
+class DRW_ReverseTable;
+class DRW_DecodeTable;
 
 class DRW_TextCodec
 {
 public:
     DRW_TextCodec();
     ~DRW_TextCodec();
+    DRW_TextCodec(const DRW_TextCodec&) = default;
+    DRW_TextCodec& operator=(const DRW_TextCodec&) = default;
     std::string fromUtf8(const std::string& s);
     std::string toUtf8(const std::string &s);
+    /** as above, plain ASCII text is moved through without a copy */
+    std::string fromUtf8(std::string &&s);
+    std::string toUtf8(std::string &&s);
     int getVersion(){return version;}
     void setVersion(const std::string &v, bool dxfFormat);
     void setVersion(DRW::Version v, bool dxfFormat);
     void setCodePage(const std::string &c, bool dxfFormat);
     std::string getCodePage(){return cp;}
 
+    /**
+     * Number of strings converted since the last resetStats(), by all codecs.
+     * Plain ASCII strings skip the converter, the others take the slow path.
+     * Each thread counts on its own: the strings of a thread show up once
+     * it has ended (the parallel parser's workers when a read is done) or
+     * when it calls stats() itself.
+     */
+    struct Stats {
+        unsigned long long toUtf8Ascii;
+        unsigned long long toUtf8Converted;
+        unsigned long long fromUtf8Ascii;
+        unsigned long long fromUtf8Converted;
+    };
+    static Stats stats();
+    static void resetStats();
+
 private:
     std::string correctCodePage(const std::string& s);
+    bool plainToUtf8(const std::string &s) const;
+    bool plainFromUtf8(const std::string &s) const;
 
 private:
     DRW::Version version{DRW::UNKNOWNV};
     std::string cp;
-    std::unique_ptr< DRW_Converter> conv;
+    std::shared_ptr< DRW_Converter> conv; //converters are stateless, copies share them
+    bool asciiPass{true}; //ASCII is unchanged by the converter, false for UTF-16
 };
 
 class DRW_Converter
@@ -56,24 +82,24 @@ public:
 
 class DRW_ConvTable : public DRW_Converter {
 public:
-    DRW_ConvTable(const int *t, int l):DRW_Converter(t, l) {}
+    DRW_ConvTable(const int *t, int l);
     std::string fromUtf8(const std::string &s) override;
     std::string toUtf8(const std::string &s) override;
+private:
+    const DRW_ReverseTable *reverse{nullptr};
 };
 
 class DRW_ConvDBCSTable : public DRW_Converter {
 public:
-    DRW_ConvDBCSTable(const int *t,  const int *lt, const int dt[][2], int l)
-        :DRW_Converter(t, l)
-        ,leadTable{lt}
-        ,doubleTable{dt}
-    {}
+    DRW_ConvDBCSTable(const int *t,  const int *lt, const int dt[][2], int l);
 
     std::string fromUtf8(const std::string &s) override;
     std::string toUtf8(const std::string &s) override;
 private:
     const int *leadTable{nullptr};
     const int (*doubleTable)[2];
+    const DRW_ReverseTable *reverse{nullptr};
+    const DRW_DecodeTable *decode{nullptr};
 
 };
 
@@ -82,6 +108,9 @@ public:
     DRW_Conv932Table();
     std::string fromUtf8(const std::string &s) override;
     std::string toUtf8(const std::string &s) override;
+private:
+    const DRW_ReverseTable *reverse{nullptr};
+    const DRW_DecodeTable *decode{nullptr};
 
 };
 
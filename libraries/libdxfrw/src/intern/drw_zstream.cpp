@@ -0,0 +1,339 @@
+/******************************************************************************
+**  libDXFrw - Library to read/write DXF files (ascii & binary)              **
+**                                                                           **
+**  This library is free software, licensed under the terms of the GNU       **
+**  General Public License as published by the Free Software Foundation,     **
+**  either version 2 of the License, or (at your option) any later version.  **
+**  You should have received a copy of the GNU General Public License        **
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.    **
+******************************************************************************/
+
+#include "drw_zstream.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+#ifdef DRW_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef DRW_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace {
+const size_t chunkSize = 1 << 16;
+
+bool endsWith(const std::string &s, const char *suffix) {
+    size_t n = strlen(suffix);
+    if (s.size() < n)
+        return false;
+    for (size_t i = 0; i < n; ++i) {
+        if (std::tolower(static_cast<unsigned char>(s[s.size() - n + i])) != suffix[i])
+            return false;
+    }
+    return true;
+}
+} // namespace
+
+DRW_Compression DRW_sniffCompression(const char *data, size_t size) {
+    const unsigned char *p = reinterpret_cast<const unsigned char*>(data);
+    if (size >= 2 && p[0] == 0x1f && p[1] == 0x8b)
+        return DRW_Compression::Gzip;
+    if (size >= 4 && p[0] == 0x28 && p[1] == 0xb5 && p[2] == 0x2f && p[3] == 0xfd)
+        return DRW_Compression::Zstd;
+    return DRW_Compression::None;
+}
+
+DRW_Compression DRW_compressionFromName(const std::string &fileName) {
+    if (endsWith(fileName, ".gz"))
+        return DRW_Compression::Gzip;
+    if (endsWith(fileName, ".zst"))
+        return DRW_Compression::Zstd;
+    return DRW_Compression::None;
+}
+
+bool DRW_compressionSupported(DRW_Compression c) {
+    switch (c) {
+    case DRW_Compression::None:
+        return true;
+#ifdef DRW_HAVE_ZLIB
+    case DRW_Compression::Gzip:
+        return true;
+#endif
+#ifdef DRW_HAVE_ZSTD
+    case DRW_Compression::Zstd:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * DRW_InflateBuf
+ * ------------------------------------------------------------------------ */
+
+DRW_InflateBuf::DRW_InflateBuf(std::streambuf *source, DRW_Compression c, const char *data, size_t size)
+    : mSource(source), mCompression(c), mOut(chunkSize), mInData(data), mInEnd(data ? size : 0) {
+    switch (c) {
+#ifdef DRW_HAVE_ZLIB
+    case DRW_Compression::Gzip: {
+        z_stream *z = new z_stream();
+        //15 + 16: gzip header and trailer, largest window
+        if (inflateInit2(z, 15 + 16) == Z_OK)
+            mState = z;
+        else
+            delete z;
+        break; }
+#endif
+#ifdef DRW_HAVE_ZSTD
+    case DRW_Compression::Zstd:
+        mState = ZSTD_createDCtx();
+        break;
+#endif
+    default:
+        break;
+    }
+    if (mState == nullptr) {
+        mGood = false;
+        mEnd = true;
+    }
+}
+
+DRW_InflateBuf::~DRW_InflateBuf() {
+    if (mState == nullptr)
+        return;
+    switch (mCompression) {
+#ifdef DRW_HAVE_ZLIB
+    case DRW_Compression::Gzip:
+        inflateEnd(static_cast<z_stream*>(mState));
+        delete static_cast<z_stream*>(mState);
+        break;
+#endif
+#ifdef DRW_HAVE_ZSTD
+    case DRW_Compression::Zstd:
+        ZSTD_freeDCtx(static_cast<ZSTD_DCtx*>(mState));
+        break;
+#endif
+    default:
+        break;
+    }
+}
+
+DRW_InflateBuf::int_type DRW_InflateBuf::underflow() {
+    if (gptr() < egptr())
+        return traits_type::to_int_type(*gptr());
+    size_t got = fill(mOut.data(), mOut.size());
+    if (got == 0)
+        return traits_type::eof();
+    setg(mOut.data(), mOut.data(), mOut.data() + got);
+    return traits_type::to_int_type(*gptr());
+}
+
+/** keeps the unused input and appends the next chunk of the source */
+bool DRW_InflateBuf::readInput() {
+    if (mSource == nullptr)
+        return false;
+    size_t left = mInEnd - mInPos;
+    if (mIn.empty())
+        mIn.resize(chunkSize);
+    if (left > 0 && mInData + mInPos != mIn.data())
+        memmove(mIn.data(), mInData + mInPos, left);
+    mInData = mIn.data();
+    mInPos = 0;
+    mInEnd = left;
+    std::streamsize got = mSource->sgetn(mIn.data() + left, static_cast<std::streamsize>(mIn.size() - left));
+    if (got <= 0) {
+        mSource = nullptr; //do not wait on a pipe or terminal again
+        return false;
+    }
+    mInEnd += static_cast<size_t>(got);
+    return true;
+}
+
+/** decompresses into dst until at least one byte is produced or the data ends */
+size_t DRW_InflateBuf::fill(char *dst, size_t size) {
+    size_t produced = 0;
+    while (produced == 0 && !mEnd) {
+        if (mInPos == mInEnd && !readInput()) {
+            //input ended in the middle of a gzip member or zstd frame
+            mGood = mFrameDone;
+            mEnd = true;
+            break;
+        }
+        switch (mCompression) {
+#ifdef DRW_HAVE_ZLIB
+        case DRW_Compression::Gzip: {
+            z_stream *z = static_cast<z_stream*>(mState);
+            if (mFrameDone) {
+                //a second member follows, anything else is trailing garbage
+                //ignored like gzip does
+                if (mInEnd - mInPos < 2 && !readInput()) {
+                    mEnd = true;
+                    break;
+                }
+                if (DRW_sniffCompression(mInData + mInPos, mInEnd - mInPos) != DRW_Compression::Gzip) {
+                    mEnd = true;
+                    break;
+                }
+                inflateReset(z);
+                mFrameDone = false;
+            }
+            z->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(mInData + mInPos));
+            z->avail_in = static_cast<uInt>(mInEnd - mInPos);
+            z->next_out = reinterpret_cast<Bytef*>(dst);
+            z->avail_out = static_cast<uInt>(size);
+            int ret = inflate(z, Z_NO_FLUSH);
+            mInPos = mInEnd - z->avail_in;
+            produced = size - z->avail_out;
+            if (ret == Z_STREAM_END) {
+                mFrameDone = true;
+            } else if (ret != Z_OK) {
+                mGood = false;
+                mEnd = true;
+            }
+            break; }
+#endif
+#ifdef DRW_HAVE_ZSTD
+        case DRW_Compression::Zstd: {
+            ZSTD_inBuffer in {mInData, mInEnd, mInPos};
+            ZSTD_outBuffer out {dst, size, 0};
+            size_t ret = ZSTD_decompressStream(static_cast<ZSTD_DCtx*>(mState), &out, &in);
+            mInPos = in.pos;
+            produced = out.pos;
+            if (ZSTD_isError(ret)) {
+                mGood = false;
+                mEnd = true;
+            } else {
+                mFrameDone = ret == 0;
+            }
+            break; }
+#endif
+        default:
+            (void)dst;
+            (void)size;
+            mGood = false;
+            mEnd = true;
+            break;
+        }
+    }
+    return produced;
+}
+
+/* ---------------------------------------------------------------------------
+ * DRW_DeflateBuf
+ * ------------------------------------------------------------------------ */
+
+DRW_DeflateBuf::DRW_DeflateBuf(std::ostream *sink, DRW_Compression c)
+    : mSink(sink), mCompression(c), mIn(chunkSize), mOut(chunkSize) {
+    switch (c) {
+#ifdef DRW_HAVE_ZLIB
+    case DRW_Compression::Gzip: {
+        z_stream *z = new z_stream();
+        if (deflateInit2(z, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) == Z_OK)
+            mState = z;
+        else
+            delete z;
+        break; }
+#endif
+#ifdef DRW_HAVE_ZSTD
+    case DRW_Compression::Zstd:
+        mState = ZSTD_createCCtx();
+        break;
+#endif
+    default:
+        break;
+    }
+    mGood = mState != nullptr;
+    setp(mIn.data(), mIn.data() + mIn.size());
+}
+
+DRW_DeflateBuf::~DRW_DeflateBuf() {
+    if (mState == nullptr)
+        return;
+    switch (mCompression) {
+#ifdef DRW_HAVE_ZLIB
+    case DRW_Compression::Gzip:
+        deflateEnd(static_cast<z_stream*>(mState));
+        delete static_cast<z_stream*>(mState);
+        break;
+#endif
+#ifdef DRW_HAVE_ZSTD
+    case DRW_Compression::Zstd:
+        ZSTD_freeCCtx(static_cast<ZSTD_CCtx*>(mState));
+        break;
+#endif
+    default:
+        break;
+    }
+}
+
+bool DRW_DeflateBuf::finish() {
+    if (mGood) {
+        mGood = compress(pbase(), static_cast<size_t>(pptr() - pbase()), true);
+        setp(mIn.data(), mIn.data() + mIn.size());
+    }
+    mSink->flush();
+    return mGood && mSink->good();
+}
+
+DRW_DeflateBuf::int_type DRW_DeflateBuf::overflow(int_type ch) {
+    if (sync() != 0)
+        return traits_type::eof();
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
+
+int DRW_DeflateBuf::sync() {
+    if (mGood && pptr() > pbase()) {
+        mGood = compress(pbase(), static_cast<size_t>(pptr() - pbase()), false);
+        setp(mIn.data(), mIn.data() + mIn.size());
+    }
+    return mGood ? 0 : -1;
+}
+
+/** compresses size bytes and writes all the output produced to the sink */
+bool DRW_DeflateBuf::compress(const char *data, size_t size, bool end) {
+    switch (mCompression) {
+#ifdef DRW_HAVE_ZLIB
+    case DRW_Compression::Gzip: {
+        z_stream *z = static_cast<z_stream*>(mState);
+        z->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+        z->avail_in = static_cast<uInt>(size);
+        int ret;
+        do {
+            z->next_out = reinterpret_cast<Bytef*>(mOut.data());
+            z->avail_out = static_cast<uInt>(mOut.size());
+            ret = deflate(z, end ? Z_FINISH : Z_NO_FLUSH);
+            if (ret == Z_STREAM_ERROR)
+                return false;
+            mSink->write(mOut.data(), static_cast<std::streamsize>(mOut.size() - z->avail_out));
+        } while (z->avail_out == 0);
+        return mSink->good() && (!end || ret == Z_STREAM_END); }
+#endif
+#ifdef DRW_HAVE_ZSTD
+    case DRW_Compression::Zstd: {
+        ZSTD_inBuffer in {data, size, 0};
+        for (;;) {
+            ZSTD_outBuffer out {mOut.data(), mOut.size(), 0};
+            size_t left = ZSTD_compressStream2(static_cast<ZSTD_CCtx*>(mState), &out, &in,
+                                               end ? ZSTD_e_end : ZSTD_e_continue);
+            if (ZSTD_isError(left))
+                return false;
+            mSink->write(mOut.data(), static_cast<std::streamsize>(out.pos));
+            if (end ? left == 0 : in.pos == in.size)
+                break;
+        }
+        return mSink->good(); }
+#endif
+    default:
+        (void)data;
+        (void)size;
+        (void)end;
+        return false;
+    }
+}
@@ -0,0 +1,104 @@
+/******************************************************************************
+**  libDXFrw - Library to read/write DXF files (ascii & binary)              **
+**                                                                           **
+**  This library is free software, licensed under the terms of the GNU       **
+**  General Public License as published by the Free Software Foundation,     **
+**  either version 2 of the License, or (at your option) any later version.  **
+**  You should have received a copy of the GNU General Public License        **
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.    **
+******************************************************************************/
+
+#ifndef DRW_ZSTREAM_H
+#define DRW_ZSTREAM_H
+
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+/**
+ * Compressed file formats. gzip needs DRW_HAVE_ZLIB and zstd needs
+ * DRW_HAVE_ZSTD at build time, see DRW_compressionSupported().
+ */
+enum class DRW_Compression {
+    None,
+    Gzip,
+    Zstd
+};
+
+/** Compression of a file from its first bytes (magic number) */
+DRW_Compression DRW_sniffCompression(const char *data, size_t size);
+/** Compression requested by a file name ending in ".gz" or ".zst" */
+DRW_Compression DRW_compressionFromName(const std::string &fileName);
+/** true if the library was built with support for the compression */
+bool DRW_compressionSupported(DRW_Compression c);
+
+/**
+ * Stream buffer that decompresses a source in fixed size chunks, so only
+ * one chunk of compressed and one of plain data are in memory.
+ * The compressed data starts with the optional @data span (used in place,
+ * it must outlive the buffer) and continues with @source, if any.
+ * Concatenated gzip members and zstd frames are read as one stream.
+ */
+class DRW_InflateBuf : public std::streambuf {
+public:
+    DRW_InflateBuf(std::streambuf *source, DRW_Compression c,
+                   const char *data = nullptr, size_t size = 0);
+    ~DRW_InflateBuf() override;
+    DRW_InflateBuf(const DRW_InflateBuf&) = delete;
+    DRW_InflateBuf& operator=(const DRW_InflateBuf&) = delete;
+
+    /** false once corrupt or truncated data has been found */
+    bool good() const {return mGood;}
+
+protected:
+    int_type underflow() override;
+
+private:
+    size_t fill(char *dst, size_t size);
+    bool readInput();
+
+    std::streambuf *mSource;
+    DRW_Compression mCompression;
+    void *mState {nullptr};
+    std::vector<char> mIn;
+    std::vector<char> mOut;
+    const char *mInData {nullptr};
+    size_t mInPos {0};
+    size_t mInEnd {0};
+    bool mFrameDone {false};
+    bool mEnd {false};
+    bool mGood {true};
+};
+
+/**
+ * Stream buffer that compresses everything written to it into a sink
+ * stream. finish() must be called to write the end of the compressed data.
+ */
+class DRW_DeflateBuf : public std::streambuf {
+public:
+    DRW_DeflateBuf(std::ostream *sink, DRW_Compression c);
+    ~DRW_DeflateBuf() override;
+    DRW_DeflateBuf(const DRW_DeflateBuf&) = delete;
+    DRW_DeflateBuf& operator=(const DRW_DeflateBuf&) = delete;
+
+    /** compress the pending data and end the stream, true on success */
+    bool finish();
+
+protected:
+    int_type overflow(int_type ch) override;
+    int sync() override;
+
+private:
+    bool compress(const char *data, size_t size, bool end);
+
+    std::ostream *mSink;
+    DRW_Compression mCompression;
+    void *mState {nullptr};
+    std::vector<char> mIn;
+    std::vector<char> mOut;
+    bool mGood {true};
+};
+
+#endif // DRW_ZSTREAM_H
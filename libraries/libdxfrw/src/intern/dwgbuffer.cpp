@@ -612,7 +612,7 @@ std::string dwgBuffer::getCP8Text(){
     if (!decoder)
         return strData;
 
-    return decoder->toUtf8(strData);
+    return decoder->toUtf8(std::move(strData));
 }
 
 //TU unicode 16 bit (UCS) text converted to utf8
@@ -627,7 +627,7 @@ std::string dwgBuffer::getUCSStr(duint16 ts){
     if (!decoder)
         return strData;
 
-    return decoder->toUtf8(strData);
+    return decoder->toUtf8(std::move(strData));
 }
 
 //TU unicode 16 bit (UCS) text converted to utf8
@@ -642,7 +642,7 @@ std::string dwgBuffer::getUCSText(bool nullTerm){
     if (!decoder)
         return strData;
 
-    return decoder->toUtf8(strData);
+    return decoder->toUtf8(std::move(strData));
 }
 
 //RLZ: read a T or TU if version is 2007+
@@ -56,6 +56,10 @@ void dwgReader::parseAttribs(DRW_Entity* e) {
     if (ly_it != layermap.end()) {
         e->layer = (ly_it->second)->name;
     }
+    if (nameTable) {
+        e->layerId = nameTable->intern(e->layer);
+        e->lineTypeId = nameTable->intern(e->lineType);
+    }
 }
 
 std::string dwgReader::findTableName(DRW::TTYPE table, dint32 handle){
@@ -109,7 +113,7 @@ bool dwgReader::readDwgHeader(DRW_Header& hdr, dwgBuffer *buf, dwgBuffer *hBuf){
 bool dwgReader::checkSentinel(dwgBuffer *buf, enum secEnum::DWGSection, bool start){
     DRW_UNUSED(start);
     for (int i=0; i<16;i++) {
-        DRW_DBGH(buf->getRawChar8()); DRW_DBG(" ");
+        DRW_DBGHR(buf->getRawChar8()); DRW_DBG(" ");
     }
     return true;
 }
@@ -188,6 +188,7 @@ protected:
 
 protected:
     DRW_TextCodec decoder;
+    DRW_NameTable *nameTable {nullptr};  /*!< interns entity layer and line type names, if set */
 
 protected:
 //    duint32 blockCtrl;
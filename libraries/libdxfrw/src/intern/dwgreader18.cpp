@@ -69,8 +69,8 @@ bool dwgReader18::parseSysPage(duint8 *decompSec, duint32 decompSize){
     DRW_DBG("\nparseSysPage:\n ");
     duint32 compSize = fileBuf->getRawLong32();
     DRW_DBG("Compressed size= "); DRW_DBG(compSize); DRW_DBG(", "); DRW_DBGH(compSize);
-    DRW_DBG("\nCompression type= "); DRW_DBGH(fileBuf->getRawLong32());
-    DRW_DBG("\nSection page checksum= "); DRW_DBGH(fileBuf->getRawLong32()); DRW_DBG("\n");
+    DRW_DBG("\nCompression type= "); DRW_DBGHR(fileBuf->getRawLong32());
+    DRW_DBG("\nSection page checksum= "); DRW_DBGHR(fileBuf->getRawLong32()); DRW_DBG("\n");
 
     duint8 hdrData[20];
     fileBuf->moveBitPos(-160);
@@ -139,16 +139,16 @@ bool dwgReader18::parseDataPage(const dwgSectionInfo &si/*, duint8 *dData*/){
         DRW_DBG("\n    Data size= "); DRW_DBGH(pi.dataSize);
         DRW_DBG("\n    Start offset= "); DRW_DBGH(pi.startOffset); DRW_DBG("\n");
         dwgBuffer bufHdr(hdrData, 32, &decoder);
-        DRW_DBG("      section page type= "); DRW_DBGH(bufHdr.getRawLong32());
-        DRW_DBG("\n      section number= "); DRW_DBGH(bufHdr.getRawLong32());
+        DRW_DBG("      section page type= "); DRW_DBGHR(bufHdr.getRawLong32());
+        DRW_DBG("\n      section number= "); DRW_DBGHR(bufHdr.getRawLong32());
         pi.cSize = bufHdr.getRawLong32();
         DRW_DBG("\n      data size (compressed)= "); DRW_DBGH(pi.cSize); DRW_DBG(" dec "); DRW_DBG(pi.cSize);
         pi.uSize = bufHdr.getRawLong32();
         DRW_DBG("\n      page size (decompressed)= "); DRW_DBGH(pi.uSize); DRW_DBG(" dec "); DRW_DBG(pi.uSize);
-        DRW_DBG("\n      start offset (in decompressed buffer)= "); DRW_DBGH(bufHdr.getRawLong32());
-        DRW_DBG("\n      unknown= "); DRW_DBGH(bufHdr.getRawLong32());
-        DRW_DBG("\n      header checksum= "); DRW_DBGH(bufHdr.getRawLong32());
-        DRW_DBG("\n      data checksum= "); DRW_DBGH(bufHdr.getRawLong32()); DRW_DBG("\n");
+        DRW_DBG("\n      start offset (in decompressed buffer)= "); DRW_DBGHR(bufHdr.getRawLong32());
+        DRW_DBG("\n      unknown= "); DRW_DBGHR(bufHdr.getRawLong32());
+        DRW_DBG("\n      header checksum= "); DRW_DBGHR(bufHdr.getRawLong32());
+        DRW_DBG("\n      data checksum= "); DRW_DBGHR(bufHdr.getRawLong32()); DRW_DBG("\n");
 
         //get compressed data
         std::vector<duint8> cData(pi.cSize);
@@ -184,17 +184,17 @@ bool dwgReader18::readMetaData() {
         return false;
     maintenanceVersion = fileBuf->getRawChar8();
     DRW_DBG("maintenance version= "); DRW_DBGH(maintenanceVersion);
-    DRW_DBG("\nbyte at 0x0C= "); DRW_DBGH(fileBuf->getRawChar8());
+    DRW_DBG("\nbyte at 0x0C= "); DRW_DBGHR(fileBuf->getRawChar8());
     previewImagePos = fileBuf->getRawLong32(); //+ page header size (0x20).
     DRW_DBG("\npreviewImagePos (seekerImageData) = "); DRW_DBG(previewImagePos);
-    DRW_DBG("\napp Dwg version= "); DRW_DBGH(fileBuf->getRawChar8()); DRW_DBG(", ");
-    DRW_DBG("\napp maintenance version= "); DRW_DBGH(fileBuf->getRawChar8());
+    DRW_DBG("\napp Dwg version= "); DRW_DBGHR(fileBuf->getRawChar8()); DRW_DBG(", ");
+    DRW_DBG("\napp maintenance version= "); DRW_DBGHR(fileBuf->getRawChar8());
     duint16 cp = fileBuf->getRawShort16();
     DRW_DBG("\ncodepage= "); DRW_DBG(cp);
     if (cp == 30)
         decoder.setCodePage("ANSI_1252", false);
-    DRW_DBG("\n3 0x00 bytes(seems 0x00, appDwgV & appMaintV) = "); DRW_DBGH(fileBuf->getRawChar8()); DRW_DBG(", ");
-    DRW_DBGH(fileBuf->getRawChar8()); DRW_DBG(", "); DRW_DBGH(fileBuf->getRawChar8());
+    DRW_DBG("\n3 0x00 bytes(seems 0x00, appDwgV & appMaintV) = "); DRW_DBGHR(fileBuf->getRawChar8()); DRW_DBG(", ");
+    DRW_DBGHR(fileBuf->getRawChar8()); DRW_DBG(", "); DRW_DBGHR(fileBuf->getRawChar8());
     securityFlags = fileBuf->getRawLong32();
     DRW_DBG("\nsecurity flags= "); DRW_DBG(securityFlags);
     // UNKNOWN SECTION 4 bytes
@@ -204,7 +204,7 @@ bool dwgReader18::readMetaData() {
     DRW_DBG("\nsummary Info Address= "); DRW_DBG(sumInfoAddr);
     duint32 vbaAdd =    fileBuf->getRawLong32();
     DRW_DBG("\nVBA address= "); DRW_DBGH(vbaAdd);
-    DRW_DBG("\npos 0x28 are 0x00000080= "); DRW_DBGH(fileBuf->getRawLong32());
+    DRW_DBG("\npos 0x28 are 0x00000080= "); DRW_DBGHR(fileBuf->getRawLong32());
      DRW_DBG("\n");
     return true;
 }
@@ -249,21 +249,21 @@ bool dwgReader18::readFileHeader() {
     DRW_DBG("\nFile ID string (AcFssFcAJMB)= "); DRW_DBG(name.c_str());
     //ID string + NULL = 12
     buff.setPosition(12);
-    DRW_DBG("\n0x00 long= "); DRW_DBGH(buff.getRawLong32());
-    DRW_DBG("\n0x6c long= "); DRW_DBGH(buff.getRawLong32());
-    DRW_DBG("\n0x04 long= "); DRW_DBGH(buff.getRawLong32());
-    DRW_DBG("\nRoot tree node gap= "); DRW_DBGH(buff.getRawLong32());
-    DRW_DBG("\nLowermost left tree node gap= "); DRW_DBGH(buff.getRawLong32());
-    DRW_DBG("\nLowermost right tree node gap= "); DRW_DBGH(buff.getRawLong32());
-    DRW_DBG("\nUnknown long (1)= "); DRW_DBGH(buff.getRawLong32());
-    DRW_DBG("\nLast section page Id= "); DRW_DBGH(buff.getRawLong32());
-    DRW_DBG("\nLast section page end address 64b= "); DRW_DBGH(buff.getRawLong64());
-    DRW_DBG("\nStart of second header data address 64b= "); DRW_DBGH(buff.getRawLong64());
-    DRW_DBG("\nGap amount= "); DRW_DBGH(buff.getRawLong32());
-    DRW_DBG("\nSection page amount= "); DRW_DBGH(buff.getRawLong32());
-    DRW_DBG("\n0x20 long= "); DRW_DBGH(buff.getRawLong32());
-    DRW_DBG("\n0x80 long= "); DRW_DBGH(buff.getRawLong32());
-    DRW_DBG("\n0x40 long= "); DRW_DBGH(buff.getRawLong32());
+    DRW_DBG("\n0x00 long= "); DRW_DBGHR(buff.getRawLong32());
+    DRW_DBG("\n0x6c long= "); DRW_DBGHR(buff.getRawLong32());
+    DRW_DBG("\n0x04 long= "); DRW_DBGHR(buff.getRawLong32());
+    DRW_DBG("\nRoot tree node gap= "); DRW_DBGHR(buff.getRawLong32());
+    DRW_DBG("\nLowermost left tree node gap= "); DRW_DBGHR(buff.getRawLong32());
+    DRW_DBG("\nLowermost right tree node gap= "); DRW_DBGHR(buff.getRawLong32());
+    DRW_DBG("\nUnknown long (1)= "); DRW_DBGHR(buff.getRawLong32());
+    DRW_DBG("\nLast section page Id= "); DRW_DBGHR(buff.getRawLong32());
+    DRW_DBG("\nLast section page end address 64b= "); DRW_DBGHR(buff.getRawLong64());
+    DRW_DBG("\nStart of second header data address 64b= "); DRW_DBGHR(buff.getRawLong64());
+    DRW_DBG("\nGap amount= "); DRW_DBGHR(buff.getRawLong32());
+    DRW_DBG("\nSection page amount= "); DRW_DBGHR(buff.getRawLong32());
+    DRW_DBG("\n0x20 long= "); DRW_DBGHR(buff.getRawLong32());
+    DRW_DBG("\n0x80 long= "); DRW_DBGHR(buff.getRawLong32());
+    DRW_DBG("\n0x40 long= "); DRW_DBGHR(buff.getRawLong32());
     dint32 secPageMapId = buff.getRawLong32();
     DRW_DBG("\nSection Page Map Id= "); DRW_DBGH(secPageMapId);
     duint64 secPageMapAddr = buff.getRawLong64()+0x100;
@@ -271,10 +271,10 @@ bool dwgReader18::readFileHeader() {
     DRW_DBG("\nSection Page Map address 64b dec= "); DRW_DBG(secPageMapAddr);
     duint32 secMapId = buff.getRawLong32();
     DRW_DBG("\nSection Map Id= "); DRW_DBGH(secMapId);
-    DRW_DBG("\nSection page array size= "); DRW_DBGH(buff.getRawLong32());
-    DRW_DBG("\nGap array size= "); DRW_DBGH(buff.getRawLong32());
+    DRW_DBG("\nSection page array size= "); DRW_DBGHR(buff.getRawLong32());
+    DRW_DBG("\nGap array size= "); DRW_DBGHR(buff.getRawLong32());
     //TODO: verify CRC
-    DRW_DBG("\nCRC32= "); DRW_DBGH(buff.getRawLong32());
+    DRW_DBG("\nCRC32= "); DRW_DBGHR(buff.getRawLong32());
     for (duint8 i = 0x68; i < 0x6c; ++i)
         byteStr[i] = '\0';
 //    byteStr[i] = '\0';
@@ -284,7 +284,7 @@ bool dwgReader18::readFileHeader() {
     DRW_DBG("\nEnd Encrypted Data. Reads 0x14 bytes, equal to magic number:\n");
     for (int i=0, j=0; i< 0x14;i++) {
         DRW_DBG("magic num: "); DRW_DBGH( static_cast<unsigned char>(DRW_magicNumEnd18[i]));
-        DRW_DBG(",read "); DRW_DBGH( static_cast<unsigned char>(fileBuf->getRawChar8()));
+        DRW_DBG(",read "); DRW_DBGHR( static_cast<unsigned char>(fileBuf->getRawChar8()));
         if (j == 3) {
             DRW_DBG("\n");
             j = 0;
@@ -327,10 +327,10 @@ bool dwgReader18::readFileHeader() {
         //TODO num can be negative indicating gap
 //        duint64 ind = id > 0 ? id : -id;
         if (id < 0){
-            DRW_DBG("Parent= "); DRW_DBG(buff2.getRawLong32());
-            DRW_DBG("\nLeft= "); DRW_DBG(buff2.getRawLong32());
-            DRW_DBG(", Right= "); DRW_DBG(buff2.getRawLong32());
-            DRW_DBG(", 0x00= ");DRW_DBGH(buff2.getRawLong32()); DRW_DBG("\n");
+            DRW_DBG("Parent= "); DRW_DBGR(buff2.getRawLong32());
+            DRW_DBG("\nLeft= "); DRW_DBGR(buff2.getRawLong32());
+            DRW_DBG(", Right= "); DRW_DBGR(buff2.getRawLong32());
+            DRW_DBG(", 0x00= ");DRW_DBGHR(buff2.getRawLong32()); DRW_DBG("\n");
             i += 16;
         }
 
@@ -361,10 +361,10 @@ bool dwgReader18::readFileHeader() {
     dwgBuffer buff3(tmpDecompSec.data(), decompSize, &decoder);
     duint32 numDescriptions = buff3.getRawLong32();
     DRW_DBG("\nnumDescriptions (sections)= "); DRW_DBG(numDescriptions);
-    DRW_DBG("\n0x02 long= "); DRW_DBGH(buff3.getRawLong32());
-    DRW_DBG("\n0x00007400 long= "); DRW_DBGH(buff3.getRawLong32());
-    DRW_DBG("\n0x00 long= "); DRW_DBGH(buff3.getRawLong32());
-    DRW_DBG("\nunknown long (numDescriptions?)= "); DRW_DBG(buff3.getRawLong32()); DRW_DBG("\n");
+    DRW_DBG("\n0x02 long= "); DRW_DBGHR(buff3.getRawLong32());
+    DRW_DBG("\n0x00007400 long= "); DRW_DBGHR(buff3.getRawLong32());
+    DRW_DBG("\n0x00 long= "); DRW_DBGHR(buff3.getRawLong32());
+    DRW_DBG("\nunknown long (numDescriptions?)= "); DRW_DBGR(buff3.getRawLong32()); DRW_DBG("\n");
 
     for (unsigned int i = 0; i < numDescriptions; i++) {
         dwgSectionInfo secInfo;
@@ -374,7 +374,7 @@ bool dwgReader18::readFileHeader() {
         DRW_DBG("\nPage count= "); DRW_DBGH(secInfo.pageCount);
         secInfo.maxSize = buff3.getRawLong32();
         DRW_DBG("\nMax Decompressed Size= "); DRW_DBGH(secInfo.maxSize);
-        DRW_DBG("\nunknown long= "); DRW_DBGH(buff3.getRawLong32());
+        DRW_DBG("\nunknown long= "); DRW_DBGHR(buff3.getRawLong32());
         secInfo.compressed = buff3.getRawLong32();
         DRW_DBG("\nis Compressed? 1:no, 2:yes= "); DRW_DBGH(secInfo.compressed);
         secInfo.Id = buff3.getRawLong32();
@@ -467,9 +467,9 @@ bool dwgReader18::readDwgClasses(){
     }
     duint32 maxClassNum = dataBuf.getBitShort();
     DRW_DBG("\nMaximum class number "); DRW_DBG(maxClassNum);
-    DRW_DBG("\nRc 1 "); DRW_DBG(dataBuf.getRawChar8());
-    DRW_DBG("\nRc 2 "); DRW_DBG(dataBuf.getRawChar8());
-    DRW_DBG("\nBit "); DRW_DBG(dataBuf.getBit());
+    DRW_DBG("\nRc 1 "); DRW_DBGR(dataBuf.getRawChar8());
+    DRW_DBG("\nRc 2 "); DRW_DBGR(dataBuf.getRawChar8());
+    DRW_DBG("\nBit "); DRW_DBGR(dataBuf.getBit());
     if (499 >= maxClassNum) {
         // maxClassNum is later reduced by 499, so smaller values seem to be invalid
         // no documentation about the value of 499 found yet
@@ -488,7 +488,7 @@ bool dwgReader18::readDwgClasses(){
         strBuff.setBitPos(strStartPos & 7);
         DRW_DBG("\nclasses strings buff.getPosition: "); DRW_DBG(strBuff.getPosition());
         DRW_DBG("\nclasses strings buff.getBitPos: "); DRW_DBG(strBuff.getBitPos());
-        DRW_DBG("\nendBit "); DRW_DBG(strBuff.getBit());
+        DRW_DBG("\nendBit "); DRW_DBGR(strBuff.getBit());
         strStartPos -= 16;//decrement 16 bits
         DRW_DBG("\nstrStartPos: "); DRW_DBG(strStartPos);
         strBuff.setPosition(strStartPos >> 3);
@@ -531,9 +531,9 @@ bool dwgReader18::readDwgClasses(){
 /***************/
 
     strBuf->setPosition(strBuf->getPosition()+1);//skip remaining bits
-    DRW_DBG("\nCRC: "); DRW_DBGH(strBuf->getRawShort16());
+    DRW_DBG("\nCRC: "); DRW_DBGHR(strBuf->getRawShort16());
     if (version > DRW::AC1018){
-        DRW_DBG("\nunknown CRC: "); DRW_DBGH(strBuf->getRawShort16());
+        DRW_DBG("\nunknown CRC: "); DRW_DBGHR(strBuf->getRawShort16());
     }
     DRW_DBG("\nclasses section end sentinel= ");
     checkSentinel(strBuf, secEnum::CLASSES, false);
@@ -30,29 +30,29 @@ bool dwgReader21::readMetaData() {
         return false;
     maintenanceVersion = fileBuf->getRawChar8();
     DRW_DBG("maintenance version= "); DRW_DBGH(maintenanceVersion);
-    DRW_DBG("\nbyte at 0x0C= "); DRW_DBG(fileBuf->getRawChar8());
+    DRW_DBG("\nbyte at 0x0C= "); DRW_DBGR(fileBuf->getRawChar8());
     previewImagePos = fileBuf->getRawLong32();
     DRW_DBG("previewImagePos (seekerImageData) = "); DRW_DBG(previewImagePos);
-    DRW_DBG("\n\napp writer version= "); DRW_DBGH(fileBuf->getRawChar8());
-    DRW_DBG("\napp writer maintenance version= "); DRW_DBGH(fileBuf->getRawChar8());
+    DRW_DBG("\n\napp writer version= "); DRW_DBGHR(fileBuf->getRawChar8());
+    DRW_DBG("\napp writer maintenance version= "); DRW_DBGHR(fileBuf->getRawChar8());
     duint16 cp = fileBuf->getRawShort16();
     DRW_DBG("\ncodepage= "); DRW_DBG(cp);
     if (cp == 30)
         decoder.setCodePage("ANSI_1252", false);
     /* UNKNOUWN SECTION 2 bytes*/
-    DRW_DBG("\nUNKNOWN SECTION= "); DRW_DBG(fileBuf->getRawShort16());
-    DRW_DBG("\nUNKNOUWN SECTION 3b= "); DRW_DBG(fileBuf->getRawChar8());
+    DRW_DBG("\nUNKNOWN SECTION= "); DRW_DBGR(fileBuf->getRawShort16());
+    DRW_DBG("\nUNKNOUWN SECTION 3b= "); DRW_DBGR(fileBuf->getRawChar8());
     duint32 secType = fileBuf->getRawLong32();
     DRW_DBG("\nsecurity type flag= "); DRW_DBGH(secType);
     /* UNKNOWN2 SECTION 4 bytes*/
-    DRW_DBG("\nUNKNOWN SECTION 4bytes= "); DRW_DBG(fileBuf->getRawLong32());
+    DRW_DBG("\nUNKNOWN SECTION 4bytes= "); DRW_DBGR(fileBuf->getRawLong32());
 
-    DRW_DBG("\nSummary info address= "); DRW_DBGH(fileBuf->getRawLong32());
-    DRW_DBG("\nVBA project address= "); DRW_DBGH(fileBuf->getRawLong32());
-    DRW_DBG("\n0x00000080 32b= "); DRW_DBGH(fileBuf->getRawLong32());
-    DRW_DBG("\nApp info address= "); DRW_DBGH(fileBuf->getRawLong32());
+    DRW_DBG("\nSummary info address= "); DRW_DBGHR(fileBuf->getRawLong32());
+    DRW_DBG("\nVBA project address= "); DRW_DBGHR(fileBuf->getRawLong32());
+    DRW_DBG("\n0x00000080 32b= "); DRW_DBGHR(fileBuf->getRawLong32());
+    DRW_DBG("\nApp info address= "); DRW_DBGHR(fileBuf->getRawLong32());
     //current position are 0x30 from here to 0x80 are undocumented
-    DRW_DBG("\nAnother address? = "); DRW_DBGH(fileBuf->getRawLong32());
+    DRW_DBG("\nAnother address? = "); DRW_DBGHR(fileBuf->getRawLong32());
     return true;
 }
 
@@ -146,9 +146,9 @@ bool dwgReader21::readFileHeader() {
 #endif
 
     dwgBuffer fileHdrBuf(fileHdrdRS, 0x2CD, &decoder);
-    DRW_DBG("\nCRC 64b= "); DRW_DBGH(fileHdrBuf.getRawLong64());
-    DRW_DBG("\nunknown key 64b= "); DRW_DBGH(fileHdrBuf.getRawLong64());
-    DRW_DBG("\ncomp data CRC 64b= "); DRW_DBGH(fileHdrBuf.getRawLong64());
+    DRW_DBG("\nCRC 64b= "); DRW_DBGHR(fileHdrBuf.getRawLong64());
+    DRW_DBG("\nunknown key 64b= "); DRW_DBGHR(fileHdrBuf.getRawLong64());
+    DRW_DBG("\ncomp data CRC 64b= "); DRW_DBGHR(fileHdrBuf.getRawLong64());
     dint32 fileHdrCompLength = fileHdrBuf.getRawLong32();
     DRW_DBG("\ncompr len 4bytes= "); DRW_DBG(fileHdrCompLength);
     dint32 fileHdrCompLength2 = fileHdrBuf.getRawLong32();
@@ -182,49 +182,49 @@ bool dwgReader21::readFileHeader() {
 #endif
 
     dwgBuffer fileHdrDataBuf(&fileHdrData.front(), fileHdrDataLength, &decoder);
-    DRW_DBG("\nHeader size = "); DRW_DBGH(fileHdrDataBuf.getRawLong64());
-    DRW_DBG("\nFile size = "); DRW_DBGH(fileHdrDataBuf.getRawLong64());
-    DRW_DBG("\nPagesMapCrcCompressed = "); DRW_DBGH(fileHdrDataBuf.getRawLong64());
+    DRW_DBG("\nHeader size = "); DRW_DBGHR(fileHdrDataBuf.getRawLong64());
+    DRW_DBG("\nFile size = "); DRW_DBGHR(fileHdrDataBuf.getRawLong64());
+    DRW_DBG("\nPagesMapCrcCompressed = "); DRW_DBGHR(fileHdrDataBuf.getRawLong64());
     duint64 PagesMapCorrectionFactor = fileHdrDataBuf.getRawLong64();
     DRW_DBG("\nPagesMapCorrectionFactor = "); DRW_DBG(PagesMapCorrectionFactor);
-    DRW_DBG("\nPagesMapCrcSeed = "); DRW_DBGH(fileHdrDataBuf.getRawLong64());
-    DRW_DBG("\nPages map2offset = "); DRW_DBGH(fileHdrDataBuf.getRawLong64()); //relative to data page map 1, add 0x480 to get stream position
-    DRW_DBG("\nPages map2Id = "); DRW_DBG(fileHdrDataBuf.getRawLong64());
+    DRW_DBG("\nPagesMapCrcSeed = "); DRW_DBGHR(fileHdrDataBuf.getRawLong64());
+    DRW_DBG("\nPages map2offset = "); DRW_DBGHR(fileHdrDataBuf.getRawLong64()); //relative to data page map 1, add 0x480 to get stream position
+    DRW_DBG("\nPages map2Id = "); DRW_DBGR(fileHdrDataBuf.getRawLong64());
     duint64 PagesMapOffset = fileHdrDataBuf.getRawLong64();
     DRW_DBG("\nPagesMapOffset = "); DRW_DBGH(PagesMapOffset); //relative to data page map 1, add 0x480 to get stream position
-    DRW_DBG("\nPagesMapId = "); DRW_DBG(fileHdrDataBuf.getRawLong64());
-    DRW_DBG("\nHeader2offset = "); DRW_DBGH(fileHdrDataBuf.getRawLong64()); //relative to data page map 1, add 0x480 to get stream position
+    DRW_DBG("\nPagesMapId = "); DRW_DBGR(fileHdrDataBuf.getRawLong64());
+    DRW_DBG("\nHeader2offset = "); DRW_DBGHR(fileHdrDataBuf.getRawLong64()); //relative to data page map 1, add 0x480 to get stream position
     duint64 PagesMapSizeCompressed = fileHdrDataBuf.getRawLong64();
     DRW_DBG("\nPagesMapSizeCompressed = "); DRW_DBG(PagesMapSizeCompressed);
     duint64 PagesMapSizeUncompressed = fileHdrDataBuf.getRawLong64();
     DRW_DBG("\nPagesMapSizeUncompressed = "); DRW_DBG(PagesMapSizeUncompressed);
-    DRW_DBG("\nPagesAmount = "); DRW_DBGH(fileHdrDataBuf.getRawLong64());
+    DRW_DBG("\nPagesAmount = "); DRW_DBGHR(fileHdrDataBuf.getRawLong64());
     duint64 PagesMaxId = fileHdrDataBuf.getRawLong64();
     DRW_DBG("\nPagesMaxId = "); DRW_DBG(PagesMaxId);
-    DRW_DBG("\nUnknown (normally 0x20) = "); DRW_DBGH(fileHdrDataBuf.getRawLong64());
-    DRW_DBG("\nUnknown (normally 0x40) = "); DRW_DBGH(fileHdrDataBuf.getRawLong64());
-    DRW_DBG("\nPagesMapCrcUncompressed = "); DRW_DBGH(fileHdrDataBuf.getRawLong64());
-    DRW_DBG("\nUnknown (normally 0xf800) = "); DRW_DBGH(fileHdrDataBuf.getRawLong64());
-    DRW_DBG("\nUnknown (normally 4) = "); DRW_DBGH(fileHdrDataBuf.getRawLong64());
-    DRW_DBG("\nUnknown (normally 1) = "); DRW_DBGH(fileHdrDataBuf.getRawLong64());
-    DRW_DBG("\nSectionsAmount (number of sections + 1) = "); DRW_DBGH(fileHdrDataBuf.getRawLong64());
-    DRW_DBG("\nSectionsMapCrcUncompressed = "); DRW_DBGH(fileHdrDataBuf.getRawLong64());
+    DRW_DBG("\nUnknown (normally 0x20) = "); DRW_DBGHR(fileHdrDataBuf.getRawLong64());
+    DRW_DBG("\nUnknown (normally 0x40) = "); DRW_DBGHR(fileHdrDataBuf.getRawLong64());
+    DRW_DBG("\nPagesMapCrcUncompressed = "); DRW_DBGHR(fileHdrDataBuf.getRawLong64());
+    DRW_DBG("\nUnknown (normally 0xf800) = "); DRW_DBGHR(fileHdrDataBuf.getRawLong64());
+    DRW_DBG("\nUnknown (normally 4) = "); DRW_DBGHR(fileHdrDataBuf.getRawLong64());
+    DRW_DBG("\nUnknown (normally 1) = "); DRW_DBGHR(fileHdrDataBuf.getRawLong64());
+    DRW_DBG("\nSectionsAmount (number of sections + 1) = "); DRW_DBGHR(fileHdrDataBuf.getRawLong64());
+    DRW_DBG("\nSectionsMapCrcUncompressed = "); DRW_DBGHR(fileHdrDataBuf.getRawLong64());
     duint64 SectionsMapSizeCompressed = fileHdrDataBuf.getRawLong64();
     DRW_DBG("\nSectionsMapSizeCompressed = "); DRW_DBGH(SectionsMapSizeCompressed);
-    DRW_DBG("\nSectionsMap2Id = "); DRW_DBG(fileHdrDataBuf.getRawLong64());
+    DRW_DBG("\nSectionsMap2Id = "); DRW_DBGR(fileHdrDataBuf.getRawLong64());
     duint64 SectionsMapId = fileHdrDataBuf.getRawLong64();
     DRW_DBG("\nSectionsMapId = "); DRW_DBG(SectionsMapId);
     duint64 SectionsMapSizeUncompressed = fileHdrDataBuf.getRawLong64();
     DRW_DBG("\nSectionsMapSizeUncompressed = "); DRW_DBGH(SectionsMapSizeUncompressed);
-    DRW_DBG("\nSectionsMapCrcCompressed = "); DRW_DBGH(fileHdrDataBuf.getRawLong64());
+    DRW_DBG("\nSectionsMapCrcCompressed = "); DRW_DBGHR(fileHdrDataBuf.getRawLong64());
     duint64 SectionsMapCorrectionFactor = fileHdrDataBuf.getRawLong64();
     DRW_DBG("\nSectionsMapCorrectionFactor = "); DRW_DBG(SectionsMapCorrectionFactor);
-    DRW_DBG("\nSectionsMapCrcSeed = "); DRW_DBGH(fileHdrDataBuf.getRawLong64());
-    DRW_DBG("\nStreamVersion (normally 0x60100) = "); DRW_DBGH(fileHdrDataBuf.getRawLong64());
-    DRW_DBG("\nCrcSeed = "); DRW_DBGH(fileHdrDataBuf.getRawLong64());
-    DRW_DBG("\nCrcSeedEncoded = "); DRW_DBGH(fileHdrDataBuf.getRawLong64());
-    DRW_DBG("\nRandomSeed = "); DRW_DBGH(fileHdrDataBuf.getRawLong64());
-    DRW_DBG("\nHeader CRC64 = "); DRW_DBGH(fileHdrDataBuf.getRawLong64()); DRW_DBG("\n");
+    DRW_DBG("\nSectionsMapCrcSeed = "); DRW_DBGHR(fileHdrDataBuf.getRawLong64());
+    DRW_DBG("\nStreamVersion (normally 0x60100) = "); DRW_DBGHR(fileHdrDataBuf.getRawLong64());
+    DRW_DBG("\nCrcSeed = "); DRW_DBGHR(fileHdrDataBuf.getRawLong64());
+    DRW_DBG("\nCrcSeedEncoded = "); DRW_DBGHR(fileHdrDataBuf.getRawLong64());
+    DRW_DBG("\nRandomSeed = "); DRW_DBGHR(fileHdrDataBuf.getRawLong64());
+    DRW_DBG("\nHeader CRC64 = "); DRW_DBGHR(fileHdrDataBuf.getRawLong64()); DRW_DBG("\n");
 
     DRW_DBG("\ndwgReader21::parse page map:\n");
     std::vector<duint8> PagesMapData(PagesMapSizeUncompressed);
@@ -278,10 +278,10 @@ bool dwgReader21::readFileHeader() {
         secInfo.encrypted = SectionsMapBuf.getRawLong64();
         //encrypted (doc: 0 no, 1 yes, 2 unkn) on read: objects 0 and encrypted yes
         DRW_DBG("\nencription= "); DRW_DBGH(secInfo.encrypted);
-        DRW_DBG("\nHashCode = "); DRW_DBGH(SectionsMapBuf.getRawLong64());
+        DRW_DBG("\nHashCode = "); DRW_DBGHR(SectionsMapBuf.getRawLong64());
         duint64 SectionNameLength = SectionsMapBuf.getRawLong64();
         DRW_DBG("\nSectionNameLength = "); DRW_DBG(SectionNameLength);
-        DRW_DBG("\nUnknown = "); DRW_DBGH(SectionsMapBuf.getRawLong64());
+        DRW_DBG("\nUnknown = "); DRW_DBGHR(SectionsMapBuf.getRawLong64());
         secInfo.compressed = SectionsMapBuf.getRawLong64();
         DRW_DBG("\nEncoding (compressed) = "); DRW_DBGH(secInfo.compressed);
         secInfo.pageCount = SectionsMapBuf.getRawLong64();
@@ -308,8 +308,8 @@ bool dwgReader21::readFileHeader() {
             DRW_DBG("\n    Page uncompressed size = "); DRW_DBGH(secInfo.pages[pn].uSize);
             DRW_DBG("\n    Page compressed size = "); DRW_DBGH(secInfo.pages[pn].cSize);
 
-            DRW_DBG("\n    Page checksum = "); DRW_DBGH(SectionsMapBuf.getRawLong64());
-            DRW_DBG("\n    Page CRC = "); DRW_DBGH(SectionsMapBuf.getRawLong64()); DRW_DBG("\n");
+            DRW_DBG("\n    Page checksum = "); DRW_DBGHR(SectionsMapBuf.getRawLong64());
+            DRW_DBG("\n    Page CRC = "); DRW_DBGHR(SectionsMapBuf.getRawLong64()); DRW_DBG("\n");
         }
 
         if (!secInfo.name.empty()) {
@@ -373,9 +373,9 @@ bool dwgReader21::readDwgClasses(){
 
     duint32 maxClassNum = buff.getBitShort();
     DRW_DBG("\nMaximum class number "); DRW_DBG(maxClassNum);
-    DRW_DBG("\nRc 1 "); DRW_DBG(buff.getRawChar8());
-    DRW_DBG("\nRc 2 "); DRW_DBG(buff.getRawChar8());
-    DRW_DBG("\nBit "); DRW_DBG(buff.getBit());
+    DRW_DBG("\nRc 1 "); DRW_DBGR(buff.getRawChar8());
+    DRW_DBG("\nRc 2 "); DRW_DBGR(buff.getRawChar8());
+    DRW_DBG("\nBit "); DRW_DBGR(buff.getBit());
 
     /*******************************/
     //prepare string stream
@@ -386,7 +386,7 @@ bool dwgReader21::readDwgClasses(){
     strBuff.setBitPos(strStartPos & 7);
     DRW_DBG("\nclasses strings buff.getPosition: "); DRW_DBG(strBuff.getPosition());
     DRW_DBG("\nclasses strings buff.getBitPos: "); DRW_DBG(strBuff.getBitPos());
-    DRW_DBG("\nendBit "); DRW_DBG(strBuff.getBit());
+    DRW_DBG("\nendBit "); DRW_DBGR(strBuff.getBit());
     strStartPos -= 16;//decrement 16 bits
     DRW_DBG("\nstrStartPos: "); DRW_DBG(strStartPos);
     strBuff.setPosition(strStartPos >> 3);
@@ -425,7 +425,7 @@ bool dwgReader21::readDwgClasses(){
     DRW_DBG("\nend classes data buff.getBitPos: "); DRW_DBG(buff.getBitPos());
 
     buff.setPosition(size+20);//sizeVal+sn+32bSize
-    DRW_DBG("\nCRC: "); DRW_DBGH(buff.getRawShort16());
+    DRW_DBG("\nCRC: "); DRW_DBGHR(buff.getRawShort16());
     DRW_DBG("\nclasses section end sentinel= ");
     checkSentinel(&buff, secEnum::CLASSES, true);
     return buff.isGood();
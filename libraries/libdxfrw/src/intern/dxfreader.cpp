@@ -10,93 +10,215 @@
 **  along with this program.  If not, see <http://www.gnu.org/licenses/>.    **
 ******************************************************************************/
 
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
 #include <fstream>
+#include <locale>
 #include <string>
+#include <string_view>
 #include <sstream>
+#include <unordered_map>
 #include "dxfreader.h"
 #include "drw_textcodec.h"
 #include "drw_dbg.h"
 
+namespace {
+
+/** how the value of a group code is read */
+enum class ValueKind : unsigned char {
+    String,
+    Name,     //string of a 0 group, interned
+    Comment,  //999, skipped when comments are ignored
+    Double,
+    Int16,
+    Int32,
+    Int64,
+    Bool,
+    Binary
+};
+
+constexpr int LAST_KNOWN_CODE = 1071;
+
+constexpr ValueKind valueKindOf(int code) {
+    if (code == 0)
+        return ValueKind::Name;
+    if (code < 10)
+        return ValueKind::String;
+    if (code < 60)
+        return ValueKind::Double;
+    if (code < 80)
+        return ValueKind::Int16;
+    if (code > 89 && code < 100) //TODO this is an int 32b
+        return ValueKind::Int32;
+    if (code == 100 || code == 102 || code == 105)
+        return ValueKind::String;
+    if (code > 109 && code < 150) //skip not used at the v2012
+        return ValueKind::Double;
+    if (code > 159 && code < 170) //skip not used at the v2012
+        return ValueKind::Int64;
+    if (code < 180)
+        return ValueKind::Int16;
+    if (code > 209 && code < 240) //skip not used at the v2012
+        return ValueKind::Double;
+    if (code > 269 && code < 290) //skip not used at the v2012
+        return ValueKind::Int16;
+    if (code < 300) //TODO this is a boolean indicator, int in Binary?
+        return ValueKind::Bool;
+    if (code < 310)
+        return ValueKind::String;
+    if (code < 320)
+        return ValueKind::Binary;
+    if (code < 370)
+        return ValueKind::String;
+    if (code < 390)
+        return ValueKind::Int16;
+    if (code < 400)
+        return ValueKind::String;
+    if (code < 410)
+        return ValueKind::Int16;
+    if (code < 420)
+        return ValueKind::String;
+    if (code < 430) //TODO this is an int 32b
+        return ValueKind::Int32;
+    if (code < 440)
+        return ValueKind::String;
+    if (code < 450) //TODO this is an int 32b
+        return ValueKind::Int32;
+    if (code < 460) //TODO this is long??
+        return ValueKind::Int32;
+    if (code < 470) //TODO this is a floating point double precision??
+        return ValueKind::Double;
+    if (code < 481)
+        return ValueKind::String;
+    if (code == 999)
+        return ValueKind::Comment;
+    if (code == 1004)
+        return ValueKind::Binary;
+    if (code > 998 && code < 1009) //skip not used at the v2012
+        return ValueKind::String;
+    if (code < 1060) //TODO this is a floating point double precision??
+        return ValueKind::Double;
+    if (code < 1071)
+        return ValueKind::Int16;
+    return ValueKind::Int32; //1071, TODO this is an int 32b
+}
+
+struct ValueKindTable {
+    ValueKind kind[LAST_KNOWN_CODE + 1];
+};
+
+constexpr ValueKindTable makeValueKindTable() {
+    ValueKindTable t{};
+    for (int code = 0; code <= LAST_KNOWN_CODE; ++code)
+        t.kind[code] = valueKindOf(code);
+    return t;
+}
+
+constexpr ValueKindTable valueKinds = makeValueKindTable();
+
+DRW_RecordName internRecordName(const std::string &name) {
+    static const std::unordered_map<std::string_view, DRW_RecordName> names {
+        {"SECTION", DRW_RecordName::Section},
+        {"ENDSEC", DRW_RecordName::EndSec},
+        {"EOF", DRW_RecordName::Eof},
+        {"TABLE", DRW_RecordName::Table},
+        {"ENDTAB", DRW_RecordName::EndTab},
+        {"BLOCK", DRW_RecordName::Block},
+        {"ENDBLK", DRW_RecordName::EndBlk},
+        {"VERTEX", DRW_RecordName::Vertex},
+        {"SEQEND", DRW_RecordName::SeqEnd},
+        {"LINE", DRW_RecordName::Line},
+        {"CIRCLE", DRW_RecordName::Circle},
+        {"ARC", DRW_RecordName::Arc},
+        {"POINT", DRW_RecordName::Point},
+        {"LWPOLYLINE", DRW_RecordName::LWPolyline},
+        {"POLYLINE", DRW_RecordName::Polyline},
+        {"TEXT", DRW_RecordName::Text},
+        {"MTEXT", DRW_RecordName::MText},
+        {"HATCH", DRW_RecordName::Hatch},
+        {"DIMENSION", DRW_RecordName::Dimension},
+        {"INSERT", DRW_RecordName::Insert},
+        {"TOLERANCE", DRW_RecordName::Tolerance},
+        {"SOLID", DRW_RecordName::Solid},
+        {"SPLINE", DRW_RecordName::Spline},
+        {"LEADER", DRW_RecordName::Leader},
+        {"ELLIPSE", DRW_RecordName::Ellipse},
+        {"VIEWPORT", DRW_RecordName::Viewport},
+        {"IMAGE", DRW_RecordName::Image},
+        {"TRACE", DRW_RecordName::Trace},
+        {"3DFACE", DRW_RecordName::Face3D},
+        {"RAY", DRW_RecordName::Ray},
+        {"XLINE", DRW_RecordName::Xline},
+        {"ARC_DIMENSION", DRW_RecordName::ArcDimension},
+        {"IMAGEDEF", DRW_RecordName::ImageDef},
+        {"PLOTSETTINGS", DRW_RecordName::PlotSettings},
+    };
+    auto it = names.find(name);
+    return it == names.end() ? DRW_RecordName::Unknown : it->second;
+}
+
+} // namespace
+
 bool dxfReader::readRec(int *codeData) {
-//    std::string text;
-    int code;
+    int code = lastCode; //binary readCode needs the previous code
 
     if (!readCode(&code))
         return false;
-    *codeData = code;
+    *codeData = lastCode = code;
 
-    if (code < 10)
+    ValueKind kind;
+    if (code >= 0 && code <= LAST_KNOWN_CODE)
+        kind = valueKinds.kind[code];
+    else if (code < 0 || skip)
+        //skip safely this dxf entry ( ok for ascii dxf)
+        kind = ValueKind::String;
+    else
+        //break in binary files because the conduct is unpredictable
+        return false;
+
+    switch (kind) {
+    case ValueKind::Name:
         readString();
-    else if (code < 60)
+        recordName = internRecordName(strData);
+        break;
+    case ValueKind::Comment:
+        readString();
+        if (m_bIgnoreComments)
+            return readRec(codeData);
+        break;
+    case ValueKind::String:
+        readString();
+        break;
+    case ValueKind::Double:
         readDouble();
-    else if (code < 80)
+        break;
+    case ValueKind::Int16:
         readInt16();
-    else if (code > 89 && code < 100) //TODO this is an int 32b
+        break;
+    case ValueKind::Int32:
         readInt32();
-    else if (code == 100 || code == 102 || code == 105)
-        readString();
-    else if (code > 109 && code < 150) //skip not used at the v2012
-        readDouble();
-    else if (code > 159 && code < 170) //skip not used at the v2012
+        break;
+    case ValueKind::Int64:
         readInt64();
-    else if (code < 180)
-        readInt16();
-    else if (code > 209 && code < 240) //skip not used at the v2012
-        readDouble();
-    else if (code > 269 && code < 290) //skip not used at the v2012
-        readInt16();
-    else if (code < 300) //TODO this is a boolean indicator, int in Binary?
+        break;
+    case ValueKind::Bool:
         readBool();
-    else if (code < 310)
-        readString();
-    else if (code < 320)
+        break;
+    case ValueKind::Binary:
         readBinary();
-    else if (code < 370)
-        readString();
-    else if (code < 390)
-        readInt16();
-    else if (code < 400)
-        readString();
-    else if (code < 410)
-        readInt16();
-    else if (code < 420)
-        readString();
-    else if (code < 430) //TODO this is an int 32b
-        readInt32();
-    else if (code < 440)
-        readString();
-    else if (code < 450) //TODO this is an int 32b
-        readInt32();
-    else if (code < 460) //TODO this is long??
-        readInt32();
-    else if (code < 470) //TODO this is a floating point double precision??
-        readDouble();
-    else if (code < 481)
-        readString();
-    else if( 999 == code && m_bIgnoreComments) {
-        readString();
-        return readRec( codeData);
+        break;
     }
-    else if (code == 1004)
-        readBinary();
-    else if (code > 998 && code < 1009) //skip not used at the v2012
-        readString();
-    else if (code < 1060) //TODO this is a floating point double precision??
-        readDouble();
-    else if (code < 1071)
-        readInt16();
-    else if (code == 1071) //TODO this is an int 32b
-        readInt32();
-    else if (skip)
-        //skip safely this dxf entry ( ok for ascii dxf)
-        readString();
-    else
-        //break in binary files because the conduct is unpredictable
-        return false;
 
-    return (filestr->good());
+    return good();
 }
+
+bool dxfReader::good() const {
+    return filestr->good();
+}
+
 int dxfReader::getHandleId(){
     int res;
 #if defined(__APPLE__)
@@ -158,7 +280,7 @@ bool dxfReaderBinary::readInt16() {
     type = INT32;
     char buffer[2];
     filestr->read(buffer,2);
-    intData = (int)((buffer[1] << 8) | buffer[0]);
+    intData = static_cast<int16_t>(static_cast<unsigned char>(buffer[0]) | (static_cast<unsigned char>(buffer[1]) << 8));
     DRW_DBG(intData); DRW_DBG("\n");
     return (filestr->good());
 }
@@ -205,84 +327,401 @@ bool dxfReaderBinary::readBool() {
     return (filestr->good());
 }
 
-bool dxfReaderAscii::readCode(int *code) {
-    std::string text;
-    std::getline(*filestr, text);
-    *code = atoi(text.c_str());
+namespace {
+
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+}
+
+/** atoi() semantics over a [p, e) range */
+int parseInt(const char *p, const char *e) {
+    while (p < e && isSpace(*p))
+        ++p;
+    bool neg = false;
+    if (p < e && (*p == '-' || *p == '+'))
+        neg = (*p++ == '-');
+    long long val = 0;
+    while (p < e && *p >= '0' && *p <= '9')
+        val = val * 10 + (*p++ - '0');
+    return static_cast<int>(neg ? -val : val);
+}
+
+/**
+ * istream >> double semantics over a [p, e) range, always in "C" locale.
+ * Like the stream, a blank range leaves the previous value untouched.
+ */
+double parseDoubleSlow(const char *p, const char *e, double prev) {
+    std::istringstream sd(std::string(p, e));
+    sd.imbue(std::locale::classic());
+    double d = prev;
+    sd >> d;
+    return d;
+}
+
+/**
+ * Locale independent decimal parser.
+ * Plain decimals with up to 19 significant digits and a small exponent take
+ * the exact fast path (the mantissa fits a double and the power of ten is
+ * exact), everything else goes through the stream conversion.
+ */
+double parseDouble(const char *p, const char *e, double prev) {
+    static const double pow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+        1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19,
+        1e20, 1e21, 1e22};
+    const char *start = p;
+    while (p < e && isSpace(*p))
+        ++p;
+    bool neg = false;
+    if (p < e && (*p == '-' || *p == '+'))
+        neg = (*p++ == '-');
+    uint64_t mant = 0;
+    int digits = 0;
+    int exp10 = 0;
+    bool any = false;
+    while (p < e && *p >= '0' && *p <= '9') {
+        any = true;
+        if (mant != 0 || *p != '0')
+            ++digits;
+        if (digits > 19)
+            return parseDoubleSlow(start, e, prev);
+        mant = mant * 10 + static_cast<uint64_t>(*p++ - '0');
+    }
+    if (p < e && *p == '.') {
+        ++p;
+        while (p < e && *p >= '0' && *p <= '9') {
+            any = true;
+            if (mant != 0 || *p != '0')
+                ++digits;
+            if (digits > 19)
+                return parseDoubleSlow(start, e, prev);
+            mant = mant * 10 + static_cast<uint64_t>(*p++ - '0');
+            --exp10;
+        }
+    }
+    if (!any)
+        return parseDoubleSlow(start, e, prev);
+    if (p < e && (*p == 'e' || *p == 'E')) {
+        const char *q = p + 1;
+        bool eneg = false;
+        if (q < e && (*q == '-' || *q == '+'))
+            eneg = (*q++ == '-');
+        if (q < e && *q >= '0' && *q <= '9') {
+            int ev = 0;
+            while (q < e && *q >= '0' && *q <= '9') {
+                if (ev < 10000)
+                    ev = ev * 10 + (*q - '0');
+                ++q;
+            }
+            exp10 += eneg ? -ev : ev;
+            p = q;
+        }
+    }
+    if (p < e && !isSpace(*p))
+        return parseDoubleSlow(start, e, prev); //hex, inf, nan or trailing junk
+    if (mant == 0)
+        return neg ? -0.0 : 0.0;
+    if (mant > (uint64_t(1) << 53) || exp10 < -22 || exp10 > 22)
+        return parseDoubleSlow(start, e, prev);
+    double d = static_cast<double>(mant);
+    d = exp10 < 0 ? d / pow10[-exp10] : d * pow10[exp10];
+    return neg ? -d : d;
+}
+
+} // namespace
+
+/**
+ * Same contract as std::getline: a line ended by EOF instead of a newline
+ * is returned but leaves the reader in the not-good state.
+ */
+bool dxfReaderAsciiMem::nextLine(const char **line, size_t *len) {
+    if (pos >= end && tail) {
+        pos = tail;
+        end = tail + strlen(tail);
+        tail = nullptr;
+    }
+    const char *nl = pos < end ? static_cast<const char*>(memchr(pos, '\n', static_cast<size_t>(end - pos)))
+                               : nullptr;
+    while (nl == nullptr && source && refill())
+        nl = static_cast<const char*>(memchr(pos, '\n', static_cast<size_t>(end - pos)));
+    if (pos >= end) {
+        isGood = false;
+        *line = end;
+        *len = 0;
+        return false;
+    }
+    *line = pos;
+    if (nl) {
+        *len = static_cast<size_t>(nl - pos);
+        pos = nl + 1;
+    } else {
+        *len = static_cast<size_t>(end - pos);
+        pos = end;
+        isGood = false;
+    }
+    return isGood;
+}
+
+/** keeps the unread bytes and appends the next chunk of the source */
+bool dxfReaderAsciiMem::refill() {
+    const size_t chunk = 1 << 16;
+    size_t left = static_cast<size_t>(end - pos);
+    if (buffer.size() < left + chunk) {
+        //lines longer than a chunk grow the buffer
+        std::vector<char> grown(left + chunk);
+        if (left > 0)
+            memcpy(grown.data(), pos, left);
+        buffer.swap(grown);
+    } else if (left > 0 && pos != buffer.data()) {
+        memmove(buffer.data(), pos, left);
+    }
+    std::streamsize got = source->sgetn(buffer.data() + left, static_cast<std::streamsize>(buffer.size() - left));
+    pos = buffer.data();
+    end = pos + left + static_cast<size_t>(std::max<std::streamsize>(got, 0));
+    return got > 0;
+}
+
+bool dxfReaderAsciiMem::readCode(int *code) {
+    const char *line;
+    size_t len;
+    nextLine(&line, &len);
+    *code = parseInt(line, line + len);
     DRW_DBG(*code); DRW_DBG("\n");
-    return (filestr->good());
+    return isGood;
 }
-bool dxfReaderAscii::readString(std::string *text) {
+
+bool dxfReaderAsciiMem::readString(std::string *text) {
     type = STRING;
-    std::getline(*filestr, *text);
-    if (!text->empty() && text->at(text->size()-1) == '\r')
-        text->erase(text->size()-1);
-    return (filestr->good());
+    const char *line;
+    size_t len;
+    nextLine(&line, &len);
+    if (len > 0 && line[len - 1] == '\r')
+        --len;
+    text->assign(line, len);
+    return isGood;
 }
 
-bool dxfReaderAscii::readString() {
-    type = STRING;
-    std::getline(*filestr, strData);
-    if (!strData.empty() && strData.at(strData.size()-1) == '\r')
-        strData.erase(strData.size()-1);
+bool dxfReaderAsciiMem::readString() {
+    bool ok = readString(&strData);
     DRW_DBG(strData); DRW_DBG("\n");
-    return (filestr->good());
+    return ok;
 }
 
-bool dxfReaderAscii::readBinary() {
+bool dxfReaderAsciiMem::readBinary() {
     return readString();
 }
 
-bool dxfReaderAscii::readInt16() {
+bool dxfReaderAsciiMem::readInt16() {
     type = INT32;
-    std::string text;
-    if (readString(&text)){
-        intData = atoi(text.c_str());
+    const char *line;
+    size_t len;
+    if (nextLine(&line, &len)) {
+        intData = parseInt(line, line + len);
         DRW_DBG(intData); DRW_DBG("\n");
         return true;
     } else
         return false;
 }
 
-bool dxfReaderAscii::readInt32() {
+bool dxfReaderAsciiMem::readInt32() {
     type = INT32;
     return readInt16();
 }
 
-bool dxfReaderAscii::readInt64() {
+bool dxfReaderAsciiMem::readInt64() {
     type = INT64;
     return readInt16();
 }
 
-bool dxfReaderAscii::readDouble() {
+bool dxfReaderAsciiMem::readDouble() {
     type = DOUBLE;
-    std::string text;
-    if (readString(&text)){
-#if defined(__APPLE__)
-        int succeeded=sscanf( & (text[0]), "%lg", &doubleData);
-        if(succeeded != 1) {
-            DRW_DBG("dxfReaderAscii::readDouble(): reading double error: ");
-            DRW_DBG(text);
-            DRW_DBG('\n');
-        }
-#else
-        std::istringstream sd(text);
-        sd >> doubleData;
+    const char *line;
+    size_t len;
+    if (nextLine(&line, &len)) {
+        doubleData = parseDouble(line, line + len, doubleData);
         DRW_DBG(doubleData); DRW_DBG('\n');
-#endif
         return true;
     } else
         return false;
 }
 
-//saved as int or add a bool member??
-bool dxfReaderAscii::readBool() {
+bool dxfReaderAsciiMem::readBool() {
     type = BOOL;
-    std::string text;
-    if (readString(&text)){
-        intData = atoi(text.c_str());
+    const char *line;
+    size_t len;
+    if (nextLine(&line, &len)) {
+        intData = parseInt(line, line + len);
         DRW_DBG(intData); DRW_DBG("\n");
         return true;
     } else
         return false;
 }
+
+bool dxfReaderAsciiMem::readRaw(int *code, std::string_view *value) {
+    const char *line;
+    size_t len;
+    nextLine(&line, &len);
+    *code = parseInt(line, line + len);
+    nextLine(&line, &len);
+    if (len > 0 && line[len - 1] == '\r')
+        --len;
+    *value = std::string_view(line, len);
+    return isGood;
+}
+
+int dxfReaderAsciiMem::rawInt(std::string_view value) {
+    return parseInt(value.data(), value.data() + value.size());
+}
+
+double dxfReaderAsciiMem::rawDouble(std::string_view value) {
+    return parseDouble(value.data(), value.data() + value.size(), std::nan(""));
+}
+
+bool dxfReaderAsciiMem::scanEntities(std::vector<const char*> *starts, const char **sectionEnd) const {
+    if (source)
+        return false; //only the current chunk is in memory
+    const char *p = pos;
+    while (p < end) {
+        const char *rec = p;
+        const char *nl = static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!nl)
+            return false;
+        int code = parseInt(p, nl);
+        p = nl + 1;
+        nl = static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!nl)
+            return false;
+        std::string_view value(p, static_cast<size_t>(nl - p));
+        if (!value.empty() && value.back() == '\r')
+            value.remove_suffix(1);
+        p = nl + 1;
+        if (code != 0) {
+            if (starts->empty())
+                return false; //first record in entities must be 0
+            continue;
+        }
+        if (value == "ENDSEC" || value == "ENDBLK") {
+            *sectionEnd = rec;
+            return true;
+        }
+        if (value != "VERTEX" && value != "SEQEND")
+            starts->push_back(rec);
+    }
+    return false;
+}
+
+namespace {
+
+template <typename T>
+T loadLE(const char *p) {
+    T value;
+    memcpy(&value, p, sizeof(T)); //binary dxf is little endian, as the hosts we run on
+    return value;
+}
+
+} // namespace
+
+const char *dxfReaderBinaryMem::take(size_t n) {
+    if (static_cast<size_t>(end - pos) < n) {
+        pos = end;
+        isGood = false;
+        return nullptr;
+    }
+    const char *p = pos;
+    pos += n;
+    return p;
+}
+
+bool dxfReaderBinaryMem::readCode(int *code) {
+    const char *p = take(2);
+    if (!p)
+        return false;
+    unsigned value = loadLE<uint16_t>(p);
+    //some writers store the 32 bits code 90 in 16 bits, then the last two
+    //bytes read as its value are the real code and this is its value
+    if (*code == 90 && value > 2000) {
+        DRW_DBG(*code); DRW_DBG(" de 16bits\n");
+        value = loadLE<uint16_t>(p - 2);
+        pos = p;
+    }
+    *code = static_cast<int>(value);
+    DRW_DBG(*code); DRW_DBG("\n");
+    return true;
+}
+
+bool dxfReaderBinaryMem::readString(std::string *text) {
+    type = STRING;
+    const char *nul = static_cast<const char*>(memchr(pos, '\0', static_cast<size_t>(end - pos)));
+    if (!nul) { //same as getline: the rest is returned, but not good
+        text->assign(pos, static_cast<size_t>(end - pos));
+        pos = end;
+        isGood = false;
+        return false;
+    }
+    text->assign(pos, static_cast<size_t>(nul - pos));
+    pos = nul + 1;
+    return true;
+}
+
+bool dxfReaderBinaryMem::readString() {
+    bool ok = readString(&strData);
+    DRW_DBG(strData); DRW_DBG("\n");
+    return ok;
+}
+
+bool dxfReaderBinaryMem::readBinary() {
+    const char *p = take(1);
+    if (!p)
+        return false;
+    size_t chunklen = static_cast<unsigned char>(*p);
+    DRW_DBG(chunklen); DRW_DBG(" byte(s) binary data bypassed\n");
+    return take(chunklen) != nullptr;
+}
+
+bool dxfReaderBinaryMem::readInt16() {
+    type = INT32;
+    const char *p = take(2);
+    if (!p)
+        return false;
+    intData = loadLE<int16_t>(p);
+    DRW_DBG(intData); DRW_DBG("\n");
+    return true;
+}
+
+bool dxfReaderBinaryMem::readInt32() {
+    type = INT32;
+    const char *p = take(4);
+    if (!p)
+        return false;
+    intData = loadLE<int32_t>(p);
+    DRW_DBG(intData); DRW_DBG("\n");
+    return true;
+}
+
+bool dxfReaderBinaryMem::readInt64() {
+    type = INT64;
+    const char *p = take(8);
+    if (!p)
+        return false;
+    int64 = loadLE<uint64_t>(p);
+    DRW_DBG(int64); DRW_DBG(" int64\n");
+    return true;
+}
+
+bool dxfReaderBinaryMem::readDouble() {
+    type = DOUBLE;
+    const char *p = take(8);
+    if (!p)
+        return false;
+    doubleData = loadLE<double>(p);
+    DRW_DBG(doubleData); DRW_DBG("\n");
+    return true;
+}
+
+bool dxfReaderBinaryMem::readBool() {
+    const char *p = take(1);
+    if (!p)
+        return false;
+    intData = static_cast<signed char>(*p);
+    DRW_DBG(intData); DRW_DBG("\n");
+    return true;
+}
@@ -13,8 +13,26 @@
 #ifndef DXFREADER_H
 #define DXFREADER_H
 
+#include <streambuf>
+#include <string_view>
+#include <utility>
+#include <vector>
 #include "drw_textcodec.h"
 
+/**
+ * Names of the 0 group records (sections, tables, entities and objects).
+ * dxfReader interns them while reading, so dxfRW can dispatch on a small
+ * integer instead of comparing strings.
+ */
+enum class DRW_RecordName : unsigned char {
+    Unknown,
+    Section, EndSec, Eof, Table, EndTab, Block, EndBlk, Vertex, SeqEnd,
+    Line, Circle, Arc, Point, LWPolyline, Polyline, Text, MText, Hatch,
+    Dimension, Insert, Tolerance, Solid, Spline, Leader, Ellipse, Viewport,
+    Image, Trace, Face3D, Ray, Xline, ArcDimension,
+    ImageDef, PlotSettings
+};
+
 class dxfReader {
 public:
     enum TYPE {
@@ -35,8 +53,10 @@ public:
     bool readRec(int *code);
 
     std::string getString() {return strData;}
+    /** interned name of the last 0 group record */
+    DRW_RecordName getRecordName() const {return recordName;}
     int getHandleId();//Convert hex string to int
-    std::string toUtf8String(std::string t) {return decoder.toUtf8(t);}
+    std::string toUtf8String(std::string t) {return decoder.toUtf8(std::move(t));}
     std::string getUtf8String() {return decoder.toUtf8(strData);}
     double getDouble() {return doubleData;}
     int getInt32() {return intData;}
@@ -47,6 +67,17 @@ public:
     void setCodePage(const std::string &c){decoder.setCodePage(c, true);}
     std::string getCodePage(){ return decoder.getCodePage();}
     void setIgnoreComments(const bool bValue) {m_bIgnoreComments = bValue;}
+    /** intern layer and line type names of entities into t, nullptr to stop */
+    void setNameTable(DRW_NameTable *t) {nameTable = t;}
+    DRW_NameTable *getNameTable() const {return nameTable;}
+    /** allocate XDATA items of entities from a, nullptr for the heap */
+    void setVariantArena(DRW_VariantArena *a) {variantArena = a;}
+    DRW_VariantArena *getVariantArena() const {return variantArena;}
+    /** use the text codec and comment handling of another reader */
+    void copySettings(const dxfReader &other) {
+        decoder = other.decoder;
+        m_bIgnoreComments = other.m_bIgnoreComments;
+    }
 
 protected:
     virtual bool readCode(int *code) = 0; //return true if successful (not EOF)
@@ -58,6 +89,7 @@ protected:
     virtual bool readInt64() = 0;
     virtual bool readDouble() = 0;
     virtual bool readBool() = 0;
+    virtual bool good() const;
 
 protected:
     std::istream *filestr;
@@ -67,7 +99,11 @@ protected:
     unsigned long long int int64; //64 bits integer
     bool skip; //set to true for ascii dxf, false for binary
 private:
+    DRW_RecordName recordName {DRW_RecordName::Unknown};
+    int lastCode {0};
     DRW_TextCodec decoder;
+    DRW_NameTable *nameTable = nullptr;
+    DRW_VariantArena *variantArena = nullptr;
     bool m_bIgnoreComments {false};
 };
 
@@ -85,9 +121,27 @@ public:
     bool readBool() override;
 };
 
-class dxfReaderAscii : public dxfReader {
+/**
+ * ASCII reader working in place over a memory block, usually a mapped file.
+ * Lines are located with memchr and numbers are parsed straight from the
+ * block, so no temporary strings or streams are created per record.
+ * The block must stay valid while the reader is in use.
+ */
+class dxfReaderAsciiMem : public dxfReader {
 public:
-    dxfReaderAscii(std::istream *stream):dxfReader(stream){skip = true; }
+    /**
+     * If a trailer is given it is read after the block, so a slice of a
+     * section can be parsed as if it were terminated.
+     */
+    dxfReaderAsciiMem(const char *data, size_t size, const char *trailer = nullptr):dxfReader(nullptr),
+        pos(data), end(data + size), tail(trailer){skip = true; }
+    /**
+     * Reads the block and then the lines of a stream buffer, one chunk at a
+     * time, so only the current chunk is in memory. Used for pipes and
+     * compressed files, whose first bytes were read to sniff the format.
+     */
+    dxfReaderAsciiMem(const char *data, size_t size, std::streambuf *source):dxfReader(nullptr),
+        pos(data), end(data + size), tail(nullptr), source(source){skip = true; }
     bool readCode(int *code) override;
     bool readString(std::string *text) override;
     bool readString() override;
@@ -97,6 +151,70 @@ public:
     bool readInt32() override;
     bool readInt64() override;
     bool readBool() override;
+    bool good() const override {return isGood;}
+
+    /**
+     * Reads a group without converting its value, for scans interested in
+     * a few codes only. @value points into the block, without the trailing
+     * '\r', and comments are not skipped.
+     */
+    bool readRaw(int *code, std::string_view *value);
+    /** integer of a raw value, as readInt32() converts it */
+    static int rawInt(std::string_view value);
+    /** double of a raw value as readDouble() converts it, NaN if blank */
+    static double rawDouble(std::string_view value);
+
+    const char *position() const {return pos;}
+    void seek(const char *p) {pos = p;}
+    /**
+     * Scans the rest of an ENTITIES section without consuming it.
+     * Stores in @starts the 0 records where a top level entity begins
+     * (VERTEX and SEQEND belong to the previous POLYLINE) and in @sectionEnd
+     * the ENDSEC (or ENDBLK) record. Returns false if the section does not
+     * begin with a 0 record or is not terminated, and for stream buffers.
+     */
+    bool scanEntities(std::vector<const char*> *starts, const char **sectionEnd) const;
+
+private:
+    bool nextLine(const char **line, size_t *len);
+    bool refill();
+
+    const char *pos;
+    const char *end;
+    const char *tail;
+    std::streambuf *source {nullptr};
+    std::vector<char> buffer;
+    bool isGood {true};
+};
+
+/**
+ * Binary reader working over a memory block, usually a mapped file
+ * without its sentinel. Values are loaded straight from the block as
+ * little endian, strings are located with memchr. The block must stay
+ * valid while the reader is in use.
+ */
+class dxfReaderBinaryMem : public dxfReader {
+public:
+    dxfReaderBinaryMem(const char *data, size_t size):dxfReader(nullptr),
+        pos(data), end(data + size){skip = false; }
+    bool readCode(int *code) override;
+    bool readString(std::string *text) override;
+    bool readString() override;
+    bool readBinary() override;
+    bool readInt16() override;
+    bool readInt32() override;
+    bool readInt64() override;
+    bool readDouble() override;
+    bool readBool() override;
+    bool good() const override {return isGood;}
+
+private:
+    /** the next @n bytes, nullptr past the end of the block */
+    const char *take(size_t n);
+
+    const char *pos;
+    const char *end;
+    bool isGood {true};
 };
 
 #endif // DXFREADER_H
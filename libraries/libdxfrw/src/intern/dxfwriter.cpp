@@ -11,9 +11,11 @@
 ******************************************************************************/
 
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <string>
 #include <algorithm>
+#include <utility>
 #include "dxfwriter.h"
 
 //RLZ TODO change std::endl to x0D x0A (13 10)
@@ -91,24 +93,50 @@
     return (filestr->good());
 }*/
 
+bool dxfWriter::flush() {
+    return (filestr->good());
+}
+
 bool dxfWriter::writeUtf8String(int code, std::string text) {
-    std::string t = encoder.fromUtf8(text);
-    return writeString(code, t);
+    return writeString(code, encoder.fromUtf8(std::move(text)));
 }
 
 bool dxfWriter::writeUtf8Caps(int code, std::string text) {
-    std::string strname = text;
-    std::transform(strname.begin(), strname.end(), strname.begin(),::toupper);
-    std::string t = encoder.fromUtf8(strname);
-    return writeString(code, t);
+    std::transform(text.begin(), text.end(), text.begin(),::toupper);
+    return writeString(code, encoder.fromUtf8(std::move(text)));
+}
+
+dxfWriterBinary::dxfWriterBinary(std::ostream *stream):dxfWriter(stream){
+    block.reserve(BLOCK_SIZE);
+}
+
+dxfWriterBinary::~dxfWriterBinary() {
+    flush();
+}
+
+char *dxfWriterBinary::group(int code, size_t valueSize) {
+    if (block.size() + 2 + valueSize > BLOCK_SIZE)
+        flush();
+    size_t pos = block.size();
+    block.resize(pos + 2 + valueSize);
+    char *buffer = &block[pos];
+    buffer[0] =code & 0xFF;
+    buffer[1] =code  >> 8;
+    return buffer + 2;
+}
+
+bool dxfWriterBinary::flush() {
+    if (!block.empty()) {
+        filestr->write(block.data(), block.size());
+        block.clear();
+    }
+    return (filestr->good());
 }
 
 bool dxfWriterBinary::writeString(int code, std::string text) {
-    char bufcode[2];
-    bufcode[0] =code & 0xFF;
-    bufcode[1] =code  >> 8;
-    filestr->write(bufcode, 2);
-    *filestr << text << '\0';
+    char *buffer = group(code, text.size() + 1);
+    memcpy(buffer, text.data(), text.size());
+    buffer[text.size()] = '\0';
     return (filestr->good());
 }
 
@@ -143,37 +171,26 @@ bool dxfWriterBinary::writeString(int code, std::string text) {
 }*/
 
 bool dxfWriterBinary::writeInt16(int code, int data) {
-    char bufcode[2];
-    char buffer[2];
-    bufcode[0] =code & 0xFF;
-    bufcode[1] =code  >> 8;
+    //290-299 are boolean groups, a single byte in binary files
+    if (code >= 290 && code < 300)
+        return writeBool(code, data != 0);
+    char *buffer = group(code, 2);
     buffer[0] =data & 0xFF;
     buffer[1] =data  >> 8;
-    filestr->write(bufcode, 2);
-    filestr->write(buffer, 2);
     return (filestr->good());
 }
 
 bool dxfWriterBinary::writeInt32(int code, int data) {
-    char buffer[4];
-    buffer[0] =code & 0xFF;
-    buffer[1] =code  >> 8;
-    filestr->write(buffer, 2);
-
+    char *buffer = group(code, 4);
     buffer[0] =data & 0xFF;
     buffer[1] =data  >> 8;
     buffer[2] =data  >> 16;
     buffer[3] =data  >> 24;
-    filestr->write(buffer, 4);
     return (filestr->good());
 }
 
 bool dxfWriterBinary::writeInt64(int code, unsigned long long int data) {
-    char buffer[8];
-    buffer[0] =code & 0xFF;
-    buffer[1] =code  >> 8;
-    filestr->write(buffer, 2);
-
+    char *buffer = group(code, 8);
     buffer[0] =data & 0xFF;
     buffer[1] =data  >> 8;
     buffer[2] =data  >> 16;
@@ -182,39 +199,23 @@ bool dxfWriterBinary::writeInt64(int code, unsigned long long int data) {
     buffer[5] =data  >> 40;
     buffer[6] =data  >> 48;
     buffer[7] =data  >> 56;
-    filestr->write(buffer, 8);
     return (filestr->good());
 }
 
 bool dxfWriterBinary::writeDouble(int code, double data) {
-    char bufcode[2];
-    char buffer[8];
-    bufcode[0] =code & 0xFF;
-    bufcode[1] =code  >> 8;
-    filestr->write(bufcode, 2);
-
-    unsigned char *val;
-    val = (unsigned char *) &data;
-    for (int i=0; i<8; i++) {
-        buffer[i] =val[i];
-    }
-    filestr->write(buffer, 8);
+    char *buffer = group(code, 8);
+    memcpy(buffer, &data, 8);
     return (filestr->good());
 }
 
 //saved as int or add a bool member??
 bool dxfWriterBinary::writeBool(int code, bool data) {
-    char buffer[1];
-    char bufcode[2];
-    bufcode[0] =code & 0xFF;
-    bufcode[1] =code  >> 8;
-    filestr->write(bufcode, 2);
+    char *buffer = group(code, 1);
     buffer[0] = data;
-    filestr->write(buffer, 1);
     return (filestr->good());
 }
 
-dxfWriterAscii::dxfWriterAscii(std::ofstream *stream):dxfWriter(stream){
+dxfWriterAscii::dxfWriterAscii(std::ostream *stream):dxfWriter(stream){
     filestr->precision(16);
 }
 
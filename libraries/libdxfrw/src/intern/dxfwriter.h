@@ -17,7 +17,7 @@
 
 class dxfWriter {
 public:
-    dxfWriter(std::ofstream *stream){filestr = stream; /*count =0;*/}
+    dxfWriter(std::ostream *stream){filestr = stream; /*count =0;*/}
     virtual ~dxfWriter() = default;
     virtual bool writeString(int code, std::string text) = 0;
     bool writeUtf8String(int code, std::string text);
@@ -28,29 +28,45 @@ public:
     virtual bool writeInt64(int code, unsigned long long int data) = 0;
     virtual bool writeDouble(int code, double data) = 0;
     virtual bool writeBool(int code, bool data) = 0;
+    /** writes out data held back by the writer, if any */
+    virtual bool flush();
     void setVersion(const std::string &v, bool dxfFormat){encoder.setVersion(v, dxfFormat);}
     void setCodePage(const std::string &c){encoder.setCodePage(c, true);}
     std::string getCodePage(){return encoder.getCodePage();}
 protected:
-    std::ofstream *filestr = nullptr;
+    std::ostream *filestr = nullptr;
 private:
     DRW_TextCodec encoder;
 };
 
+/**
+ * Binary writer, groups are collected in a block of BLOCK_SIZE bytes and
+ * the stream is written once per block instead of once per field.
+ * flush() must be called before the stream is closed.
+ */
 class dxfWriterBinary : public dxfWriter {
 public:
-    dxfWriterBinary(std::ofstream *stream):dxfWriter(stream){}
+    dxfWriterBinary(std::ostream *stream);
+    ~dxfWriterBinary() override;
     bool writeString(int code, std::string text) override;
     bool writeInt16(int code, int data) override;
     bool writeInt32(int code, int data) override;
     bool writeInt64(int code, unsigned long long int data) override;
     bool writeDouble(int code, double data) override;
     bool writeBool(int code, bool data) override;
+    bool flush() override;
+
+private:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+    /** appends the little endian group code and reserves room for the value */
+    char *group(int code, size_t valueSize);
+
+    std::string block;
 };
 
 class dxfWriterAscii : public dxfWriter {
 public:
-    dxfWriterAscii(std::ofstream *stream);
+    dxfWriterAscii(std::ostream *stream);
     bool writeString(int code, std::string text) override;
     bool writeInt16(int code, int data) override;
     bool writeInt32(int code, int data) override;
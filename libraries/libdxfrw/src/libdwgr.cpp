@@ -96,12 +96,12 @@ bool dwgR::testReader(){
     DRW_DBG("\n dataBuf pos: ");DRW_DBG(dataBuf.getPosition());
     DRW_DBG("\n filebuf bitpos: ");DRW_DBG(fileBuf.getBitPos());
     DRW_DBG("\n dataBuf bitpos: ");DRW_DBG(dataBuf.getBitPos());
-    DRW_DBG("\n filebuf first byte : ");DRW_DBGH(fileBuf.getRawChar8());
-    DRW_DBG("\n dataBuf  first byte : ");DRW_DBGH(dataBuf.getRawChar8());
+    DRW_DBG("\n filebuf first byte : ");DRW_DBGHR(fileBuf.getRawChar8());
+    DRW_DBG("\n dataBuf  first byte : ");DRW_DBGHR(dataBuf.getRawChar8());
     fileBuf.setBitPos(4);
     dataBuf.setBitPos(4);
-    DRW_DBG("\n filebuf first byte : ");DRW_DBGH(fileBuf.getRawChar8());
-    DRW_DBG("\n dataBuf  first byte : ");DRW_DBGH(dataBuf.getRawChar8());
+    DRW_DBG("\n filebuf first byte : ");DRW_DBGHR(fileBuf.getRawChar8());
+    DRW_DBG("\n dataBuf  first byte : ");DRW_DBGHR(dataBuf.getRawChar8());
     DRW_DBG("\n filebuf pos: ");DRW_DBG(fileBuf.getPosition());
     DRW_DBG("\n dataBuf pos: ");DRW_DBG(dataBuf.getPosition());
     DRW_DBG("\n filebuf bitpos: ");DRW_DBG(fileBuf.getBitPos());
@@ -112,12 +112,12 @@ bool dwgR::testReader(){
     DRW_DBG("\n dataBuf pos: ");DRW_DBG(dataBuf.getPosition());
     DRW_DBG("\n filebuf bitpos: ");DRW_DBG(fileBuf.getBitPos());
     DRW_DBG("\n dataBuf bitpos: ");DRW_DBG(dataBuf.getBitPos());
-    DRW_DBG("\n filebuf first byte : ");DRW_DBGH(fileBuf.getRawChar8());
-    DRW_DBG("\n dataBuf  first byte : ");DRW_DBGH(dataBuf.getRawChar8());
+    DRW_DBG("\n filebuf first byte : ");DRW_DBGHR(fileBuf.getRawChar8());
+    DRW_DBG("\n dataBuf  first byte : ");DRW_DBGHR(dataBuf.getRawChar8());
     fileBuf.setBitPos(0);
     dataBuf.setBitPos(0);
-    DRW_DBG("\n filebuf first byte : ");DRW_DBGH(fileBuf.getRawChar8());
-    DRW_DBG("\n dataBuf  first byte : ");DRW_DBGH(dataBuf.getRawChar8());
+    DRW_DBG("\n filebuf first byte : ");DRW_DBGHR(fileBuf.getRawChar8());
+    DRW_DBG("\n dataBuf  first byte : ");DRW_DBGHR(dataBuf.getRawChar8());
     DRW_DBG("\n filebuf pos: ");DRW_DBG(fileBuf.getPosition());
     DRW_DBG("\n dataBuf pos: ");DRW_DBG(dataBuf.getPosition());
     DRW_DBG("\n filebuf bitpos: ");DRW_DBG(fileBuf.getBitPos());
@@ -251,8 +251,10 @@ bool dwgR::openFile(std::ifstream *filestr){
     if (!reader) {
         error = DRW::BAD_VERSION;
         filestr->close();
-    } else
+    } else {
+        reader->nameTable = nameTable;
         isOk = true;
+    }
 
     return isOk;
 }
@@ -287,7 +289,7 @@ bool dwgR::processDwg() {
         ret = ret2;
     }
 
-    iface->addHeader(&hdr);
+    iface->takeHeader(std::move(hdr));
 
     for (auto it=reader->ltypemap.begin(); it!=reader->ltypemap.end(); ++it) {
         DRW_LType *lt = it->second;
@@ -35,6 +35,8 @@ public:
     DRW::error getError(){return error;}
 bool testReader();
     void setDebug(DRW::DebugLevel lvl);
+    /** intern entity layer and line type names into names, see dxfRW::setNameTable */
+    void setNameTable(DRW_NameTable *names) {nameTable = names;}
 
 private:
     bool openFile(std::ifstream *filestr);
@@ -48,6 +50,7 @@ private:
     bool applyExt { false }; /*apply extrusion in entities to conv in 2D?*/
     std::string codePage;
     DRW_Interface *iface { nullptr };
+    DRW_NameTable *nameTable { nullptr };
     std::unique_ptr< dwgReader > reader;
 
 };
@@ -15,18 +15,67 @@
 #include "libdxfrw.h"
 #include <fstream>
 #include <algorithm>
+#include <atomic>
 #include <sstream>
 #include <cassert>
 #include <functional>
+#include <memory>
+#include <thread>
+#include <tuple>
 
 #include "intern/drw_textcodec.h"
 #include "intern/dxfreader.h"
 #include "intern/dxfwriter.h"
 #include "intern/drw_dbg.h"
+#include "intern/drw_mmap.h"
+#include "intern/drw_zstream.h"
 #include "intern/dwgutil.h"
 
 #define FIRSTHANDLE 48
 
+//! Entities parsed into the same object record after record, one per type
+/*!
+*  A slot is reset to the defaults of its type rather than constructed
+*  again, so its strings and lists keep their capacity. Entities of a batch
+*  give their XDATA and vertex buffers back here once the batch is
+*  delivered, for the next entities to fill.
+*/
+struct dxfRW::EntitySlots {
+    std::tuple<DRW_Point, DRW_Line, DRW_Ray, DRW_Xline, DRW_Circle, DRW_Arc, DRW_Ellipse,
+               DRW_Trace, DRW_Solid, DRW_3Dface, DRW_Viewport, DRW_Insert, DRW_LWPolyline,
+               DRW_Polyline, DRW_Tolerance, DRW_Text, DRW_MText, DRW_Hatch, DRW_Spline,
+               DRW_Image, DRW_Dimension, DRW_Leader> entities;
+    std::vector<std::vector<std::shared_ptr<DRW_Variant>>> extData;
+    std::vector<DRW_PackedList<DRW_Vertex2D>> vertices;
+
+    void adopt(DRW_Entity &e) {
+        if (!extData.empty()) {
+            e.extData.swap(extData.back());
+            extData.pop_back();
+        }
+    }
+    void adopt(DRW_LWPolyline &e) {
+        adopt(static_cast<DRW_Entity&>(e));
+        if (!vertices.empty()) {
+            std::swap(e.vertlist, vertices.back());
+            vertices.pop_back();
+        }
+    }
+    void recycle(DRW_Entity &e) {
+        if (e.extData.capacity() > 0) {
+            e.extData.clear();
+            extData.push_back(std::move(e.extData));
+        }
+    }
+    void recycle(DRW_LWPolyline &e) {
+        recycle(static_cast<DRW_Entity&>(e));
+        if (e.vertlist.capacity() > 0) {
+            e.vertlist.clear();
+            vertices.push_back(std::move(e.vertlist));
+        }
+    }
+};
+
 
 dxfRW::dxfRW(const char* name){
     DRW_DBGSL(DRW_dbg::Level::None);
@@ -35,7 +84,23 @@ dxfRW::dxfRW(const char* name){
     writer = nullptr;
     applyExt = false;
     elParts = 128; //parts number when convert ellipse to polyline
+    slots.reset(new EntitySlots);
+}
+dxfRW::dxfRW(const dxfRW &parent, dxfReader *chunkReader, DRW_Interface *out)
+    : version{parent.version}
+    , fileName{parent.fileName}
+    , binFile{parent.binFile}
+    , batchSize{parent.batchSize}
+    , slots{new EntitySlots}
+    , variantArena{DRW_VariantArena::create()}
+    , reader{chunkReader}
+    , iface{out}
+    , applyExt{parent.applyExt}
+    , elParts{parent.elParts}
+{
+    reader->setVariantArena(variantArena.get());
 }
+
 dxfRW::~dxfRW(){
     delete reader;
     delete writer;
@@ -60,15 +125,24 @@ void dxfRW::setDebug(DRW::DebugLevel lvl){
 #define ERR_BAD_CODE  return setError( DRW::BAD_CODE_PARSED);
 
 
+namespace {
+const char binarySentinel[] = "AutoCAD Binary DXF\r\n\x1a";
+const size_t writeBufferSize = 1 << 20;
+
+bool isBinaryDxf(const char *data, size_t size) {
+    return size >= 22 && memcmp(data, binarySentinel, 21) == 0;
+}
+} // namespace
+
 bool dxfRW::readAscii(DRW_Interface *interface_, bool ext, std::string& content) {
     if (nullptr == interface_) {
         ERR_UNKNOWN;
     }
     applyExt = ext;
-    std::istringstream filestr(content);
     iface = interface_;
 
-    reader = new dxfReaderAscii(&filestr);
+    binFile = false;
+    reader = new dxfReaderAsciiMem(content.data(), content.size());
     bool isOk {processDxf()};
     setVersion((DRW::Version) reader->getVersion());
     delete reader;
@@ -78,40 +152,113 @@ bool dxfRW::readAscii(DRW_Interface *interface_, bool ext, std::string& content)
 
 bool dxfRW::read(DRW_Interface *interface_, bool ext){
     drw_assert(fileName.empty() == false);
-    if (nullptr == interface_) {
-         ERR_UNKNOWN;
+    if (memoryMapped) {
+        DRW_MappedFile map;
+        if (!map.open(fileName)) {
+            return setError(DRW::BAD_OPEN);
+        }
+        DRW_DBG("dxfRW::read mapped file\n");
+        return read(interface_, ext, map.data(), map.size());
     }
-    applyExt = ext;
-    std::ifstream filestr;
+
+    std::filebuf filebuf;
     DRW_DBG("dxfRW::read 1def\n");
-    filestr.open (fileName.c_str(), std::ios_base::in | std::ios::binary);
-    if (!filestr.is_open() || !filestr.good()) {
+    if (!filebuf.open(fileName, std::ios_base::in | std::ios::binary)) {
         return setError(DRW::BAD_OPEN);
     }
+    return read(interface_, ext, &filebuf);
+}
 
-    char line[22];
-    char line2[22] = "AutoCAD Binary DXF\r\n";
-    line2[20] = (char)26;
-    line2[21] = '\0';
-    filestr.read (line, 22);
-    filestr.close();
+bool dxfRW::read(DRW_Interface *interface_, bool ext, const char *data, size_t size) {
+    if (nullptr == interface_) {
+        ERR_UNKNOWN;
+    }
+    applyExt = ext;
     iface = interface_;
-    DRW_DBG("dxfRW::read 2\n");
-    if (strncmp(line, line2, 21) == 0) {
-        filestr.open (fileName.c_str(), std::ios_base::in | std::ios::binary);
+
+    DRW_Compression compression = DRW_sniffCompression(data, size);
+    if (compression != DRW_Compression::None) {
+        if (!DRW_compressionSupported(compression)) {
+            DRW_DBG("dxfRW::read compression not supported by this build\n");
+            return setError(DRW::BAD_OPEN);
+        }
+        DRW_InflateBuf inflater(nullptr, compression, data, size);
+        return readInflated(&inflater);
+    }
+    if (isBinaryDxf(data, size)) {
+        DRW_DBG("dxfRW::read binary memory\n");
         binFile = true;
         //skip sentinel
-        filestr.seekg (22, std::ios::beg);
-        reader = new dxfReaderBinary(&filestr);
-        DRW_DBG("dxfRW::read binary file\n");
+        reader = new dxfReaderBinaryMem(data + 22, size - 22);
     } else {
+        DRW_DBG("dxfRW::read ascii memory\n");
         binFile = false;
-        filestr.open (fileName.c_str(), std::ios_base::in);
-        reader = new dxfReaderAscii(&filestr);
+        reader = new dxfReaderAsciiMem(data, size);
+    }
+    bool isOk {processDxf()};
+    setVersion((DRW::Version) reader->getVersion());
+    delete reader;
+    reader = nullptr;
+    return isOk;
+}
+
+bool dxfRW::read(DRW_Interface *interface_, bool ext, std::streambuf *source) {
+    if (nullptr == interface_ || nullptr == source) {
+        ERR_UNKNOWN;
     }
+    applyExt = ext;
+    iface = interface_;
 
+    //the first chunk tells ascii, binary and compressed files apart
+    std::vector<char> head(1 << 16);
+    head.resize(static_cast<size_t>(std::max<std::streamsize>(
+        source->sgetn(head.data(), static_cast<std::streamsize>(head.size())), 0)));
+    DRW_Compression compression = DRW_sniffCompression(head.data(), head.size());
+    if (compression != DRW_Compression::None) {
+        if (!DRW_compressionSupported(compression)) {
+            DRW_DBG("dxfRW::read compression not supported by this build\n");
+            return setError(DRW::BAD_OPEN);
+        }
+        DRW_InflateBuf inflater(source, compression, head.data(), head.size());
+        return readInflated(&inflater);
+    }
+    return readStream(source, head);
+}
+
+bool dxfRW::readInflated(DRW_InflateBuf *inflater) {
+    DRW_DBG("dxfRW::read compressed file\n");
+    std::vector<char> head(1 << 16);
+    head.resize(static_cast<size_t>(std::max<std::streamsize>(
+        inflater->sgetn(head.data(), static_cast<std::streamsize>(head.size())), 0)));
+    bool isOk = readStream(inflater, head);
+    if (!inflater->good()) {
+        DRW_DBG("dxfRW::read corrupt or truncated compressed data\n");
+        return setError(DRW::BAD_READ_SECTION);
+    }
+    return isOk;
+}
+
+bool dxfRW::readStream(std::streambuf *source, const std::vector<char> &head) {
+    std::string content;
+    if (isBinaryDxf(head.data(), head.size())) {
+        //binary files are loaded whole and read from memory
+        DRW_DBG("dxfRW::read binary stream\n");
+        binFile = true;
+        //skip sentinel
+        content.assign(head.data() + 22, head.size() - 22);
+        std::vector<char> chunk(1 << 16);
+        std::streamsize got;
+        while ((got = source->sgetn(chunk.data(), static_cast<std::streamsize>(chunk.size()))) > 0) {
+            content.append(chunk.data(), static_cast<size_t>(got));
+        }
+        reader = new dxfReaderBinaryMem(content.data(), content.size());
+    } else {
+        //ascii files are tokenized chunk by chunk
+        DRW_DBG("dxfRW::read ascii stream\n");
+        binFile = false;
+        reader = new dxfReaderAsciiMem(head.data(), head.size(), source);
+    }
     bool isOk {processDxf()};
-    filestr.close();
     setVersion((DRW::Version) reader->getVersion());
     delete reader;
     reader = nullptr;
@@ -120,19 +267,62 @@ bool dxfRW::read(DRW_Interface *interface_, bool ext){
 
 bool dxfRW::write(DRW_Interface *interface_, DRW::Version ver, bool bin){
     bool isOk = false;
-    std::ofstream filestr;
     setVersion(ver);
     binFile = bin;
     iface = interface_;
+    DRW_Compression compression = DRW_compressionFromName(fileName);
+    if (!DRW_compressionSupported(compression)) {
+        DRW_DBG("dxfRW::write compression not supported by this build\n");
+        return setError(DRW::BAD_OPEN);
+    }
+    //large buffer, most drawings are written with a few system calls
+    std::vector<char> fileBuffer(writeBufferSize);
+    std::filebuf filebuf;
+    filebuf.pubsetbuf(fileBuffer.data(), static_cast<std::streamsize>(fileBuffer.size()));
+    //compressed data must not go through newline translation
+    std::ios_base::openmode mode = std::ios_base::out | std::ios::trunc;
+    if (binFile || compression != DRW_Compression::None) {
+        mode |= std::ios::binary;
+    }
+    if (filebuf.open(fileName.c_str(), mode) == nullptr) {
+        DRW_DBG("dxfRW::write can not open file\n");
+        return setError(DRW::BAD_OPEN);
+    }
+    std::ostream filestr(&filebuf);
+    if (compression != DRW_Compression::None) {
+        DRW_DeflateBuf deflater(&filestr, compression);
+        std::ostream compressed(&deflater);
+        isOk = writeDxf(&compressed);
+        isOk = deflater.finish() && isOk;
+    } else {
+        isOk = writeDxf(&filestr);
+    }
+    filestr.flush();
+    isOk = isOk && filestr.good();
+    return filebuf.close() != nullptr && isOk;
+}
+
+bool dxfRW::write(DRW_Interface *interface_, DRW::Version ver, bool bin, std::streambuf *sink){
+    if (nullptr == sink) {
+        return setError(DRW::BAD_OPEN);
+    }
+    setVersion(ver);
+    binFile = bin;
+    iface = interface_;
+    std::ostream out(sink);
+    bool isOk = writeDxf(&out);
+    out.flush();
+    return isOk && out.good();
+}
+
+bool dxfRW::writeDxf(std::ostream *out){
     if (binFile) {
-        filestr.open (fileName.c_str(), std::ios_base::out | std::ios::binary | std::ios::trunc);
         //write sentinel
-        filestr << "AutoCAD Binary DXF\r\n" << (char)26 << '\0';
-        writer = new dxfWriterBinary(&filestr);
+        *out << "AutoCAD Binary DXF\r\n" << (char)26 << '\0';
+        writer = new dxfWriterBinary(out);
         DRW_DBG("dxfRW::read binary file\n");
     } else {
-        filestr.open (fileName.c_str(), std::ios_base::out | std::ios::trunc);
-        writer = new dxfWriterAscii(&filestr);
+        writer = new dxfWriterAscii(out);
         std::string comm = std::string("dxfrw ") + std::string(DRW_VERSION);
         writeString(999, comm);
     }
@@ -167,9 +357,7 @@ bool dxfRW::write(DRW_Interface *interface_, DRW::Version ver, bool bin){
     }
     writeName("EOF");
 
-    filestr.flush();
-    filestr.close();
-    isOk = true;
+    bool isOk = writer->flush();
     delete writer;
     writer = nullptr;
     return isOk;
@@ -1300,13 +1488,12 @@ bool dxfRW::writeLWPolyline(DRW_LWPolyline *ent){
         writeDoubleOpt(38, ent->elevation);
         writeDoubleOpt(39, ent->thickness);
 
-        for (int i = 0;  i< ent->vertexnum; i++){
-            auto& v = ent->vertlist.at(i);
-            writeDouble(10, v->x);
-            writeDouble(20, v->y);
-            writeDoubleOpt(40, v->stawidth);
-            writeDoubleOpt(41, v->endwidth);
-            writeDoubleOpt(42, v->bulge);
+        for (const DRW_Vertex2D &v: ent->vertlist.values()){
+            writeDouble(10, v.x);
+            writeDouble(20, v.y);
+            writeDoubleOpt(40, v.stawidth);
+            writeDoubleOpt(41, v.endwidth);
+            writeDoubleOpt(42, v.bulge);
         }
     } else {
         //RLZ: TODO convert lwpolyline in polyline (not exist in acad 12)
@@ -2298,6 +2485,9 @@ bool dxfRW::processDxf() {
     bool inSection {false};
 
     reader->setIgnoreComments( false);
+    reader->setNameTable(nameTable);
+    variantArena = DRW_VariantArena::create();
+    reader->setVariantArena(variantArena.get());
     while (readRec(&code)) {
         DRW_DBG(code); DRW_DBG(" code\n");
         /* at this level we should only get:
@@ -2316,21 +2506,21 @@ bool dxfRW::processDxf() {
                 // ignore further comments, as libdxfrw doesn't support comments in sections
                 reader->setIgnoreComments(true);
                 if (!inSection) {
-                    std::string sectionstr{getString()};
+                    DRW_RecordName name {getRecordName()};
 
-                    if ("SECTION" == sectionstr) {
-                        DRW_DBG(sectionstr);
+                    if (DRW_RecordName::Section == name) {
+                        DRW_DBG(getString());
                         DRW_DBG(" new section\n");
                         inSection = true;
                         continue;
                     }
-                    if ("EOF" == sectionstr) {
+                    if (DRW_RecordName::Eof == name) {
                         return true; //found EOF terminate
                     }
                 }
                 else {
                     // in case SECTION was unknown or not supported
-                    if ("ENDSEC" == getString()) {
+                    if (DRW_RecordName::EndSec == getRecordName()) {
                         inSection = false;
                     }
                 }
@@ -2348,12 +2538,19 @@ bool dxfRW::processDxf() {
                     }
                     else if ("TABLES" == sectionname) {
                         processed = processTables();
+                        if (processed) {
+                            iface->endTables();
+                        }
                     }
                     else if ("BLOCKS" == sectionname) {
                         processed = processBlocks();
+                        if (processed) {
+                            iface->endBlocks();
+                        }
                     }
                     else if ("ENTITIES" == sectionname) {
-                        processed = processEntities(false);
+                        processed = threads > 1 ? processEntitiesParallel()
+                                                : processEntities(false);
                     }
                     else if ("OBJECTS" == sectionname) {
                         processed = processObjects();
@@ -2382,7 +2579,7 @@ bool dxfRW::processDxf() {
         }
     }
 
-    if (0 == code && "EOF" == getString()) {
+    if (0 == code && DRW_RecordName::Eof == getRecordName()) {
         // in case the final EOF has no newline we end up here!
         // this is caused by filestr->good() which is false for missing newline on EOF
         return true;
@@ -2403,7 +2600,7 @@ bool dxfRW::processHeader() {
             sectionstr = getString();
             DRW_DBG(sectionstr); DRW_DBG(" processHeader\n\n");
             if (sectionstr == "ENDSEC") {
-                iface->addHeader(&header);
+                iface->takeHeader(std::move(header));
                 return true;  //found ENDSEC terminate
             }
 
@@ -2634,15 +2831,14 @@ bool dxfRW::processAppId(){
 bool dxfRW::processBlocks() {
     DRW_DBG("dxfRW::processBlocks\n");
     int code;
-    std::string sectionstr;
     while (readRec(&code)) {
         DRW_DBG(code); DRW_DBG("\n");
         if (code == 0) {
-            sectionstr = getString();
-            DRW_DBG(sectionstr); DRW_DBG("\n");
-            if (sectionstr == "BLOCK") {
+            DRW_DBG(getString()); DRW_DBG("\n");
+            DRW_RecordName name {getRecordName()};
+            if (name == DRW_RecordName::Block) {
                 processBlock();
-            } else if (sectionstr == "ENDSEC") {
+            } else if (name == DRW_RecordName::EndSec) {
                 return true;  //found ENDSEC terminate
             }
         }
@@ -2658,7 +2854,7 @@ bool dxfRW::processBlock() {
     {
         auto ent = static_cast<DRW_Block*>(e);
         iface->addBlock(*ent);
-            if (nextentity == "ENDBLK") {  //found ENDBLK, terminate
+            if (nextName == DRW_RecordName::EndBlk) {  //found ENDBLK, terminate
                 iface->endBlock();
             } else {
                 processEntities(true);
@@ -2669,6 +2865,27 @@ bool dxfRW::processBlock() {
 
 /********* Entities Section *********/
 
+namespace {
+
+/* Entities that dxfRW::setBatchSize() delivers in batches */
+bool isBatched(DRW_RecordName name) {
+    switch (name) {
+    case DRW_RecordName::Point:
+    case DRW_RecordName::Line:
+    case DRW_RecordName::Circle:
+    case DRW_RecordName::Arc:
+    case DRW_RecordName::Ellipse:
+    case DRW_RecordName::Text:
+    case DRW_RecordName::LWPolyline:
+    case DRW_RecordName::Insert:
+        return true;
+    default:
+        return false;
+    }
+}
+
+} // namespace
+
 bool dxfRW::processEntities(bool isblock) {
     DRW_DBG("dxfRW::processEntities\n");
     int code;
@@ -2677,82 +2894,390 @@ bool dxfRW::processEntities(bool isblock) {
     }
 
     if (code == 0) {
-        nextentity = getString();
+        readNextEntity();
     } else if (!isblock) {
         return setError(DRW::BAD_READ_ENTITIES);  //first record in entities is 0
     }
 
     bool processed {false};
     do {
-        if (nextentity == "ENDSEC" || nextentity == "ENDBLK") {
-            return true;  //found ENDSEC or ENDBLK terminate
+        //entities delivered one by one must not overtake a pending batch
+        if (!batch.empty() && !isBatched(nextName)) {
+            flushBatch();
         }
-        if (nextentity == "LINE") {
+        switch (nextName) {
+        case DRW_RecordName::EndSec:
+        case DRW_RecordName::EndBlk:
+            return true;  //found ENDSEC or ENDBLK terminate
+        case DRW_RecordName::Line:
             processed = processLine();
-        }  else if (nextentity == "CIRCLE") {
+            break;
+        case DRW_RecordName::Circle:
             processed = processCircle();
-        } else if (nextentity == "ARC") {
+            break;
+        case DRW_RecordName::Arc:
             processed = processArc();
-        } else if (nextentity == "POINT") {
+            break;
+        case DRW_RecordName::Point:
             processed = processPoint();
-        } else if (nextentity == "LWPOLYLINE") {
+            break;
+        case DRW_RecordName::LWPolyline:
             processed = processLWPolyline();
-        } else if (nextentity == "POLYLINE") {
+            break;
+        case DRW_RecordName::Polyline:
             processed = processPolyline();
-        }else if (nextentity == "TEXT") {
+            break;
+        case DRW_RecordName::Text:
             processed = processText();
-        } else if (nextentity == "MTEXT") {
+            break;
+        case DRW_RecordName::MText:
             processed = processMText();
-        } else if (nextentity == "HATCH") {
+            break;
+        case DRW_RecordName::Hatch:
             processed = processHatch();
-        } else if (nextentity == "DIMENSION") {
+            break;
+        case DRW_RecordName::Dimension:
             processed = processDimension();
-        } else if (nextentity == "INSERT") {
+            break;
+        case DRW_RecordName::Insert:
             processed = processInsert();
-        } else if (nextentity == "TOLERANCE") {
+            break;
+        case DRW_RecordName::Tolerance:
             processed = processTolerance();
-        } else if (nextentity == "SOLID") {
+            break;
+        case DRW_RecordName::Solid:
             processed = processSolid();
-        }else if (nextentity == "SPLINE") {
+            break;
+        case DRW_RecordName::Spline:
             processed = processSpline();
-        }else if (nextentity == "LEADER") {
+            break;
+        case DRW_RecordName::Leader:
             processed = processLeader();
-        } else if (nextentity == "ELLIPSE") {
+            break;
+        case DRW_RecordName::Ellipse:
             processed = processEllipse();
-        } else if (nextentity == "VIEWPORT") {
+            break;
+        case DRW_RecordName::Viewport:
             processed = processViewport();
-        } else if (nextentity == "IMAGE") {
+            break;
+        case DRW_RecordName::Image:
             processed = processImage();
-        } else if (nextentity == "TRACE") {
+            break;
+        case DRW_RecordName::Trace:
             processed = processTrace();
-        } else if (nextentity == "3DFACE") {
+            break;
+        case DRW_RecordName::Face3D:
             processed = process3dface();
-        } else if (nextentity == "RAY") {
+            break;
+        case DRW_RecordName::Ray:
             processed = processRay();
-        } else if (nextentity == "XLINE") {
+            break;
+        case DRW_RecordName::Xline:
             processed = processXline();
-        } else if (nextentity == "ARC_DIMENSION") {
+            break;
+        case DRW_RecordName::ArcDimension:
             processed = processArcDimension();
-        } else {
+            break;
+        default:
             if (!readRec(&code)) {
                 return setError(DRW::BAD_READ_ENTITIES); //end of file without ENDSEC
             }
             if (code == 0) {
-                nextentity = getString();
+                readNextEntity();
             }
             processed = true;
+            break;
         }
     } while (processed);
 
+    //entities read before the error are still delivered
+    flushBatch();
     return setError(DRW::BAD_READ_ENTITIES);
 }
 
+namespace {
+
+/* Entity callback stored by a worker of processEntitiesParallel() */
+/* Names of an entity parsed without the name table, interned at replay */
+void internNames(DRW_Entity &e, DRW_NameTable *names) {
+    e.layerId = names->intern(e.layer);
+    e.lineTypeId = names->intern(e.lineType);
+}
+
+void internNames(DRW_Polyline &e, DRW_NameTable *names) {
+    internNames(static_cast<DRW_Entity&>(e), names);
+    for (auto &v : e.vertlist.values())
+        internNames(v, names);
+}
+
+class DRW_RecordedCall {
+public:
+    virtual ~DRW_RecordedCall() = default;
+    virtual void replay(DRW_Interface *iface, DRW_NameTable *names) = 0;
+};
+
+template <class T>
+class DRW_RecordedRef : public DRW_RecordedCall {
+public:
+    using Method = void (DRW_Interface::*)(const T&);
+    DRW_RecordedRef(const T &e, Method m): ent(e), method(m) {}
+    void replay(DRW_Interface *iface, DRW_NameTable *names) override {
+        if (names)
+            internNames(ent, names);
+        (iface->*method)(ent);
+    }
+private:
+    T ent;
+    Method method;
+};
+
+template <class T>
+class DRW_RecordedPtr : public DRW_RecordedCall {
+public:
+    using Method = void (DRW_Interface::*)(const T*);
+    DRW_RecordedPtr(const T *e, Method m): ent(*e), method(m) {}
+    void replay(DRW_Interface *iface, DRW_NameTable *names) override {
+        if (names)
+            internNames(ent, names);
+        (iface->*method)(&ent);
+    }
+private:
+    T ent;
+    Method method;
+};
+
+class DRW_RecordedBatch : public DRW_RecordedCall {
+public:
+    explicit DRW_RecordedBatch(const DRW_EntityBatch &b): batch(b) {}
+    void replay(DRW_Interface *iface, DRW_NameTable *names) override {
+        if (names)
+            batch.forEach([names](auto &e) {internNames(e, names);});
+        iface->addBatch(batch);
+    }
+private:
+    DRW_EntityBatch batch;
+};
+
+//thrown into a worker whose part is no longer wanted
+struct DRW_ReadCancelled {};
+
+/*
+ * Keeps a copy of every entity received, to be delivered later in order.
+ * The parts are parsed without the name table, their names are interned
+ * on the delivering thread, in file order.
+ */
+class DRW_RecordingInterface : public DRW_Interface {
+public:
+    void replay(DRW_Interface *iface, DRW_NameTable *names) {
+        for (const auto &c : calls)
+            c->replay(iface, names);
+    }
+
+    //the parser of this part stops at its next entity once *flag is set
+    void cancelOn(const std::atomic<bool> *flag) {
+        cancelled = flag;
+    }
+
+    void addBatch(const DRW_EntityBatch &b) override {
+        checkCancelled();
+        calls.emplace_back(new DRW_RecordedBatch(b));
+    }
+
+    void addHeader(const DRW_Header*) override {}
+    void addLType(const DRW_LType&) override {}
+    void addLayer(const DRW_Layer&) override {}
+    void addDimStyle(const DRW_Dimstyle&) override {}
+    void addVport(const DRW_Vport&) override {}
+    void addView(const DRW_View&) override {}
+    void addUCS(const DRW_UCS&) override {}
+    void addTextStyle(const DRW_Textstyle&) override {}
+    void addAppId(const DRW_AppId&) override {}
+    void addBlock(const DRW_Block&) override {}
+    void setBlock(const int) override {}
+    void endBlock() override {}
+    void addPoint(const DRW_Point& data) override {add(data, &DRW_Interface::addPoint);}
+    void addLine(const DRW_Line& data) override {add(data, &DRW_Interface::addLine);}
+    void addRay(const DRW_Ray& data) override {add(data, &DRW_Interface::addRay);}
+    void addXline(const DRW_Xline& data) override {add(data, &DRW_Interface::addXline);}
+    void addArc(const DRW_Arc& data) override {add(data, &DRW_Interface::addArc);}
+    void addCircle(const DRW_Circle& data) override {add(data, &DRW_Interface::addCircle);}
+    void addEllipse(const DRW_Ellipse& data) override {add(data, &DRW_Interface::addEllipse);}
+    void addLWPolyline(const DRW_LWPolyline& data) override {add(data, &DRW_Interface::addLWPolyline);}
+    void addPolyline(const DRW_Polyline& data) override {add(data, &DRW_Interface::addPolyline);}
+    void addSpline(const DRW_Spline* data) override {add(data, &DRW_Interface::addSpline);}
+    void addKnot(const DRW_Entity&) override {}
+    void addInsert(const DRW_Insert& data) override {add(data, &DRW_Interface::addInsert);}
+    void addTrace(const DRW_Trace& data) override {add(data, &DRW_Interface::addTrace);}
+    void add3dFace(const DRW_3Dface& data) override {add(data, &DRW_Interface::add3dFace);}
+    void addSolid(const DRW_Solid& data) override {add(data, &DRW_Interface::addSolid);}
+    void addMText(const DRW_MText& data) override {add(data, &DRW_Interface::addMText);}
+    void addText(const DRW_Text& data) override {add(data, &DRW_Interface::addText);}
+    void addTolerance(const DRW_Tolerance& data) override {add(data, &DRW_Interface::addTolerance);}
+    void addDimAlign(const DRW_DimAligned *data) override {add(data, &DRW_Interface::addDimAlign);}
+    void addDimLinear(const DRW_DimLinear *data) override {add(data, &DRW_Interface::addDimLinear);}
+    void addDimRadial(const DRW_DimRadial *data) override {add(data, &DRW_Interface::addDimRadial);}
+    void addDimDiametric(const DRW_DimDiametric *data) override {add(data, &DRW_Interface::addDimDiametric);}
+    void addDimAngular(const DRW_DimAngular *data) override {add(data, &DRW_Interface::addDimAngular);}
+    void addDimAngular3P(const DRW_DimAngular3p *data) override {add(data, &DRW_Interface::addDimAngular3P);}
+    void addDimOrdinate(const DRW_DimOrdinate *data) override {add(data, &DRW_Interface::addDimOrdinate);}
+    void addLeader(const DRW_Leader *data) override {add(data, &DRW_Interface::addLeader);}
+    void addHatch(const DRW_Hatch *data) override {add(data, &DRW_Interface::addHatch);}
+    void addViewport(const DRW_Viewport& data) override {add(data, &DRW_Interface::addViewport);}
+    void addImage(const DRW_Image *data) override {add(data, &DRW_Interface::addImage);}
+    void linkImage(const DRW_ImageDef*) override {}
+    void addComment(const char*) override {}
+    void addPlotSettings(const DRW_PlotSettings*) override {}
+
+    void writeHeader(DRW_Header&) override {}
+    void writeBlocks() override {}
+    void writeBlockRecords() override {}
+    void writeEntities() override {}
+    void writeLTypes() override {}
+    void writeLayers() override {}
+    void writeViews() override {}
+    void writeUCSs() override {}
+    void writeTextstyles() override {}
+    void writeVports() override {}
+    void writeDimstyles() override {}
+    void writeObjects() override {}
+    void writeAppId() override {}
+
+private:
+    void checkCancelled() const {
+        if (cancelled != nullptr && cancelled->load(std::memory_order_relaxed))
+            throw DRW_ReadCancelled();
+    }
+    template <class T>
+    void add(const T &e, void (DRW_Interface::*m)(const T&)) {
+        checkCancelled();
+        calls.emplace_back(new DRW_RecordedRef<T>(e, m));
+    }
+    template <class T>
+    void add(const T *e, void (DRW_Interface::*m)(const T*)) {
+        checkCancelled();
+        if (e)
+            calls.emplace_back(new DRW_RecordedPtr<T>(e, m));
+    }
+
+    std::vector<std::unique_ptr<DRW_RecordedCall>> calls;
+    const std::atomic<bool> *cancelled = nullptr;
+};
+
+/*
+ * Joins the worker threads however the parallel read is left: the
+ * interface callbacks run on the calling thread meanwhile and may throw.
+ * The workers still parsing are cancelled first.
+ */
+class DRW_WorkerJoin {
+public:
+    DRW_WorkerJoin(std::vector<std::thread> &threads, std::atomic<bool> &cancel) :
+        threads {threads}, cancel {cancel} {}
+    ~DRW_WorkerJoin() {
+        cancel = true;
+        for (auto &t : threads) {
+            if (t.joinable())
+                t.join();
+        }
+    }
+    DRW_WorkerJoin(const DRW_WorkerJoin&) = delete;
+    DRW_WorkerJoin &operator=(const DRW_WorkerJoin&) = delete;
+
+private:
+    std::vector<std::thread> &threads;
+    std::atomic<bool> &cancel;
+};
+
+/* Smallest number of entities worth a thread of its own */
+constexpr size_t MIN_ENTITIES_PER_THREAD = 1024;
+
+} // namespace
+
+bool dxfRW::processEntitiesParallel() {
+    DRW_DBG("dxfRW::processEntitiesParallel\n");
+    auto *mem = dynamic_cast<dxfReaderAsciiMem*>(reader);
+    std::vector<const char*> starts;
+    const char *sectionEnd = nullptr;
+    if (mem == nullptr || !mem->scanEntities(&starts, &sectionEnd)
+            || starts.front() != mem->position()) {
+        return processEntities(false);
+    }
+
+    size_t parts = std::min(static_cast<size_t>(threads), starts.size() / MIN_ENTITIES_PER_THREAD);
+    if (parts < 2) {
+        return processEntities(false);
+    }
+
+    //split at the entity nearest to an even share of the bytes
+    std::vector<const char*> bounds {starts.front()};
+    size_t bytes = static_cast<size_t>(sectionEnd - starts.front());
+    for (size_t i = 1; i < parts; ++i) {
+        const char *target = starts.front() + bytes / parts * i;
+        auto it = std::lower_bound(starts.begin(), starts.end(), target);
+        if (it != starts.end() && *it > bounds.back())
+            bounds.push_back(*it);
+    }
+    bounds.push_back(sectionEnd);
+    parts = bounds.size() - 1;
+
+    //each part reads as if the section ended there
+    static const char *trailer = "  0\nENDSEC\n";
+    std::vector<std::unique_ptr<dxfRW>> workers;
+    std::vector<DRW_RecordingInterface> recorded(parts);
+    for (size_t i = 0; i < parts; ++i) {
+        auto *chunk = new dxfReaderAsciiMem(bounds[i], static_cast<size_t>(bounds[i + 1] - bounds[i]), trailer);
+        chunk->copySettings(*reader);
+        //the first part goes straight to the interface
+        DRW_Interface *out = i == 0 ? iface : &recorded[i];
+        if (i == 0)
+            chunk->setNameTable(nameTable);
+        workers.emplace_back(new dxfRW(*this, chunk, out));
+    }
+
+    std::vector<std::thread> pool;
+    std::vector<char> done(parts, 0);
+    std::atomic<bool> cancel {false};
+    for (auto &r : recorded)
+        r.cancelOn(&cancel);
+    DRW_WorkerJoin joinWorkers {pool, cancel};
+    for (size_t i = 1; i < parts; ++i) {
+        pool.emplace_back([&workers, &done, i]() {
+            try {
+                done[i] = workers[i]->processEntities(false);
+            } catch (...) {
+                workers[i]->setError(DRW::BAD_READ_ENTITIES);
+            }
+        });
+    }
+    bool isOk = workers[0]->processEntities(false);
+    if (!isOk) {
+        error = workers[0]->getError();
+    }
+    for (size_t i = 1; i < parts; ++i) {
+        pool[i - 1].join();
+        if (isOk) {
+            //entities read before a failure are still delivered
+            recorded[i].replay(iface, nameTable);
+            if (!done[i]) {
+                isOk = false;
+                error = workers[i]->getError();
+            }
+        }
+    }
+    if (!isOk) {
+        return false;
+    }
+
+    //continue with the terminating record of the section
+    mem->seek(sectionEnd);
+    return processEntities(false);
+}
+
 bool dxfRW::doProcessEntity(DRW_Entity& ent, DRW_EntityFunc applyFunc) {
     int code;
     while (readRec(&code)) {
         DRW_DBG(code); DRW_DBG("\n");
         if (0 == code) {
-            nextentity = getString();
+            readNextEntity();
             DRW_DBG(nextentity); DRW_DBG("\n");
             if (applyExt) {
                 ent.applyExtrusion();
@@ -2772,7 +3297,7 @@ bool dxfRW::doProcessParseable(DRW_ParseableEntity &ent, DRW_ParseableFunc apply
     while (readRec(&code)) {
         DRW_DBG(code); DRW_DBG("\n");
         if (0 == code) {
-            nextentity = getString();
+            readNextEntity();
             DRW_DBG(nextentity); DRW_DBG("\n");
             applyFunc(&ent);
             return true;  //found new entity or ENDSEC, terminate
@@ -2784,9 +3309,72 @@ bool dxfRW::doProcessParseable(DRW_ParseableEntity &ent, DRW_ParseableFunc apply
     return setError(sectionError);
 }
 
+namespace {
+//the defaults a reused entity slot goes back to
+template <class T>
+const T &pristine() {
+    static const T entity{};
+    return entity;
+}
+} // namespace
+
+/* Entity slot of type T, reset to the defaults of T */
+template <class T>
+T &dxfRW::entitySlot() {
+    T &slot = std::get<T>(slots->entities);
+    //copy assignment keeps the capacity of the strings and lists of the slot;
+    //entities with a hand-written copy constructor declare it defaulted
+    slot = pristine<T>();
+    return slot;
+}
+
+/* Parse the next entity into the batch, delivered when the batch is full */
+template <class T>
+bool dxfRW::processBatched(std::vector<T> &items, DRW::ETYPE type, bool extrude) {
+    T &ent = items.emplace_back();
+    slots->adopt(ent);
+    //captures no more than std::function holds without allocating
+    auto added = [this, type](auto *e) {
+        batch.addColumns(*static_cast<T*>(e));
+        batch.order.push_back(type);
+        if (batch.size() >= batchSize) {
+            flushBatch();
+        }
+    };
+    bool isOk = extrude ? doProcessEntity(ent, added) : doProcessParseable(ent, added);
+    if (!isOk) {
+        items.pop_back();
+    }
+    return isOk;
+}
+
+void dxfRW::flushBatch() {
+    if (batch.empty()) {
+        return;
+    }
+    iface->addBatch(batch);
+    auto recycle = [this](auto &items) {
+        for (auto &e : items) {
+            slots->recycle(e);
+        }
+    };
+    recycle(batch.points);
+    recycle(batch.lines);
+    recycle(batch.circles);
+    recycle(batch.arcs);
+    recycle(batch.ellipses);
+    recycle(batch.texts);
+    recycle(batch.lwpolylines);
+    recycle(batch.inserts);
+    batch.clear();
+}
+
 bool dxfRW::processEllipse() {
     DRW_DBG("dxfRW::processEllipse");
-    DRW_Ellipse ellipse;
+    if (batchSize > 0) {
+        return processBatched(batch.ellipses, DRW::ELLIPSE, true);
+    }
+    DRW_Ellipse &ellipse = entitySlot<DRW_Ellipse>();
     return doProcessEntity(ellipse, [this](DRW_Entity* e){
         auto ent = static_cast<DRW_Ellipse*>(e);
         iface->addEllipse(*ent);
@@ -2795,7 +3383,7 @@ bool dxfRW::processEllipse() {
 
 bool dxfRW::processTrace() {
     DRW_DBG("dxfRW::processTrace");
-    DRW_Trace trace;
+    DRW_Trace &trace = entitySlot<DRW_Trace>();
     return doProcessEntity(trace,[this](DRW_Entity* e){
         auto ent = static_cast<DRW_Trace*>(e);
         iface->addTrace(*ent);
@@ -2804,7 +3392,7 @@ bool dxfRW::processTrace() {
 
 bool dxfRW::processSolid() {
     DRW_DBG("dxfRW::processSolid");
-    DRW_Solid solid;
+    DRW_Solid &solid = entitySlot<DRW_Solid>();
     return doProcessEntity(solid,[this](DRW_Entity* e){
         auto ent = static_cast<DRW_Solid*>(e);
         iface->addSolid(*ent);
@@ -2813,7 +3401,7 @@ bool dxfRW::processSolid() {
 
 bool dxfRW::process3dface() {
     DRW_DBG("dxfRW::process3dface");
-    DRW_3Dface face;
+    DRW_3Dface &face = entitySlot<DRW_3Dface>();
     return doProcessParseable(face,[this](DRW_ParseableEntity* e){
         auto ent = static_cast<DRW_3Dface*>(e);
         iface->add3dFace(*ent);
@@ -2822,7 +3410,7 @@ bool dxfRW::process3dface() {
 
 bool dxfRW::processViewport() {
     DRW_DBG("dxfRW::processViewport");
-    DRW_Viewport vp;
+    DRW_Viewport &vp = entitySlot<DRW_Viewport>();
     return doProcessParseable(vp,[this](DRW_ParseableEntity* e){
         auto ent = static_cast<DRW_Viewport*>(e);
         iface->addViewport(*ent);
@@ -2831,7 +3419,10 @@ bool dxfRW::processViewport() {
 
 bool dxfRW::processPoint() {
     DRW_DBG("dxfRW::processPoint\n");
-    DRW_Point point;
+    if (batchSize > 0) {
+        return processBatched(batch.points, DRW::POINT, false);
+    }
+    DRW_Point &point = entitySlot<DRW_Point>();
     return doProcessParseable(point,[this](DRW_ParseableEntity* e){
         auto ent = static_cast<DRW_Point*>(e);
         iface->addPoint(*ent);
@@ -2840,7 +3431,10 @@ bool dxfRW::processPoint() {
 
 bool dxfRW::processLine() {
     DRW_DBG("dxfRW::processLine\n");
-    DRW_Line line;
+    if (batchSize > 0) {
+        return processBatched(batch.lines, DRW::LINE, false);
+    }
+    DRW_Line &line = entitySlot<DRW_Line>();
     return doProcessParseable(line, [this](DRW_ParseableEntity* e){
         auto ent = static_cast<DRW_Line*>(e);
         iface->addLine(*ent);
@@ -2849,7 +3443,7 @@ bool dxfRW::processLine() {
 
 bool dxfRW::processRay() {
     DRW_DBG("dxfRW::processRay\n");
-    DRW_Ray line;
+    DRW_Ray &line = entitySlot<DRW_Ray>();
     return doProcessParseable(line,[this](DRW_ParseableEntity* e){
         auto ent = static_cast<DRW_Ray*>(e);
         iface->addRay(*ent);
@@ -2858,7 +3452,7 @@ bool dxfRW::processRay() {
 
 bool dxfRW::processXline() {
     DRW_DBG("dxfRW::processXline\n");
-    DRW_Xline line;
+    DRW_Xline &line = entitySlot<DRW_Xline>();
     return doProcessParseable(line,[this](DRW_ParseableEntity* e){
         auto ent = static_cast<DRW_Xline*>(e);
         iface->addXline(*ent);
@@ -2867,7 +3461,10 @@ bool dxfRW::processXline() {
 
 bool dxfRW::processCircle() {
     DRW_DBG("dxfRW::processPoint\n");
-    DRW_Circle circle;
+    if (batchSize > 0) {
+        return processBatched(batch.circles, DRW::CIRCLE, true);
+    }
+    DRW_Circle &circle = entitySlot<DRW_Circle>();
     return doProcessEntity(circle, [this](DRW_Entity* e){
         auto ent = static_cast<DRW_Circle*>(e);
         iface->addCircle(*ent);
@@ -2876,7 +3473,10 @@ bool dxfRW::processCircle() {
 
 bool dxfRW::processArc() {
     DRW_DBG("dxfRW::processPoint\n");
-    DRW_Arc arc;
+    if (batchSize > 0) {
+        return processBatched(batch.arcs, DRW::ARC, true);
+    }
+    DRW_Arc &arc = entitySlot<DRW_Arc>();
     return doProcessEntity(arc, [this](DRW_Entity* e){
         auto ent = static_cast<DRW_Arc*>(e);
         iface->addArc(*ent);
@@ -2885,7 +3485,10 @@ bool dxfRW::processArc() {
 
 bool dxfRW::processInsert() {
     DRW_DBG("dxfRW::processInsert");
-    DRW_Insert insert;
+    if (batchSize > 0) {
+        return processBatched(batch.inserts, DRW::INSERT, false);
+    }
+    DRW_Insert &insert = entitySlot<DRW_Insert>();
     return doProcessParseable(insert,[this](DRW_ParseableEntity* e){
        auto ent = static_cast<DRW_Insert*>(e);
        iface->addInsert(*ent);
@@ -2894,7 +3497,10 @@ bool dxfRW::processInsert() {
 
 bool dxfRW::processLWPolyline() {
     DRW_DBG("dxfRW::processLWPolyline");
-    DRW_LWPolyline pl;
+    if (batchSize > 0) {
+        return processBatched(batch.lwpolylines, DRW::LWPOLYLINE, true);
+    }
+    DRW_LWPolyline &pl = entitySlot<DRW_LWPolyline>();
     return doProcessEntity(pl, [this](DRW_Entity* e){
         auto ent = static_cast<DRW_LWPolyline*>(e);
         iface->addLWPolyline(*ent);
@@ -2904,13 +3510,13 @@ bool dxfRW::processLWPolyline() {
 bool dxfRW::processPolyline() {
     DRW_DBG("dxfRW::processPolyline");
     int code;
-    DRW_Polyline pl;
+    DRW_Polyline &pl = entitySlot<DRW_Polyline>();
     while (readRec(&code)) {
         DRW_DBG(code); DRW_DBG("\n");
         if (0 == code) {
-            nextentity = getString();
+            readNextEntity();
             DRW_DBG(nextentity); DRW_DBG("\n");
-            if (nextentity != "VERTEX") {
+            if (nextName != DRW_RecordName::Vertex) {
                 iface->addPolyline(pl);
                 return true;  //found new entity or ENDSEC, terminate
             }
@@ -2930,22 +3536,22 @@ bool dxfRW::processPolyline() {
 bool dxfRW::processVertex(DRW_Polyline *pl) {
     DRW_DBG("dxfRW::processVertex");
     int code;
-    auto v = std::make_shared<DRW_Vertex>();
+    DRW_Vertex v;
     while (readRec(&code)) {
         DRW_DBG(code); DRW_DBG("\n");
         if(0 == code)  {
-            pl->appendVertex(v);
-            nextentity = getString();
+            pl->appendVertex(std::move(v));
+            readNextEntity();
             DRW_DBG(nextentity); DRW_DBG("\n");
-            if (nextentity == "SEQEND") {
+            if (nextName == DRW_RecordName::SeqEnd) {
                 return true;  //found SEQEND no more vertex, terminate
             }
-            if (nextentity == "VERTEX"){
-                v = std::make_shared<DRW_Vertex>(); //another vertex
+            if (nextName == DRW_RecordName::Vertex){
+                v = DRW_Vertex(); //another vertex
             }
         }
 
-        if (!v->parseCode(code, reader)) { //the members of v are reinitialized here
+        if (!v.parseCode(code, reader)) { //the members of v are reinitialized here
             return setError(DRW::BAD_CODE_PARSED);
         }
     }
@@ -2955,7 +3561,7 @@ bool dxfRW::processVertex(DRW_Polyline *pl) {
 
 bool dxfRW::processTolerance() {
     DRW_DBG("dxfRW::processTolerance\n");
-    DRW_Tolerance tol;
+    DRW_Tolerance &tol = entitySlot<DRW_Tolerance>();
     return doProcessParseable(tol,[this](DRW_ParseableEntity* e){
        auto ent = static_cast<DRW_Tolerance*>(e);
        iface->addTolerance(*ent);
@@ -2964,7 +3570,10 @@ bool dxfRW::processTolerance() {
 
 bool dxfRW::processText() {
     DRW_DBG("dxfRW::processText");
-    DRW_Text txt;
+    if (batchSize > 0) {
+        return processBatched(batch.texts, DRW::TEXT, false);
+    }
+    DRW_Text &txt = entitySlot<DRW_Text>();
     return doProcessParseable(txt,[this](DRW_ParseableEntity* e){
        auto ent = static_cast<DRW_Text*>(e);
        iface->addText(*ent);
@@ -2973,7 +3582,7 @@ bool dxfRW::processText() {
 
 bool dxfRW::processMText() {
     DRW_DBG("dxfRW::processMText");
-    DRW_MText txt;
+    DRW_MText &txt = entitySlot<DRW_MText>();
     return doProcessParseable(txt,[this](DRW_ParseableEntity* e){
        auto ent = static_cast<DRW_MText*>(e);
        ent->updateAngle();
@@ -2983,7 +3592,7 @@ bool dxfRW::processMText() {
 
 bool dxfRW::processHatch() {
     DRW_DBG("dxfRW::processHatch");
-    DRW_Hatch hatch;
+    DRW_Hatch &hatch = entitySlot<DRW_Hatch>();
     return doProcessParseable(hatch,[this](DRW_ParseableEntity* e){
        auto ent = static_cast<DRW_Hatch*>(e);
        iface->addHatch(ent);
@@ -2992,7 +3601,7 @@ bool dxfRW::processHatch() {
 
 bool dxfRW::processSpline() {
     DRW_DBG("dxfRW::processSpline");
-    DRW_Spline sp;
+    DRW_Spline &sp = entitySlot<DRW_Spline>();
     return doProcessParseable(sp,[this](DRW_ParseableEntity* e){
        auto ent = static_cast<DRW_Spline*>(e);
        iface->addSpline(ent);
@@ -3001,7 +3610,7 @@ bool dxfRW::processSpline() {
 
 bool dxfRW::processImage() {
     DRW_DBG("dxfRW::processImage");
-    DRW_Image img;
+    DRW_Image &img = entitySlot<DRW_Image>();
     return doProcessParseable(img,[this](DRW_ParseableEntity* e){
        auto ent = static_cast<DRW_Image*>(e);
        iface->addImage(ent);
@@ -3015,7 +3624,7 @@ bool dxfRW::processArcDimension() {
     while (readRec(&code)) {
         DRW_DBG(code); DRW_DBG("\n");
         if (0 == code) {
-            nextentity = getString();
+            readNextEntity();
             DRW_DBG(nextentity); DRW_DBG("\n");
             // fixme - sand - restore ARCDimension
             // iface->addArcDimension(&dim);
@@ -3031,7 +3640,7 @@ bool dxfRW::processArcDimension() {
 
 bool dxfRW::processDimension() {
     DRW_DBG("dxfRW::processDimension");
-    DRW_Dimension dim;
+    DRW_Dimension &dim = entitySlot<DRW_Dimension>();
     return doProcessParseable(dim,[this](DRW_ParseableEntity* e){
        auto ent = static_cast<DRW_Dimension*>(e);
         int type = ent->type & 0x0F;
@@ -3079,7 +3688,7 @@ bool dxfRW::processDimension() {
 
 bool dxfRW::processLeader() {
     DRW_DBG("dxfRW::processLeader");
-    DRW_Leader leader;
+    DRW_Leader &leader = entitySlot<DRW_Leader>();
     return doProcessParseable(leader,[this](DRW_ParseableEntity* e){
         auto ent = static_cast<DRW_Leader*>(e);
         iface->addLeader(ent);
@@ -3097,15 +3706,15 @@ bool dxfRW::processObjects() {
     }
 
     bool processed {false};
-    nextentity = getString();
+    readNextEntity();
     do {
-        if ("ENDSEC" == nextentity) {
+        if (DRW_RecordName::EndSec == nextName) {
             return true;  //found ENDSEC terminate
         }
-        if ("IMAGEDEF" == nextentity) {
+        if (DRW_RecordName::ImageDef == nextName) {
             processed = processImageDef();
         }
-        else if ("PLOTSETTINGS" == nextentity) {
+        else if (DRW_RecordName::PlotSettings == nextName) {
             processed = processPlotSettings();
         }
         else {
@@ -3113,7 +3722,7 @@ bool dxfRW::processObjects() {
                 return setError(DRW::BAD_READ_OBJECTS); //end of file without ENDSEC
             }
             if (code == 0) {
-                nextentity = getString();
+                readNextEntity();
             }
             processed = true;
         }
@@ -3267,6 +3876,15 @@ std::string dxfRW::getString() {
     return reader->getString();
 }
 
+DRW_RecordName dxfRW::getRecordName() {
+    return reader->getRecordName();
+}
+
+void dxfRW::readNextEntity() {
+    nextentity = reader->getString();
+    nextName = reader->getRecordName();
+}
+
 void dxfRW::writeSectionStart(const std::string &name) {
     writeString(0, "SECTION");
     writeString(2, name);
@@ -15,6 +15,8 @@
 #define LIBDXFRW_H
 
 #include <functional>
+#include <iosfwd>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include "drw_entities.h"
@@ -25,6 +27,8 @@
 
 class dxfReader;
 class dxfWriter;
+enum class DRW_RecordName : unsigned char;
+class DRW_InflateBuf;
 
 using DRW_TableEntryFunc = std::function<void(DRW_TableEntry*)>;
 using DRW_EntityFunc = std::function<void(DRW_Entity*)>;
@@ -46,9 +50,59 @@ public:
      * @return true for success
      */
     bool read(DRW_Interface *interface_, bool ext);
+    /*!
+     * Reads a DXF file held in memory, in place. ASCII, binary and
+     * compressed content is told apart by its first bytes.
+     */
+    bool read(DRW_Interface *interface_, bool ext, const char *data, size_t size);
+    /*!
+     * Reads a DXF file from a stream buffer (pipe, socket...) in chunks.
+     * ASCII, binary and compressed content is told apart by its first bytes.
+     */
+    bool read(DRW_Interface *interface_, bool ext, std::streambuf *source);
     bool readAscii(DRW_Interface *interface_, bool ext, std::string& content);
     void setBinary(bool b) {binFile = b;}
+    /*!
+     * Map the file in memory and tokenize ASCII DXF in place instead of
+     * reading it in chunks. Binary DXF is always read from memory, without
+     * mapping it is loaded whole first.
+     * gzip and zstd compressed files are recognised by their magic number
+     * and decompressed in chunks while reading; their entities are parsed
+     * on the calling thread.
+     */
+    void setMemoryMapped(bool b) {memoryMapped = b;}
+    /*!
+     * Number of threads used to parse the ENTITIES section of ASCII files
+     * that are memory mapped or read from memory. The section is split at entity boundaries, each part is
+     * parsed by its own thread and the interface still receives the entities
+     * in file order. Values below 2 parse on the calling thread. An
+     * exception thrown by the interface leaves read() once the other
+     * threads have stopped, as it does on one thread.
+     */
+    void setThreads(int n) {threads = n;}
+    /*!
+     * Intern the layer and line type names of the entities read into
+     * names, and set DRW_Entity::layerId and lineTypeId from it, so the
+     * interface can keep ids instead of copying the names. The table must
+     * outlive read(); nullptr (the default) leaves the ids alone.
+     */
+    void setNameTable(DRW_NameTable *names) {nameTable = names;}
+    /*!
+     * Deliver points, lines, circles, arcs, ellipses, texts, lwpolylines
+     * and inserts of DXF files in batches of up to n entities through
+     * DRW_Interface::addBatch() instead of one call each. A batch ends
+     * when it is full or an entity of another type comes; file order is
+     * kept. 0 (the default) uses the per-entity callbacks.
+     */
+    void setBatchSize(size_t n) {batchSize = n;}
+    /// writes the file specified in constructor, gzip or zstd compressed
+    /// when its name ends in ".gz" or ".zst"
     bool write(DRW_Interface *interface_, DRW::Version ver, bool bin);
+    /*!
+     * Writes the drawing to a stream buffer (memory, pipe...) owned by the
+     * caller, uncompressed. The buffer is synced before returning.
+     */
+    bool write(DRW_Interface *interface_, DRW::Version ver, bool bin, std::streambuf *sink);
 
     DRW::Version getVersion() const;
     DRW::error getError() const;
@@ -109,6 +163,13 @@ public:
     bool writePlotSettings(DRW_PlotSettings *ent);
 private:
 
+    /// worker used by processEntitiesParallel(), takes ownership of chunkReader
+    dxfRW(const dxfRW &parent, dxfReader *chunkReader, DRW_Interface *out);
+    /// used by read() for gzip and zstd compressed content
+    bool writeDxf(std::ostream *out);
+    bool readInflated(DRW_InflateBuf *inflater);
+    /// used by read() for streams whose first chunk was read into head
+    bool readStream(std::streambuf *source, const std::vector<char> &head);
     /// used by read() to parse the content of the file
     bool processDxf();
     bool processHeader();
@@ -117,8 +178,14 @@ private:
     bool processBlocks();
     bool processBlock();
     bool processEntities(bool isblock);
+    bool processEntitiesParallel();
     bool doProcessEntity(DRW_Entity& ent, DRW_EntityFunc applyFunc);
     bool doProcessParseable(DRW_ParseableEntity& ent, DRW_ParseableFunc applyFunc, DRW::error sectionError = DRW::BAD_READ_ENTITIES);
+    template <class T>
+    bool processBatched(std::vector<T> &items, DRW::ETYPE type, bool extrude);
+    void flushBatch();
+    template <class T>
+    T &entitySlot();
     bool processObjects();
 
     bool processLType();
@@ -181,6 +248,8 @@ private:
     inline bool readRec(int *codeData);
 
     inline std::string getString();
+    inline DRW_RecordName getRecordName();
+    inline void readNextEntity();
     inline void writeSectionStart(const std::string& name);
     inline void writeSectionEnd();
     inline void writeSymTypeRecord(const std::string& typeName);
@@ -206,7 +275,7 @@ private:
 
     void setVersion(DRW::Version v);
 
-    DRW::Version version;
+    DRW::Version version {DRW::UNKNOWNV};
     bool afterAC1009 {false};
     bool afterAC1012 {false};
     bool afterAC1014 {false};
@@ -217,12 +286,21 @@ private:
     std::string fileName;
     std::string codePage;
     bool binFile = false;
+    bool memoryMapped = false;
+    int threads = 1;
+    DRW_NameTable *nameTable = nullptr;
+    size_t batchSize = 0;
+    DRW_EntityBatch batch;  /*!< entities not yet delivered, see setBatchSize() */
+    struct EntitySlots;
+    std::unique_ptr<EntitySlots> slots;  /*!< entities and buffers reused from one record to the next */
+    DRW_VariantArena::Ptr variantArena;  /*!< XDATA items of the current read */
     dxfReader *reader = nullptr;
     dxfWriter *writer = nullptr;
     DRW_Interface *iface = nullptr;
     DRW_Header header;
 //    int section;
     std::string nextentity;
+    DRW_RecordName nextName {};  /*!< interned nextentity */
     int entCount = 0;
     bool wlayer0 = false;
     bool dimstyleStd = false;
@@ -44,6 +44,11 @@ fn main() {
     println!("cargo:rustc-link-search=native={}", lib_path.display());
     println!("cargo:rustc-link-lib=static=recad_core");
 
+    // gzip compressed DXF support uses the system zlib (core built with -Dzlib=false on Windows)
+    if !target.contains("windows") {
+        println!("cargo:rustc-link-lib=z");
+    }
+
     // Link C++ standard library - Zig uses LLVM's libc++
     if target.contains("apple") {
         println!("cargo:rustc-link-lib=c++");
@@ -1,7 +1,7 @@
 //! FFI bindings to librecad_core
 
 use std::ffi::{CStr, CString};
-use std::os::raw::{c_char, c_double, c_int};
+use std::os::raw::{c_char, c_double, c_int, c_void};
 
 /// Error codes from the C library
 #[repr(C)]
@@ -75,6 +75,14 @@ impl std::str::FromStr for LcDxfVersion {
     }
 }
 
+/// DXF encoding for export
+#[repr(C)]
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum LcDxfFormat {
+    Ascii = 0,
+    Binary = 1,
+}
+
 /// Entity types
 #[repr(C)]
 #[derive(Debug, Clone, Copy, PartialEq, Eq)]
@@ -174,6 +182,26 @@ impl std::str::FromStr for LcDetailLevel {
     }
 }
 
+/// How the drawing bounds are computed
+#[repr(C)]
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum LcBoundsMode {
+    Fast = 0,
+    Refined = 1,
+}
+
+impl std::str::FromStr for LcBoundsMode {
+    type Err = String;
+
+    fn from_str(s: &str) -> Result<Self, Self::Err> {
+        match s.to_lowercase().as_str() {
+            "fast" => Ok(LcBoundsMode::Fast),
+            "refined" | "exact" => Ok(LcBoundsMode::Refined),
+            _ => Err(format!("Unknown bounds mode: {}", s)),
+        }
+    }
+}
+
 /// 3D point
 #[repr(C)]
 #[derive(Debug, Clone, Copy, Default)]
@@ -252,14 +280,108 @@ pub struct LcFileInfo {
     pub entity_counts: [c_int; 20],
 }
 
+/// Time spent in a validation rule and the issues it raised
+#[repr(C)]
+pub struct LcRuleStats {
+    pub name: *mut c_char,
+    pub seconds: c_double,
+    pub issue_count: c_int,
+}
+
 /// Validation result
 #[repr(C)]
 pub struct LcValidationResult {
     pub is_valid: c_int,
     pub issue_count: c_int,
     pub issues: *mut LcValidationIssue,
+    pub rules: *mut LcRuleStats,
+    pub rules_len: c_int,
+    pub stopped: c_int,
+}
+
+/// Entity found by a spatial query
+#[repr(C)]
+pub struct LcQueryHit {
+    pub index: c_int,
+    pub entity_type: LcEntityType,
+    pub layer: *const c_char,
+    pub handle: c_int,
+    pub distance: c_double,
+}
+
+/// Spatial query result
+#[repr(C)]
+pub struct LcQueryResult {
+    pub hit_count: c_int,
+    pub hits: *mut LcQueryHit,
+}
+
+/// Use one parser thread per hardware core
+pub const LC_THREADS_AUTO: c_int = -1;
+
+/// Options for opening a document
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct LcOpenOptions {
+    pub threads: c_int,
+    pub bounds: LcBoundsMode,
+}
+
+/// Options for validating a document or a file
+#[repr(C)]
+pub struct LcValidateOptions {
+    pub rules: *const c_char,
+    pub threads: c_int,
+    pub fail_fast: c_int,
+}
+
+impl LcOpenOptions {
+    /// Options for `jobs` parser threads, 0 meaning one per core
+    pub fn with_jobs(jobs: usize) -> Self {
+        let threads = if jobs == 0 {
+            LC_THREADS_AUTO
+        } else {
+            jobs.min(c_int::MAX as usize) as c_int
+        };
+        LcOpenOptions {
+            threads,
+            bounds: LcBoundsMode::Fast,
+        }
+    }
 }
 
+impl Default for LcOpenOptions {
+    fn default() -> Self {
+        LcOpenOptions {
+            threads: 1,
+            bounds: LcBoundsMode::Fast,
+        }
+    }
+}
+
+/// Where `lc_document_open_source` reads from
+#[repr(C)]
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+#[allow(dead_code)]
+pub enum LcSourceKind {
+    Memory = 0,
+    Fd = 1,
+    Stdin = 2,
+}
+
+/// Input of `lc_document_open_source`
+#[repr(C)]
+pub struct LcSource {
+    pub kind: LcSourceKind,
+    pub data: *const c_void,
+    pub size: usize,
+    pub fd: c_int,
+    pub name: *const c_char,
+}
+
+/// File name standing for stdin as input and stdout as output
+pub const STDIO_NAME: &str = "-";
+
 /// Document handle (opaque)
 #[repr(C)]
 #[allow(dead_code)]
@@ -267,6 +389,13 @@ pub struct LcDocument {
     _private: [u8; 0],
 }
 
+/// Entity cursor handle (opaque)
+#[repr(C)]
+#[allow(dead_code)]
+pub struct LcCursor {
+    _private: [u8; 0],
+}
+
 // External C functions
 #[allow(dead_code)]
 extern "C" {
@@ -275,29 +404,89 @@ extern "C" {
     pub fn lc_detect_format(filename: *const c_char) -> LcFormat;
 
     pub fn lc_document_open(filename: *const c_char) -> *mut LcDocument;
+    pub fn lc_document_open_ex(
+        filename: *const c_char,
+        options: *const LcOpenOptions,
+    ) -> *mut LcDocument;
+    pub fn lc_document_open_source(
+        source: *const LcSource,
+        options: *const LcOpenOptions,
+    ) -> *mut LcDocument;
     pub fn lc_document_save(
         doc: *mut LcDocument,
         filename: *const c_char,
         version: LcDxfVersion,
     ) -> LcError;
+    pub fn lc_document_save_ex(
+        doc: *mut LcDocument,
+        filename: *const c_char,
+        version: LcDxfVersion,
+        format: LcDxfFormat,
+    ) -> LcError;
+    pub fn lc_document_save_fd(
+        doc: *mut LcDocument,
+        fd: c_int,
+        format: LcFormat,
+        version: LcDxfVersion,
+        dxf_format: LcDxfFormat,
+    ) -> LcError;
     pub fn lc_document_close(doc: *mut LcDocument);
 
+    pub fn lc_cursor_open(filename: *const c_char) -> *mut LcCursor;
+    pub fn lc_cursor_next(cursor: *mut LcCursor, entity: *mut *const LcEntityInfo) -> LcError;
+    pub fn lc_cursor_close(cursor: *mut LcCursor);
+
     pub fn lc_convert(
         input_file: *const c_char,
         output_file: *const c_char,
         dxf_version: LcDxfVersion,
     ) -> LcError;
+    pub fn lc_convert_ex(
+        input_file: *const c_char,
+        output_file: *const c_char,
+        dxf_version: LcDxfVersion,
+        dxf_format: LcDxfFormat,
+    ) -> LcError;
 
     pub fn lc_get_file_info(filename: *const c_char, detail: LcDetailLevel) -> *mut LcFileInfo;
+    pub fn lc_get_file_info_ex(
+        filename: *const c_char,
+        detail: LcDetailLevel,
+        options: *const LcOpenOptions,
+    ) -> *mut LcFileInfo;
     pub fn lc_document_get_info(doc: *mut LcDocument, detail: LcDetailLevel) -> *mut LcFileInfo;
     pub fn lc_file_info_free(info: *mut LcFileInfo);
     pub fn lc_file_info_to_json(info: *const LcFileInfo) -> *mut c_char;
 
     pub fn lc_validate(filename: *const c_char) -> *mut LcValidationResult;
+    pub fn lc_validate_ex(
+        filename: *const c_char,
+        options: *const LcValidateOptions,
+    ) -> *mut LcValidationResult;
+    pub fn lc_validate_source(
+        source: *const LcSource,
+        options: *const LcValidateOptions,
+    ) -> *mut LcValidationResult;
     pub fn lc_document_validate(doc: *mut LcDocument) -> *mut LcValidationResult;
+    pub fn lc_document_validate_ex(
+        doc: *mut LcDocument,
+        options: *const LcValidateOptions,
+    ) -> *mut LcValidationResult;
     pub fn lc_validation_result_free(result: *mut LcValidationResult);
     pub fn lc_validation_result_to_json(result: *const LcValidationResult) -> *mut c_char;
 
+    pub fn lc_document_query_bbox(
+        doc: *mut LcDocument,
+        window: *const LcBoundingBox,
+    ) -> *mut LcQueryResult;
+    pub fn lc_document_query_nearest(
+        doc: *mut LcDocument,
+        point: *const LcPoint3D,
+        k: c_int,
+    ) -> *mut LcQueryResult;
+    pub fn lc_query_result_free(result: *mut LcQueryResult);
+    pub fn lc_query_result_to_json(result: *const LcQueryResult) -> *mut c_char;
+
     pub fn lc_string_free(s: *mut c_char);
 }
 
@@ -331,32 +520,108 @@ pub fn detect_format(filename: &str) -> LcFormat {
     unsafe { lc_detect_format(c_filename.as_ptr()) }
 }
 
-/// Convert a file
-pub fn convert(input: &str, output: &str, dxf_version: LcDxfVersion) -> Result<(), String> {
-    let c_input = CString::new(input).unwrap();
-    let c_output = CString::new(output).unwrap();
+/// Open a document, run `f` on it and close it again
+fn with_document<T>(
+    filename: &str,
+    options: &LcOpenOptions,
+    f: impl FnOnce(*mut LcDocument) -> Result<T, String>,
+) -> Result<T, String> {
+    let c_filename = CString::new(filename).unwrap();
 
-    let result = unsafe { lc_convert(c_input.as_ptr(), c_output.as_ptr(), dxf_version) };
+    unsafe {
+        let doc = if filename == STDIO_NAME {
+            let source = LcSource {
+                kind: LcSourceKind::Stdin,
+                data: std::ptr::null(),
+                size: 0,
+                fd: 0,
+                name: c_filename.as_ptr(),
+            };
+            lc_document_open_source(&source, options)
+        } else {
+            lc_document_open_ex(c_filename.as_ptr(), options)
+        };
+        if doc.is_null() {
+            return Err(last_error());
+        }
 
-    if result == LcError::Ok {
-        Ok(())
-    } else {
-        Err(last_error())
+        let result = f(doc);
+        lc_document_close(doc);
+        result
     }
 }
 
-/// Get file info as JSON string
-pub fn get_file_info_json(filename: &str, detail: LcDetailLevel) -> Result<String, String> {
+/// Get the info of a file, run `f` on it and free it again
+fn with_file_info<T>(
+    filename: &str,
+    detail: LcDetailLevel,
+    options: &LcOpenOptions,
+    f: impl FnOnce(*mut LcFileInfo) -> Result<T, String>,
+) -> Result<T, String> {
+    if filename == STDIO_NAME {
+        // stdin can only be read once, so parse it whatever the detail level
+        return with_document(filename, options, |doc| unsafe {
+            let info = lc_document_get_info(doc, detail);
+            if info.is_null() {
+                return Err(last_error());
+            }
+
+            let result = f(info);
+            lc_file_info_free(info);
+            result
+        });
+    }
+
     let c_filename = CString::new(filename).unwrap();
 
     unsafe {
-        let info = lc_get_file_info(c_filename.as_ptr(), detail);
+        let info = lc_get_file_info_ex(c_filename.as_ptr(), detail, options);
         if info.is_null() {
             return Err(last_error());
         }
 
-        let json_ptr = lc_file_info_to_json(info);
+        let result = f(info);
         lc_file_info_free(info);
+        result
+    }
+}
+
+/// Convert a file
+pub fn convert(
+    input: &str,
+    output: &str,
+    dxf_version: LcDxfVersion,
+    dxf_format: LcDxfFormat,
+    options: &LcOpenOptions,
+) -> Result<(), String> {
+    let c_output = CString::new(output).unwrap();
+
+    with_document(input, options, |doc| {
+        let result = unsafe {
+            if output == STDIO_NAME {
+                // stdout gets DXF, there is no file name to pick the format from
+                lc_document_save_fd(doc, 1, LcFormat::Dxf, dxf_version, dxf_format)
+            } else {
+                lc_document_save_ex(doc, c_output.as_ptr(), dxf_version, dxf_format)
+            }
+        };
+
+        if result == LcError::Ok {
+            Ok(())
+        } else {
+            Err(last_error())
+        }
+    })
+}
+
+/// Get file info as JSON string
+pub fn get_file_info_json(
+    filename: &str,
+    detail: LcDetailLevel,
+    options: &LcOpenOptions,
+) -> Result<String, String> {
+    with_file_info(filename, detail, options, |info| unsafe {
+        let json_ptr = lc_file_info_to_json(info);
 
         if json_ptr.is_null() {
             return Err("Failed to convert to JSON".to_string());
@@ -366,38 +631,100 @@ pub fn get_file_info_json(filename: &str, detail: LcDetailLevel) -> Result<Strin
         lc_string_free(json_ptr);
 
         Ok(json)
-    }
+    })
 }
 
 /// Get file info structure
-pub fn get_file_info(filename: &str, detail: LcDetailLevel) -> Result<FileInfo, String> {
-    let c_filename = CString::new(filename).unwrap();
+pub fn get_file_info(
+    filename: &str,
+    detail: LcDetailLevel,
+    options: &LcOpenOptions,
+) -> Result<FileInfo, String> {
+    with_file_info(filename, detail, options, |info| unsafe { Ok(FileInfo::from_raw(info)) })
+}
 
-    unsafe {
-        let info = lc_get_file_info(c_filename.as_ptr(), detail);
-        if info.is_null() {
+/// How a file is validated
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum ValidateMode {
+    /// Open the document, then check it, entities on several threads
+    Document,
+    /// Check entities as they are read, optionally stopping at the first error
+    Streaming { fail_fast: bool },
+}
+
+/// Validate a file with the named rules (all when `None`), checking entities
+/// on as many threads as `options` parses with, run `f` on the result and free it
+fn with_validation_result<T>(
+    filename: &str,
+    rules: Option<&str>,
+    mode: ValidateMode,
+    options: &LcOpenOptions,
+    f: impl FnOnce(*mut LcValidationResult) -> Result<T, String>,
+) -> Result<T, String> {
+    let c_rules = match rules {
+        Some(rules) => Some(CString::new(rules).map_err(|_| "Invalid rule list".to_string())?),
+        None => None,
+    };
+    let validate_options = LcValidateOptions {
+        rules: c_rules.as_ref().map_or(std::ptr::null(), |r| r.as_ptr()),
+        threads: options.threads,
+        fail_fast: (mode == ValidateMode::Streaming { fail_fast: true }) as c_int,
+    };
+
+    let run = |result: *mut LcValidationResult| unsafe {
+        if result.is_null() {
             return Err(last_error());
         }
 
-        let result = FileInfo::from_raw(info);
-        lc_file_info_free(info);
+        let res = f(result);
+        lc_validation_result_free(result);
+        res
+    };
 
-        Ok(result)
+    if mode == ValidateMode::Document {
+        return with_document(filename, options, |doc| unsafe {
+            run(lc_document_validate_ex(doc, &validate_options))
+        });
     }
-}
 
-/// Validate a file and return JSON result
-pub fn validate_json(filename: &str) -> Result<String, String> {
     let c_filename = CString::new(filename).unwrap();
-
     unsafe {
-        let result = lc_validate(c_filename.as_ptr());
-        if result.is_null() {
-            return Err(last_error());
+        let result = if filename == STDIO_NAME {
+            let source = LcSource {
+                kind: LcSourceKind::Stdin,
+                data: std::ptr::null(),
+                size: 0,
+                fd: 0,
+                name: c_filename.as_ptr(),
+            };
+            lc_validate_source(&source, &validate_options)
+        } else {
+            lc_validate_ex(c_filename.as_ptr(), &validate_options)
+        };
+
+        // A file that could not be read comes back as a lone FILE_ERROR issue,
+        // fail as opening it does in the document mode
+        if !result.is_null() && (*result).rules_len == 0 && (*result).issue_count == 1 {
+            let issue = &*(*result).issues;
+            if CStr::from_ptr(issue.code).to_bytes() == b"FILE_ERROR" {
+                let message = CStr::from_ptr(issue.message).to_string_lossy().into_owned();
+                lc_validation_result_free(result);
+                return Err(message);
+            }
         }
+        run(result)
+    }
+}
 
+/// Validate a file and return JSON result
+pub fn validate_json(
+    filename: &str,
+    rules: Option<&str>,
+    mode: ValidateMode,
+    options: &LcOpenOptions,
+) -> Result<String, String> {
+    with_validation_result(filename, rules, mode, options, |result| unsafe {
         let json_ptr = lc_validation_result_to_json(result);
-        lc_validation_result_free(result);
 
         if json_ptr.is_null() {
             return Err("Failed to convert to JSON".to_string());
@@ -407,24 +734,83 @@ pub fn validate_json(filename: &str) -> Result<String, String> {
         lc_string_free(json_ptr);
 
         Ok(json)
-    }
+    })
 }
 
 /// Validate a file
-pub fn validate(filename: &str) -> Result<ValidationResult, String> {
-    let c_filename = CString::new(filename).unwrap();
+pub fn validate(
+    filename: &str,
+    rules: Option<&str>,
+    mode: ValidateMode,
+    options: &LcOpenOptions,
+) -> Result<ValidationResult, String> {
+    with_validation_result(filename, rules, mode, options, |result| unsafe {
+        Ok(ValidationResult::from_raw(result))
+    })
+}
 
-    unsafe {
-        let result = lc_validate(c_filename.as_ptr());
+/// A spatial query on the model space entities
+#[derive(Debug, Clone, Copy)]
+pub enum SpatialQuery {
+    /// Entities whose bounding box intersects the window
+    Window(LcBoundingBox),
+    /// The `k` entities nearest to the point
+    Nearest(LcPoint3D, usize),
+}
+
+/// Run a spatial query on a file, run `f` on its result and free it again
+fn with_query_result<T>(
+    filename: &str,
+    query: SpatialQuery,
+    options: &LcOpenOptions,
+    f: impl FnOnce(*mut LcQueryResult) -> Result<T, String>,
+) -> Result<T, String> {
+    with_document(filename, options, |doc| unsafe {
+        let result = match query {
+            SpatialQuery::Window(window) => lc_document_query_bbox(doc, &window),
+            SpatialQuery::Nearest(point, k) => {
+                lc_document_query_nearest(doc, &point, k.min(c_int::MAX as usize) as c_int)
+            }
+        };
         if result.is_null() {
             return Err(last_error());
         }
 
-        let res = ValidationResult::from_raw(result);
-        lc_validation_result_free(result);
+        let res = f(result);
+        lc_query_result_free(result);
+        res
+    })
+}
 
-        Ok(res)
-    }
+/// Query a file and return JSON result
+pub fn query_json(
+    filename: &str,
+    query: SpatialQuery,
+    options: &LcOpenOptions,
+) -> Result<String, String> {
+    with_query_result(filename, query, options, |result| unsafe {
+        let json_ptr = lc_query_result_to_json(result);
+
+        if json_ptr.is_null() {
+            return Err("Failed to convert to JSON".to_string());
+        }
+
+        let json = CStr::from_ptr(json_ptr).to_string_lossy().into_owned();
+        lc_string_free(json_ptr);
+
+        Ok(json)
+    })
+}
+
+/// Query a file
+pub fn query(
+    filename: &str,
+    query: SpatialQuery,
+    options: &LcOpenOptions,
+) -> Result<Vec<QueryHit>, String> {
+    with_query_result(filename, query, options, |result| unsafe {
+        Ok(QueryHit::from_raw(result))
+    })
 }
 
 // High-level Rust types
@@ -597,11 +983,22 @@ pub struct Issue {
     pub location: String,
 }
 
+/// Validation rule that ran (Rust-owned)
+#[derive(Debug, Clone)]
+pub struct RuleStats {
+    pub name: String,
+    pub seconds: f64,
+    pub issue_count: i32,
+}
+
 /// Validation result (Rust-owned)
 #[derive(Debug, Clone)]
 pub struct ValidationResult {
     pub is_valid: bool,
     pub issues: Vec<Issue>,
+    pub rules: Vec<RuleStats>,
+    /// Fail-fast stopped reading at the first error
+    pub stopped: bool,
 }
 
 impl ValidationResult {
@@ -633,13 +1030,66 @@ impl ValidationResult {
             }
         }
 
+        let mut rules = Vec::new();
+        if !result.rules.is_null() {
+            for i in 0..result.rules_len {
+                let rule = &*result.rules.offset(i as isize);
+                rules.push(RuleStats {
+                    name: if rule.name.is_null() {
+                        String::new()
+                    } else {
+                        CStr::from_ptr(rule.name).to_string_lossy().into_owned()
+                    },
+                    seconds: rule.seconds,
+                    issue_count: rule.issue_count,
+                });
+            }
+        }
+
         ValidationResult {
             is_valid: result.is_valid != 0,
             issues,
+            rules,
+            stopped: result.stopped != 0,
         }
     }
 }
 
+/// Entity found by a spatial query (Rust-owned)
+#[derive(Debug, Clone)]
+pub struct QueryHit {
+    pub index: i32,
+    pub entity_type: LcEntityType,
+    pub layer: String,
+    pub handle: i32,
+    pub distance: f64,
+}
+
+impl QueryHit {
+    unsafe fn from_raw(raw: *const LcQueryResult) -> Vec<Self> {
+        let result = &*raw;
+
+        let mut hits = Vec::new();
+        if !result.hits.is_null() {
+            for i in 0..result.hit_count {
+                let hit = &*result.hits.offset(i as isize);
+                hits.push(QueryHit {
+                    index: hit.index,
+                    entity_type: hit.entity_type,
+                    layer: if hit.layer.is_null() {
+                        String::new()
+                    } else {
+                        CStr::from_ptr(hit.layer).to_string_lossy().into_owned()
+                    },
+                    handle: hit.handle,
+                    distance: hit.distance,
+                });
+            }
+        }
+        hits
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -758,6 +1208,13 @@ mod tests {
         assert_eq!(LcFormat::Jwc as i32, 4);
     }
 
+    #[test]
+    fn test_source_kind_enum_values() {
+        assert_eq!(LcSourceKind::Memory as i32, 0);
+        assert_eq!(LcSourceKind::Fd as i32, 1);
+        assert_eq!(LcSourceKind::Stdin as i32, 2);
+    }
+
     #[test]
     fn test_detail_level_enum_values() {
         assert_eq!(LcDetailLevel::Summary as i32, 0);
@@ -766,6 +1223,14 @@ mod tests {
         assert_eq!(LcDetailLevel::Full as i32, 3);
     }
 
+    #[test]
+    fn test_open_options_with_jobs() {
+        assert_eq!(LcOpenOptions::default().threads, 1);
+        assert_eq!(LcOpenOptions::with_jobs(1).threads, 1);
+        assert_eq!(LcOpenOptions::with_jobs(8).threads, 8);
+        assert_eq!(LcOpenOptions::with_jobs(0).threads, LC_THREADS_AUTO);
+    }
+
     #[test]
     fn test_severity_enum_values() {
         assert_eq!(LcSeverity::Info as i32, 0);
@@ -773,3 +1238,133 @@ mod tests {
         assert_eq!(LcSeverity::Error as i32, 2);
     }
 }
+
+#[cfg(test)]
+mod cursor_tests {
+    use super::*;
+    use std::fmt::Write as _;
+    use std::path::PathBuf;
+    use std::time::{Duration, Instant};
+
+    fn fixture(name: &str) -> PathBuf {
+        PathBuf::from(env!("CARGO_MANIFEST_DIR")).join("tests").join("test_fixtures").join(name)
+    }
+
+    /// Open a cursor, or the error lc_cursor_open() reported
+    fn open_cursor(path: &std::path::Path) -> Result<*mut LcCursor, String> {
+        let c_path = CString::new(path.to_str().unwrap()).unwrap();
+        let cursor = unsafe { lc_cursor_open(c_path.as_ptr()) };
+        if cursor.is_null() {
+            Err(last_error())
+        } else {
+            Ok(cursor)
+        }
+    }
+
+    /// Types of the entities a cursor returns, or the error that ended it
+    fn cursor_types(path: &std::path::Path) -> Result<Vec<LcEntityType>, String> {
+        let cursor = open_cursor(path)?;
+        let mut types = Vec::new();
+        let result = loop {
+            let mut entity: *const LcEntityInfo = std::ptr::null();
+            let err = unsafe { lc_cursor_next(cursor, &mut entity) };
+            if err != LcError::Ok {
+                break Err(last_error());
+            }
+            if entity.is_null() {
+                break Ok(types);
+            }
+            types.push(unsafe { (*entity).entity_type });
+        };
+        unsafe { lc_cursor_close(cursor) };
+        result
+    }
+
+    fn info_types(path: &std::path::Path) -> Vec<LcEntityType> {
+        let info = get_file_info(path.to_str().unwrap(), LcDetailLevel::Verbose, &LcOpenOptions::default())
+            .expect("File should open");
+        assert_eq!(info.entities.len(), info.entity_count as usize);
+        info.entities.iter().map(|e| e.entity_type).collect()
+    }
+
+    /// An ASCII DXF of `count` lines, more than the cursor queues ahead
+    fn write_lines(path: &std::path::Path, count: usize) {
+        let mut dxf = String::from("  0\nSECTION\n  2\nENTITIES\n");
+        for i in 0..count {
+            write!(dxf, "  0\nLINE\n  8\n0\n 10\n{}\n 20\n0\n 11\n{}\n 21\n1\n", i, i + 1).unwrap();
+        }
+        dxf.push_str("  0\nENDSEC\n  0\nEOF\n");
+        std::fs::write(path, dxf).unwrap();
+    }
+
+    #[test]
+    fn test_cursor_matches_document_entities() {
+        for name in ["mixed_entities.dxf", "blocks.dxf", "curves.dxf"] {
+            let path = fixture(name);
+            let types = cursor_types(&path).expect("Cursor should read to the end");
+            assert!(!types.is_empty(), "{} has entities", name);
+            assert_eq!(types, info_types(&path), "Cursor over {} should match the document", name);
+        }
+
+        let temp_dir = tempfile::tempdir().unwrap();
+        let large = temp_dir.path().join("large.dxf");
+        write_lines(&large, 5000);
+        assert_eq!(cursor_types(&large).unwrap().len(), 5000);
+    }
+
+    #[test]
+    fn test_cursor_jww() {
+        let temp_dir = tempfile::tempdir().unwrap();
+        let jww = temp_dir.path().join("mixed.jww");
+        convert(
+            fixture("mixed_entities.dxf").to_str().unwrap(),
+            jww.to_str().unwrap(),
+            LcDxfVersion::V2007,
+            LcDxfFormat::Ascii,
+            &LcOpenOptions::default(),
+        )
+        .expect("Conversion to JWW should succeed");
+
+        let types = cursor_types(&jww).expect("Cursor should read a JWW file");
+        assert!(!types.is_empty());
+        assert_eq!(types, info_types(&jww));
+    }
+
+    #[test]
+    fn test_cursor_close_while_parser_waits() {
+        let temp_dir = tempfile::tempdir().unwrap();
+        let dxf = temp_dir.path().join("large.dxf");
+        write_lines(&dxf, 20000);
+        let jww = temp_dir.path().join("large.jww");
+        convert(dxf.to_str().unwrap(), jww.to_str().unwrap(), LcDxfVersion::V2007, LcDxfFormat::Ascii,
+                &LcOpenOptions::default())
+            .expect("Conversion to JWW should succeed");
+
+        for path in [&dxf, &jww] {
+            let cursor = open_cursor(path).unwrap();
+            let mut entity: *const LcEntityInfo = std::ptr::null();
+            assert_eq!(unsafe { lc_cursor_next(cursor, &mut entity) }, LcError::Ok);
+            assert!(!entity.is_null());
+
+            // Let the parser fill the queue and block on it, then close
+            std::thread::sleep(Duration::from_millis(100));
+            let start = Instant::now();
+            unsafe { lc_cursor_close(cursor) };
+            assert!(start.elapsed() < Duration::from_secs(10), "Close should not wait for the reader");
+        }
+    }
+
+    #[test]
+    fn test_cursor_errors() {
+        let missing = fixture("no_such_file.dxf");
+        let err = open_cursor(&missing).expect_err("Missing file should not open");
+        assert!(!err.is_empty());
+
+        // The parser only finds out on its thread, the cursor reports it
+        let temp_dir = tempfile::tempdir().unwrap();
+        let malformed = temp_dir.path().join("malformed.dxf");
+        std::fs::write(&malformed, "  0\nSECTION\n  2\nENTITIES\n  0\nLINE\n 10\nnot a number\n").unwrap();
+        let err = cursor_types(&malformed).expect_err("Malformed file should fail");
+        assert!(!err.is_empty());
+    }
+}
@@ -10,7 +10,10 @@ use clap::{Parser, Subcommand};
 use colored::*;
 use std::path::PathBuf;
 
-use ffi::{LcDetailLevel, LcDxfVersion, LcEntityType, LcSeverity};
+use ffi::{
+    LcBoundingBox, LcBoundsMode, LcDetailLevel, LcDxfFormat, LcDxfVersion, LcEntityType, LcFormat, LcOpenOptions,
+    LcPoint3D, LcSeverity, SpatialQuery, ValidateMode,
+};
 
 #[derive(Parser)]
 #[command(name = "cadutil")]
@@ -20,26 +23,34 @@ use ffi::{LcDetailLevel, LcDxfVersion, LcEntityType, LcSeverity};
 struct Cli {
     #[command(subcommand)]
     command: Commands,
+
+    /// Threads used to parse DXF entities and to check them in validate (0 = one per CPU core)
+    #[arg(long, global = true, default_value_t = 1)]
+    jobs: usize,
 }
 
 #[derive(Subcommand)]
 enum Commands {
     /// Convert files between DXF and JWW formats
     Convert {
-        /// Input file (DXF or JWW)
+        /// Input file (DXF or JWW), - to read stdin
         input: PathBuf,
 
-        /// Output file (DXF or JWW)
+        /// Output file (DXF or JWW), - to write DXF to stdout
         output: PathBuf,
 
         /// DXF version for output (r12, r14, 2000, 2004, 2007, 2010, 2013, 2018)
         #[arg(short = 'V', long, default_value = "2007")]
         dxf_version: String,
+
+        /// Write binary DXF (smaller and faster to read back)
+        #[arg(long)]
+        binary: bool,
     },
 
     /// Display file information
     Info {
-        /// Input file to analyze
+        /// Input file to analyze, - to read stdin
         input: PathBuf,
 
         /// Detail level (summary, normal, verbose, full)
@@ -49,13 +60,56 @@ enum Commands {
         /// Output as JSON
         #[arg(short, long)]
         json: bool,
+
+        /// Bounds computation (fast, refined = exact arcs, ellipses and splines)
+        #[arg(long, default_value = "fast")]
+        bounds: String,
     },
 
     /// Validate a DXF file
     Validate {
-        /// Input file to validate
+        /// Input file to validate, - to read stdin
         input: PathBuf,
 
+        /// Comma separated rules to run (default: all; an unknown name lists them)
+        #[arg(long, value_name = "RULE,...")]
+        rules: Option<String>,
+
+        /// Check entities while the file is read instead of after opening it
+        #[arg(long)]
+        stream: bool,
+
+        /// Stop reading at the first error (implies --stream)
+        #[arg(long)]
+        fail_fast: bool,
+
+        /// Also print the issue count and time of every rule
+        #[arg(short, long)]
+        verbose: bool,
+
+        /// Output as JSON
+        #[arg(short, long)]
+        json: bool,
+    },
+
+    /// Find entities by location
+    Query {
+        /// Input file to search, - to read stdin
+        input: PathBuf,
+
+        /// Entities whose bounding box intersects the window x0,y0,x1,y1
+        #[arg(long, value_name = "X0,Y0,X1,Y1", allow_hyphen_values = true,
+              required_unless_present = "nearest", conflicts_with = "nearest")]
+        bbox: Option<String>,
+
+        /// Entities nearest to the point x,y
+        #[arg(long, value_name = "X,Y", allow_hyphen_values = true)]
+        nearest: Option<String>,
+
+        /// Number of entities --nearest returns
+        #[arg(short = 'k', long, default_value_t = 1)]
+        count: usize,
+
         /// Output as JSON
         #[arg(short, long)]
         json: bool,
@@ -67,21 +121,46 @@ enum Commands {
 
 fn main() -> Result<()> {
     let cli = Cli::parse();
+    let options = LcOpenOptions::with_jobs(cli.jobs);
 
     match cli.command {
         Commands::Convert {
             input,
             output,
             dxf_version,
-        } => cmd_convert(&input, &output, &dxf_version),
+            binary,
+        } => cmd_convert(&input, &output, &dxf_version, binary, &options),
 
         Commands::Info {
             input,
             detail,
             json,
-        } => cmd_info(&input, &detail, json),
+            bounds,
+        } => cmd_info(&input, &detail, json, &bounds, &options),
 
-        Commands::Validate { input, json } => cmd_validate(&input, json),
+        Commands::Validate {
+            input,
+            rules,
+            stream,
+            fail_fast,
+            verbose,
+            json,
+        } => {
+            let mode = if stream || fail_fast {
+                ValidateMode::Streaming { fail_fast }
+            } else {
+                ValidateMode::Document
+            };
+            cmd_validate(&input, rules.as_deref(), mode, json, verbose, &options)
+        }
+
+        Commands::Query {
+            input,
+            bbox,
+            nearest,
+            count,
+            json,
+        } => cmd_query(&input, bbox.as_deref(), nearest.as_deref(), count, json, &options),
 
         Commands::Version => {
             println!("cadutil {}", env!("CARGO_PKG_VERSION"));
@@ -91,49 +170,85 @@ fn main() -> Result<()> {
     }
 }
 
-fn cmd_convert(input: &PathBuf, output: &PathBuf, dxf_version: &str) -> Result<()> {
+fn cmd_convert(
+    input: &PathBuf,
+    output: &PathBuf,
+    dxf_version: &str,
+    binary: bool,
+    options: &LcOpenOptions,
+) -> Result<()> {
     let input_str = input.to_string_lossy();
     let output_str = output.to_string_lossy();
 
     // Detect formats
     let in_format = ffi::detect_format(&input_str);
-    let out_format = ffi::detect_format(&output_str);
+    let to_stdout = output_str == ffi::STDIO_NAME;
+    let out_format = if to_stdout {
+        LcFormat::Dxf
+    } else {
+        ffi::detect_format(&output_str)
+    };
+
+    // Progress goes to stderr when the drawing itself is written to stdout
+    let progress = |line: String| {
+        if to_stdout {
+            eprintln!("{}", line);
+        } else {
+            println!("{}", line);
+        }
+    };
 
-    println!(
+    progress(format!(
         "{} {} ({}) -> {} ({})",
         "Converting:".green().bold(),
         input_str,
         in_format.as_str(),
         output_str,
         out_format.as_str()
-    );
+    ));
 
     // Parse DXF version
     let version: LcDxfVersion = dxf_version
         .parse()
         .map_err(|e: String| anyhow::anyhow!("{}", e))?;
 
+    let format = if binary {
+        if out_format != LcFormat::Dxf {
+            return Err(anyhow::anyhow!("--binary requires a DXF output file"));
+        }
+        LcDxfFormat::Binary
+    } else {
+        LcDxfFormat::Ascii
+    };
+
     // Perform conversion
-    ffi::convert(&input_str, &output_str, version)
+    ffi::convert(&input_str, &output_str, version, format, options)
         .map_err(|e| anyhow::anyhow!("Conversion failed: {}", e))?;
 
-    println!("{}", "Conversion completed successfully!".green());
+    progress(format!("{}", "Conversion completed successfully!".green()));
     Ok(())
 }
 
-fn cmd_info(input: &PathBuf, detail: &str, json: bool) -> Result<()> {
+fn cmd_info(input: &PathBuf, detail: &str, json: bool, bounds: &str, options: &LcOpenOptions) -> Result<()> {
     let input_str = input.to_string_lossy();
 
     let detail_level: LcDetailLevel = detail
         .parse()
         .map_err(|e: String| anyhow::anyhow!("{}", e))?;
+    let bounds_mode: LcBoundsMode = bounds
+        .parse()
+        .map_err(|e: String| anyhow::anyhow!("{}", e))?;
+    let options = LcOpenOptions {
+        bounds: bounds_mode,
+        ..*options
+    };
 
     if json {
-        let json_output = ffi::get_file_info_json(&input_str, detail_level)
+        let json_output = ffi::get_file_info_json(&input_str, detail_level, &options)
             .map_err(|e| anyhow::anyhow!("Failed to get file info: {}", e))?;
         println!("{}", json_output);
     } else {
-        let info = ffi::get_file_info(&input_str, detail_level)
+        let info = ffi::get_file_info(&input_str, detail_level, &options)
             .map_err(|e| anyhow::anyhow!("Failed to get file info: {}", e))?;
 
         print_file_info(&info, detail_level);
@@ -268,24 +383,32 @@ fn print_file_info(info: &ffi::FileInfo, detail: LcDetailLevel) {
     }
 }
 
-fn cmd_validate(input: &PathBuf, json: bool) -> Result<()> {
+fn cmd_validate(
+    input: &PathBuf,
+    rules: Option<&str>,
+    mode: ValidateMode,
+    json: bool,
+    verbose: bool,
+    options: &LcOpenOptions,
+) -> Result<()> {
     let input_str = input.to_string_lossy();
 
     if json {
-        let json_output = ffi::validate_json(&input_str)
+        let json_output = ffi::validate_json(&input_str, rules, mode, options)
             .map_err(|e| anyhow::anyhow!("Validation failed: {}", e))?;
         println!("{}", json_output);
     } else {
-        let result = ffi::validate(&input_str)
+        let result = ffi::validate(&input_str, rules, mode, options)
             .map_err(|e| anyhow::anyhow!("Validation failed: {}", e))?;
 
-        print_validation_result(&result, &input_str);
+        // The rule table is for tuning a rule selection, not for every run
+        print_validation_result(&result, &input_str, verbose || rules.is_some());
     }
 
     Ok(())
 }
 
-fn print_validation_result(result: &ffi::ValidationResult, filename: &str) {
+fn print_validation_result(result: &ffi::ValidationResult, filename: &str, show_rules: bool) {
     println!("{}", "Validation Result".cyan().bold());
     println!("{}", "=================".cyan());
     println!("  File: {}", filename);
@@ -297,6 +420,9 @@ fn print_validation_result(result: &ffi::ValidationResult, filename: &str) {
     }
 
     println!("  Issues: {}", result.issues.len());
+    if result.stopped {
+        println!("  {}", "Stopped at the first error, the rest of the file was not checked".yellow());
+    }
     println!();
 
     if !result.issues.is_empty() {
@@ -318,5 +444,93 @@ fn print_validation_result(result: &ffi::ValidationResult, filename: &str) {
                 println!("         at {}", issue.location.dimmed());
             }
         }
+        println!();
+    }
+
+    if !show_rules {
+        return;
+    }
+    println!("{}", "Rules".cyan().bold());
+    println!("{}", "-----".cyan());
+    for rule in &result.rules {
+        println!(
+            "  {:<24} {:>6} issues {:>10.3} ms",
+            rule.name,
+            rule.issue_count,
+            rule.seconds * 1000.0
+        );
+    }
+}
+
+/// Parse `n` comma separated numbers
+fn parse_coords(value: &str, n: usize, what: &str) -> Result<Vec<f64>> {
+    let coords: Vec<f64> = value
+        .split(',')
+        .map(|c| c.trim().parse::<f64>())
+        .collect::<Result<_, _>>()
+        .map_err(|_| anyhow::anyhow!("Invalid {}: {}", what, value))?;
+    if coords.len() != n {
+        return Err(anyhow::anyhow!("{} needs {} comma separated numbers: {}", what, n, value));
+    }
+    Ok(coords)
+}
+
+fn cmd_query(
+    input: &PathBuf,
+    bbox: Option<&str>,
+    nearest: Option<&str>,
+    count: usize,
+    json: bool,
+    options: &LcOpenOptions,
+) -> Result<()> {
+    let input_str = input.to_string_lossy();
+
+    let query = match (bbox, nearest) {
+        (Some(bbox), _) => {
+            let c = parse_coords(bbox, 4, "--bbox")?;
+            SpatialQuery::Window(LcBoundingBox {
+                min: LcPoint3D { x: c[0], y: c[1], z: 0.0 },
+                max: LcPoint3D { x: c[2], y: c[3], z: 0.0 },
+            })
+        }
+        (None, Some(point)) => {
+            let c = parse_coords(point, 2, "--nearest")?;
+            SpatialQuery::Nearest(LcPoint3D { x: c[0], y: c[1], z: 0.0 }, count)
+        }
+        (None, None) => return Err(anyhow::anyhow!("Either --bbox or --nearest is required")),
+    };
+
+    if json {
+        let json_output = ffi::query_json(&input_str, query, options)
+            .map_err(|e| anyhow::anyhow!("Query failed: {}", e))?;
+        println!("{}", json_output);
+    } else {
+        let hits = ffi::query(&input_str, query, options)
+            .map_err(|e| anyhow::anyhow!("Query failed: {}", e))?;
+
+        print_query_hits(&hits, matches!(query, SpatialQuery::Nearest(..)));
+    }
+
+    Ok(())
+}
+
+fn print_query_hits(hits: &[ffi::QueryHit], nearest: bool) {
+    println!("{}", "Query Result".cyan().bold());
+    println!("{}", "============".cyan());
+    println!("  Entities: {}", hits.len());
+    println!();
+
+    for hit in hits {
+        print!(
+            "  {:6}. {:12} layer: {:16} handle: {:X}",
+            hit.index,
+            hit.entity_type.as_str(),
+            hit.layer,
+            hit.handle
+        );
+        if nearest {
+            print!("  distance: {:.4}", hit.distance);
+        }
+        println!();
     }
 }
@@ -166,6 +166,37 @@ mod info_tests {
         assert!(stdout.contains("\"layer_count\""), "JSON should contain layer_count field");
     }
 
+    #[test]
+    fn test_info_from_stdin() {
+        use std::io::Write;
+        use std::process::Stdio;
+
+        let test_file = get_test_dxf_path();
+        let from_file = run_cadutil(&["info", test_file.to_str().unwrap(), "--json", "--detail", "full"]);
+
+        let mut child = Command::new(get_binary_path())
+            .args(["info", "-", "--json", "--detail", "full"])
+            .env("LD_LIBRARY_PATH", get_lib_path())
+            .stdin(Stdio::piped())
+            .stdout(Stdio::piped())
+            .spawn()
+            .expect("Failed to execute cadutil");
+        let data = std::fs::read(&test_file).unwrap();
+        child.stdin.take().unwrap().write_all(&data).unwrap();
+        let from_stdin = child.wait_with_output().unwrap();
+
+        assert!(from_stdin.status.success(), "Info on stdin should succeed");
+        // Everything but the filename must match reading the file
+        let strip = |out: &[u8]| {
+            String::from_utf8_lossy(out)
+                .lines()
+                .filter(|l| !l.contains("\"filename\""))
+                .collect::<Vec<_>>()
+                .join("\n")
+        };
+        assert_eq!(strip(&from_stdin.stdout), strip(&from_file.stdout));
+    }
+
     #[test]
     fn test_info_nonexistent_file() {
         let output = run_cadutil(&["info", "/nonexistent/file.dxf"]);
@@ -345,6 +376,113 @@ mod convert_tests {
         assert!(output.status.success(), "Convert DXF to JWW should succeed");
         assert!(output_file.exists(), "JWW output file should be created");
     }
+
+    #[test]
+    fn test_convert_binary() {
+        let test_file = get_test_dxf_path();
+        let temp_dir = tempdir().expect("Failed to create temp dir");
+        let output_file = temp_dir.path().join("output.dxf");
+
+        let output = run_cadutil(&[
+            "convert",
+            test_file.to_str().unwrap(),
+            output_file.to_str().unwrap(),
+            "--binary",
+        ]);
+
+        assert!(output.status.success(), "Convert to binary DXF should succeed");
+        let content = fs::read(&output_file).expect("Failed to read output");
+        assert!(content.starts_with(b"AutoCAD Binary DXF\r\n"), "Output should be binary DXF");
+
+        // Reading it back gives the same drawing
+        let original = run_cadutil(&["info", test_file.to_str().unwrap(), "--json"]);
+        let converted = run_cadutil(&["info", output_file.to_str().unwrap(), "--json"]);
+        assert!(converted.status.success(), "Binary DXF should be readable");
+        let count = |out: &[u8]| {
+            String::from_utf8_lossy(out)
+                .lines()
+                .find(|l| l.contains("\"entity_count\""))
+                .map(|l| l.to_string())
+        };
+        assert!(count(&original.stdout).is_some());
+        assert_eq!(count(&original.stdout), count(&converted.stdout), "Entities should survive binary output");
+    }
+
+    #[test]
+    fn test_convert_binary_to_jww() {
+        let test_file = get_test_dxf_path();
+        let temp_dir = tempdir().expect("Failed to create temp dir");
+        let output_file = temp_dir.path().join("output.jww");
+
+        let output = run_cadutil(&[
+            "convert",
+            test_file.to_str().unwrap(),
+            output_file.to_str().unwrap(),
+            "--binary",
+        ]);
+
+        assert!(!output.status.success(), "--binary with JWW output should fail");
+    }
+
+    #[test]
+    fn test_convert_to_stdout() {
+        let test_file = get_test_dxf_path();
+        let temp_dir = tempdir().expect("Failed to create temp dir");
+
+        for binary in [false, true] {
+            let output_file = temp_dir.path().join("output.dxf");
+            let mut to_file = vec!["convert", test_file.to_str().unwrap(), output_file.to_str().unwrap()];
+            let mut to_stdout = vec!["convert", test_file.to_str().unwrap(), "-"];
+            if binary {
+                to_file.push("--binary");
+                to_stdout.push("--binary");
+            }
+            assert!(run_cadutil(&to_file).status.success());
+            let output = run_cadutil(&to_stdout);
+
+            assert!(output.status.success(), "Convert to stdout should succeed");
+            // Progress messages go to stderr, stdout holds only the drawing
+            let content = fs::read(&output_file).expect("Failed to read output");
+            assert_eq!(output.stdout, content, "stdout should match the file output");
+        }
+    }
+
+    #[test]
+    fn test_convert_gzip() {
+        let test_file = get_test_dxf_path();
+        let temp_dir = tempdir().expect("Failed to create temp dir");
+        let count = |out: &[u8]| {
+            String::from_utf8_lossy(out)
+                .lines()
+                .find(|l| l.contains("\"entity_count\""))
+                .map(|l| l.to_string())
+        };
+        let original = run_cadutil(&["info", test_file.to_str().unwrap(), "--json"]);
+        assert!(count(&original.stdout).is_some());
+
+        for (name, binary) in [("output.dxf.gz", false), ("output_bin.dxf.gz", true)] {
+            let output_file = temp_dir.path().join(name);
+            let mut args = vec!["convert", test_file.to_str().unwrap(), output_file.to_str().unwrap()];
+            if binary {
+                args.push("--binary");
+            }
+            let output = run_cadutil(&args);
+            assert!(output.status.success(), "Convert to {} should succeed", name);
+            let content = fs::read(&output_file).expect("Failed to read output");
+            assert!(content.starts_with(&[0x1f, 0x8b]), "{} should be gzip compressed", name);
+
+            let converted = run_cadutil(&["info", output_file.to_str().unwrap(), "--json"]);
+            assert!(converted.status.success(), "{} should be readable", name);
+            assert_eq!(count(&original.stdout), count(&converted.stdout), "Entities should survive {}", name);
+        }
+
+        // Compressed input is recognised by content, not by name
+        let renamed = temp_dir.path().join("renamed.dxf");
+        fs::copy(temp_dir.path().join("output.dxf.gz"), &renamed).expect("Failed to copy");
+        let converted = run_cadutil(&["info", renamed.to_str().unwrap(), "--json"]);
+        assert!(converted.status.success(), "Gzip DXF named .dxf should be readable");
+        assert_eq!(count(&original.stdout), count(&converted.stdout));
+    }
 }
 
 mod error_handling_tests {
@@ -410,6 +548,244 @@ mod fixture_tests {
         PathBuf::from(manifest_dir).join("tests").join("test_fixtures")
     }
 
+    #[test]
+    fn test_summary_matches_normal_detail() {
+        // The summary is computed by a separate count-only scan; its fields
+        // must agree with the head of the fully parsed output
+        for name in ["blocks.dxf", "circles.dxf", "mixed_entities.dxf", "simple_line.dxf"] {
+            let file = get_fixtures_path().join(name);
+            let summary = run_cadutil(&["info", file.to_str().unwrap(), "--json", "--detail", "summary"]);
+            let normal = run_cadutil(&["info", file.to_str().unwrap(), "--json", "--detail", "normal"]);
+
+            assert!(summary.status.success() && normal.status.success(), "Info on {} should succeed", name);
+            let summary = String::from_utf8_lossy(&summary.stdout);
+            let normal = String::from_utf8_lossy(&normal.stdout);
+            let head = summary.trim_end().trim_end_matches('}').trim_end();
+            assert!(normal.starts_with(head), "Summary of {} differs from normal detail", name);
+        }
+    }
+
+    #[test]
+    fn test_block_contents_and_insert_bounds() {
+        // Block contents are not model space; INSERTs extend the bounds by
+        // the placed block, nested, rotated, scaled and arrayed
+        let file = get_fixtures_path().join("blocks.dxf");
+        let output = run_cadutil(&["info", file.to_str().unwrap(), "--json"]);
+        assert!(output.status.success(), "Info on blocks.dxf should succeed");
+
+        let json: serde_json::Value = serde_json::from_slice(&output.stdout)
+            .expect("Output should be valid JSON");
+        assert_eq!(json["entity_count"].as_i64().unwrap(), 4);
+        let counts: Vec<i64> = json["blocks"].as_array().unwrap().iter()
+            .map(|b| b["entity_count"].as_i64().unwrap())
+            .collect();
+        assert_eq!(counts, [2, 2, 1]);
+
+        let min = &json["bounds"]["min"];
+        let max = &json["bounds"]["max"];
+        let close = |v: &serde_json::Value, expected: f64| (v.as_f64().unwrap() - expected).abs() < 1e-9;
+        assert!(close(&min[0], -7.0) && close(&min[1], -10.0), "Unexpected bounds min {}", min);
+        assert!(close(&max[0], 100.0) && close(&max[1], 124.0), "Unexpected bounds max {}", max);
+    }
+
+    #[test]
+    fn test_refined_bounds_of_curves() {
+        // A quarter arc, the upper half of an ellipse and a quadratic spline
+        // whose middle control point lies above the curve
+        let file = get_fixtures_path().join("curves.dxf");
+        let bounds = |mode: &str| -> (serde_json::Value, serde_json::Value) {
+            let output = run_cadutil(&["info", file.to_str().unwrap(), "--json", "--bounds", mode]);
+            assert!(output.status.success(), "Info with --bounds {} should succeed", mode);
+            let json: serde_json::Value = serde_json::from_slice(&output.stdout)
+                .expect("Output should be valid JSON");
+            (json["bounds"]["min"].clone(), json["bounds"]["max"].clone())
+        };
+        let close = |v: &serde_json::Value, expected: f64| (v.as_f64().unwrap() - expected).abs() < 1e-6;
+
+        let (min, max) = bounds("refined");
+        assert!(close(&min[0], 0.0) && close(&min[1], 0.0), "Unexpected refined min {}", min);
+        assert!(close(&max[0], 120.0) && close(&max[1], 10.0), "Unexpected refined max {}", max);
+
+        // The fast bounds are conservative and contain the refined ones
+        let (min, max) = bounds("fast");
+        assert!(min[0].as_f64().unwrap() <= 0.0 && min[1].as_f64().unwrap() <= 0.0);
+        assert!(max[0].as_f64().unwrap() >= 120.0 && max[1].as_f64().unwrap() > 10.0);
+
+        let output = run_cadutil(&["info", file.to_str().unwrap(), "--bounds", "nope"]);
+        assert!(!output.status.success(), "Unknown bounds mode should fail");
+    }
+
+    fn validate_json(file: &str, args: &[&str]) -> serde_json::Value {
+        let file = get_fixtures_path().join(file);
+        let mut all = vec!["validate", file.to_str().unwrap(), "--json"];
+        all.extend_from_slice(args);
+        let output = run_cadutil(&all);
+        assert!(output.status.success(), "Validate {:?} should succeed", args);
+        serde_json::from_slice(&output.stdout).expect("Output should be valid JSON")
+    }
+
+    #[test]
+    fn test_validation_rules() {
+        let json = validate_json("invalid.dxf", &[]);
+        assert_eq!(json["is_valid"], false);
+        let issues: Vec<(String, String)> = json["issues"].as_array().unwrap().iter()
+            .map(|i| (i["code"].as_str().unwrap().to_string(), i["location"].as_str().unwrap().to_string()))
+            .collect();
+        let expected = [
+            ("UNDEFINED_LAYER", "entity #1"),
+            ("ZERO_LENGTH_LINE", "entity #1"),
+            ("INVALID_RADIUS", "entity #2"),
+            ("INVALID_ELLIPSE", "entity #3"),
+        ];
+        assert_eq!(issues, expected.map(|(c, l)| (c.to_string(), l.to_string())));
+
+        // Every rule reports its issue count and time
+        let rules = json["rules"].as_array().unwrap();
+        assert_eq!(rules.len(), 9);
+        for rule in rules {
+            assert!(rule["time_ms"].as_f64().unwrap() >= 0.0, "Rule {} has no time", rule["name"]);
+        }
+        let radius = rules.iter().find(|r| r["name"] == "invalid-radius").unwrap();
+        assert_eq!(radius["issue_count"], 1);
+    }
+
+    #[test]
+    fn test_validate_selected_rules() {
+        let json = validate_json("invalid.dxf", &["--rules", "zero-length-line,undefined-block"]);
+        assert_eq!(json["is_valid"], true, "A zero length line is only a warning");
+        assert_eq!(json["issue_count"], 1);
+        assert_eq!(json["issues"][0]["code"], "ZERO_LENGTH_LINE");
+        let names: Vec<&str> = json["rules"].as_array().unwrap().iter()
+            .map(|r| r["name"].as_str().unwrap())
+            .collect();
+        assert_eq!(names, ["undefined-block", "zero-length-line"], "Rules run in table order");
+
+        let file = get_fixtures_path().join("invalid.dxf");
+        let output = run_cadutil(&["validate", file.to_str().unwrap(), "--rules", "no-such-rule"]);
+        assert!(!output.status.success(), "Unknown rule should fail");
+        assert!(String::from_utf8_lossy(&output.stderr).contains("invalid-radius"), "Error should list the rules");
+
+        let json = validate_json("invalid.dxf", &["--rules", "invalid-ellipse"]);
+        assert_eq!(json["is_valid"], true, "An invalid ellipse is only a warning");
+        assert_eq!(json["issues"][0]["severity"], "warning");
+    }
+
+    #[test]
+    fn test_validate_rule_table() {
+        let file = get_fixtures_path().join("invalid.dxf");
+        let text = |args: &[&str]| -> String {
+            let mut all = vec!["validate", file.to_str().unwrap()];
+            all.extend_from_slice(args);
+            let output = run_cadutil(&all);
+            assert!(output.status.success(), "Validate {:?} should succeed", args);
+            String::from_utf8_lossy(&output.stdout).to_string()
+        };
+
+        assert!(!text(&[]).contains("Rules"), "The rule table is only printed on request");
+        assert!(text(&["--verbose"]).contains("invalid-radius"));
+        let selected = text(&["--rules", "invalid-radius"]);
+        assert!(selected.contains("Rules") && selected.contains("invalid-radius"));
+    }
+
+    #[test]
+    fn test_validate_stream_matches_document() {
+        for file in ["invalid.dxf", "blocks.dxf", "mixed_entities.dxf"] {
+            let document = validate_json(file, &[]);
+            let stream = validate_json(file, &["--stream"]);
+            assert_eq!(stream["issues"], document["issues"], "Streaming issues of {} should match", file);
+            assert_eq!(stream["rules"].as_array().unwrap().len(), 9);
+            assert!(stream.get("stopped").is_none(), "Only fail-fast stops");
+        }
+    }
+
+    #[test]
+    fn test_validate_stream_forward_references() {
+        // The layer table follows the entities and a block inserts one defined after it
+        for args in [&[][..], &["--stream"][..], &["--fail-fast"][..]] {
+            let json = validate_json("forward_refs.dxf", args);
+            assert_eq!(json["is_valid"], true, "Validate {:?}", args);
+            assert_eq!(json["issue_count"], 0, "Validate {:?}: {}", args, json["issues"]);
+        }
+    }
+
+    fn query_json(file: &str, args: &[&str]) -> serde_json::Value {
+        let file = get_fixtures_path().join(file);
+        let mut all = vec!["query", file.to_str().unwrap(), "--json"];
+        all.extend_from_slice(args);
+        let output = run_cadutil(&all);
+        assert!(output.status.success(), "Query {:?} should succeed", args);
+        serde_json::from_slice(&output.stdout).expect("Output should be valid JSON")
+    }
+
+    fn hit_indices(json: &serde_json::Value) -> Vec<i64> {
+        json["hits"].as_array().unwrap().iter()
+            .map(|h| h["index"].as_i64().unwrap())
+            .collect()
+    }
+
+    #[test]
+    fn test_query_bbox() {
+        // Indexed boxes are exact: the spline's middle control point at
+        // (110, 20) lies well above the curve, which peaks at y = 10
+        assert_eq!(hit_indices(&query_json("curves.dxf", &["--bbox", "0,0,10,10"])), [0]);
+        assert_eq!(hit_indices(&query_json("curves.dxf", &["--bbox", "108,15,112,20"])), Vec::<i64>::new());
+        assert_eq!(hit_indices(&query_json("curves.dxf", &["--bbox", "200,-100,-100,100"])), [0, 1, 2]);
+        assert_eq!(hit_indices(&query_json("curves.dxf", &["--bbox", "-5,-5,-1,-1"])), Vec::<i64>::new());
+
+        // INSERTs are found by the block they place, not only their insertion point
+        assert_eq!(hit_indices(&query_json("blocks.dxf", &["--bbox", "90,105,101,130"])), [1]);
+    }
+
+    #[test]
+    fn test_query_nearest() {
+        let json = query_json("curves.dxf", &["--nearest", "125,0", "-k", "2"]);
+        assert_eq!(hit_indices(&json), [2, 1]);
+        assert_eq!(json["hits"][0]["type"], "SPLINE");
+        assert!((json["hits"][0]["distance"].as_f64().unwrap() - 5.0).abs() < 1e-9);
+        assert!((json["hits"][1]["distance"].as_f64().unwrap() - 55.0).abs() < 1e-9);
+
+        // k beyond the entity count returns every indexed entity
+        assert_eq!(hit_indices(&query_json("blocks.dxf", &["--nearest", "-7,3", "-k", "10"])), [3, 0, 2, 1]);
+    }
+
+    #[test]
+    fn test_query_invalid_arguments() {
+        let file = get_fixtures_path().join("curves.dxf");
+        let file = file.to_str().unwrap();
+        for args in [
+            vec!["query", file],
+            vec!["query", file, "--bbox", "1,2,3"],
+            vec!["query", file, "--bbox", "a,b,c,d"],
+            vec!["query", file, "--bbox", "0,0,1,1", "--nearest", "0,0"],
+        ] {
+            let output = run_cadutil(&args);
+            assert!(!output.status.success(), "{:?} should fail", args);
+        }
+    }
+
+    #[test]
+    fn test_convert_keeps_block_contents() {
+        let temp_dir = tempfile::tempdir().expect("Failed to create temp dir");
+        let file = get_fixtures_path().join("blocks.dxf");
+        let output_file = temp_dir.path().join("blocks_out.dxf");
+
+        let output = run_cadutil(&["convert", file.to_str().unwrap(), output_file.to_str().unwrap()]);
+        assert!(output.status.success(), "Convert should succeed");
+
+        let original = run_cadutil(&["info", file.to_str().unwrap(), "--json"]);
+        let converted = run_cadutil(&["info", output_file.to_str().unwrap(), "--json"]);
+        let original: serde_json::Value = serde_json::from_slice(&original.stdout).unwrap();
+        let converted: serde_json::Value = serde_json::from_slice(&converted.stdout).unwrap();
+        let user_blocks = |json: &serde_json::Value| -> Vec<serde_json::Value> {
+            json["blocks"].as_array().unwrap().iter()
+                .filter(|b| !b["name"].as_str().unwrap().starts_with('*'))
+                .cloned()
+                .collect()
+        };
+        assert_eq!(user_blocks(&original), user_blocks(&converted));
+        assert_eq!(original["bounds"], converted["bounds"]);
+    }
+
     #[test]
     fn test_empty_dxf_info() {
         let empty_file = get_fixtures_path().join("empty.dxf");
@@ -497,3 +873,166 @@ mod fixture_tests {
         assert!(json["issues"].as_array().is_some(), "Should have issues array");
     }
 }
+
+mod parallel_tests {
+    use super::*;
+    use std::fmt::Write as _;
+    use std::fs;
+    use tempfile::tempdir;
+
+    /// Write an ASCII DXF large enough to be split between parser threads
+    fn write_large_dxf(path: &std::path::Path, count: usize) {
+        let mut dxf = String::from("  0\nSECTION\n  2\nHEADER\n  9\n$ACADVER\n  1\nAC1015\n  0\nENDSEC\n");
+        dxf.push_str("  0\nSECTION\n  2\nENTITIES\n");
+        for i in 0..count {
+            let x = (i % 100) as f64 * 2.5;
+            let y = (i / 100) as f64 * 1.5;
+            match i % 3 {
+                0 => write!(
+                    dxf,
+                    "  0\nLINE\n  8\nL{}\n 10\n{}\n 20\n{}\n 11\n{}\n 21\n{}\n",
+                    i % 4, x, y, x + 1.0, y + 0.5
+                ),
+                1 => write!(dxf, "  0\nCIRCLE\n  8\nL{}\n 10\n{}\n 20\n{}\n 40\n0.75\n", i % 4, x, y),
+                _ => write!(
+                    dxf,
+                    "  0\nPOLYLINE\n  8\nL{}\n 66\n1\n 10\n0\n 20\n0\n  0\nVERTEX\n 10\n{}\n 20\n{}\n  0\nVERTEX\n 10\n{}\n 20\n{}\n  0\nSEQEND\n",
+                    i % 4, x, y, x, y + 1.0
+                ),
+            }
+            .unwrap();
+        }
+        dxf.push_str("  0\nENDSEC\n  0\nEOF\n");
+        fs::write(path, dxf).expect("Failed to write test DXF");
+    }
+
+    #[test]
+    fn test_info_jobs_matches_single_thread() {
+        let temp_dir = tempdir().expect("Failed to create temp dir");
+        let input = temp_dir.path().join("large.dxf");
+        write_large_dxf(&input, 9000);
+
+        let single = run_cadutil(&["info", input.to_str().unwrap(), "--json", "--detail", "full"]);
+        let parallel = run_cadutil(&[
+            "--jobs", "4", "info", input.to_str().unwrap(), "--json", "--detail", "full",
+        ]);
+
+        assert!(single.status.success(), "Single threaded info should succeed");
+        assert!(parallel.status.success(), "Parallel info should succeed");
+
+        let json: serde_json::Value = serde_json::from_slice(&parallel.stdout)
+            .expect("Output should be valid JSON");
+        assert_eq!(json["entity_count"].as_i64().unwrap(), 9000);
+        assert_eq!(single.stdout, parallel.stdout, "Entities should keep file order");
+    }
+
+    #[test]
+    fn test_validate_jobs_matches_single_thread() {
+        // Every entity is on an undefined layer; enough of them to be checked in slices
+        let temp_dir = tempdir().expect("Failed to create temp dir");
+        let input = temp_dir.path().join("large.dxf");
+        write_large_dxf(&input, 40000);
+
+        let issues = |jobs: &str| -> serde_json::Value {
+            let output = run_cadutil(&["--jobs", jobs, "validate", input.to_str().unwrap(), "--json"]);
+            assert!(output.status.success(), "Validate with --jobs {} should succeed", jobs);
+            let json: serde_json::Value = serde_json::from_slice(&output.stdout)
+                .expect("Output should be valid JSON");
+            json["issues"].clone()
+        };
+
+        let single = issues("1");
+        assert_eq!(single.as_array().unwrap().len(), 40000);
+        assert_eq!(single[39999]["location"], "entity #39999");
+        assert_eq!(single, issues("4"), "Issues should come out in entity order");
+    }
+
+    #[test]
+    fn test_validate_fail_fast_stops_at_first_error() {
+        // A zero radius circle first, an invalid ellipse in the last reader batch
+        let temp_dir = tempdir().expect("Failed to create temp dir");
+        let input = temp_dir.path().join("errors.dxf");
+        let mut dxf = String::from("  0\nSECTION\n  2\nTABLES\n  0\nTABLE\n  2\nLAYER\n  0\nLAYER\n  2\n0\n");
+        dxf.push_str("  0\nENDTAB\n  0\nENDSEC\n  0\nSECTION\n  2\nENTITIES\n");
+        dxf.push_str("  0\nCIRCLE\n  8\n0\n 10\n0\n 20\n0\n 40\n0\n");
+        for i in 0..20000 {
+            write!(dxf, "  0\nLINE\n  8\n0\n 10\n{}\n 20\n0\n 11\n{}\n 21\n1\n", i, i + 1).unwrap();
+        }
+        dxf.push_str("  0\nELLIPSE\n  8\n0\n 10\n0\n 20\n0\n 11\n1\n 21\n0\n 40\n2\n");
+        dxf.push_str("  0\nENDSEC\n  0\nEOF\n");
+        fs::write(&input, dxf).expect("Failed to write test DXF");
+
+        let validate = |args: &[&str]| -> serde_json::Value {
+            let mut all = vec!["--jobs", "4", "validate", input.to_str().unwrap(), "--json"];
+            all.extend_from_slice(args);
+            let output = run_cadutil(&all);
+            assert!(output.status.success(), "Validate {:?} should succeed", args);
+            serde_json::from_slice(&output.stdout).expect("Output should be valid JSON")
+        };
+        let codes = |json: &serde_json::Value| -> Vec<String> {
+            json["issues"].as_array().unwrap().iter()
+                .map(|i| i["code"].as_str().unwrap().to_string())
+                .collect()
+        };
+
+        let full = validate(&["--stream"]);
+        assert_eq!(codes(&full), ["INVALID_RADIUS", "INVALID_ELLIPSE"]);
+        assert!(full.get("stopped").is_none());
+
+        let fast = validate(&["--fail-fast"]);
+        assert_eq!(fast["is_valid"], false);
+        assert_eq!(fast["stopped"], true);
+        assert_eq!(codes(&fast), ["INVALID_RADIUS"], "The read should stop before the ellipse");
+        assert_eq!(fast["issues"][0]["location"], "entity #0");
+    }
+
+    #[test]
+    fn test_validate_fail_fast_stops_at_undefined_reference() {
+        // Tables and blocks come first, so a bad reference on the first entity is final
+        let temp_dir = tempdir().expect("Failed to create temp dir");
+        let write = |name: &str, first: &str| -> PathBuf {
+            let mut dxf = String::from("  0\nSECTION\n  2\nTABLES\n  0\nTABLE\n  2\nLAYER\n  0\nLAYER\n  2\n0\n");
+            dxf.push_str("  0\nENDTAB\n  0\nENDSEC\n  0\nSECTION\n  2\nBLOCKS\n  0\nENDSEC\n");
+            dxf.push_str("  0\nSECTION\n  2\nENTITIES\n");
+            dxf.push_str(first);
+            for i in 0..20000 {
+                write!(dxf, "  0\nLINE\n  8\n0\n 10\n{}\n 20\n0\n 11\n{}\n 21\n1\n", i, i + 1).unwrap();
+            }
+            dxf.push_str("  0\nCIRCLE\n  8\n0\n 10\n0\n 20\n0\n 40\n0\n");
+            dxf.push_str("  0\nENDSEC\n  0\nEOF\n");
+            let input = temp_dir.path().join(name);
+            fs::write(&input, dxf).expect("Failed to write test DXF");
+            input
+        };
+
+        for (input, code) in [
+            (write("layer.dxf", "  0\nLINE\n  8\nMISSING\n 10\n0\n 20\n0\n 11\n1\n 21\n1\n"), "UNDEFINED_LAYER"),
+            (write("block.dxf", "  0\nINSERT\n  8\n0\n  2\nNOPE\n 10\n0\n 20\n0\n"), "UNDEFINED_BLOCK"),
+        ] {
+            let output = run_cadutil(&["validate", input.to_str().unwrap(), "--json", "--fail-fast"]);
+            assert!(output.status.success(), "Validate {} should succeed", code);
+            let fast: serde_json::Value = serde_json::from_slice(&output.stdout).expect("Output should be valid JSON");
+            assert_eq!(fast["is_valid"], false);
+            assert_eq!(fast["stopped"], true, "{} should stop the read", code);
+            assert_eq!(fast["issue_count"], 1, "The read should stop before the circle");
+            assert_eq!(fast["issues"][0]["code"], code);
+            assert_eq!(fast["issues"][0]["location"], "entity #0");
+        }
+    }
+
+    #[test]
+    fn test_jobs_auto() {
+        let test_file = get_test_dxf_path();
+        let output = run_cadutil(&["info", test_file.to_str().unwrap(), "--jobs", "0"]);
+
+        assert!(output.status.success(), "Info with --jobs 0 should succeed");
+    }
+
+    #[test]
+    fn test_jobs_invalid() {
+        let test_file = get_test_dxf_path();
+        let output = run_cadutil(&["info", test_file.to_str().unwrap(), "--jobs", "many"]);
+
+        assert!(!output.status.success(), "Non-numeric --jobs should fail");
+    }
+}
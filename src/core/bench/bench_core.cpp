@@ -0,0 +1,955 @@
+/**
+ * Benchmarks for cadutil_core
+ *
+ * Usage: bench_core [--entities N] [--repeat N] [--threads N] [file.dxf]
+ *
+ * Without a file argument a synthetic drawing is generated in the
+ * temporary directory. Build and run with:
+ *   zig build bench --release=fast
+ */
+
+#include "libdxfrw.h"
+#include "librecad_core.h"
+#include "drw_mmap.h"
+#include "dxfreader.h"
+#include "drw_textcodec.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/* ============================================================================
+ * Helpers
+ * ============================================================================ */
+
+/* Heap allocations made by the process, counted by the operators below */
+static std::atomic<long> heapAllocations{0};
+
+void* operator new(size_t size) {
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    return malloc(size ? size : 1);
+}
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept { return operator new(size, tag); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+/* Interface that only counts what the parser delivers */
+class CountingInterface : public DRW_Interface {
+public:
+    long entities = 0;
+    long tableEntries = 0;
+    double checksum = 0.0;  /* order dependent, to compare parallel reads */
+
+    void addHeader(const DRW_Header*) override {}
+    void addLType(const DRW_LType&) override { tableEntries++; }
+    void addLayer(const DRW_Layer&) override { tableEntries++; }
+    void addDimStyle(const DRW_Dimstyle&) override { tableEntries++; }
+    void addVport(const DRW_Vport&) override { tableEntries++; }
+    void addView(const DRW_View&) override { tableEntries++; }
+    void addUCS(const DRW_UCS&) override { tableEntries++; }
+    void addTextStyle(const DRW_Textstyle&) override { tableEntries++; }
+    void addAppId(const DRW_AppId&) override { tableEntries++; }
+    void addBlock(const DRW_Block&) override {}
+    void setBlock(const int) override {}
+    void endBlock() override {}
+    void addPoint(const DRW_Point&) override { entities++; }
+    void addLine(const DRW_Line& l) override { entities++; checksum = checksum * 0.5 + l.basePoint.x; }
+    void addRay(const DRW_Ray&) override { entities++; }
+    void addXline(const DRW_Xline&) override { entities++; }
+    void addArc(const DRW_Arc&) override { entities++; }
+    void addCircle(const DRW_Circle&) override { entities++; }
+    void addEllipse(const DRW_Ellipse&) override { entities++; }
+    void addLWPolyline(const DRW_LWPolyline&) override { entities++; }
+    void addPolyline(const DRW_Polyline&) override { entities++; }
+    void addSpline(const DRW_Spline*) override { entities++; }
+    void addKnot(const DRW_Entity&) override {}
+    void addInsert(const DRW_Insert&) override { entities++; }
+    void addTrace(const DRW_Trace&) override { entities++; }
+    void add3dFace(const DRW_3Dface&) override { entities++; }
+    void addSolid(const DRW_Solid&) override { entities++; }
+    void addMText(const DRW_MText&) override { entities++; }
+    void addText(const DRW_Text&) override { entities++; }
+    void addTolerance(const DRW_Tolerance&) override { entities++; }
+    void addDimAlign(const DRW_DimAligned*) override { entities++; }
+    void addDimLinear(const DRW_DimLinear*) override { entities++; }
+    void addDimRadial(const DRW_DimRadial*) override { entities++; }
+    void addDimDiametric(const DRW_DimDiametric*) override { entities++; }
+    void addDimAngular(const DRW_DimAngular*) override { entities++; }
+    void addDimAngular3P(const DRW_DimAngular3p*) override { entities++; }
+    void addDimOrdinate(const DRW_DimOrdinate*) override { entities++; }
+    void addLeader(const DRW_Leader*) override { entities++; }
+    void addHatch(const DRW_Hatch*) override { entities++; }
+    void addViewport(const DRW_Viewport&) override { entities++; }
+    void addImage(const DRW_Image*) override { entities++; }
+    void linkImage(const DRW_ImageDef*) override {}
+    void addComment(const char*) override {}
+    void addPlotSettings(const DRW_PlotSettings*) override {}
+
+    void writeHeader(DRW_Header&) override {}
+    void writeBlocks() override {}
+    void writeBlockRecords() override {}
+    void writeEntities() override {}
+    void writeLTypes() override {}
+    void writeLayers() override {}
+    void writeViews() override {}
+    void writeUCSs() override {}
+    void writeTextstyles() override {}
+    void writeVports() override {}
+    void writeDimstyles() override {}
+    void writeObjects() override {}
+    void writeAppId() override {}
+};
+
+/* Counting interface that takes common entities a batch at a time */
+class BatchCountingInterface : public CountingInterface {
+public:
+    long batches = 0;
+
+    void addBatch(const DRW_EntityBatch& batch) override {
+        batches++;
+        entities += static_cast<long>(batch.size());
+        for (const DRW_Line& l : batch.lines) checksum = checksum * 0.5 + l.basePoint.x;
+    }
+};
+
+/*
+ * Counting interface that notes the allocation count at the first and the
+ * last entity, so table and header parsing are left out.
+ */
+class AllocationCountingInterface : public BatchCountingInterface {
+public:
+    long first = -1;
+    long last = 0;
+    long firstEntities = 0;
+
+    void mark(long delivered) {
+        long now = heapAllocations.load(std::memory_order_relaxed);
+        if (first < 0) {
+            first = now;
+            firstEntities = delivered;
+        }
+        last = now;
+    }
+    long allocations() const { return first < 0 ? 0 : last - first; }
+    double perEntity() const {
+        long n = entities - firstEntities;
+        return n > 0 ? static_cast<double>(allocations()) / n : 0.0;
+    }
+
+    void addBatch(const DRW_EntityBatch& batch) override {
+        BatchCountingInterface::addBatch(batch);
+        mark(static_cast<long>(batch.size()));
+    }
+    void addPoint(const DRW_Point& e) override { CountingInterface::addPoint(e); mark(1); }
+    void addLine(const DRW_Line& e) override { CountingInterface::addLine(e); mark(1); }
+    void addArc(const DRW_Arc& e) override { CountingInterface::addArc(e); mark(1); }
+    void addCircle(const DRW_Circle& e) override { CountingInterface::addCircle(e); mark(1); }
+    void addEllipse(const DRW_Ellipse& e) override { CountingInterface::addEllipse(e); mark(1); }
+    void addLWPolyline(const DRW_LWPolyline& e) override { CountingInterface::addLWPolyline(e); mark(1); }
+    void addInsert(const DRW_Insert& e) override { CountingInterface::addInsert(e); mark(1); }
+    void addText(const DRW_Text& e) override { CountingInterface::addText(e); mark(1); }
+};
+
+static long fileSize(const std::string& path) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return -1;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fclose(f);
+    return size;
+}
+
+/* Best wall time of `repeat` runs, in seconds */
+static double timeBest(int repeat, const std::function<bool()>& fn) {
+    double best = 1e300;
+    for (int i = 0; i < repeat; i++) {
+        auto t0 = std::chrono::steady_clock::now();
+        if (!fn()) return -1.0;
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(t1 - t0).count());
+    }
+    return best;
+}
+
+/*
+ * Write an entity-heavy ASCII DXF (R2000) with `count` entities, each with
+ * a few XDATA items when `xdata` is set
+ */
+static bool writeSyntheticDxf(const std::string& path, long count, bool xdata = false) {
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) return false;
+
+    fprintf(f, "  0\nSECTION\n  2\nHEADER\n  9\n$ACADVER\n  1\nAC1015\n"
+               "  9\n$DWGCODEPAGE\n  3\nANSI_1252\n  0\nENDSEC\n");
+    fprintf(f, "  0\nSECTION\n  2\nTABLES\n  0\nTABLE\n  2\nLAYER\n 70\n8\n");
+    for (int l = 0; l < 8; l++) {
+        fprintf(f, "  0\nLAYER\n  5\n%X\n100\nAcDbSymbolTableRecord\n100\nAcDbLayerTableRecord\n"
+                   "  2\nLAYER_%d\n 70\n0\n 62\n%d\n  6\nCONTINUOUS\n", 0x20 + l, l, l + 1);
+    }
+    fprintf(f, "  0\nENDTAB\n  0\nENDSEC\n");
+
+    fprintf(f, "  0\nSECTION\n  2\nENTITIES\n");
+    for (long i = 0; i < count; i++) {
+        double x = (i % 1000) * 10.125;
+        double y = (i / 1000) * 7.375;
+        int layer = static_cast<int>(i % 8);
+        long handle = 0x100 + i;
+        switch (i % 5) {
+            case 0:
+                fprintf(f, "  0\nLINE\n  5\n%lX\n100\nAcDbEntity\n  8\nLAYER_%d\n100\nAcDbLine\n"
+                           " 10\n%.6f\n 20\n%.6f\n 30\n0.0\n 11\n%.6f\n 21\n%.6f\n 31\n0.0\n",
+                        handle, layer, x, y, x + 5.5, y + 3.25);
+                break;
+            case 1:
+                fprintf(f, "  0\nCIRCLE\n  5\n%lX\n100\nAcDbEntity\n  8\nLAYER_%d\n100\nAcDbCircle\n"
+                           " 10\n%.6f\n 20\n%.6f\n 30\n0.0\n 40\n%.6f\n",
+                        handle, layer, x, y, 1.5 + (i % 7));
+                break;
+            case 2:
+                fprintf(f, "  0\nARC\n  5\n%lX\n100\nAcDbEntity\n  8\nLAYER_%d\n100\nAcDbCircle\n"
+                           " 10\n%.6f\n 20\n%.6f\n 30\n0.0\n 40\n%.6f\n100\nAcDbArc\n 50\n15.0\n 51\n135.0\n",
+                        handle, layer, x, y, 2.25);
+                break;
+            case 3:
+                fprintf(f, "  0\nTEXT\n  5\n%lX\n100\nAcDbEntity\n  8\nLAYER_%d\n100\nAcDbText\n"
+                           " 10\n%.6f\n 20\n%.6f\n 30\n0.0\n 40\n2.5\n  1\nLabel %ld\n100\nAcDbText\n",
+                        handle, layer, x, y, i);
+                break;
+            default:
+                fprintf(f, "  0\nLWPOLYLINE\n  5\n%lX\n100\nAcDbEntity\n  8\nLAYER_%d\n100\nAcDbPolyline\n"
+                           " 90\n4\n 70\n1\n", handle, layer);
+                for (int v = 0; v < 4; v++) {
+                    fprintf(f, " 10\n%.6f\n 20\n%.6f\n", x + (v & 1) * 4.0, y + (v >> 1) * 4.0);
+                }
+                break;
+        }
+        if (xdata) {
+            fprintf(f, "1001\nCADUTIL\n1000\nrow %ld\n1010\n%.6f\n1020\n%.6f\n1030\n0.0\n"
+                       "1040\n%.3f\n1070\n%d\n", i / 1000, x, y, i * 0.5, layer);
+        }
+    }
+    fprintf(f, "  0\nENDSEC\n  0\nEOF\n");
+    return fclose(f) == 0;
+}
+
+/* ============================================================================
+ * Benchmarks
+ * ============================================================================ */
+
+/* ASCII DXF read throughput: std::istream reader vs mapped in-place reader */
+static void benchAsciiRead(const std::string& path, int repeat) {
+    double mb = fileSize(path) / (1024.0 * 1024.0);
+    long entities = 0;
+
+    auto run = [&](bool mapped) {
+        return timeBest(repeat, [&]() {
+            CountingInterface iface;
+            dxfRW dxf(path.c_str());
+            dxf.setMemoryMapped(mapped);
+            bool ok = dxf.read(&iface, false);
+            entities = iface.entities;
+            return ok;
+        });
+    };
+
+    double tStream = run(false);
+    double tMapped = run(true);
+    if (tStream < 0 || tMapped < 0) {
+        printf("ascii read: failed to read %s\n", path.c_str());
+        return;
+    }
+
+    printf("ascii read (%.1f MB, %ld entities)\n", mb, entities);
+    printf("  %-10s %8.3f s %9.1f MB/s\n", "stream", tStream, mb / tStream);
+    printf("  %-10s %8.3f s %9.1f MB/s  (x%.2f)\n", "mapped", tMapped, mb / tMapped, tStream / tMapped);
+}
+
+/* Mapped ASCII read with the ENTITIES section parsed by 1 vs `threads` threads */
+static void benchParallelRead(const std::string& path, int repeat, int threads) {
+    double mb = fileSize(path) / (1024.0 * 1024.0);
+    long entities[2] = {0, 0};
+    double checksum[2] = {0.0, 0.0};
+
+    auto run = [&](int n, int slot) {
+        return timeBest(repeat, [&]() {
+            CountingInterface iface;
+            dxfRW dxf(path.c_str());
+            dxf.setMemoryMapped(true);
+            dxf.setThreads(n);
+            bool ok = dxf.read(&iface, false);
+            entities[slot] = iface.entities;
+            checksum[slot] = iface.checksum;
+            return ok;
+        });
+    };
+
+    double tSingle = run(1, 0);
+    double tParallel = run(threads, 1);
+    if (tSingle < 0 || tParallel < 0) {
+        printf("parallel read: failed to read %s\n", path.c_str());
+        return;
+    }
+
+    printf("parallel read (%.1f MB, %ld entities)\n", mb, entities[0]);
+    printf("  %-10s %8.3f s %9.1f MB/s\n", "1 thread", tSingle, mb / tSingle);
+    printf("  %2d %-7s %8.3f s %9.1f MB/s  (x%.2f)%s\n", threads, "threads", tParallel, mb / tParallel,
+           tSingle / tParallel,
+           entities[0] == entities[1] && checksum[0] == checksum[1] ? "" : "  MISMATCH");
+}
+
+/* Mapped ASCII read with one callback per entity vs batched delivery */
+static void benchBatchedRead(const std::string& path, int repeat) {
+    double mb = fileSize(path) / (1024.0 * 1024.0);
+    long entities[2] = {0, 0};
+    double checksum[2] = {0.0, 0.0};
+    long batches = 0;
+
+    auto run = [&](size_t batchSize, int slot) {
+        return timeBest(repeat, [&]() {
+            BatchCountingInterface iface;
+            dxfRW dxf(path.c_str());
+            dxf.setMemoryMapped(true);
+            dxf.setBatchSize(batchSize);
+            bool ok = dxf.read(&iface, false);
+            entities[slot] = iface.entities;
+            checksum[slot] = iface.checksum;
+            batches = iface.batches;
+            return ok;
+        });
+    };
+
+    double tSingle = run(0, 0);
+    double tBatched = run(4096, 1);
+    if (tSingle < 0 || tBatched < 0) {
+        printf("batched read: failed to read %s\n", path.c_str());
+        return;
+    }
+
+    printf("batched read (%.1f MB, %ld entities)\n", mb, entities[0]);
+    printf("  %-10s %8.3f s %9.1f MB/s\n", "per entity", tSingle, mb / tSingle);
+    printf("  %-10s %8.3f s %9.1f MB/s  (x%.2f, %ld batches)%s\n", "batched", tBatched, mb / tBatched,
+           tSingle / tBatched, batches,
+           entities[0] == entities[1] && checksum[0] == checksum[1] ? "" : "  MISMATCH");
+}
+
+/* Heap allocations per parsed entity, with and without XDATA on every entity */
+static void benchAllocations(const std::string& path, long count) {
+    const char* tmp = getenv("TMPDIR");
+    std::string xdataPath = std::string(tmp ? tmp : "/tmp") + "/cadutil_bench_xdata.dxf";
+    if (!writeSyntheticDxf(xdataPath, std::min(count, 100000L), true)) {
+        printf("allocations: failed to write %s\n", xdataPath.c_str());
+        return;
+    }
+
+    printf("heap allocations per entity\n");
+    for (const std::string& file : {path, xdataPath}) {
+        for (size_t batchSize : {size_t(0), size_t(4096)}) {
+            AllocationCountingInterface iface;
+            dxfRW dxf(file.c_str());
+            dxf.setMemoryMapped(true);
+            dxf.setBatchSize(batchSize);
+            if (!dxf.read(&iface, false)) {
+                printf("allocations: failed to read %s\n", file.c_str());
+                break;
+            }
+            printf("  %-10s %-10s %8.4f  (%ld in %ld entities)\n", file == path ? "drawing" : "xdata",
+                   batchSize ? "batched" : "per entity", iface.perEntity(), iface.allocations(),
+                   iface.entities);
+        }
+    }
+    remove(xdataPath.c_str());
+}
+
+/* The same drawing saved as ASCII and binary DXF, read back by the parser */
+static void benchBinaryRead(const std::string& path, int repeat) {
+    LcDocument* doc = lc_document_open(path.c_str());
+    std::string ascii = path + ".ascii.dxf";
+    std::string binary = path + ".binary.dxf";
+    bool saved = doc &&
+        lc_document_save_ex(doc, ascii.c_str(), LC_DXF_VERSION_2007, LC_DXF_ASCII) == LC_OK &&
+        lc_document_save_ex(doc, binary.c_str(), LC_DXF_VERSION_2007, LC_DXF_BINARY) == LC_OK;
+    if (doc) lc_document_close(doc);
+    if (!saved) {
+        printf("binary read: failed to convert %s\n", path.c_str());
+        return;
+    }
+
+    /* Group reads alone, without building entities */
+    long groups[2] = {0, 0};
+    auto tokenize = [&](const std::string& file, int slot) {
+        return timeBest(repeat, [&]() {
+            DRW_MappedFile map;
+            if (!map.open(file)) return false;
+            std::unique_ptr<dxfReader> reader;
+            if (slot == 0)
+                reader.reset(new dxfReaderAsciiMem(map.data(), map.size()));
+            else
+                reader.reset(new dxfReaderBinaryMem(map.data() + 22, map.size() - 22));
+            reader->setIgnoreComments(true);  /* the ASCII writer adds one */
+            int code = 0;
+            long n = 0;
+            while (reader->readRec(&code)) n++;
+            groups[slot] = n;
+            return true;
+        });
+    };
+
+    long entities[3] = {0, 0, 0};
+    double checksum[3] = {0.0, 0.0, 0.0};
+    auto run = [&](const std::string& file, bool mapped, int slot) {
+        return timeBest(repeat, [&]() {
+            CountingInterface iface;
+            dxfRW dxf(file.c_str());
+            dxf.setMemoryMapped(mapped);
+            bool ok = dxf.read(&iface, false);
+            entities[slot] = iface.entities;
+            checksum[slot] = iface.checksum;
+            return ok;
+        });
+    };
+
+    double tTokAscii = tokenize(ascii, 0);
+    double tTokBinary = tokenize(binary, 1);
+    double tAscii = run(ascii, true, 0);
+    double tBinary = run(binary, true, 1);
+    double tLoaded = run(binary, false, 2);
+    double mbAscii = fileSize(ascii) / (1024.0 * 1024.0);
+    double mbBinary = fileSize(binary) / (1024.0 * 1024.0);
+    remove(ascii.c_str());
+    remove(binary.c_str());
+    if (tTokAscii < 0 || tTokBinary < 0 || tAscii < 0 || tBinary < 0 || tLoaded < 0) {
+        printf("binary read: failed to read back %s\n", path.c_str());
+        return;
+    }
+
+    bool same = entities[0] == entities[1] && entities[0] == entities[2] &&
+                checksum[0] == checksum[1] && checksum[0] == checksum[2];
+    printf("ascii vs binary read (%ld entities)\n", entities[0]);
+    printf("  %-10s %8.3f s %9.1f MB/s  groups only\n", "ascii", tTokAscii, mbAscii / tTokAscii);
+    printf("  %-10s %8.3f s %9.1f MB/s  groups only (x%.2f)%s\n", "binary", tTokBinary, mbBinary / tTokBinary,
+           tTokAscii / tTokBinary, groups[0] == groups[1] ? "" : "  MISMATCH");
+    printf("  %-10s %8.3f s %9.1f MB/s  %6.1f MB\n", "ascii", tAscii, mbAscii / tAscii, mbAscii);
+    printf("  %-10s %8.3f s %9.1f MB/s  %6.1f MB  (x%.2f)%s\n", "binary", tBinary, mbBinary / tBinary, mbBinary,
+           tAscii / tBinary, same ? "" : "  MISMATCH");
+    printf("  %-10s %8.3f s %9.1f MB/s  (not mapped)\n", "binary", tLoaded, mbBinary / tLoaded);
+}
+
+/* Entity pull cursor vs loading the whole document, with time to first entity */
+static void benchCursor(const std::string& path, int repeat) {
+    long counted[2] = {0, 0};
+    double firstEntity = 1e300;
+
+    double tDocument = timeBest(repeat, [&]() {
+        LcDocument* doc = lc_document_open(path.c_str());
+        if (!doc) return false;
+        LcFileInfo* info = lc_document_get_info(doc, LC_DETAIL_FULL);
+        counted[0] = info ? info->entities_len : 0;
+        lc_file_info_free(info);
+        lc_document_close(doc);
+        return true;
+    });
+    double tCursor = timeBest(repeat, [&]() {
+        auto t0 = std::chrono::steady_clock::now();
+        LcCursor* cursor = lc_cursor_open(path.c_str());
+        if (!cursor) return false;
+        const LcEntityInfo* e = nullptr;
+        long n = 0;
+        LcError err;
+        while ((err = lc_cursor_next(cursor, &e)) == LC_OK && e) {
+            if (n++ == 0) {
+                auto t1 = std::chrono::steady_clock::now();
+                firstEntity = std::min(firstEntity, std::chrono::duration<double>(t1 - t0).count());
+            }
+        }
+        lc_cursor_close(cursor);
+        counted[1] = n;
+        return err == LC_OK;
+    });
+    if (tDocument < 0 || tCursor < 0) {
+        printf("cursor: failed to read %s\n", path.c_str());
+        return;
+    }
+
+    printf("entity cursor (%ld entities)\n", counted[0]);
+    printf("  %-10s %8.3f s\n", "document", tDocument);
+    printf("  %-10s %8.3f s  first entity after %.3f ms%s\n", "cursor", tCursor, firstEntity * 1000.0,
+           counted[0] == counted[1] ? "" : "  MISMATCH");
+}
+
+/* Compare the count-only summary scan with a full document load */
+static void benchSummary(const std::string& path, int repeat) {
+    int counted[2] = {0, 0};
+
+    double tDocument = timeBest(repeat, [&]() {
+        LcDocument* doc = lc_document_open(path.c_str());
+        if (!doc) return false;
+        LcFileInfo* info = lc_document_get_info(doc, LC_DETAIL_SUMMARY);
+        counted[0] = info ? info->entity_count : -1;
+        lc_file_info_free(info);
+        lc_document_close(doc);
+        return true;
+    });
+    double tSummary = timeBest(repeat, [&]() {
+        LcFileInfo* info = lc_get_file_info_ex(path.c_str(), LC_DETAIL_SUMMARY, nullptr);
+        if (!info) return false;
+        counted[1] = info->entity_count;
+        lc_file_info_free(info);
+        return true;
+    });
+    if (tDocument < 0 || tSummary < 0) {
+        printf("summary: failed to read %s\n", path.c_str());
+        return;
+    }
+
+    printf("summary (%d entities)\n", counted[0]);
+    printf("  %-10s %8.3f s\n", "document", tDocument);
+    printf("  %-10s %8.3f s  %.1fx%s\n", "scan", tSummary, tDocument / tSummary,
+           counted[0] == counted[1] ? "" : "  MISMATCH");
+}
+
+/* ASCII vs binary DXF output: write time, size and time to read back */
+static void benchWrite(const std::string& path, int repeat) {
+    LcDocument* doc = lc_document_open(path.c_str());
+    if (!doc) {
+        printf("write: failed to read %s\n", path.c_str());
+        return;
+    }
+
+    printf("dxf output\n");
+    const char* names[2] = {"ascii", "binary"};
+    const LcDxfFormat formats[2] = {LC_DXF_ASCII, LC_DXF_BINARY};
+    for (int i = 0; i < 2; i++) {
+        std::string out = path + "." + names[i] + ".dxf";
+        double tWrite = timeBest(repeat, [&]() {
+            return lc_document_save_ex(doc, out.c_str(), LC_DXF_VERSION_2007, formats[i]) == LC_OK;
+        });
+        double tRead = timeBest(repeat, [&]() {
+            LcDocument* copy = lc_document_open(out.c_str());
+            if (!copy) return false;
+            lc_document_close(copy);
+            return true;
+        });
+        printf("  %-10s write %7.3f s  read %7.3f s  %6.1f MB\n", names[i], tWrite, tRead,
+               fileSize(out) / 1e6);
+        remove(out.c_str());
+    }
+    lc_document_close(doc);
+}
+
+/* Many small drawings with a full R2007 header, where header handling is a large part of the time */
+static void benchSmallFiles(const std::string& path, int repeat) {
+    std::string small = path + ".small.dxf";
+    if (!writeSyntheticDxf(small, 20)) {
+        printf("small files: failed to write %s\n", small.c_str());
+        return;
+    }
+    LcDocument* doc = lc_document_open(small.c_str());
+    bool ok = doc && lc_document_save_ex(doc, small.c_str(), LC_DXF_VERSION_2007, LC_DXF_ASCII) == LC_OK;
+    lc_document_close(doc);
+    LcBuffer* buffer = nullptr;
+    if (ok) {
+        doc = lc_document_open(small.c_str());
+        buffer = lc_document_save_to_buffer(doc, LC_FORMAT_DXF, LC_DXF_VERSION_2007, LC_DXF_ASCII);
+        lc_document_close(doc);
+    }
+    remove(small.c_str());
+    if (!buffer) {
+        printf("small files: failed to save %s\n", small.c_str());
+        return;
+    }
+
+    const int files = 2000;
+    LcSource source = {};
+    source.kind = LC_SOURCE_MEMORY;
+    source.data = buffer->data;
+    source.size = buffer->size;
+    double t = timeBest(repeat, [&]() {
+        for (int i = 0; i < files; i++) {
+            LcDocument* d = lc_document_open_source(&source, nullptr);
+            if (!d) return false;
+            lc_document_close(d);
+        }
+        return true;
+    });
+    printf("small files (%d x %.1f KB, R2007 header)\n", files, buffer->size / 1024.0);
+    printf("  %-10s %8.3f s %9.1f us/file\n", "open", t, t * 1e6 / files);
+    lc_buffer_free(buffer);
+}
+
+/* Contour-map style drawing: one LWPOLYLINE, POLYLINE and SPLINE with `vertices` vertices each */
+static bool writeLargePolylineDxf(const std::string& path, long vertices) {
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) return false;
+
+    fprintf(f, "  0\nSECTION\n  2\nHEADER\n  9\n$ACADVER\n  1\nAC1015\n  0\nENDSEC\n");
+    fprintf(f, "  0\nSECTION\n  2\nENTITIES\n");
+    fprintf(f, "  0\nLWPOLYLINE\n  5\n100\n100\nAcDbEntity\n  8\n0\n100\nAcDbPolyline\n"
+               " 90\n%ld\n 70\n0\n", vertices);
+    for (long i = 0; i < vertices; i++) {
+        fprintf(f, " 10\n%.6f\n 20\n%.6f\n", i * 0.5, (i % 977) * 0.25);
+    }
+    fprintf(f, "  0\nPOLYLINE\n  5\n101\n100\nAcDbEntity\n  8\n0\n100\nAcDb3dPolyline\n"
+               " 66\n1\n 10\n0.0\n 20\n0.0\n 30\n0.0\n 70\n8\n");
+    for (long i = 0; i < vertices; i++) {
+        fprintf(f, "  0\nVERTEX\n  8\n0\n100\nAcDbVertex\n100\nAcDb3dPolylineVertex\n"
+                   " 10\n%.6f\n 20\n%.6f\n 30\n%.6f\n 70\n32\n", i * 0.5, (i % 977) * 0.25, (i % 13) * 1.5);
+    }
+    fprintf(f, "  0\nSEQEND\n  8\n0\n");
+    fprintf(f, "  0\nSPLINE\n  5\n102\n100\nAcDbEntity\n  8\n0\n100\nAcDbSpline\n"
+               " 70\n8\n 71\n3\n 72\n%ld\n 73\n%ld\n", vertices + 4, vertices);
+    for (long i = 0; i < vertices + 4; i++) {
+        fprintf(f, " 40\n%ld.0\n", std::min(std::max(i - 3, 0L), vertices - 3));
+    }
+    for (long i = 0; i < vertices; i++) {
+        fprintf(f, " 10\n%.6f\n 20\n%.6f\n 30\n0.0\n", i * 0.5, (i % 977) * 0.25);
+    }
+    fprintf(f, "  0\nENDSEC\n  0\nEOF\n");
+    return fclose(f) == 0;
+}
+
+/* Entities with very many vertices, where per-vertex storage dominates the parse */
+static void benchLargePolylines(const std::string& path, long count, int repeat) {
+    std::string large = path + ".contours.dxf";
+    long vertices = std::max(16L, count);
+    if (!writeLargePolylineDxf(large, vertices)) {
+        printf("large polylines: failed to write %s\n", large.c_str());
+        return;
+    }
+    double mb = fileSize(large) / (1024.0 * 1024.0);
+    long entities = 0;
+    double t = timeBest(repeat, [&]() {
+        CountingInterface iface;
+        dxfRW dxf(large.c_str());
+        dxf.setMemoryMapped(true);
+        bool ok = dxf.read(&iface, false);
+        entities = iface.entities;
+        return ok;
+    });
+    remove(large.c_str());
+    if (t < 0) {
+        printf("large polylines: failed to read %s\n", large.c_str());
+        return;
+    }
+    printf("large polylines (%.1f MB, %ld entities of %ld vertices)\n", mb, entities, vertices);
+    printf("  %-10s %8.3f s %9.1f Mvertex/s\n", "mapped", t, 3.0 * vertices / t / 1e6);
+}
+
+/* Spatial queries: R-tree build on the first query, then viewport sized windows and nearest lookups */
+static void benchSpatialQuery(const std::string& path, int repeat) {
+    LcDocument* doc = lc_document_open(path.c_str());
+    LcFileInfo* info = doc ? lc_document_get_info(doc, LC_DETAIL_SUMMARY) : nullptr;
+    if (!info) {
+        printf("spatial query: failed to read %s\n", path.c_str());
+        lc_document_close(doc);
+        return;
+    }
+    LcBoundingBox bounds = info->bounds;
+    lc_file_info_free(info);
+
+    /* A window off the drawing builds the index and finds nothing */
+    LcBoundingBox outside = {bounds.min, bounds.min};
+    outside.min.x -= 2.0;
+    outside.max.x -= 1.0;
+    auto t0 = std::chrono::steady_clock::now();
+    lc_query_result_free(lc_document_query_bbox(doc, &outside));
+    auto t1 = std::chrono::steady_clock::now();
+    LcQueryResult* all = lc_document_query_bbox(doc, &bounds);
+    int indexed = all ? all->hit_count : 0;
+    lc_query_result_free(all);
+
+    /* Windows of 1/100 of the drawing in each direction */
+    const int queries = 10000;
+    double w = (bounds.max.x - bounds.min.x) / 100.0;
+    double h = (bounds.max.y - bounds.min.y) / 100.0;
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> ux(bounds.min.x, bounds.max.x - w);
+    std::uniform_real_distribution<double> uy(bounds.min.y, bounds.max.y - h);
+    std::vector<LcBoundingBox> windows(queries);
+    for (LcBoundingBox& b : windows) {
+        b.min = {ux(rng), uy(rng), 0.0};
+        b.max = {b.min.x + w, b.min.y + h, 0.0};
+    }
+
+    long hits = 0;
+    double tWindow = timeBest(repeat, [&]() {
+        hits = 0;
+        for (const LcBoundingBox& b : windows) {
+            LcQueryResult* r = lc_document_query_bbox(doc, &b);
+            if (!r) return false;
+            hits += r->hit_count;
+            lc_query_result_free(r);
+        }
+        return true;
+    });
+    double tNearest = timeBest(repeat, [&]() {
+        for (const LcBoundingBox& b : windows) {
+            LcQueryResult* r = lc_document_query_nearest(doc, &b.min, 10);
+            if (!r) return false;
+            lc_query_result_free(r);
+        }
+        return true;
+    });
+    lc_document_close(doc);
+    if (tWindow < 0 || tNearest < 0) {
+        printf("spatial query: query failed\n");
+        return;
+    }
+
+    printf("spatial query (%d entities indexed, %d queries)\n", indexed, queries);
+    printf("  %-10s %8.3f s\n", "build", std::chrono::duration<double>(t1 - t0).count());
+    printf("  %-10s %8.2f us  %.1f hits\n", "window", tWindow / queries * 1e6,
+           static_cast<double>(hits) / queries);
+    printf("  %-10s %8.2f us  k = 10\n", "nearest", tNearest / queries * 1e6);
+}
+
+/* All validation rules on one thread vs several, with the issues compared */
+static void benchValidate(const std::string& path, int repeat, int threads) {
+    LcDocument* doc = lc_document_open(path.c_str());
+    if (!doc) {
+        printf("validate: failed to read %s\n", path.c_str());
+        return;
+    }
+
+    std::string issues[2];
+    auto run = [&](int n, int slot) {
+        LcValidateOptions options = {nullptr, n, 0};
+        return timeBest(repeat, [&]() {
+            LcValidationResult* result = lc_document_validate_ex(doc, &options);
+            if (!result) return false;
+            issues[slot].clear();
+            for (int i = 0; i < result->issue_count; i++) {
+                issues[slot] += result->issues[i].code;
+                issues[slot] += result->issues[i].location;
+            }
+            lc_validation_result_free(result);
+            return true;
+        });
+    };
+
+    double tSingle = run(1, 0);
+    double tParallel = run(threads, 1);
+    lc_document_close(doc);
+    if (tSingle < 0 || tParallel < 0) {
+        printf("validate: validation failed\n");
+        return;
+    }
+
+    printf("validate (all rules)\n");
+    printf("  %-10s %8.2f ms\n", "1 thread", tSingle * 1e3);
+    printf("  %2d %-7s %8.2f ms  (x%.2f)%s\n", threads, "threads", tParallel * 1e3, tSingle / tParallel,
+           issues[0] == issues[1] ? "" : "  MISMATCH");
+}
+
+/* Validation of a file while it is read against opening it and validating the document */
+static void benchValidateStream(const std::string& path, int repeat) {
+    std::string issues[2];
+    auto collect = [&](LcValidationResult* result, int slot) {
+        if (!result) return false;
+        issues[slot].clear();
+        for (int i = 0; i < result->issue_count; i++) {
+            issues[slot] += result->issues[i].code;
+            issues[slot] += result->issues[i].location;
+        }
+        lc_validation_result_free(result);
+        return true;
+    };
+
+    double tDocument = timeBest(repeat, [&]() {
+        LcDocument* doc = lc_document_open(path.c_str());
+        if (!doc) return false;
+        bool ok = collect(lc_document_validate(doc), 0);
+        lc_document_close(doc);
+        return ok;
+    });
+    double tStream = timeBest(repeat, [&]() {
+        return collect(lc_validate_ex(path.c_str(), nullptr), 1);
+    });
+    int stopped = 0;
+    double tFailFast = timeBest(repeat, [&]() {
+        LcValidateOptions options = {nullptr, 1, 1};
+        LcValidationResult* result = lc_validate_ex(path.c_str(), &options);
+        if (!result) return false;
+        stopped = result->stopped;
+        lc_validation_result_free(result);
+        return true;
+    });
+    if (tDocument < 0 || tStream < 0 || tFailFast < 0) {
+        printf("validate file: validation failed\n");
+        return;
+    }
+
+    printf("validate file (all rules)\n");
+    printf("  %-10s %8.2f ms\n", "open+check", tDocument * 1e3);
+    printf("  %-10s %8.2f ms  (x%.2f)%s\n", "streaming", tStream * 1e3, tDocument / tStream,
+           issues[0] == issues[1] ? "" : "  MISMATCH");
+    printf("  %-10s %8.2f ms  (x%.2f)%s\n", "fail-fast", tFailFast * 1e3, tDocument / tFailFast,
+           stopped ? "  stopped" : "");
+}
+
+/* Shift-JIS text: every double byte character of the common lead bytes, in lines of 32 */
+static std::string sjisCorpus(size_t bytes) {
+    std::string line, corpus;
+    while (corpus.size() < bytes) {
+        for (int lead = 0x88; lead <= 0xEA; lead++) {
+            if (lead > 0x9F && lead < 0xE0) continue;
+            for (int trail = 0x40; trail <= 0xFC; trail++) {
+                if (trail == 0x7F) continue;
+                line += static_cast<char>(lead);
+                line += static_cast<char>(trail);
+                if (line.size() == 64) {
+                    corpus += line;
+                    corpus += '\n';
+                    line.clear();
+                }
+            }
+        }
+    }
+    return corpus;
+}
+
+/* Shift-JIS text entities decoded to UTF-8 (reading) and encoded back (writing R2000 DXF) */
+static void benchCodepage(int repeat) {
+    DRW_TextCodec codec;
+    codec.setVersion(DRW::AC1015, true);
+    codec.setCodePage("ANSI_932", true);
+
+    /* One string per line, like the text of many TEXT entities */
+    std::string sjis = sjisCorpus(8 << 20);
+    std::vector<std::string> sjisLines, utf8Lines;
+    for (size_t start = 0, end; (end = sjis.find('\n', start)) != std::string::npos; start = end + 1) {
+        sjisLines.push_back(sjis.substr(start, end - start));
+        utf8Lines.push_back(codec.toUtf8(sjisLines.back()));
+    }
+
+    size_t out[2] = {0, 0};
+    double tDecode = timeBest(repeat, [&]() {
+        out[0] = 0;
+        for (const std::string& l : sjisLines) {
+            out[0] += codec.toUtf8(l).size();
+        }
+        return true;
+    });
+    double tEncode = timeBest(repeat, [&]() {
+        out[1] = 0;
+        for (const std::string& l : utf8Lines) {
+            out[1] += codec.fromUtf8(l).size();
+        }
+        return true;
+    });
+    /* Encoding must be reversible for characters of the codepage */
+    bool same = true;
+    for (size_t i = 0; i < utf8Lines.size() && same; i += 97) {
+        same = codec.toUtf8(codec.fromUtf8(utf8Lines[i])) == utf8Lines[i];
+    }
+
+    double mb = sjis.size() / (1024.0 * 1024.0);
+    printf("ANSI_932 text (%.1f MB shift-jis, %zu strings)\n", mb, sjisLines.size());
+    printf("  %-10s %8.3f s %9.1f MB/s  %.1f MB utf-8\n", "decode", tDecode, mb / tDecode,
+           out[0] / (1024.0 * 1024.0));
+    printf("  %-10s %8.3f s %9.1f MB/s  %.1f MB shift-jis%s\n", "encode", tEncode, mb / tEncode,
+           out[1] / (1024.0 * 1024.0), same ? "" : "  MISMATCH");
+
+    /* Names and numbers as in most DXF strings, which need no conversion */
+    std::vector<std::string> asciiLines;
+    size_t asciiBytes = 0;
+    for (size_t i = 0; asciiBytes < sjis.size(); i++) {
+        asciiLines.push_back("LAYER_" + std::to_string(i) + " DIM-STYLE Standard " + std::to_string(i * 7919));
+        asciiBytes += asciiLines.back().size();
+    }
+    DRW_TextCodec::resetStats();
+    double tAsciiDecode = timeBest(repeat, [&]() {
+        for (std::string& l : asciiLines) {
+            l = codec.toUtf8(std::move(l));
+        }
+        return true;
+    });
+    double tAsciiEncode = timeBest(repeat, [&]() {
+        for (std::string& l : asciiLines) {
+            l = codec.fromUtf8(std::move(l));
+        }
+        return true;
+    });
+    DRW_TextCodec::Stats st = DRW_TextCodec::stats();
+    mb = asciiBytes / (1024.0 * 1024.0);
+    printf("ASCII text (%.1f MB, %zu strings)\n", mb, asciiLines.size());
+    printf("  %-10s %8.3f s %9.1f MB/s  %llu converted\n", "decode", tAsciiDecode, mb / tAsciiDecode,
+           st.toUtf8Converted);
+    printf("  %-10s %8.3f s %9.1f MB/s  %llu converted\n", "encode", tAsciiEncode, mb / tAsciiEncode,
+           st.fromUtf8Converted);
+}
+
+/* Strings that went through the codepage converters instead of the ASCII fast path */
+static void printCodecStats(const char* what) {
+    DRW_TextCodec::Stats st = DRW_TextCodec::stats();
+    printf("%s: %llu of %llu strings decoded and %llu of %llu encoded by the converters\n", what,
+           st.toUtf8Converted, st.toUtf8Ascii + st.toUtf8Converted, st.fromUtf8Converted,
+           st.fromUtf8Ascii + st.fromUtf8Converted);
+}
+
+int main(int argc, char* argv[]) {
+    long count = 500000;
+    int repeat = 3;
+    int threads = std::max(2, static_cast<int>(std::thread::hardware_concurrency()));
+    std::string path;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--entities") && i + 1 < argc) {
+            count = atol(argv[++i]);
+        } else if (!strcmp(argv[i], "--repeat") && i + 1 < argc) {
+            repeat = std::max(1, atoi(argv[++i]));
+        } else if (!strcmp(argv[i], "--threads") && i + 1 < argc) {
+            threads = std::max(2, atoi(argv[++i]));
+        } else {
+            path = argv[i];
+        }
+    }
+
+    bool generated = path.empty();
+    if (generated) {
+        const char* tmp = getenv("TMPDIR");
+        path = std::string(tmp ? tmp : "/tmp") + "/cadutil_bench.dxf";
+        if (!writeSyntheticDxf(path, count)) {
+            fprintf(stderr, "Failed to write %s\n", path.c_str());
+            return 1;
+        }
+    }
+
+    DRW_TextCodec::resetStats();
+    benchAsciiRead(path, repeat);
+    benchParallelRead(path, repeat, threads);
+    benchBatchedRead(path, repeat);
+    benchAllocations(path, count);
+    benchBinaryRead(path, repeat);
+    benchCursor(path, repeat);
+    benchSummary(path, repeat);
+    benchWrite(path, repeat);
+    benchSmallFiles(path, repeat);
+    benchLargePolylines(path, count, repeat);
+    benchSpatialQuery(path, repeat);
+    benchValidate(path, repeat, threads);
+    benchValidateStream(path, repeat);
+    printCodecStats("Text codec");
+    benchCodepage(repeat);
+
+    if (generated) remove(path.c_str());
+    return 0;
+}
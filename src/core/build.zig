@@ -17,7 +17,9 @@ pub fn build(b: *std.Build) void {
         librecad_root ++ "/libraries/libdxfrw/src/libdxfrw.cpp",
         librecad_root ++ "/libraries/libdxfrw/src/libdwgr.cpp",
         librecad_root ++ "/libraries/libdxfrw/src/intern/drw_dbg.cpp",
+        librecad_root ++ "/libraries/libdxfrw/src/intern/drw_mmap.cpp",
         librecad_root ++ "/libraries/libdxfrw/src/intern/drw_textcodec.cpp",
+        librecad_root ++ "/libraries/libdxfrw/src/intern/drw_zstream.cpp",
         librecad_root ++ "/libraries/libdxfrw/src/intern/dwgbuffer.cpp",
         librecad_root ++ "/libraries/libdxfrw/src/intern/dwgreader.cpp",
         librecad_root ++ "/libraries/libdxfrw/src/intern/dwgreader15.cpp",
@@ -41,14 +43,35 @@ pub fn build(b: *std.Build) void {
     // librecad_core sources
     const core_sources = [_][]const u8{
         "src/librecad_core.cpp",
+        "src/block_extents.cpp",
+        "src/dxf_summary.cpp",
+        "src/exact_extents.cpp",
+        "src/spatial_index.cpp",
+        "src/validation.cpp",
+        "src/entity_store.cpp",
+        "src/io_buffers.cpp",
     };
 
+    // Compressed DXF (.dxf.gz / .dxf.zst) support
+    const with_zlib = b.option(bool, "zlib", "Read and write gzip compressed DXF (links zlib)") orelse true;
+    const with_zstd = b.option(bool, "zstd", "Read and write zstd compressed DXF (links libzstd)") orelse false;
+
+    // libdxfrw debug output (dxfRW::setDebug), compiled out when disabled
+    const with_dxfrw_debug = b.option(bool, "dxfrw-debug", "Keep the libdxfrw debug output") orelse true;
+
     // Common C++ flags
-    const cpp_flags = [_][]const u8{
+    const base_cpp_flags = [_][]const u8{
         "-std=c++17",
         "-fPIC",
         "-DNDEBUG",
     };
+    const no_flags = [_][]const u8{};
+    const cpp_flags = std.mem.concat(b.allocator, []const u8, &[_][]const []const u8{
+        &base_cpp_flags,
+        if (with_zlib) &[_][]const u8{"-DDRW_HAVE_ZLIB"} else &no_flags,
+        if (with_zstd) &[_][]const u8{"-DDRW_HAVE_ZSTD"} else &no_flags,
+        if (with_dxfrw_debug) &no_flags else &[_][]const u8{"-DDRW_NO_DBG"},
+    }) catch @panic("OOM");
 
     // Include paths
     const include_paths = [_][]const u8{
@@ -81,23 +104,24 @@ pub fn build(b: *std.Build) void {
     // Add libdxfrw sources
     lib.addCSourceFiles(.{
         .files = &libdxfrw_sources,
-        .flags = &cpp_flags,
+        .flags = cpp_flags,
     });
 
     // Add jwwlib sources
     lib.addCSourceFiles(.{
         .files = &jwwlib_sources,
-        .flags = &cpp_flags,
+        .flags = cpp_flags,
     });
 
     // Add core sources
     lib.addCSourceFiles(.{
         .files = &core_sources,
-        .flags = &cpp_flags,
+        .flags = cpp_flags,
     });
 
     // Link C++ standard library
     lib.linkLibCpp();
+    linkCompression(lib, with_zlib, with_zstd);
 
     b.installArtifact(lib);
 
@@ -122,20 +146,21 @@ pub fn build(b: *std.Build) void {
 
     shared_lib.addCSourceFiles(.{
         .files = &libdxfrw_sources,
-        .flags = &cpp_flags,
+        .flags = cpp_flags,
     });
 
     shared_lib.addCSourceFiles(.{
         .files = &jwwlib_sources,
-        .flags = &cpp_flags,
+        .flags = cpp_flags,
     });
 
     shared_lib.addCSourceFiles(.{
         .files = &core_sources,
-        .flags = &cpp_flags,
+        .flags = cpp_flags,
     });
 
     shared_lib.linkLibCpp();
+    linkCompression(shared_lib, with_zlib, with_zstd);
 
     b.installArtifact(shared_lib);
 
@@ -164,8 +189,103 @@ pub fn build(b: *std.Build) void {
     test_exe.addIncludePath(b.path("include"));
     test_exe.linkLibrary(lib);
     test_exe.linkLibCpp();
+    linkCompression(test_exe, with_zlib, with_zstd);
 
     const run_test = b.addRunArtifact(test_exe);
     const test_step = b.step("test", "Run tests");
     test_step.dependOn(&run_test.step);
+
+    // Text codec test executable (C++, uses libdxfrw directly)
+    const codec_test_module = b.createModule(.{
+        .root_source_file = null, // C++ only, no Zig source
+        .target = target,
+        .optimize = optimize,
+        .link_libcpp = true,
+    });
+
+    const codec_test_exe = b.addExecutable(.{
+        .name = "test_textcodec",
+        .root_module = codec_test_module,
+    });
+
+    codec_test_exe.addCSourceFiles(.{
+        .files = &[_][]const u8{"test/test_textcodec.cpp"},
+        .flags = cpp_flags,
+    });
+
+    for (include_paths) |path| {
+        codec_test_exe.addIncludePath(b.path(path));
+    }
+    codec_test_exe.linkLibrary(lib);
+    codec_test_exe.linkLibCpp();
+    linkCompression(codec_test_exe, with_zlib, with_zstd);
+
+    const run_codec_test = b.addRunArtifact(codec_test_exe);
+    test_step.dependOn(&run_codec_test.step);
+
+    // Parallel DXF read test executable (C++, uses libdxfrw directly)
+    const parallel_test_module = b.createModule(.{
+        .root_source_file = null, // C++ only, no Zig source
+        .target = target,
+        .optimize = optimize,
+        .link_libcpp = true,
+    });
+
+    const parallel_test_exe = b.addExecutable(.{
+        .name = "test_parallel_read",
+        .root_module = parallel_test_module,
+    });
+
+    parallel_test_exe.addCSourceFiles(.{
+        .files = &[_][]const u8{"test/test_parallel_read.cpp"},
+        .flags = cpp_flags,
+    });
+
+    for (include_paths) |path| {
+        parallel_test_exe.addIncludePath(b.path(path));
+    }
+    parallel_test_exe.linkLibrary(lib);
+    parallel_test_exe.linkLibCpp();
+    linkCompression(parallel_test_exe, with_zlib, with_zstd);
+
+    const run_parallel_test = b.addRunArtifact(parallel_test_exe);
+    test_step.dependOn(&run_parallel_test.step);
+
+    // Create a module for benchmark executable (C++, uses libdxfrw directly)
+    const bench_module = b.createModule(.{
+        .root_source_file = null, // C++ only, no Zig source
+        .target = target,
+        .optimize = optimize,
+        .link_libcpp = true,
+    });
+
+    // Benchmark executable
+    const bench_exe = b.addExecutable(.{
+        .name = "bench_core",
+        .root_module = bench_module,
+    });
+
+    bench_exe.addCSourceFiles(.{
+        .files = &[_][]const u8{"bench/bench_core.cpp"},
+        .flags = cpp_flags,
+    });
+
+    for (include_paths) |path| {
+        bench_exe.addIncludePath(b.path(path));
+    }
+    bench_exe.linkLibrary(lib);
+    bench_exe.linkLibCpp();
+    linkCompression(bench_exe, with_zlib, with_zstd);
+
+    const run_bench = b.addRunArtifact(bench_exe);
+    if (b.args) |args| {
+        run_bench.addArgs(args);
+    }
+    const bench_step = b.step("bench", "Run benchmarks");
+    bench_step.dependOn(&run_bench.step);
+}
+
+fn linkCompression(step: *std.Build.Step.Compile, with_zlib: bool, with_zstd: bool) void {
+    if (with_zlib) step.linkSystemLibrary("z");
+    if (with_zstd) step.linkSystemLibrary("zstd");
 }
@@ -54,6 +54,12 @@ typedef enum {
     LC_DXF_VERSION_2018 = 2018
 } LcDxfVersion;
 
+/* DXF encoding for export */
+typedef enum {
+    LC_DXF_ASCII = 0,
+    LC_DXF_BINARY = 1      /* Smaller and faster to read back */
+} LcDxfFormat;
+
 /* Entity types */
 typedef enum {
     LC_ENTITY_UNKNOWN = 0,
@@ -98,6 +104,53 @@ typedef enum {
  * ============================================================================ */
 typedef struct LcDocument LcDocument;
 
+/* Entity cursor handle (opaque pointer), see lc_cursor_open() */
+typedef struct LcCursor LcCursor;
+
+/* Use one parser thread per hardware core */
+#define LC_THREADS_AUTO (-1)
+
+/* How the drawing bounds reported by lc_document_get_info() are computed */
+typedef enum {
+    LC_BOUNDS_FAST = 0,     /* Arcs and ellipses as full circles, splines by their control points */
+    LC_BOUNDS_REFINED = 1   /* Exact arc and ellipse extremes, splines bounded by subdivision */
+} LcBoundsMode;
+
+/* Options for lc_document_open_ex() */
+typedef struct {
+    int threads;  /* Threads parsing DXF entities: 0 or 1 = calling thread only, LC_THREADS_AUTO = one per core */
+    LcBoundsMode bounds;  /* Bounds of the opened document, LC_BOUNDS_FAST when zeroed */
+} LcOpenOptions;
+
+/* Options for lc_document_validate_ex() and lc_validate_ex() */
+typedef struct {
+    const char* rules;  /* Comma separated rule names, NULL or "" = all, see lc_validation_rules() */
+    int threads;        /* Threads checking entities: 0 or 1 = calling thread only, LC_THREADS_AUTO = one per core */
+    int fail_fast;      /* lc_validate_ex(): stop reading at the first error-level issue */
+} LcValidateOptions;
+
+/* Where lc_document_open_source() reads from */
+typedef enum {
+    LC_SOURCE_MEMORY = 0,  /* data/size: a file image in memory */
+    LC_SOURCE_FD = 1,      /* fd: an open file descriptor, pipe or socket */
+    LC_SOURCE_STDIN = 2    /* standard input */
+} LcSourceKind;
+
+/* Input of lc_document_open_source() */
+typedef struct {
+    LcSourceKind kind;
+    const void* data;      /* LC_SOURCE_MEMORY */
+    size_t size;           /* LC_SOURCE_MEMORY */
+    int fd;                /* LC_SOURCE_FD */
+    const char* name;      /* Optional name reported as the document filename */
+} LcSource;
+
+/* Serialized document owned by the library, free with lc_buffer_free() */
+typedef struct {
+    unsigned char* data;
+    size_t size;
+} LcBuffer;
+
 /* ============================================================================
  * Basic info structures
  * ============================================================================ */
@@ -183,12 +236,36 @@ typedef struct {
     int entity_counts[20];  /* Indexed by LcEntityType */
 } LcFileInfo;
 
+/* A validation rule that ran, see lc_validation_rules() */
+typedef struct {
+    char* name;
+    double seconds;       /* Time spent in the rule, summed over threads */
+    int issue_count;
+} LcRuleStats;
+
 typedef struct {
     int is_valid;
     int issue_count;
     LcValidationIssue* issues;
+    LcRuleStats* rules;   /* In the order of lc_validation_rules() */
+    int rules_len;
+    int stopped;          /* Fail-fast stopped reading: the file was not checked to the end */
 } LcValidationResult;
 
+/* Entity found by lc_document_query_bbox() or lc_document_query_nearest() */
+typedef struct {
+    int index;            /* Model space entity index, as in LcFileInfo::entities */
+    LcEntityType type;
+    const char* layer;    /* Owned by the document, valid until it is closed */
+    int handle;
+    double distance;      /* From the query point to the entity's bounding box, 0 for window queries */
+} LcQueryHit;
+
+typedef struct {
+    int hit_count;
+    LcQueryHit* hits;
+} LcQueryResult;
+
 /* ============================================================================
  * Core API Functions
  * ============================================================================ */
@@ -205,6 +282,7 @@ const char* lc_last_error(void);
 
 /**
  * Detect file format from filename/extension
+ * "drawing.dxf.gz" and "drawing.dxf.zst" are detected as LC_FORMAT_DXF
  */
 LcFormat lc_detect_format(const char* filename);
 
@@ -214,21 +292,95 @@ LcFormat lc_detect_format(const char* filename);
 
 /**
  * Open a document (DXF or JWW)
+ * gzip and zstd compressed DXF files are recognised by their content and
+ * decompressed while parsing, without a temporary file.
  * Returns NULL on error, check lc_last_error()
  */
 LcDocument* lc_document_open(const char* filename);
 
+/**
+ * Open a document with options (NULL options = same as lc_document_open)
+ * With more than one thread, the ENTITIES section of ASCII DXF files is
+ * split and parsed in parallel; entities keep their file order.
+ * Returns NULL on error, check lc_last_error()
+ */
+LcDocument* lc_document_open_ex(const char* filename, const LcOpenOptions* options);
+
+/**
+ * Open a document from memory, a file descriptor or stdin
+ * The format (DXF, binary DXF, compressed DXF or JWW) is sniffed from the
+ * first bytes. Memory is parsed in place and only needs to stay valid until
+ * the call returns; descriptors are read to their end and not closed.
+ * Returns NULL on error, check lc_last_error()
+ */
+LcDocument* lc_document_open_source(const LcSource* source, const LcOpenOptions* options);
+
 /**
  * Save document to file
  * For DXF output, use version parameter
+ * DXF output is gzip or zstd compressed when the filename ends in ".gz" or ".zst"
  */
 LcError lc_document_save(LcDocument* doc, const char* filename, LcDxfVersion version);
 
+/**
+ * Save document to file, choosing between ASCII and binary DXF
+ * The format is ignored for JWW output
+ */
+LcError lc_document_save_ex(LcDocument* doc, const char* filename, LcDxfVersion version, LcDxfFormat format);
+
+/**
+ * Save document into a memory buffer owned by the library
+ * format is LC_FORMAT_DXF or LC_FORMAT_JWW; version and dxf_format only apply to DXF.
+ * The output is built in one growing block that is returned without a copy.
+ * Returns NULL on error, check lc_last_error(). Free with lc_buffer_free()
+ */
+LcBuffer* lc_document_save_to_buffer(LcDocument* doc, LcFormat format, LcDxfVersion version, LcDxfFormat dxf_format);
+
+/**
+ * Free a buffer returned by lc_document_save_to_buffer()
+ */
+void lc_buffer_free(LcBuffer* buffer);
+
+/**
+ * Save document to a file descriptor (pipe, socket, stdout), which is not closed
+ * Output is collected in a large block, so most documents take a single write.
+ */
+LcError lc_document_save_fd(LcDocument* doc, int fd, LcFormat format, LcDxfVersion version, LcDxfFormat dxf_format);
+
 /**
  * Close and free document
  */
 void lc_document_close(LcDocument* doc);
 
+/* ============================================================================
+ * Cursor API
+ * ============================================================================ */
+
+/**
+ * Open a pull cursor over the entities of a file (DXF or JWW)
+ * The file is parsed on a background thread that runs at most a small,
+ * fixed number of entities ahead of the caller, so memory use does not
+ * grow with the file size. Entities come in the same order as the
+ * entities of lc_document_get_info().
+ * Returns NULL on error, check lc_last_error()
+ */
+LcCursor* lc_cursor_open(const char* filename);
+
+/**
+ * Advance the cursor to the next entity (LC_DETAIL_FULL data)
+ * On LC_OK *entity points to the entity, or is NULL after the last one.
+ * The entity and its strings are owned by the cursor and stay valid until
+ * the next call to lc_cursor_next() or lc_cursor_close().
+ * On a parse error returns LC_ERR_READ_ERROR, check lc_last_error()
+ */
+LcError lc_cursor_next(LcCursor* cursor, const LcEntityInfo** entity);
+
+/**
+ * Stop parsing and free the cursor
+ * May be called before the last entity has been read.
+ */
+void lc_cursor_close(LcCursor* cursor);
+
 /* ============================================================================
  * Conversion API
  * ============================================================================ */
@@ -239,6 +391,12 @@ void lc_document_close(LcDocument* doc);
  */
 LcError lc_convert(const char* input_file, const char* output_file, LcDxfVersion dxf_version);
 
+/**
+ * Convert file, choosing between ASCII and binary DXF output
+ */
+LcError lc_convert_ex(const char* input_file, const char* output_file, LcDxfVersion dxf_version,
+                      LcDxfFormat dxf_format);
+
 /* ============================================================================
  * Info API
  * ============================================================================ */
@@ -249,8 +407,18 @@ LcError lc_convert(const char* input_file, const char* output_file, LcDxfVersion
  */
 LcFileInfo* lc_get_file_info(const char* filename, LcDetailLevel detail);
 
+/**
+ * Get file information with open options (NULL options = same as lc_get_file_info)
+ * LC_DETAIL_SUMMARY of an ASCII DXF file is computed by a scanner that only
+ * counts records and reads coordinates, without loading the document,
+ * unless LC_BOUNDS_REFINED bounds are asked for.
+ * Caller must free with lc_file_info_free()
+ */
+LcFileInfo* lc_get_file_info_ex(const char* filename, LcDetailLevel detail, const LcOpenOptions* options);
+
 /**
  * Get file info from open document
+ * The bounds follow the LcOpenOptions::bounds mode the document was opened with.
  */
 LcFileInfo* lc_document_get_info(LcDocument* doc, LcDetailLevel detail);
 
@@ -275,11 +443,51 @@ char* lc_file_info_to_json(const LcFileInfo* info);
  */
 LcValidationResult* lc_validate(const char* filename);
 
+/**
+ * Validate a file while it is read, without keeping its entities. The
+ * entities are checked a batch at a time as the parser hands them over.
+ * A reference to an undefined layer is reported as soon as the DXF TABLES
+ * section has been read, one to an undefined block once the BLOCKS section
+ * has; before that, and in JWW files, it is reported once the file is read
+ * to the end. The issues are the same as those of
+ * lc_document_validate_ex() on the opened file.
+ *
+ * With options->fail_fast the read stops at the first batch holding an
+ * error-level issue and `stopped` is set: the result holds the issues
+ * found up to there, without pending references and document rules.
+ * options->threads parse DXF entities, as in LcOpenOptions; a fail-fast
+ * read parses on the calling thread.
+ * NULL options = same as lc_validate. Unreadable files give a FILE_ERROR
+ * issue, as with lc_validate; returns NULL for an unknown rule name.
+ */
+LcValidationResult* lc_validate_ex(const char* filename, const LcValidateOptions* options);
+
+/**
+ * lc_validate_ex() on a file in memory, a file descriptor or stdin, see
+ * lc_document_open_source()
+ */
+LcValidationResult* lc_validate_source(const LcSource* source, const LcValidateOptions* options);
+
 /**
  * Validate an open document
  */
 LcValidationResult* lc_document_validate(LcDocument* doc);
 
+/**
+ * Validate an open document with a subset of the rules and/or several
+ * threads (NULL options = same as lc_document_validate). Entity rules run
+ * over slices of the document in parallel; the issues come out in the
+ * same order whatever the thread count.
+ * Returns NULL on error (e.g. an unknown rule name), check lc_last_error()
+ */
+LcValidationResult* lc_document_validate_ex(LcDocument* doc, const LcValidateOptions* options);
+
+/**
+ * Names of all validation rules, comma separated, in the order their
+ * issues are reported. The string is static; do not free it.
+ */
+const char* lc_validation_rules(void);
+
 /**
  * Free validation result
  */
@@ -291,6 +499,42 @@ void lc_validation_result_free(LcValidationResult* result);
  */
 char* lc_validation_result_to_json(const LcValidationResult* result);
 
+/* ============================================================================
+ * Spatial Query API
+ * ============================================================================ */
+
+/**
+ * Find the model space entities whose bounding box intersects a window
+ * Only X and Y are compared; the corners may be given in any order.
+ * The first query of a document bulk loads a packed R-tree over the
+ * entity bounding boxes (exact for arcs, ellipses and splines, INSERTs by
+ * the block they place); later queries only walk the tree. Entities
+ * without stored geometry, such as hatches and dimensions, are not indexed.
+ * Hits are in entity order.
+ * Returns NULL on error, check lc_last_error(). Free with lc_query_result_free()
+ */
+LcQueryResult* lc_document_query_bbox(LcDocument* doc, const LcBoundingBox* window);
+
+/**
+ * Find the k model space entities nearest to a point (X and Y)
+ * The distance is the one to the entity's bounding box, as indexed by
+ * lc_document_query_bbox(). Hits are nearest first, equal distances in
+ * entity order; fewer than k come back when fewer entities are indexed.
+ * Returns NULL on error, check lc_last_error(). Free with lc_query_result_free()
+ */
+LcQueryResult* lc_document_query_nearest(LcDocument* doc, const LcPoint3D* point, int k);
+
+/**
+ * Free query result
+ */
+void lc_query_result_free(LcQueryResult* result);
+
+/**
+ * Export query result as JSON string
+ * Caller must free returned string with lc_string_free()
+ */
+char* lc_query_result_to_json(const LcQueryResult* result);
+
 /* ============================================================================
  * Memory Management
  * ============================================================================ */
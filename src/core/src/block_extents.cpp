@@ -0,0 +1,82 @@
+/**
+ * cadutil_core - Block extents
+ */
+
+#include "block_extents.h"
+
+#include <cmath>
+
+size_t BlockExtents::addBlock(std::string_view name, const DRW_Coord& basePoint) {
+    size_t i = blocks_.size();
+    blocks_.emplace_back();
+    blocks_.back().basePoint = basePoint;
+    /* A name defined twice keeps its first definition */
+    if (index_.find(name) == index_.end()) {
+        names_.emplace_back(name);
+        index_.emplace(names_.back(), i);
+    }
+    return i;
+}
+
+void BlockExtents::addInsert(size_t i, std::string_view name, const Placement& placement) {
+    blocks_[i].inserts.push_back({std::string(name), placement});
+}
+
+const Extent* BlockExtents::resolve(size_t i) {
+    Block& block = blocks_[i];
+    if (block.state == State::Resolving) {
+        return nullptr;
+    }
+    if (block.state == State::Unresolved) {
+        block.state = State::Resolving;
+        Extent ext = block.geometry;
+        for (const NestedInsert& n : block.inserts) {
+            place(ext, n.name, n.placement);
+        }
+        block.resolved = ext;
+        block.state = State::Resolved;
+    }
+    return &block.resolved;
+}
+
+/*
+ * A block point q lands on point + R(rotation) * (S * (q - basePoint) + o),
+ * o being the column and row offset of the copy in the array. The corners of
+ * the block extent bound the single copy, and the outermost copies of the
+ * array shift that box by the extreme offsets.
+ */
+void BlockExtents::place(Extent& ext, std::string_view name, const Placement& placement) {
+    auto it = index_.find(name);
+    const Extent* block = it == index_.end() ? nullptr : resolve(it->second);
+    if (!block || block->empty()) {
+        ext.add(placement.point);
+        return;
+    }
+
+    const DRW_Coord& base = blocks_[it->second].basePoint;
+    const DRW_Coord& p = placement.point;
+    double c = std::cos(placement.rotation);
+    double s = std::sin(placement.rotation);
+
+    Extent copy;
+    for (int k = 0; k < 8; k++) {
+        double x = placement.scaleX * ((k & 1 ? block->hi.x : block->lo.x) - base.x);
+        double y = placement.scaleY * ((k & 2 ? block->hi.y : block->lo.y) - base.y);
+        double z = placement.scaleZ * ((k & 4 ? block->hi.z : block->lo.z) - base.z);
+        copy.add({p.x + c * x - s * y, p.y + s * x + c * y, p.z + z});
+    }
+
+    double columns = placement.columns > 1 ? (placement.columns - 1) * placement.columnSpacing : 0.0;
+    double rows = placement.rows > 1 ? (placement.rows - 1) * placement.rowSpacing : 0.0;
+    if (columns == 0.0 && rows == 0.0) {
+        ext.add(copy);
+        return;
+    }
+    for (int k = 0; k < 4; k++) {
+        double ox = k & 1 ? columns : 0.0;
+        double oy = k & 2 ? rows : 0.0;
+        DRW_Coord offset{c * ox - s * oy, s * ox + c * oy, 0.0};
+        ext.add({copy.lo.x + offset.x, copy.lo.y + offset.y, copy.lo.z});
+        ext.add({copy.hi.x + offset.x, copy.hi.y + offset.y, copy.hi.z});
+    }
+}
@@ -0,0 +1,107 @@
+/**
+ * cadutil_core - Block extents
+ *
+ * Bounds of block definitions and of the INSERTs that place them. The
+ * extent of each block is resolved once, nested blocks included, and every
+ * INSERT then maps the cached extent through its transform instead of
+ * walking the block contents again.
+ */
+
+#ifndef BLOCK_EXTENTS_H
+#define BLOCK_EXTENTS_H
+
+#include "drw_base.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/* Axis aligned bounds, empty until a point is added */
+struct Extent {
+    DRW_Coord lo{1e20, 1e20, 1e20};
+    DRW_Coord hi{-1e20, -1e20, -1e20};
+
+    void add(const DRW_Coord& p) {
+        lo.x = std::min(lo.x, p.x);
+        lo.y = std::min(lo.y, p.y);
+        lo.z = std::min(lo.z, p.z);
+        hi.x = std::max(hi.x, p.x);
+        hi.y = std::max(hi.y, p.y);
+        hi.z = std::max(hi.z, p.z);
+    }
+
+    void add(const Extent& other) {
+        if (other.empty()) return;
+        add(other.lo);
+        add(other.hi);
+    }
+
+    bool empty() const { return lo.x > hi.x; }
+};
+
+/* What an INSERT applies to the block it references */
+struct Placement {
+    DRW_Coord point{0.0, 0.0, 0.0};
+    double scaleX = 1.0;
+    double scaleY = 1.0;
+    double scaleZ = 1.0;
+    double rotation = 0.0;  /* radians */
+    int columns = 1;
+    int rows = 1;
+    double columnSpacing = 0.0;
+    double rowSpacing = 0.0;
+};
+
+class BlockExtents {
+public:
+    BlockExtents() = default;
+    /* The index views the names, which a copy would not own */
+    BlockExtents(const BlockExtents&) = delete;
+    BlockExtents& operator=(const BlockExtents&) = delete;
+    BlockExtents(BlockExtents&&) = default;
+    BlockExtents& operator=(BlockExtents&&) = default;
+
+    /* Start a block definition, returns its index */
+    size_t addBlock(std::string_view name, const DRW_Coord& basePoint);
+    /* Bounds of the entities of block i, grown while it is read */
+    Extent& geometry(size_t i) { return blocks_[i].geometry; }
+    /* INSERT of block `name` inside block i */
+    void addInsert(size_t i, std::string_view name, const Placement& placement);
+
+    /*
+     * Grow ext by an INSERT of block `name`. Blocks that are not defined,
+     * are empty or reference themselves contribute the insertion point.
+     */
+    void place(Extent& ext, std::string_view name, const Placement& placement);
+
+private:
+    enum class State { Unresolved, Resolving, Resolved };
+
+    struct NestedInsert {
+        std::string name;
+        Placement placement;
+    };
+
+    struct Block {
+        DRW_Coord basePoint;
+        Extent geometry;
+        Extent resolved;  /* geometry and nested INSERTs */
+        State state = State::Unresolved;
+        std::vector<NestedInsert> inserts;
+    };
+
+    /* Extent of block i, nullptr while it is being resolved */
+    const Extent* resolve(size_t i);
+
+    std::vector<Block> blocks_;
+    /* Block names, a deque so the views of index_ stay valid as it grows */
+    std::deque<std::string> names_;
+    /* Looked up by view, placing an INSERT does not allocate */
+    std::unordered_map<std::string_view, size_t> index_;
+};
+
+#endif /* BLOCK_EXTENTS_H */
@@ -0,0 +1,634 @@
+/**
+ * cadutil_core - DXF summary scanner
+ *
+ * The scanner mirrors the record handling of dxfRW::processDxf() and the
+ * bounds rules of DocumentImpl, but only converts the few group codes that
+ * feed the summary. Every other value is skipped as a raw line.
+ */
+
+#include "dxf_summary.h"
+#include "dxfreader.h"
+#include "drw_mmap.h"
+#include "drw_zstream.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+/* Larger counts may make the vector reserve of libdxfrw fail; leave those to it */
+constexpr int MAX_RESERVE = 1 << 24;
+
+/* Which group codes of an entity feed the summary */
+enum class Geometry {
+    None,        /* counted only */
+    Point,       /* 10/20/30 */
+    Line,        /* 10/20/30 and 11/21/31 */
+    Circle,      /* center and radius (40) */
+    Ellipse,     /* center and major axis (11/21) */
+    LWPolyline,  /* 10/20 per vertex */
+    Polyline,    /* VERTEX records up to SEQEND */
+    Spline,      /* 10/20/30 per control point */
+    Insert,      /* block name (2) and placement */
+    Dimension,   /* counted for known types (70) only */
+    Hatch,       /* counted, loop count (91) checked */
+    Skipped      /* parsed by libdxfrw but not part of the document */
+};
+
+struct EntityKind {
+    LcEntityType type;
+    Geometry geometry;
+};
+
+/* Entities dispatched by dxfRW::processEntities(), anything else is skipped */
+const EntityKind* entityKind(std::string_view name) {
+    static const std::unordered_map<std::string_view, EntityKind> kinds {
+        {"POINT", {LC_ENTITY_POINT, Geometry::Point}},
+        {"LINE", {LC_ENTITY_LINE, Geometry::Line}},
+        {"CIRCLE", {LC_ENTITY_CIRCLE, Geometry::Circle}},
+        {"ARC", {LC_ENTITY_ARC, Geometry::Circle}},
+        {"ELLIPSE", {LC_ENTITY_ELLIPSE, Geometry::Ellipse}},
+        {"LWPOLYLINE", {LC_ENTITY_LWPOLYLINE, Geometry::LWPolyline}},
+        {"POLYLINE", {LC_ENTITY_POLYLINE, Geometry::Polyline}},
+        {"SPLINE", {LC_ENTITY_SPLINE, Geometry::Spline}},
+        {"TEXT", {LC_ENTITY_TEXT, Geometry::Point}},
+        {"MTEXT", {LC_ENTITY_MTEXT, Geometry::Point}},
+        {"INSERT", {LC_ENTITY_INSERT, Geometry::Insert}},
+        {"DIMENSION", {LC_ENTITY_DIMENSION, Geometry::Dimension}},
+        {"HATCH", {LC_ENTITY_HATCH, Geometry::Hatch}},
+        {"LEADER", {LC_ENTITY_LEADER, Geometry::None}},
+        {"SOLID", {LC_ENTITY_SOLID, Geometry::None}},
+        {"TRACE", {LC_ENTITY_TRACE, Geometry::None}},
+        {"3DFACE", {LC_ENTITY_3DFACE, Geometry::None}},
+        {"IMAGE", {LC_ENTITY_IMAGE, Geometry::None}},
+        {"VIEWPORT", {LC_ENTITY_VIEWPORT, Geometry::None}},
+        {"RAY", {LC_ENTITY_UNKNOWN, Geometry::Skipped}},
+        {"XLINE", {LC_ENTITY_UNKNOWN, Geometry::Skipped}},
+        {"TOLERANCE", {LC_ENTITY_UNKNOWN, Geometry::Skipped}},
+        {"ARC_DIMENSION", {LC_ENTITY_UNKNOWN, Geometry::Skipped}},
+    };
+    auto it = kinds.find(name);
+    return it == kinds.end() ? nullptr : &it->second;
+}
+
+/* Coordinate a 10/20/30 (or 11/21/31) group sets */
+double& axis(DRW_Coord& p, int code) {
+    return code < 20 ? p.x : code < 30 ? p.y : p.z;
+}
+
+/* Names the reader would pass through the code page are left to it */
+bool isPlainName(std::string_view name) {
+    for (char c : name) {
+        if (static_cast<unsigned char>(c) >= 0x80 || c == '\\') return false;
+    }
+    return true;
+}
+
+bool isTableName(std::string_view name) {
+    return name == "LTYPE" || name == "LAYER" || name == "STYLE" || name == "VPORT" ||
+           name == "VIEW" || name == "UCS" || name == "APPID" || name == "DIMSTYLE" ||
+           name == "BLOCK_RECORD";
+}
+
+class SummaryScanner {
+public:
+    SummaryScanner(const char* data, size_t size, DxfSummary* summary)
+        : reader(data, size), sum(summary) {}
+
+    bool scan();
+
+private:
+    static constexpr size_t noBlock = SIZE_MAX;
+
+    /* Next group, comments are skipped like dxfRW does after the first 0 group */
+    bool next() {
+        bool good;
+        do {
+            good = reader.readRaw(&code, &value);
+        } while (good && code == 999);
+        return good;
+    }
+
+    bool number(double* d) const {
+        *d = dxfReaderAsciiMem::rawDouble(value);
+        return !std::isnan(*d);
+    }
+
+    /* Bounds of the block being read, or of the model */
+    void updateBounds(const DRW_Coord& p) {
+        (block_ == noBlock ? sum->bounds : blocks_.geometry(block_)).add(p);
+    }
+
+    void count(LcEntityType type) {
+        if (block_ == noBlock) sum->entityCounts[type]++;
+    }
+
+    bool sections();
+    bool header();
+    bool tables();
+    bool table(std::string_view entryName, int* count);
+    bool blocks();
+    bool block();
+    bool entities(bool isBlock, std::string_view* endName);
+    bool entity(const EntityKind& kind);
+    bool insert();
+    bool polyline();
+    bool objects();
+
+    dxfReaderAsciiMem reader;
+    DxfSummary* sum;
+    int code = 0;
+    std::string_view value;
+
+    /* Header state, kept across HEADER sections like DRW_Header */
+    bool haveVariable = false;
+    bool variableValue = true;
+    bool currentIsVersion = false;
+    std::optional<std::string> version;
+
+    /* Block definitions, and the model space INSERTs placed once they are all read */
+    BlockExtents blocks_;
+    size_t block_ = noBlock;
+    std::vector<std::pair<std::string, Placement>> inserts_;
+};
+
+bool SummaryScanner::scan() {
+    if (!sections()) {
+        return false;
+    }
+    for (const auto& insert : inserts_) {
+        blocks_.place(sum->bounds, insert.first, insert.second);
+    }
+    return true;
+}
+
+bool SummaryScanner::sections() {
+    bool inSection = false;
+    while (next()) {
+        switch (code) {
+            case 0:
+                if (!inSection) {
+                    if (value == "SECTION") {
+                        inSection = true;
+                        continue;
+                    }
+                    if (value == "EOF") {
+                        return true;
+                    }
+                } else if (value == "ENDSEC") {
+                    inSection = false;
+                }
+                break;
+            case 2:
+                if (inSection) {
+                    bool processed;
+                    if (value == "HEADER") {
+                        processed = header();
+                    } else if (value == "TABLES") {
+                        processed = tables();
+                    } else if (value == "BLOCKS") {
+                        processed = blocks();
+                    } else if (value == "ENTITIES") {
+                        std::string_view endName;
+                        processed = entities(false, &endName);
+                    } else if (value == "OBJECTS") {
+                        processed = objects();
+                    } else {
+                        continue;
+                    }
+                    if (!processed) {
+                        return false;
+                    }
+                    inSection = false;
+                }
+                continue;
+            default:
+                inSection = false;
+                break;
+        }
+    }
+    /* A final EOF without newline */
+    return code == 0 && value == "EOF";
+}
+
+bool SummaryScanner::header() {
+    while (next()) {
+        if (code == 0) {
+            if (value != "ENDSEC") {
+                return false;
+            }
+            if (version) {
+                sum->dxfVersion = *version;
+            }
+            return true;
+        }
+        if (!haveVariable && code != 9) {
+            return false;
+        }
+        switch (code) {
+            case 9:
+                if (value == "$CUSTOMPROPERTYTAG" || value == "$CUSTOMPROPERTY") {
+                    variableValue = false;
+                } else {
+                    variableValue = true;
+                    haveVariable = true;
+                    currentIsVersion = value == "$ACADVER";
+                    if (currentIsVersion) {
+                        version.reset();
+                    }
+                }
+                break;
+            case 1:
+            case 2:
+            case 3:
+            case 6:
+            case 7:
+            case 8:
+            case 390:
+                if (currentIsVersion && (code != 1 || variableValue)) {
+                    /* Non ASCII text would go through the code page */
+                    for (char c : value) {
+                        if (static_cast<unsigned char>(c) >= 0x80) return false;
+                    }
+                    version = std::string(value);
+                }
+                break;
+            case 10: case 20: case 30: case 40: case 50: case 62:
+            case 70: case 280: case 290: case 370: case 380:
+                if (currentIsVersion) {
+                    return false;  /* $ACADVER would no longer be a string */
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return false;
+}
+
+bool SummaryScanner::tables() {
+    while (next()) {
+        if (code != 0) continue;
+        if (value == "TABLE") {
+            if (!next()) {
+                return false;
+            }
+            if (code == 2 && isTableName(value)) {
+                std::string_view name = value;
+                if (!table(name, name == "LAYER" ? &sum->layerCount : nullptr)) {
+                    return false;
+                }
+            }
+        } else if (value == "ENDSEC") {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SummaryScanner::table(std::string_view entryName, int* count) {
+    bool reading = false;
+    bool isLType = entryName == "LTYPE";
+    while (next()) {
+        if (code == 0) {
+            if (value == entryName) {
+                reading = true;
+                if (count) ++*count;
+            } else if (value == "ENDTAB") {
+                return true;
+            } else if (reading && count) {
+                return false;  /* libdxfrw would add the last entry again */
+            }
+        } else if (isLType && reading && code == 73) {
+            int size = dxfReaderAsciiMem::rawInt(value);
+            if (size < 0 || size > MAX_RESERVE) return false;
+        }
+    }
+    return false;
+}
+
+bool SummaryScanner::blocks() {
+    while (next()) {
+        if (code != 0) continue;
+        if (value == "BLOCK") {
+            if (!block()) {
+                return false;
+            }
+        } else if (value == "ENDSEC") {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* BLOCK record and its entities, as dxfRW::processBlock() reads them */
+bool SummaryScanner::block() {
+    std::string_view name;
+    DRW_Coord basePoint;
+    while (next()) {
+        if (code == 0) {
+            sum->blockCount++;
+            if (!isPlainName(name)) {
+                return false;
+            }
+            block_ = blocks_.addBlock(name, basePoint);
+            std::string_view endName;
+            bool ok = value == "ENDBLK" || (entities(true, &endName) && endName == "ENDBLK");
+            block_ = noBlock;
+            return ok;
+        }
+        if (code == 2) {
+            name = value;
+        } else if ((code == 10 || code == 20 || code == 30) && !number(&axis(basePoint, code))) {
+            return false;
+        }
+    }
+    return false;
+}
+
+/*
+ * Like dxfRW::processEntities(), this first reads one group. In a block that
+ * group belongs to the first entity and is lost, which changes its geometry
+ * when it is a coordinate; the scanner drops it the same way.
+ */
+bool SummaryScanner::entities(bool isBlock, std::string_view* endName) {
+    std::string_view name = value;
+    if (!next()) {
+        return false;
+    }
+    if (code == 0) {
+        name = value;
+    } else if (!isBlock) {
+        return false;
+    }
+
+    for (;;) {
+        if (name == "ENDSEC" || name == "ENDBLK") {
+            *endName = name;
+            return true;
+        }
+        const EntityKind* kind = entityKind(name);
+        if (kind) {
+            if (!entity(*kind)) {
+                return false;
+            }
+        } else {
+            do {
+                if (!next()) {
+                    return false;
+                }
+            } while (code != 0);
+        }
+        name = value;
+    }
+}
+
+/* Reads the groups of one entity, up to the 0 group of the next record */
+bool SummaryScanner::entity(const EntityKind& kind) {
+    if (kind.geometry == Geometry::Polyline) {
+        return polyline();
+    }
+    if (kind.geometry == Geometry::Insert) {
+        return insert();
+    }
+
+    DRW_Coord p1, p2;
+    double radius = 0.0;
+    bool haveRadius = false;
+    int dimType = 0;
+    std::vector<DRW_Coord> points;  /* LWPOLYLINE vertices, SPLINE control points */
+    double d;
+
+    while (next()) {
+        if (code == 0) {
+            break;
+        }
+        switch (kind.geometry) {
+            case Geometry::Point:
+            case Geometry::Line:
+            case Geometry::Circle:
+            case Geometry::Ellipse:
+                switch (code) {
+                    case 10:
+                    case 20:
+                    case 30:
+                        if (!number(&axis(p1, code))) return false;
+                        break;
+                    case 11:
+                    case 21:
+                    case 31:
+                        if (kind.geometry == Geometry::Line || kind.geometry == Geometry::Ellipse) {
+                            if (!number(&axis(p2, code))) return false;
+                        }
+                        break;
+                    case 40:
+                        if (kind.geometry == Geometry::Circle) {
+                            if (!number(&radius)) return false;
+                            haveRadius = true;
+                        }
+                        break;
+                    default:
+                        break;
+                }
+                break;
+            case Geometry::LWPolyline:
+                if (code == 10) {
+                    if (!number(&d)) return false;
+                    points.push_back({d, 0.0, 0.0});
+                } else if (code == 20 && !points.empty()) {
+                    if (!number(&points.back().y)) return false;
+                } else if (code == 90) {
+                    int n = dxfReaderAsciiMem::rawInt(value);
+                    if (n < 0 || n > MAX_RESERVE) return false;
+                }
+                break;
+            case Geometry::Spline:
+                if (code == 10) {
+                    if (!number(&d)) return false;
+                    points.push_back({d, 0.0, 0.0});
+                } else if (code == 20 && !points.empty()) {
+                    if (!number(&points.back().y)) return false;
+                } else if (code == 30 && !points.empty()) {
+                    if (!number(&points.back().z)) return false;
+                }
+                break;
+            case Geometry::Dimension:
+                if (code == 70) {
+                    dimType = dxfReaderAsciiMem::rawInt(value);
+                }
+                break;
+            case Geometry::Hatch:
+                if (code == 91) {
+                    int n = dxfReaderAsciiMem::rawInt(value);
+                    if (n < 0 || n > MAX_RESERVE) return false;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    if (code != 0) {
+        return false;  /* end of file inside the entity */
+    }
+
+    switch (kind.geometry) {
+        case Geometry::Skipped:
+            return true;
+        case Geometry::Dimension:
+            if ((dimType & 0x0F) > 6) return true;
+            break;
+        case Geometry::Point:
+            updateBounds(p1);
+            break;
+        case Geometry::Line:
+            updateBounds(p1);
+            updateBounds(p2);
+            break;
+        case Geometry::Circle:
+            if (!haveRadius) return false;  /* left uninitialized by libdxfrw */
+            updateBounds({p1.x - radius, p1.y - radius, p1.z});
+            updateBounds({p1.x + radius, p1.y + radius, p1.z});
+            break;
+        case Geometry::Ellipse: {
+            double majorLen = std::sqrt(p2.x*p2.x + p2.y*p2.y);
+            updateBounds({p1.x - majorLen, p1.y - majorLen, p1.z});
+            updateBounds({p1.x + majorLen, p1.y + majorLen, p1.z});
+            break;
+        }
+        case Geometry::LWPolyline:
+        case Geometry::Spline:
+            for (const auto& p : points) {
+                updateBounds(p);
+            }
+            break;
+        default:
+            break;
+    }
+    count(kind.type);
+    return true;
+}
+
+/* INSERT, placed into the model bounds once every block is known */
+bool SummaryScanner::insert() {
+    std::string_view name;
+    Placement placement;
+    while (next()) {
+        if (code == 0) {
+            break;
+        }
+        switch (code) {
+            case 2:
+                name = value;
+                break;
+            case 10:
+            case 20:
+            case 30:
+                if (!number(&axis(placement.point, code))) return false;
+                break;
+            case 41:
+                if (!number(&placement.scaleX)) return false;
+                break;
+            case 42:
+                if (!number(&placement.scaleY)) return false;
+                break;
+            case 43:
+                if (!number(&placement.scaleZ)) return false;
+                break;
+            case 50:
+                if (!number(&placement.rotation)) return false;
+                placement.rotation = placement.rotation / ARAD;
+                break;
+            case 70:
+                placement.columns = dxfReaderAsciiMem::rawInt(value);
+                break;
+            case 71:
+                placement.rows = dxfReaderAsciiMem::rawInt(value);
+                break;
+            case 44:
+                if (!number(&placement.columnSpacing)) return false;
+                break;
+            case 45:
+                if (!number(&placement.rowSpacing)) return false;
+                break;
+            default:
+                break;
+        }
+    }
+    if (code != 0 || !isPlainName(name)) {
+        return false;
+    }
+
+    if (block_ == noBlock) {
+        inserts_.emplace_back(std::string(name), placement);
+    } else {
+        blocks_.addInsert(block_, name, placement);
+    }
+    count(LC_ENTITY_INSERT);
+    return true;
+}
+
+/* POLYLINE with its VERTEX records, as dxfRW::processPolyline() reads them */
+bool SummaryScanner::polyline() {
+    while (next()) {
+        if (code != 0) continue;
+        if (value != "VERTEX") {
+            count(LC_ENTITY_POLYLINE);
+            return true;
+        }
+        DRW_Coord v;
+        for (;;) {
+            if (!next()) {
+                return false;
+            }
+            if (code == 0) {
+                updateBounds(v);
+                if (value == "SEQEND") {
+                    break;
+                }
+                if (value != "VERTEX") {
+                    return false;  /* libdxfrw would read it into the vertex */
+                }
+                v = DRW_Coord();
+                continue;
+            }
+            if ((code == 10 || code == 20 || code == 30) && !number(&axis(v, code))) {
+                return false;
+            }
+        }
+    }
+    return false;
+}
+
+bool SummaryScanner::objects() {
+    if (!next() || code != 0) {
+        return false;
+    }
+    while (value != "ENDSEC") {
+        do {
+            if (!next()) {
+                return false;
+            }
+        } while (code != 0);
+    }
+    return true;
+}
+
+} // namespace
+
+bool readDxfSummary(const std::string& filename, DxfSummary* summary) {
+    DRW_MappedFile map;
+    if (!map.open(filename) || map.size() < 22) {
+        return false;
+    }
+    if (memcmp(map.data(), "AutoCAD Binary DXF", 18) == 0 ||
+        DRW_sniffCompression(map.data(), map.size()) != DRW_Compression::None) {
+        return false;
+    }
+    SummaryScanner scanner(map.data(), map.size(), summary);
+    return scanner.scan();
+}
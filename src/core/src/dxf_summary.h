@@ -0,0 +1,34 @@
+/**
+ * cadutil_core - DXF summary scanner
+ *
+ * Computes the LC_DETAIL_SUMMARY data of an ASCII DXF file (layer, block and
+ * per type entity counts, bounds and version) straight from the group codes,
+ * without building DRW objects or the document model.
+ */
+
+#ifndef DXF_SUMMARY_H
+#define DXF_SUMMARY_H
+
+#include "librecad_core.h"
+#include "drw_base.h"
+#include "block_extents.h"
+
+#include <string>
+
+struct DxfSummary {
+    std::string dxfVersion;
+    int layerCount = 0;
+    int blockCount = 0;
+    int entityCounts[20] = {};  /* Indexed by LcEntityType, model space only */
+    Extent bounds;              /* Model space, blocks placed by their INSERTs */
+};
+
+/*
+ * Summarize a DXF file with the same results as reading it into a document.
+ * Returns false for binary and compressed files and for anything the
+ * scanner does not model exactly (including malformed files); the caller
+ * then falls back to the full parser, which also reports the errors.
+ */
+bool readDxfSummary(const std::string& filename, DxfSummary* summary);
+
+#endif /* DXF_SUMMARY_H */
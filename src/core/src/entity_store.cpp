@@ -0,0 +1,230 @@
+/**
+ * cadutil_core - Columnar entity store
+ */
+
+#include "entity_store.h"
+
+#include <utility>
+
+namespace {
+
+/* Geometry fields kept in the coordinate pool, in this order */
+enum GeomField : unsigned {
+    P1 = 1,        /* point1: 3 values */
+    P2 = 2,        /* point2: 3 values */
+    RADIUS = 4,    /* radius, or the axis ratio of an ellipse */
+    ANGLES = 8,    /* start and end angle */
+    HEIGHT = 16,
+    ROTATION = 32,
+    SCALE = 64     /* x, y and z scale */
+};
+
+unsigned geomFields(uint8_t type) {
+    switch (type) {
+        case LC_ENTITY_POINT: return P1;
+        case LC_ENTITY_LINE: return P1 | P2;
+        case LC_ENTITY_CIRCLE: return P1 | RADIUS;
+        case LC_ENTITY_ARC: return P1 | RADIUS | ANGLES;
+        case LC_ENTITY_ELLIPSE: return P1 | P2 | RADIUS | ANGLES;
+        case LC_ENTITY_TEXT:
+        case LC_ENTITY_MTEXT: return P1 | HEIGHT | ROTATION;
+        case LC_ENTITY_INSERT: return P1 | ROTATION | SCALE;
+        case LC_ENTITY_SOLID:
+        case LC_ENTITY_TRACE:
+        case LC_ENTITY_3DFACE: return P1;
+        default: return 0;
+    }
+}
+
+bool isShape(uint8_t type) {
+    return type == LC_ENTITY_POLYLINE || type == LC_ENTITY_LWPOLYLINE || type == LC_ENTITY_SPLINE;
+}
+
+bool isText(uint8_t type) {
+    return type == LC_ENTITY_TEXT || type == LC_ENTITY_MTEXT;
+}
+
+const uint8_t flagClosed = 0x01;
+
+template <typename T>
+size_t bytes(const std::vector<T>& v) {
+    return v.capacity() * sizeof(T);
+}
+
+} // namespace
+
+size_t EntityStore::add(const EntityData& e) {
+    size_t index = types_.size();
+    uint8_t type = static_cast<uint8_t>(e.type);
+    types_.push_back(type);
+    flags_.push_back(e.closed ? flagClosed : 0);
+    layers_.push_back(e.layerId != EntityData::noName ? e.layerId : names_.intern(e.layer));
+    lineTypes_.push_back(e.lineTypeId != EntityData::noName ? e.lineTypeId : names_.intern(e.lineType));
+    colors_.push_back(e.color);
+    handles_.push_back(e.handle);
+    geom_.push_back(static_cast<uint32_t>(coords_.size()));
+
+    unsigned fields = geomFields(type);
+    if (fields & P1) coords_.insert(coords_.end(), {e.point1.x, e.point1.y, e.point1.z});
+    if (fields & P2) coords_.insert(coords_.end(), {e.point2.x, e.point2.y, e.point2.z});
+    if (fields & RADIUS) coords_.push_back(e.radius);
+    if (fields & ANGLES) coords_.insert(coords_.end(), {e.startAngle, e.endAngle});
+    if (fields & HEIGHT) coords_.push_back(e.height);
+    if (fields & ROTATION) coords_.push_back(e.rotation);
+    if (fields & SCALE) coords_.insert(coords_.end(), {e.scaleX, e.scaleY, e.scaleZ});
+
+    uint32_t extra = 0;
+    if (isText(type)) {
+        extra = static_cast<uint32_t>(texts_.size());
+        texts_.push_back({textPool_.size(), static_cast<uint32_t>(e.text.size())});
+        textPool_.insert(textPool_.end(), e.text.begin(), e.text.end());
+        textPool_.push_back('\0');
+    } else if (type == LC_ENTITY_INSERT) {
+        extra = static_cast<uint32_t>(inserts_.size());
+        inserts_.push_back({names_.intern(e.blockName), e.columns, e.rows,
+                            e.columnSpacing, e.rowSpacing});
+    } else if (isShape(type)) {
+        extra = static_cast<uint32_t>(shapes_.size());
+        shapes_.push_back({vertices_.size(), 0, e.vertexCount, e.degree, params_.size(), 0, 0});
+    }
+    extra_.push_back(extra);
+    return index;
+}
+
+void EntityStore::addVertex(const DRW_Coord& v) {
+    if (shapes_.empty()) return;
+    ShapeRow& shape = shapes_.back();
+    if (shape.first + shape.stored != vertices_.size()) return;
+    vertices_.push_back(v);
+    shape.stored++;
+}
+
+void EntityStore::setSplineParameters(const std::vector<double>& knots, const std::vector<double>& weights) {
+    if (shapes_.empty()) return;
+    ShapeRow& shape = shapes_.back();
+    if (shape.params != params_.size() || shape.knotCount || shape.weightCount) return;
+    params_.insert(params_.end(), knots.begin(), knots.end());
+    params_.insert(params_.end(), weights.begin(), weights.end());
+    shape.knotCount = static_cast<uint32_t>(knots.size());
+    shape.weightCount = static_cast<uint32_t>(weights.size());
+}
+
+StoreRange<double> EntityStore::geometry(size_t i) const {
+    const double* first = coords_.data() + geom_[i];
+    const double* last = coords_.data() + (i + 1 < geom_.size() ? geom_[i + 1] : coords_.size());
+    return {first, last};
+}
+
+StoreRange<DRW_Coord> EntityStore::vertices(size_t i) const {
+    if (!isShape(types_[i])) return {};
+    const ShapeRow& shape = shapes_[extra_[i]];
+    const DRW_Coord* first = vertices_.data() + shape.first;
+    return {first, first + shape.stored};
+}
+
+StoreRange<double> EntityStore::knots(size_t i) const {
+    if (!isShape(types_[i])) return {};
+    const ShapeRow& shape = shapes_[extra_[i]];
+    const double* first = params_.data() + shape.params;
+    return {first, first + shape.knotCount};
+}
+
+StoreRange<double> EntityStore::weights(size_t i) const {
+    if (!isShape(types_[i])) return {};
+    const ShapeRow& shape = shapes_[extra_[i]];
+    const double* first = params_.data() + shape.params + shape.knotCount;
+    return {first, first + shape.weightCount};
+}
+
+std::string_view EntityStore::text(uint32_t row) const {
+    const TextRow& t = texts_[row];
+    return std::string_view(textPool_.data() + t.offset, t.length);
+}
+
+EntityData EntityStore::get(size_t i) const {
+    EntityData e;
+    uint8_t type = types_[i];
+    e.type = static_cast<LcEntityType>(type);
+    e.layerId = layers_[i];
+    e.layer = names_[e.layerId];
+    e.lineTypeId = lineTypes_[i];
+    e.lineType = names_[e.lineTypeId];
+    e.color = colors_[i];
+    e.handle = handles_[i];
+    e.closed = (flags_[i] & flagClosed) != 0;
+
+    const double* g = coords_.data() + geom_[i];
+    unsigned fields = geomFields(type);
+    if (fields & P1) { e.point1 = {g[0], g[1], g[2]}; g += 3; }
+    if (fields & P2) { e.point2 = {g[0], g[1], g[2]}; g += 3; }
+    if (fields & RADIUS) e.radius = *g++;
+    if (fields & ANGLES) { e.startAngle = g[0]; e.endAngle = g[1]; g += 2; }
+    if (fields & HEIGHT) e.height = *g++;
+    if (fields & ROTATION) e.rotation = *g++;
+    if (fields & SCALE) { e.scaleX = g[0]; e.scaleY = g[1]; e.scaleZ = g[2]; }
+
+    if (isText(type)) {
+        e.text = text(extra_[i]);
+    } else if (type == LC_ENTITY_INSERT) {
+        const InsertRow& insert = inserts_[extra_[i]];
+        e.blockNameId = insert.block;
+        e.blockName = names_[e.blockNameId];
+        e.columns = insert.columns;
+        e.rows = insert.rows;
+        e.columnSpacing = insert.columnSpacing;
+        e.rowSpacing = insert.rowSpacing;
+    } else if (isShape(type)) {
+        const ShapeRow& shape = shapes_[extra_[i]];
+        e.vertexCount = shape.count;
+        e.degree = shape.degree;
+    }
+    return e;
+}
+
+void EntityStore::clear() {
+    types_.clear();
+    flags_.clear();
+    layers_.clear();
+    lineTypes_.clear();
+    colors_.clear();
+    handles_.clear();
+    geom_.clear();
+    extra_.clear();
+    coords_.clear();
+    texts_.clear();
+    textPool_.clear();
+    inserts_.clear();
+    shapes_.clear();
+    vertices_.clear();
+    params_.clear();
+}
+
+void EntityStore::swap(EntityStore& other) {
+    std::swap(names_, other.names_);
+    types_.swap(other.types_);
+    flags_.swap(other.flags_);
+    layers_.swap(other.layers_);
+    lineTypes_.swap(other.lineTypes_);
+    colors_.swap(other.colors_);
+    handles_.swap(other.handles_);
+    geom_.swap(other.geom_);
+    extra_.swap(other.extra_);
+    coords_.swap(other.coords_);
+    texts_.swap(other.texts_);
+    textPool_.swap(other.textPool_);
+    inserts_.swap(other.inserts_);
+    shapes_.swap(other.shapes_);
+    vertices_.swap(other.vertices_);
+    params_.swap(other.params_);
+}
+
+size_t EntityStore::memoryUsage() const {
+    size_t total = bytes(types_) + bytes(flags_) + bytes(layers_) + bytes(lineTypes_) +
+                   bytes(colors_) + bytes(handles_) + bytes(geom_) + bytes(extra_) +
+                   bytes(coords_) + bytes(texts_) + bytes(textPool_) + bytes(inserts_) +
+                   bytes(shapes_) + bytes(vertices_) + bytes(params_);
+    for (uint32_t id = 0; id < names_.size(); id++) {
+        total += sizeof(std::string) + names_[id].capacity();
+    }
+    return total;
+}
@@ -0,0 +1,175 @@
+/**
+ * cadutil_core - Columnar entity store
+ *
+ * Keeps the entities of a document column by column instead of one wide
+ * record per entity: a type column, interned layer and line type IDs,
+ * the geometry of each entity as a short run in a shared coordinate pool,
+ * sparse side tables for text, insert and polyline data, and contiguous
+ * vertex and spline knot pools. A LINE costs about 80 bytes and no
+ * allocation of its own.
+ */
+
+#ifndef ENTITY_STORE_H
+#define ENTITY_STORE_H
+
+#include "librecad_core.h"
+#include "drw_base.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/*
+ * One entity as it is added to the store or read back from it. The
+ * strings are views: into the parsed entity while adding, into the store
+ * when read back, where they are NUL terminated and stay valid until the
+ * store is cleared.
+ * layerId and lineTypeId are IDs in the store's name table. When an
+ * entity is added with an ID the name is not looked up again; noName
+ * means the name is interned from the view.
+ */
+struct EntityData {
+    static constexpr uint32_t noName = UINT32_MAX;
+
+    LcEntityType type = LC_ENTITY_UNKNOWN;
+    std::string_view layer;
+    uint32_t layerId = noName;
+    int color = 256; /* BYLAYER */
+    std::string_view lineType = "BYLAYER";
+    uint32_t lineTypeId = noName;
+    double lineWeight = -1.0; /* BYLAYER */
+    int handle = 0;
+
+    /* Geometry (simplified storage) */
+    DRW_Coord point1{0,0,0};
+    DRW_Coord point2{0,0,0};
+    double radius = 0.0;
+    double startAngle = 0.0;
+    double endAngle = 0.0;
+    std::string_view text;
+    std::string_view blockName;
+    uint32_t blockNameId = noName; /* set when read back */
+    double height = 0.0;
+    double rotation = 0.0;
+    double scaleX = 1.0;
+    double scaleY = 1.0;
+    double scaleZ = 1.0;
+    int columns = 1;       /* INSERT array */
+    int rows = 1;
+    double columnSpacing = 0.0;
+    double rowSpacing = 0.0;
+    int vertexCount = 0;
+    int degree = 0;
+    bool closed = false;
+};
+
+/* Read-only run of values held by the store */
+template <typename T>
+struct StoreRange {
+    const T* first = nullptr;
+    const T* last = nullptr;
+
+    const T* begin() const { return first; }
+    const T* end() const { return last; }
+    size_t size() const { return static_cast<size_t>(last - first); }
+    bool empty() const { return first == last; }
+    const T& operator[](size_t i) const { return first[i]; }
+};
+
+class EntityStore {
+public:
+    EntityStore() = default;
+    EntityStore(const EntityStore&) = delete;
+    EntityStore& operator=(const EntityStore&) = delete;
+
+    /* Append an entity, returns its index */
+    size_t add(const EntityData& e);
+    /* Append a vertex to the polyline or spline added last */
+    void addVertex(const DRW_Coord& v);
+    /* Knot vector and control point weights of the spline added last */
+    void setSplineParameters(const std::vector<double>& knots, const std::vector<double>& weights);
+    /* Entity i, with views into the store */
+    EntityData get(size_t i) const;
+
+    size_t size() const { return types_.size(); }
+    bool empty() const { return types_.empty(); }
+    /* Drop all entities, keeping the interned names and the capacity */
+    void clear();
+    void swap(EntityStore& other);
+
+    /* Dense columns, one element per entity */
+    const std::vector<uint8_t>& types() const { return types_; }
+    const std::vector<uint32_t>& layers() const { return layers_; }
+    const std::vector<uint32_t>& lineTypes() const { return lineTypes_; }
+    /*
+     * Layer, line type and block names. The DXF reader interns into this
+     * table directly, so entities arrive with their IDs.
+     */
+    const DRW_NameTable& names() const { return names_; }
+    DRW_NameTable& names() { return names_; }
+    /* Interned block name of an INSERT */
+    uint32_t blockName(size_t i) const { return inserts_[extra_[i]].block; }
+    /* Radius of a CIRCLE or ARC */
+    double radius(size_t i) const { return coords_[geom_[i] + 3]; }
+    /*
+     * Scalars of entity i in the order point1, point2, radius, start and
+     * end angle, height, rotation, scale, each only where its type has it
+     * (e.g. a LINE is two points, an ELLIPSE two points, ratio and angles).
+     * The runs of consecutive entities are adjacent.
+     */
+    StoreRange<double> geometry(size_t i) const;
+    /* Stored vertices or control points of a POLYLINE, LWPOLYLINE or SPLINE */
+    StoreRange<DRW_Coord> vertices(size_t i) const;
+    /* Knots and weights of a SPLINE, empty when the reader had none */
+    StoreRange<double> knots(size_t i) const;
+    StoreRange<double> weights(size_t i) const;
+
+    /* Bytes held by the columns, pools and tables */
+    size_t memoryUsage() const;
+
+private:
+    struct TextRow {
+        size_t offset;
+        uint32_t length;
+    };
+    struct InsertRow {
+        uint32_t block;    /* interned name */
+        int32_t columns;
+        int32_t rows;
+        double columnSpacing;
+        double rowSpacing;
+    };
+    struct ShapeRow {
+        size_t first;      /* in vertices_ */
+        uint32_t stored;   /* vertices kept in vertices_ */
+        int count;         /* vertex or control point count of the entity */
+        int degree;
+        size_t params;     /* knots, then weights, in params_ */
+        uint32_t knotCount;
+        uint32_t weightCount;
+    };
+
+    std::string_view text(uint32_t row) const;
+
+    DRW_NameTable names_;
+
+    std::vector<uint8_t> types_;
+    std::vector<uint8_t> flags_;
+    std::vector<uint32_t> layers_;
+    std::vector<uint32_t> lineTypes_;
+    std::vector<int32_t> colors_;
+    std::vector<int32_t> handles_;
+    std::vector<uint32_t> geom_;   /* start of the entity's run in coords_ */
+    std::vector<uint32_t> extra_;  /* row in the side table of its type */
+
+    std::vector<double> coords_;
+    std::vector<TextRow> texts_;
+    std::vector<char> textPool_;
+    std::vector<InsertRow> inserts_;
+    std::vector<ShapeRow> shapes_;
+    std::vector<DRW_Coord> vertices_;
+    std::vector<double> params_;
+};
+
+#endif /* ENTITY_STORE_H */
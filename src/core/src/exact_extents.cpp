@@ -0,0 +1,331 @@
+/**
+ * cadutil_core - Exact entity extents
+ */
+
+#include "exact_extents.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+constexpr double twoPi = 2.0 * M_PI;
+constexpr double halfPi = 0.5 * M_PI;
+
+/* Splines of a higher degree are bounded by their control points */
+constexpr int maxSplineDegree = 25;
+/* Subdivision stops once the control points overshoot by this share of the spline size */
+constexpr double splineTolerance = 1e-9;
+constexpr int maxSubdivisions = 32;
+
+/*
+ * Fold v[0, n) into [*lo, *hi]. NaN values are skipped like in
+ * Extent::add(): the SIMD min/max return the accumulator for them.
+ */
+void reduce(const double* v, size_t n, double* lo, double* hi) {
+    size_t i = 0;
+    double mn = *lo;
+    double mx = *hi;
+#if defined(__SSE2__) || defined(_M_X64)
+    __m128d mn0 = _mm_set1_pd(mn), mn1 = mn0;
+    __m128d mx0 = _mm_set1_pd(mx), mx1 = mx0;
+    for (; i + 4 <= n; i += 4) {
+        __m128d a = _mm_load_pd(v + i);
+        __m128d b = _mm_load_pd(v + i + 2);
+        mn0 = _mm_min_pd(a, mn0);
+        mn1 = _mm_min_pd(b, mn1);
+        mx0 = _mm_max_pd(a, mx0);
+        mx1 = _mm_max_pd(b, mx1);
+    }
+    alignas(16) double l[2], h[2];
+    _mm_store_pd(l, _mm_min_pd(mn0, mn1));
+    _mm_store_pd(h, _mm_max_pd(mx0, mx1));
+    mn = std::min(l[0], l[1]);
+    mx = std::max(h[0], h[1]);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    float64x2_t mn0 = vdupq_n_f64(mn), mn1 = mn0;
+    float64x2_t mx0 = vdupq_n_f64(mx), mx1 = mx0;
+    for (; i + 4 <= n; i += 4) {
+        float64x2_t a = vld1q_f64(v + i);
+        float64x2_t b = vld1q_f64(v + i + 2);
+        /* vminq/vmaxq would propagate NaN */
+        mn0 = vbslq_f64(vcltq_f64(a, mn0), a, mn0);
+        mn1 = vbslq_f64(vcltq_f64(b, mn1), b, mn1);
+        mx0 = vbslq_f64(vcgtq_f64(a, mx0), a, mx0);
+        mx1 = vbslq_f64(vcgtq_f64(b, mx1), b, mx1);
+    }
+    double l[2], h[2];
+    vst1q_f64(l, vbslq_f64(vcltq_f64(mn1, mn0), mn1, mn0));
+    vst1q_f64(h, vbslq_f64(vcgtq_f64(mx1, mx0), mx1, mx0));
+    mn = std::min(l[0], l[1]);
+    mx = std::max(h[0], h[1]);
+#endif
+    for (; i < n; i++) {
+        mn = std::min(mn, v[i]);
+        mx = std::max(mx, v[i]);
+    }
+    *lo = mn;
+    *hi = mx;
+}
+
+/* Candidate points in coordinate columns, reduced a batch at a time */
+class PointReducer {
+public:
+    void add(double x, double y, double z) {
+        xs[size] = x;
+        ys[size] = y;
+        zs[size] = z;
+        if (++size == batchSize) flush();
+    }
+
+    void add(const DRW_Coord& p) { add(p.x, p.y, p.z); }
+
+    Extent finish() {
+        flush();
+        return ext;
+    }
+
+private:
+    static constexpr size_t batchSize = 512;
+
+    void flush() {
+        reduce(xs, size, &ext.lo.x, &ext.hi.x);
+        reduce(ys, size, &ext.lo.y, &ext.hi.y);
+        reduce(zs, size, &ext.lo.z, &ext.hi.z);
+        size = 0;
+    }
+
+    alignas(16) double xs[batchSize];
+    alignas(16) double ys[batchSize];
+    alignas(16) double zs[batchSize];
+    size_t size = 0;
+    Extent ext;
+};
+
+/* Sweep from start to end counterclockwise, a full turn when they coincide */
+double sweep(double start, double end) {
+    double s = std::fmod(end - start, twoPi);
+    if (s <= 0.0) s += twoPi;
+    return s;
+}
+
+bool inSweep(double angle, double start, double sweep) {
+    double d = std::fmod(angle - start, twoPi);
+    if (d < 0.0) d += twoPi;
+    return d <= sweep;
+}
+
+/* The quadrant points of a circle, k counting quarter turns from +X */
+void addQuadrant(PointReducer& out, const DRW_Coord& c, double r, long k) {
+    switch (((k % 4) + 4) % 4) {
+        case 0: out.add(c.x + r, c.y, c.z); break;
+        case 1: out.add(c.x, c.y + r, c.z); break;
+        case 2: out.add(c.x - r, c.y, c.z); break;
+        default: out.add(c.x, c.y - r, c.z); break;
+    }
+}
+
+void addCircle(PointReducer& out, const DRW_Coord& c, double r) {
+    for (long k = 0; k < 4; k++) {
+        addQuadrant(out, c, r, k);
+    }
+}
+
+/* Arc end points and the quadrant points the arc passes */
+void addArc(PointReducer& out, const DRW_Coord& c, double r, double start, double end) {
+    double s = sweep(start, end);
+    out.add(c.x + r * std::cos(start), c.y + r * std::sin(start), c.z);
+    out.add(c.x + r * std::cos(start + s), c.y + r * std::sin(start + s), c.z);
+    long k = static_cast<long>(std::ceil(start / halfPi));
+    for (int n = 0; n < 4 && k * halfPi <= start + s; n++, k++) {
+        addQuadrant(out, c, r, k);
+    }
+}
+
+/*
+ * Point t of an ellipse is c + M cos t + m sin t, M being the major axis
+ * and m the minor axis. x(t) is extreme where tan t = m.x / M.x, y(t)
+ * where tan t = m.y / M.y, each at two opposite parameters.
+ */
+void addEllipse(PointReducer& out, const DRW_Coord& c, const DRW_Coord& major, double ratio,
+                double start, double end) {
+    double mx = -ratio * major.y;
+    double my = ratio * major.x;
+    auto add = [&](double t) {
+        double ct = std::cos(t);
+        double st = std::sin(t);
+        out.add(c.x + major.x * ct + mx * st, c.y + major.y * ct + my * st, c.z);
+    };
+
+    double s = sweep(start, end);
+    add(start);
+    add(start + s);
+    double tx = std::atan2(mx, major.x);
+    double ty = std::atan2(my, major.y);
+    for (double t : {tx, tx + M_PI, ty, ty + M_PI}) {
+        if (inSweep(t, start, s)) add(t);
+    }
+}
+
+/* Control points of a Bezier span in homogeneous coordinates (wx, wy, wz, w) */
+typedef std::array<double, 4> Homogeneous;
+typedef std::vector<Homogeneous> BezierSpan;
+
+/*
+ * Bezier pieces are split in half until their control points, which bound
+ * the curve, overshoot the box of its end points by no more than tol.
+ */
+void addBezier(PointReducer& out, const BezierSpan& span, double tol, int depth) {
+    size_t last = span.size() - 1;
+    std::vector<DRW_Coord> points(span.size());
+    for (size_t k = 0; k <= last; k++) {
+        double w = span[k][3];
+        points[k] = {span[k][0] / w, span[k][1] / w, span[k][2] / w};
+    }
+
+    double overshoot = 0.0;
+    for (int axis = 0; axis < 3; axis++) {
+        auto coord = [axis](const DRW_Coord& p) { return axis == 0 ? p.x : axis == 1 ? p.y : p.z; };
+        double lo = std::min(coord(points[0]), coord(points[last]));
+        double hi = std::max(coord(points[0]), coord(points[last]));
+        for (size_t k = 1; k < last; k++) {
+            overshoot = std::max(overshoot, std::max(lo - coord(points[k]), coord(points[k]) - hi));
+        }
+    }
+    if (!(overshoot > tol) || depth == maxSubdivisions) {
+        for (const DRW_Coord& p : points) out.add(p);
+        return;
+    }
+
+    /* de Casteljau at t = 1/2 */
+    BezierSpan left(span.size());
+    BezierSpan right(span.size());
+    BezierSpan work = span;
+    for (size_t r = 0; r <= last; r++) {
+        left[r] = work[0];
+        right[last - r] = work[last - r];
+        for (size_t k = 0; k < last - r; k++) {
+            for (int d = 0; d < 4; d++) {
+                work[k][d] = 0.5 * (work[k][d] + work[k + 1][d]);
+            }
+        }
+    }
+    addBezier(out, left, tol, depth + 1);
+    addBezier(out, right, tol, depth + 1);
+}
+
+/*
+ * Bezier control point j of knot span i is the blossom of the spline at
+ * (a, .., a, b, .., b) with j copies of b, a and b being the span's knots.
+ * It is de Boor's algorithm with the j-th argument used at level j.
+ */
+Homogeneous blossom(const std::vector<Homogeneous>& pw, const StoreRange<double>& u, size_t i,
+                    int p, double a, double b, int j) {
+    std::vector<Homogeneous> d(pw.begin() + (i - p), pw.begin() + (i + 1));
+    for (int r = 1; r <= p; r++) {
+        double t = r <= p - j ? a : b;
+        for (int k = p; k >= r; k--) {
+            size_t idx = i - p + k;
+            double denom = u[idx + p + 1 - r] - u[idx];
+            double alpha = denom > 0.0 ? (t - u[idx]) / denom : 0.0;
+            for (int c = 0; c < 4; c++) {
+                d[k][c] = (1.0 - alpha) * d[k - 1][c] + alpha * d[k][c];
+            }
+        }
+    }
+    return d[p];
+}
+
+void addSpline(PointReducer& out, const StoreRange<DRW_Coord>& points, const StoreRange<double>& knots,
+               const StoreRange<double>& weights, int degree) {
+    size_t n = points.size();
+    size_t p = degree > 0 ? static_cast<size_t>(degree) : 0;
+    bool exact = degree >= 1 && degree <= maxSplineDegree && n > p && knots.size() == n + p + 1;
+    for (size_t k = 1; exact && k < knots.size(); k++) {
+        exact = knots[k - 1] <= knots[k];
+    }
+    bool rational = weights.size() == n;
+    for (size_t k = 0; exact && rational && k < n; k++) {
+        exact = weights[k] > 0.0;
+    }
+    if (!exact) {
+        for (const DRW_Coord& v : points) out.add(v);
+        return;
+    }
+
+    Extent hull;
+    std::vector<Homogeneous> pw(n);
+    for (size_t k = 0; k < n; k++) {
+        double w = rational ? weights[k] : 1.0;
+        pw[k] = {w * points[k].x, w * points[k].y, w * points[k].z, w};
+        hull.add(points[k]);
+    }
+    double size = std::max({hull.hi.x - hull.lo.x, hull.hi.y - hull.lo.y, hull.hi.z - hull.lo.z});
+    double tol = splineTolerance * size;
+
+    BezierSpan span(p + 1);
+    for (size_t i = p; i < n; i++) {
+        double a = knots[i];
+        double b = knots[i + 1];
+        if (!(a < b)) continue;
+        for (size_t j = 0; j <= p; j++) {
+            span[j] = blossom(pw, knots, i, static_cast<int>(p), a, b, static_cast<int>(j));
+        }
+        addBezier(out, span, tol, 0);
+    }
+}
+
+} // namespace
+
+Extent exactExtent(const EntityStore& store, size_t first, size_t count) {
+    PointReducer out;
+    const std::vector<uint8_t>& types = store.types();
+    for (size_t i = first; i < first + count; i++) {
+        switch (types[i]) {
+            case LC_ENTITY_POINT:
+            case LC_ENTITY_TEXT:
+            case LC_ENTITY_MTEXT:
+                out.add(store.get(i).point1);
+                break;
+            case LC_ENTITY_LINE: {
+                EntityData e = store.get(i);
+                out.add(e.point1);
+                out.add(e.point2);
+                break;
+            }
+            case LC_ENTITY_CIRCLE: {
+                EntityData e = store.get(i);
+                addCircle(out, e.point1, e.radius);
+                break;
+            }
+            case LC_ENTITY_ARC: {
+                EntityData e = store.get(i);
+                addArc(out, e.point1, e.radius, e.startAngle, e.endAngle);
+                break;
+            }
+            case LC_ENTITY_ELLIPSE: {
+                EntityData e = store.get(i);
+                addEllipse(out, e.point1, e.point2, e.radius, e.startAngle, e.endAngle);
+                break;
+            }
+            case LC_ENTITY_LWPOLYLINE:
+            case LC_ENTITY_POLYLINE:
+                for (const DRW_Coord& v : store.vertices(i)) out.add(v);
+                break;
+            case LC_ENTITY_SPLINE:
+                addSpline(out, store.vertices(i), store.knots(i), store.weights(i), store.get(i).degree);
+                break;
+            default:
+                break;
+        }
+    }
+    return out.finish();
+}
@@ -0,0 +1,25 @@
+/**
+ * cadutil_core - Exact entity extents
+ *
+ * Tight bounds of stored entities for LC_BOUNDS_REFINED: arcs and ellipses
+ * by the axis extremes inside their angular range, splines by subdividing
+ * their Bezier spans until the control points no longer overshoot the
+ * curve. The candidate points are gathered into coordinate columns and
+ * folded into the extent a batch at a time with SIMD min/max.
+ */
+
+#ifndef EXACT_EXTENTS_H
+#define EXACT_EXTENTS_H
+
+#include "block_extents.h"
+#include "entity_store.h"
+
+#include <cstddef>
+
+/*
+ * Extent of entities [first, first + count) of store. INSERTs are left
+ * out; the caller places them with BlockExtents.
+ */
+Extent exactExtent(const EntityStore& store, size_t first, size_t count);
+
+#endif /* EXACT_EXTENTS_H */
@@ -0,0 +1,174 @@
+/**
+ * cadutil_core - Stream buffers over memory and file descriptors
+ */
+
+#include "io_buffers.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+static long readFd(int fd, char* data, size_t size) {
+#ifdef _WIN32
+    return _read(fd, data, static_cast<unsigned>(size));
+#else
+    return static_cast<long>(::read(fd, data, size));
+#endif
+}
+
+FdSource::FdSource(int fd) : fd_(fd), buffer_(1 << 16) {}
+
+std::string_view FdSource::peek(size_t n) {
+    /* Pipes return short reads, so top up until n bytes are buffered */
+    size_t avail = static_cast<size_t>(egptr() - gptr());
+    n = std::min(n, buffer_.size());
+    if (avail < n) {
+        std::memmove(buffer_.data(), gptr(), avail);
+        while (avail < n) {
+            long got = readFd(fd_, buffer_.data() + avail, buffer_.size() - avail);
+            if (got < 0 && errno == EINTR) continue;
+            if (got <= 0) {
+                failed_ = got < 0;
+                break;
+            }
+            avail += static_cast<size_t>(got);
+        }
+        setg(buffer_.data(), buffer_.data(), buffer_.data() + avail);
+    }
+    return std::string_view(gptr(), std::min(n, avail));
+}
+
+FdSource::int_type FdSource::underflow() {
+    if (gptr() < egptr()) {
+        return traits_type::to_int_type(*gptr());
+    }
+    long n;
+    do {
+        n = readFd(fd_, buffer_.data(), buffer_.size());
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0) {
+        failed_ = failed_ || n < 0;
+        return traits_type::eof();
+    }
+    setg(buffer_.data(), buffer_.data(), buffer_.data() + n);
+    return traits_type::to_int_type(*gptr());
+}
+
+static long writeFd(int fd, const char* data, size_t size) {
+#ifdef _WIN32
+    return _write(fd, data, static_cast<unsigned>(size));
+#else
+    return static_cast<long>(::write(fd, data, size));
+#endif
+}
+
+MemorySink::~MemorySink() {
+    free(data_);
+}
+
+char* MemorySink::release(size_t* size) {
+    *size = data_ ? static_cast<size_t>(pptr() - pbase()) : 0;
+    char* data = data_;
+    data_ = nullptr;
+    setp(nullptr, nullptr);
+    return data;
+}
+
+/* Make room for extra more bytes, doubling the block to keep appends amortized O(1) */
+bool MemorySink::reserve(size_t extra) {
+    size_t used = static_cast<size_t>(pptr() - pbase());
+    size_t capacity = static_cast<size_t>(epptr() - pbase());
+    if (used + extra <= capacity) return true;
+    if (failed_) return false;
+
+    size_t grown = std::max(used + extra, std::max<size_t>(capacity * 2, 1 << 16));
+    char* data = static_cast<char*>(realloc(data_, grown));
+    if (!data) {
+        failed_ = true;
+        return false;
+    }
+    data_ = data;
+    setp(data_, data_ + grown);
+    advance(used);
+    return true;
+}
+
+/* pbump() takes an int, so move the put pointer in pieces */
+void MemorySink::advance(size_t n) {
+    while (n > 0) {
+        int step = static_cast<int>(std::min<size_t>(n, 1 << 30));
+        pbump(step);
+        n -= static_cast<size_t>(step);
+    }
+}
+
+MemorySink::int_type MemorySink::overflow(int_type ch) {
+    if (traits_type::eq_int_type(ch, traits_type::eof())) return traits_type::not_eof(ch);
+    if (!reserve(1)) return traits_type::eof();
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+    return ch;
+}
+
+std::streamsize MemorySink::xsputn(const char* s, std::streamsize n) {
+    if (n <= 0) return 0;
+    if (!reserve(static_cast<size_t>(n))) return 0;
+    std::memcpy(pptr(), s, static_cast<size_t>(n));
+    advance(static_cast<size_t>(n));
+    return n;
+}
+
+FdSink::FdSink(int fd) : fd_(fd), buffer_(1 << 22) {
+    setp(buffer_.data(), buffer_.data() + buffer_.size());
+}
+
+FdSink::~FdSink() {
+    drain();
+}
+
+/* Write out the buffered bytes, retrying short writes */
+bool FdSink::drain() {
+    const char* p = pbase();
+    size_t left = static_cast<size_t>(pptr() - pbase());
+    while (left > 0 && !failed_) {
+        long n = writeFd(fd_, p, left);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            failed_ = true;
+            break;
+        }
+        p += n;
+        left -= static_cast<size_t>(n);
+    }
+    setp(buffer_.data(), buffer_.data() + buffer_.size());
+    return !failed_;
+}
+
+FdSink::int_type FdSink::overflow(int_type ch) {
+    if (!drain()) return traits_type::eof();
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
+
+int FdSink::sync() {
+    return drain() ? 0 : -1;
+}
+
+void setBinaryMode(int fd) {
+#ifdef _WIN32
+    _setmode(fd, _O_BINARY);
+#else
+    (void)fd;
+#endif
+}
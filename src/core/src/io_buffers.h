@@ -0,0 +1,98 @@
+/**
+ * cadutil_core - Stream buffers over memory and file descriptors
+ *
+ * Lets the DXF and JWW readers take their input from a caller's buffer,
+ * a file descriptor or stdin instead of a named file, and the writers
+ * produce a memory buffer or write to a descriptor.
+ */
+
+#ifndef IO_BUFFERS_H
+#define IO_BUFFERS_H
+
+#include <cstddef>
+#include <streambuf>
+#include <string_view>
+#include <vector>
+
+/* Read-only stream buffer over memory owned by the caller, without copying it */
+class MemorySource : public std::streambuf {
+public:
+    MemorySource(const char* data, size_t size) {
+        char* p = const_cast<char*>(data);
+        setg(p, p, p + size);
+    }
+};
+
+/* Stream buffer reading a file descriptor in large chunks; the fd is not closed */
+class FdSource : public std::streambuf {
+public:
+    explicit FdSource(int fd);
+
+    /* Up to n of the next bytes (fewer only at the end of input), not consumed */
+    std::string_view peek(size_t n);
+    /* true if reading the descriptor failed, as opposed to reaching its end */
+    bool failed() const { return failed_; }
+
+protected:
+    int_type underflow() override;
+
+private:
+    int fd_;
+    std::vector<char> buffer_;
+    bool failed_ = false;
+};
+
+/* Write-only stream buffer growing a malloc'ed block, handed over by release() */
+class MemorySink : public std::streambuf {
+public:
+    MemorySink() = default;
+    ~MemorySink() override;
+    MemorySink(const MemorySink&) = delete;
+    MemorySink& operator=(const MemorySink&) = delete;
+
+    /* The bytes written so far, to be freed with free(); the sink is emptied */
+    char* release(size_t* size);
+    /* true if an allocation failed and output was lost */
+    bool failed() const { return failed_; }
+
+protected:
+    int_type overflow(int_type ch) override;
+    std::streamsize xsputn(const char* s, std::streamsize n) override;
+
+private:
+    bool reserve(size_t extra);
+    void advance(size_t n);
+
+    char* data_ = nullptr;
+    bool failed_ = false;
+};
+
+/*
+ * Write-only stream buffer collecting output in a large block and writing
+ * it to a file descriptor when the block is full and on sync(), so most
+ * documents go out in a single write. The fd is not closed.
+ */
+class FdSink : public std::streambuf {
+public:
+    explicit FdSink(int fd);
+    ~FdSink() override;
+
+    /* true if writing the descriptor failed */
+    bool failed() const { return failed_; }
+
+protected:
+    int_type overflow(int_type ch) override;
+    int sync() override;
+
+private:
+    bool drain();
+
+    int fd_;
+    std::vector<char> buffer_;
+    bool failed_ = false;
+};
+
+/* Switch a descriptor to binary mode (no newline translation on Windows) */
+void setBinaryMode(int fd);
+
+#endif /* IO_BUFFERS_H */
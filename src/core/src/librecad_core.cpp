@@ -11,24 +11,44 @@
 #include "dl_jww.h"
 #include "dl_creationinterface.h"
 #include "jwwdoc.h"
+#include "dxf_summary.h"
+#include "drw_zstream.h"
+#include "block_extents.h"
+#include "exact_extents.h"
+#include "entity_store.h"
+#include "io_buffers.h"
+#include "spatial_index.h"
+#include "validation.h"
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <memory>
+#include <cstdint>
 #include <cstring>
 #include <algorithm>
 #include <sstream>
 #include <iomanip>
 #include <cmath>
 #include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 /* Forward declaration for JWW export */
-static LcError lc_document_save_jww(LcDocument* doc, const char* filename);
+static LcError lc_document_save_jww(LcDocument* doc, std::streambuf* sink);
 
 /* Thread-local error message */
 static thread_local std::string g_last_error;
 
+/* Block size of file output; most drawings are written with a few system calls */
+static constexpr size_t writeBufferSize = 1 << 20;
+
+/* Entities the DXF reader hands over per DRW_Interface::addBatch() call */
+static constexpr size_t readerBatchSize = 4096;
+
 /* ============================================================================
  * Internal data structures
  * ============================================================================ */
@@ -46,32 +66,9 @@ struct LayerData {
 struct BlockData {
     std::string name;
     DRW_Coord basePoint{0.0, 0.0, 0.0};
-    std::vector<DRW_Entity*> entities;
-};
-
-struct EntityData {
-    LcEntityType type = LC_ENTITY_UNKNOWN;
-    std::string layer;
-    int color = 256; /* BYLAYER */
-    std::string lineType = "BYLAYER";
-    double lineWeight = -1.0; /* BYLAYER */
-    int handle = 0;
-
-    /* Geometry (simplified storage) */
-    DRW_Coord point1{0,0,0};
-    DRW_Coord point2{0,0,0};
-    double radius = 0.0;
-    double startAngle = 0.0;
-    double endAngle = 0.0;
-    std::string text;
-    std::string blockName;
-    double height = 0.0;
-    double rotation = 0.0;
-    double scaleX = 1.0;
-    double scaleY = 1.0;
-    int vertexCount = 0;
-    int degree = 0;
-    bool closed = false;
+    /* Contents: entities [first, first + count) of DocumentImpl::blockEntities */
+    size_t first = 0;
+    size_t count = 0;
 };
 
 /* ============================================================================
@@ -86,14 +83,17 @@ public:
 
     std::vector<LayerData> layers;
     std::vector<BlockData> blocks;
-    std::vector<EntityData> entities;
+    /* Model space; block contents are kept apart in blockEntities */
+    EntityStore entities;
+    EntityStore blockEntities;
+    BlockExtents blockExtents;  /* indexed like blocks */
     std::map<std::string, DRW_LType> lineTypes;
     std::map<std::string, DRW_Dimstyle> dimStyles;
     std::map<std::string, DRW_Textstyle> textStyles;
 
     DRW_Header header;
-    DRW_Coord minBound{1e20, 1e20, 1e20};
-    DRW_Coord maxBound{-1e20, -1e20, -1e20};
+    /* Model space bounds, INSERTs included once finishBounds() has run */
+    Extent bounds;
 
     /* Current block being filled (nullptr for modelspace) */
     BlockData* currentBlock = nullptr;
@@ -104,28 +104,170 @@ public:
     /* Pointer to dxfRW for writing (set during save operation) */
     dxfRW* dxfWriter = nullptr;
 
+    SpatialIndex index;
+    std::once_flag indexBuilt;
+
+    /* Bounds grown by the entities being read: the current block's or the model's */
+    Extent& currentBounds() {
+        return currentBlock ? blockExtents.geometry(currentBlock - blocks.data()) : bounds;
+    }
+
     void updateBounds(const DRW_Coord& p) {
-        minBound.x = std::min(minBound.x, p.x);
-        minBound.y = std::min(minBound.y, p.y);
-        minBound.z = std::min(minBound.z, p.z);
-        maxBound.x = std::max(maxBound.x, p.x);
-        maxBound.y = std::max(maxBound.y, p.y);
-        maxBound.z = std::max(maxBound.z, p.z);
+        currentBounds().add(p);
+    }
+
+    virtual void addEntityData(const EntityData& e) {
+        if (currentBlock) {
+            /* The block store interns its own names */
+            EntityData copy = e;
+            copy.layerId = copy.lineTypeId = EntityData::noName;
+            blockEntities.add(copy);
+            currentBlock->count++;
+            return;
+        }
+        entities.add(e);
+    }
+
+    /* Vertex of the polyline or spline added last */
+    virtual void addEntityVertex(const DRW_Coord& v) {
+        (currentBlock ? blockEntities : entities).addVertex(v);
+    }
+
+    /* Knots and weights of the spline added last */
+    virtual void addEntityKnots(const std::vector<double>& knots, const std::vector<double>& weights) {
+        (currentBlock ? blockEntities : entities).setSplineParameters(knots, weights);
+    }
+
+    /* Complete the model bounds once the document is read */
+    void finishBounds(LcBoundsMode mode) {
+        if (mode == LC_BOUNDS_REFINED) {
+            bounds = refinedBounds();
+        } else {
+            placeInserts(blockExtents, bounds);
+        }
+    }
+
+    /* Grow ext by the blocks the model space INSERTs place */
+    void placeInserts(BlockExtents& extents, Extent& ext) const {
+        const std::vector<uint8_t>& types = entities.types();
+        for (size_t i = 0; i < entities.size(); i++) {
+            if (types[i] != LC_ENTITY_INSERT) continue;
+            EntityData e = entities.get(i);
+            extents.place(ext, e.blockName, placement(e));
+        }
+    }
+
+    /* Block extents from the exact extents of their entities */
+    BlockExtents exactBlockExtents() const {
+        BlockExtents exact;
+        const std::vector<uint8_t>& types = blockEntities.types();
+        for (const BlockData& b : blocks) {
+            size_t block = exact.addBlock(b.name, b.basePoint);
+            exact.geometry(block) = exactExtent(blockEntities, b.first, b.count);
+            for (size_t i = b.first; i < b.first + b.count; i++) {
+                if (types[i] != LC_ENTITY_INSERT) continue;
+                EntityData e = blockEntities.get(i);
+                exact.addInsert(block, e.blockName, placement(e));
+            }
+        }
+        return exact;
+    }
+
+    /* Bounds from the exact extents of the stored entities, blocks included */
+    Extent refinedBounds() const {
+        BlockExtents exact = exactBlockExtents();
+        Extent ext = exactExtent(entities, 0, entities.size());
+        placeInserts(exact, ext);
+        return ext;
+    }
+
+    /* R-tree over the model space entities, built by the first query */
+    const SpatialIndex& spatialIndex() {
+        std::call_once(indexBuilt, [this] { buildIndex(); });
+        return index;
+    }
+
+    void buildIndex() {
+        BlockExtents exact = exactBlockExtents();
+        const std::vector<uint8_t>& types = entities.types();
+        std::vector<IndexBox> boxes;
+        std::vector<uint32_t> ids;
+        boxes.reserve(entities.size());
+        ids.reserve(entities.size());
+        for (size_t i = 0; i < entities.size(); i++) {
+            Extent ext;
+            if (types[i] == LC_ENTITY_INSERT) {
+                EntityData e = entities.get(i);
+                exact.place(ext, e.blockName, placement(e));
+            } else {
+                ext = exactExtent(entities, i, 1);
+            }
+            if (ext.empty()) continue;
+            boxes.push_back({ext.lo.x, ext.lo.y, ext.hi.x, ext.hi.y});
+            ids.push_back(static_cast<uint32_t>(i));
+        }
+        index.build(std::move(boxes), std::move(ids));
+    }
+
+    static Placement placement(const EntityData& e) {
+        Placement p;
+        p.point = e.point1;
+        p.scaleX = e.scaleX;
+        p.scaleY = e.scaleY;
+        p.scaleZ = e.scaleZ;
+        p.rotation = e.rotation;
+        p.columns = e.columns;
+        p.rows = e.rows;
+        p.columnSpacing = e.columnSpacing;
+        p.rowSpacing = e.rowSpacing;
+        return p;
+    }
+
+    /* Table the DXF reader interns layer and line type names into, if any */
+    virtual DRW_NameTable* readerNames() {
+        return &entities.names();
+    }
+
+    /* Set while the reader interns names into entities.names() */
+    bool readerInternsNames = false;
+
+    void setLayer(EntityData& e, const DRW_Entity& data) const {
+        e.layer = data.layer;
+        if (readerInternsNames) e.layerId = data.layerId;
     }
 
-    void addEntityData(const EntityData& e) {
-        entities.push_back(e);
+    void setLineType(EntityData& e, const DRW_Entity& data) const {
+        e.lineType = data.lineType;
+        if (readerInternsNames) e.lineTypeId = data.lineTypeId;
     }
 
     /* DRW_Interface implementation */
     void addHeader(const DRW_Header* data) override {
         if (data) {
             header = *data;
-            /* Extract version */
-            auto it = data->vars.find("$ACADVER");
-            if (it != data->vars.end() && it->second->type() == DRW_Variant::STRING) {
-                dxfVersion = *(it->second->content.s);
+            extractVersion();
+        }
+    }
+
+    void takeHeader(DRW_Header&& data) override {
+        if (header.vars.empty() && header.customVars.empty()) {
+            header = std::move(data);
+        } else {
+            /* A later HEADER section adds to the first one */
+            for (auto it = data.vars.begin(); it != data.vars.end(); ++it) {
+                header.vars.emplace(it->first, *it->second);
             }
+            for (auto it = data.customVars.begin(); it != data.customVars.end(); ++it) {
+                header.customVars.emplace(it->first, *it->second);
+            }
+        }
+        extractVersion();
+    }
+
+    void extractVersion() {
+        auto it = header.vars.find("$ACADVER");
+        if (it != header.vars.end() && it->second->type() == DRW_Variant::STRING) {
+            dxfVersion = *(it->second->content.s);
         }
     }
 
@@ -163,7 +305,9 @@ public:
         BlockData bd;
         bd.name = data.name;
         bd.basePoint = data.basePoint;
+        bd.first = blockEntities.size();
         blocks.push_back(bd);
+        blockExtents.addBlock(data.name, data.basePoint);
         currentBlock = &blocks.back();
     }
 
@@ -173,114 +317,283 @@ public:
         currentBlock = nullptr;
     }
 
-    void addPoint(const DRW_Point& data) override {
+    /* Entities the DXF reader delivers in batches: store() adds the
+       entity, extend() grows the bounds by it */
+    void store(const DRW_Point& data) {
         EntityData e;
         e.type = LC_ENTITY_POINT;
-        e.layer = data.layer;
+        setLayer(e, data);
         e.color = data.color;
-        e.lineType = data.lineType;
+        setLineType(e, data);
         e.handle = data.handle;
         e.point1 = data.basePoint;
         addEntityData(e);
-        updateBounds(data.basePoint);
     }
 
-    void addLine(const DRW_Line& data) override {
+    static void extend(Extent& ext, const DRW_Point& data) {
+        ext.add(data.basePoint);
+    }
+
+    void store(const DRW_Line& data) {
         EntityData e;
         e.type = LC_ENTITY_LINE;
-        e.layer = data.layer;
+        setLayer(e, data);
         e.color = data.color;
-        e.lineType = data.lineType;
+        setLineType(e, data);
         e.handle = data.handle;
         e.point1 = data.basePoint;
         e.point2 = data.secPoint;
         addEntityData(e);
-        updateBounds(data.basePoint);
-        updateBounds(data.secPoint);
     }
 
-    void addRay(const DRW_Ray& /*data*/) override {}
-    void addXline(const DRW_Xline& /*data*/) override {}
+    static void extend(Extent& ext, const DRW_Line& data) {
+        ext.add(data.basePoint);
+        ext.add(data.secPoint);
+    }
 
-    void addArc(const DRW_Arc& data) override {
+    void store(const DRW_Arc& data) {
         EntityData e;
         e.type = LC_ENTITY_ARC;
-        e.layer = data.layer;
+        setLayer(e, data);
         e.color = data.color;
-        e.lineType = data.lineType;
+        setLineType(e, data);
         e.handle = data.handle;
         e.point1 = data.basePoint;
         e.radius = data.radious;
         e.startAngle = data.staangle;
         e.endAngle = data.endangle;
         addEntityData(e);
-        /* Approximate bounds */
-        DRW_Coord c = data.basePoint;
-        updateBounds({c.x - data.radious, c.y - data.radious, c.z});
-        updateBounds({c.x + data.radious, c.y + data.radious, c.z});
     }
 
-    void addCircle(const DRW_Circle& data) override {
+    /* Approximate bounds for arcs: those of the full circle */
+    static void extend(Extent& ext, const DRW_Circle& data) {
+        const DRW_Coord& c = data.basePoint;
+        ext.add({c.x - data.radious, c.y - data.radious, c.z});
+        ext.add({c.x + data.radious, c.y + data.radious, c.z});
+    }
+
+    void store(const DRW_Circle& data) {
         EntityData e;
         e.type = LC_ENTITY_CIRCLE;
-        e.layer = data.layer;
+        setLayer(e, data);
         e.color = data.color;
-        e.lineType = data.lineType;
+        setLineType(e, data);
         e.handle = data.handle;
         e.point1 = data.basePoint;
         e.radius = data.radious;
         addEntityData(e);
-        DRW_Coord c = data.basePoint;
-        updateBounds({c.x - data.radious, c.y - data.radious, c.z});
-        updateBounds({c.x + data.radious, c.y + data.radious, c.z});
     }
 
-    void addEllipse(const DRW_Ellipse& data) override {
+    void store(const DRW_Ellipse& data) {
         EntityData e;
         e.type = LC_ENTITY_ELLIPSE;
-        e.layer = data.layer;
+        setLayer(e, data);
         e.color = data.color;
-        e.lineType = data.lineType;
+        setLineType(e, data);
         e.handle = data.handle;
         e.point1 = data.basePoint;
         e.point2 = data.secPoint; /* Major axis endpoint */
         e.radius = data.ratio;    /* Ratio minor/major */
+        e.startAngle = data.staparam;
+        e.endAngle = data.endparam;
         addEntityData(e);
-        /* Approximate bounds */
+    }
+
+    /* Approximate bounds */
+    static void extend(Extent& ext, const DRW_Ellipse& data) {
         double majorLen = std::sqrt(data.secPoint.x*data.secPoint.x +
                                     data.secPoint.y*data.secPoint.y);
-        DRW_Coord c = data.basePoint;
-        updateBounds({c.x - majorLen, c.y - majorLen, c.z});
-        updateBounds({c.x + majorLen, c.y + majorLen, c.z});
+        const DRW_Coord& c = data.basePoint;
+        ext.add({c.x - majorLen, c.y - majorLen, c.z});
+        ext.add({c.x + majorLen, c.y + majorLen, c.z});
     }
 
-    void addLWPolyline(const DRW_LWPolyline& data) override {
+    void store(const DRW_LWPolyline& data) {
         EntityData e;
         e.type = LC_ENTITY_LWPOLYLINE;
-        e.layer = data.layer;
+        setLayer(e, data);
         e.color = data.color;
-        e.lineType = data.lineType;
+        setLineType(e, data);
         e.handle = data.handle;
         e.vertexCount = static_cast<int>(data.vertlist.size());
         e.closed = (data.flags & 0x01) != 0;
         addEntityData(e);
-        for (const auto& v : data.vertlist) {
-            updateBounds({v->x, v->y, 0.0});
+        for (const DRW_Vertex2D& v : data.vertlist.values()) {
+            addEntityVertex({v.x, v.y, 0.0});
+        }
+    }
+
+    static void extend(Extent& ext, const DRW_LWPolyline& data) {
+        for (const DRW_Vertex2D& v : data.vertlist.values()) {
+            ext.add({v.x, v.y, 0.0});
+        }
+    }
+
+    void store(const DRW_Insert& data) {
+        EntityData e;
+        e.type = LC_ENTITY_INSERT;
+        setLayer(e, data);
+        e.color = data.color;
+        setLineType(e, data);
+        e.handle = data.handle;
+        e.blockName = data.name;
+        e.point1 = data.basePoint;
+        e.scaleX = data.xscale;
+        e.scaleY = data.yscale;
+        e.scaleZ = data.zscale;
+        e.rotation = data.angle;
+        e.columns = data.colcount;
+        e.rows = data.rowcount;
+        e.columnSpacing = data.colspace;
+        e.rowSpacing = data.rowspace;
+        addEntityData(e);
+        if (currentBlock) {
+            blockExtents.addInsert(currentBlock - blocks.data(), e.blockName, placement(e));
+        }
+    }
+
+    /* INSERTs are placed once all blocks are known, see placeInserts() */
+    static void extend(Extent& /*ext*/, const DRW_Insert& /*data*/) {}
+
+    void store(const DRW_Text& data) {
+        EntityData e;
+        e.type = LC_ENTITY_TEXT;
+        setLayer(e, data);
+        e.color = data.color;
+        setLineType(e, data);
+        e.handle = data.handle;
+        e.text = data.text;
+        e.point1 = data.basePoint;
+        e.height = data.height;
+        e.rotation = data.angle;
+        addEntityData(e);
+    }
+
+    static void extend(Extent& ext, const DRW_Text& data) {
+        ext.add(data.basePoint);
+    }
+
+    template <class T>
+    void addOne(const T& data) {
+        store(data);
+        Extent& target = currentBounds();
+        Extent ext = target;
+        extend(ext, data);
+        target = ext;
+    }
+
+    void addPoint(const DRW_Point& data) override { addOne(data); }
+    void addLine(const DRW_Line& data) override { addOne(data); }
+    void addRay(const DRW_Ray& /*data*/) override {}
+    void addXline(const DRW_Xline& /*data*/) override {}
+    void addArc(const DRW_Arc& data) override { addOne(data); }
+    void addCircle(const DRW_Circle& data) override { addOne(data); }
+    void addEllipse(const DRW_Ellipse& data) override { addOne(data); }
+    void addLWPolyline(const DRW_LWPolyline& data) override { addOne(data); }
+
+    /*
+     * Grow [lo, hi] by the values of v. Four independent lanes, which
+     * compile to packed min/max instructions instead of one dependent
+     * compare per value.
+     */
+    static void span(const std::vector<double>& v, double& lo, double& hi) {
+        const double* p = v.data();
+        size_t n = v.size();
+        double l[4] = {lo, lo, lo, lo};
+        double h[4] = {hi, hi, hi, hi};
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            for (int k = 0; k < 4; k++) {
+                l[k] = p[i + k] < l[k] ? p[i + k] : l[k];
+                h[k] = p[i + k] > h[k] ? p[i + k] : h[k];
+            }
+        }
+        for (; i < n; i++) {
+            l[0] = std::min(l[0], p[i]);
+            h[0] = std::max(h[0], p[i]);
         }
+        for (int k = 0; k < 4; k++) {
+            lo = std::min(lo, l[k]);
+            hi = std::max(hi, h[k]);
+        }
+    }
+
+    /* Same for v[i] - r[i] and v[i] + r[i], r may be negative */
+    static void span(const std::vector<double>& v, const std::vector<double>& r, double& lo, double& hi) {
+        const double* p = v.data();
+        const double* q = r.data();
+        size_t n = v.size();
+        double l[4] = {lo, lo, lo, lo};
+        double h[4] = {hi, hi, hi, hi};
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            for (int k = 0; k < 4; k++) {
+                double a = p[i + k] - q[i + k];
+                double b = p[i + k] + q[i + k];
+                double small = a < b ? a : b;
+                double large = a < b ? b : a;
+                l[k] = small < l[k] ? small : l[k];
+                h[k] = large > h[k] ? large : h[k];
+            }
+        }
+        for (; i < n; i++) {
+            double a = p[i] - q[i];
+            double b = p[i] + q[i];
+            l[0] = std::min(std::min(l[0], a), b);
+            h[0] = std::max(std::max(h[0], a), b);
+        }
+        for (int k = 0; k < 4; k++) {
+            lo = std::min(lo, l[k]);
+            hi = std::max(hi, h[k]);
+        }
+    }
+
+    /* Points given as coordinate columns */
+    static void extend(Extent& ext, const DRW_CoordColumns& points) {
+        span(points.x, ext.lo.x, ext.hi.x);
+        span(points.y, ext.lo.y, ext.hi.y);
+        span(points.z, ext.lo.z, ext.hi.z);
+    }
+
+    /* Circles and arcs as full circles, like extend(DRW_Circle) */
+    static void extend(Extent& ext, const DRW_CoordColumns& centers, const std::vector<double>& radii) {
+        span(centers.x, radii, ext.lo.x, ext.hi.x);
+        span(centers.y, radii, ext.lo.y, ext.hi.y);
+        span(centers.z, ext.lo.z, ext.hi.z);
+    }
+
+    /*
+     * The entities in file order, then the bounds: points, lines, circles
+     * and arcs from the coordinate columns, the others one array at a time
+     */
+    void addBatch(const DRW_EntityBatch& batch) override {
+        batch.forEach([this](const auto& e) { store(e); });
+        Extent& target = currentBounds();
+        Extent ext = target;
+        extend(ext, batch.pointCoords);
+        extend(ext, batch.lineStarts);
+        extend(ext, batch.lineEnds);
+        extend(ext, batch.circleCenters, batch.circleRadii);
+        extend(ext, batch.arcCenters, batch.arcRadii);
+        for (const DRW_Ellipse& e : batch.ellipses) extend(ext, e);
+        for (const DRW_Text& e : batch.texts) extend(ext, e);
+        for (const DRW_LWPolyline& e : batch.lwpolylines) extend(ext, e);
+        target = ext;
     }
 
     void addPolyline(const DRW_Polyline& data) override {
         EntityData e;
         e.type = LC_ENTITY_POLYLINE;
-        e.layer = data.layer;
+        setLayer(e, data);
         e.color = data.color;
-        e.lineType = data.lineType;
+        setLineType(e, data);
         e.handle = data.handle;
         e.vertexCount = static_cast<int>(data.vertlist.size());
         e.closed = (data.flags & 0x01) != 0;
         addEntityData(e);
-        for (const auto& v : data.vertlist) {
-            updateBounds(v->basePoint);
+        for (const DRW_Vertex& v : data.vertlist.values()) {
+            addEntityVertex(v.basePoint);
+            updateBounds(v.basePoint);
         }
     }
 
@@ -288,41 +601,29 @@ public:
         if (!data) return;
         EntityData e;
         e.type = LC_ENTITY_SPLINE;
-        e.layer = data->layer;
+        setLayer(e, *data);
         e.color = data->color;
-        e.lineType = data->lineType;
+        setLineType(e, *data);
         e.handle = data->handle;
         e.vertexCount = static_cast<int>(data->controllist.size());
         e.degree = data->degree;
         e.closed = (data->flags & 0x01) != 0;
         addEntityData(e);
-        for (const auto& cp : data->controllist) {
-            updateBounds({cp->x, cp->y, cp->z});
+        for (const DRW_Coord& cp : data->controllist.values()) {
+            addEntityVertex(cp);
+            updateBounds(cp);
         }
+        addEntityKnots(data->knotslist, data->weightlist);
     }
 
     void addKnot(const DRW_Entity& /*data*/) override {}
 
-    void addInsert(const DRW_Insert& data) override {
-        EntityData e;
-        e.type = LC_ENTITY_INSERT;
-        e.layer = data.layer;
-        e.color = data.color;
-        e.lineType = data.lineType;
-        e.handle = data.handle;
-        e.blockName = data.name;
-        e.point1 = data.basePoint;
-        e.scaleX = data.xscale;
-        e.scaleY = data.yscale;
-        e.rotation = data.angle;
-        addEntityData(e);
-        updateBounds(data.basePoint);
-    }
+    void addInsert(const DRW_Insert& data) override { addOne(data); }
 
     void addTrace(const DRW_Trace& data) override {
         EntityData e;
         e.type = LC_ENTITY_TRACE;
-        e.layer = data.layer;
+        setLayer(e, data);
         e.color = data.color;
         e.handle = data.handle;
         addEntityData(e);
@@ -331,7 +632,7 @@ public:
     void add3dFace(const DRW_3Dface& data) override {
         EntityData e;
         e.type = LC_ENTITY_3DFACE;
-        e.layer = data.layer;
+        setLayer(e, data);
         e.color = data.color;
         e.handle = data.handle;
         addEntityData(e);
@@ -340,7 +641,7 @@ public:
     void addSolid(const DRW_Solid& data) override {
         EntityData e;
         e.type = LC_ENTITY_SOLID;
-        e.layer = data.layer;
+        setLayer(e, data);
         e.color = data.color;
         e.handle = data.handle;
         addEntityData(e);
@@ -349,9 +650,9 @@ public:
     void addMText(const DRW_MText& data) override {
         EntityData e;
         e.type = LC_ENTITY_MTEXT;
-        e.layer = data.layer;
+        setLayer(e, data);
         e.color = data.color;
-        e.lineType = data.lineType;
+        setLineType(e, data);
         e.handle = data.handle;
         e.text = data.text;
         e.point1 = data.basePoint;
@@ -360,20 +661,7 @@ public:
         updateBounds(data.basePoint);
     }
 
-    void addText(const DRW_Text& data) override {
-        EntityData e;
-        e.type = LC_ENTITY_TEXT;
-        e.layer = data.layer;
-        e.color = data.color;
-        e.lineType = data.lineType;
-        e.handle = data.handle;
-        e.text = data.text;
-        e.point1 = data.basePoint;
-        e.height = data.height;
-        e.rotation = data.angle;
-        addEntityData(e);
-        updateBounds(data.basePoint);
-    }
+    void addText(const DRW_Text& data) override { addOne(data); }
 
     void addTolerance(const DRW_Tolerance& /*tol*/) override {}
 
@@ -381,7 +669,7 @@ public:
         if (!data) return;
         EntityData e;
         e.type = LC_ENTITY_DIMENSION;
-        e.layer = data->layer;
+        setLayer(e, *data);
         e.color = data->color;
         e.handle = data->handle;
         addEntityData(e);
@@ -391,7 +679,7 @@ public:
         if (!data) return;
         EntityData e;
         e.type = LC_ENTITY_DIMENSION;
-        e.layer = data->layer;
+        setLayer(e, *data);
         e.color = data->color;
         e.handle = data->handle;
         addEntityData(e);
@@ -401,7 +689,7 @@ public:
         if (!data) return;
         EntityData e;
         e.type = LC_ENTITY_DIMENSION;
-        e.layer = data->layer;
+        setLayer(e, *data);
         e.color = data->color;
         e.handle = data->handle;
         addEntityData(e);
@@ -411,7 +699,7 @@ public:
         if (!data) return;
         EntityData e;
         e.type = LC_ENTITY_DIMENSION;
-        e.layer = data->layer;
+        setLayer(e, *data);
         e.color = data->color;
         e.handle = data->handle;
         addEntityData(e);
@@ -421,7 +709,7 @@ public:
         if (!data) return;
         EntityData e;
         e.type = LC_ENTITY_DIMENSION;
-        e.layer = data->layer;
+        setLayer(e, *data);
         e.color = data->color;
         e.handle = data->handle;
         addEntityData(e);
@@ -431,7 +719,7 @@ public:
         if (!data) return;
         EntityData e;
         e.type = LC_ENTITY_DIMENSION;
-        e.layer = data->layer;
+        setLayer(e, *data);
         e.color = data->color;
         e.handle = data->handle;
         addEntityData(e);
@@ -441,7 +729,7 @@ public:
         if (!data) return;
         EntityData e;
         e.type = LC_ENTITY_DIMENSION;
-        e.layer = data->layer;
+        setLayer(e, *data);
         e.color = data->color;
         e.handle = data->handle;
         addEntityData(e);
@@ -451,7 +739,7 @@ public:
         if (!data) return;
         EntityData e;
         e.type = LC_ENTITY_LEADER;
-        e.layer = data->layer;
+        setLayer(e, *data);
         e.color = data->color;
         e.handle = data->handle;
         addEntityData(e);
@@ -461,7 +749,7 @@ public:
         if (!data) return;
         EntityData e;
         e.type = LC_ENTITY_HATCH;
-        e.layer = data->layer;
+        setLayer(e, *data);
         e.color = data->color;
         e.handle = data->handle;
         addEntityData(e);
@@ -470,7 +758,7 @@ public:
     void addViewport(const DRW_Viewport& data) override {
         EntityData e;
         e.type = LC_ENTITY_VIEWPORT;
-        e.layer = data.layer;
+        setLayer(e, data);
         e.handle = data.handle;
         addEntityData(e);
     }
@@ -479,7 +767,7 @@ public:
         if (!data) return;
         EntityData e;
         e.type = LC_ENTITY_IMAGE;
-        e.layer = data->layer;
+        setLayer(e, *data);
         e.color = data->color;
         e.handle = data->handle;
         addEntityData(e);
@@ -518,6 +806,7 @@ public:
             block.basePoint = b.basePoint;
             block.flags = 0;
             dxfWriter->writeBlock(&block);
+            writeStore(blockEntities, b.first, b.count);
         }
     }
 
@@ -535,45 +824,71 @@ public:
         }
     }
 
+    /* Names of e on an entity being written, assigned only when they change */
+    static void setWriteNames(DRW_Entity& out, const EntityData& e, bool withLineType = true) {
+        if (out.layerId != e.layerId) {
+            out.layer = e.layer.empty() ? "0" : e.layer;
+            out.layerId = e.layerId;
+        }
+        if (withLineType && out.lineTypeId != e.lineTypeId) {
+            out.lineType = e.lineType;
+            out.lineTypeId = e.lineTypeId;
+        }
+    }
+
     void writeEntities() override {
         if (!dxfWriter) return;
-
-        for (const auto& e : entities) {
+        writeStore(entities, 0, entities.size());
+    }
+
+    /* Entities [first, first + count) of store, to the block or section being written */
+    void writeStore(const EntityStore& store, size_t first, size_t count) {
+        /*
+         * One object per type, reused for every entity of that type. Each
+         * case sets all the fields it writes, and the names are copied
+         * only when the layer or line type differs from the last one.
+         */
+        DRW_Point pt;
+        DRW_Line ln;
+        DRW_Circle cir;
+        DRW_Arc arc;
+        DRW_Ellipse ell;
+        DRW_Text txt;
+        DRW_MText mtxt;
+        DRW_Insert ins;
+        DRW_Solid sol;
+        DRW_Trace tr;
+        DRW_3Dface face;
+
+        for (size_t i = first; i < first + count; i++) {
+            const EntityData e = store.get(i);
             switch (e.type) {
                 case LC_ENTITY_POINT: {
-                    DRW_Point pt;
-                    pt.layer = e.layer.empty() ? "0" : e.layer;
+                    setWriteNames(pt, e);
                     pt.color = e.color;
-                    pt.lineType = e.lineType;
                     pt.basePoint = e.point1;
                     dxfWriter->writePoint(&pt);
                     break;
                 }
                 case LC_ENTITY_LINE: {
-                    DRW_Line ln;
-                    ln.layer = e.layer.empty() ? "0" : e.layer;
+                    setWriteNames(ln, e);
                     ln.color = e.color;
-                    ln.lineType = e.lineType;
                     ln.basePoint = e.point1;
                     ln.secPoint = e.point2;
                     dxfWriter->writeLine(&ln);
                     break;
                 }
                 case LC_ENTITY_CIRCLE: {
-                    DRW_Circle cir;
-                    cir.layer = e.layer.empty() ? "0" : e.layer;
+                    setWriteNames(cir, e);
                     cir.color = e.color;
-                    cir.lineType = e.lineType;
                     cir.basePoint = e.point1;
                     cir.radious = e.radius;
                     dxfWriter->writeCircle(&cir);
                     break;
                 }
                 case LC_ENTITY_ARC: {
-                    DRW_Arc arc;
-                    arc.layer = e.layer.empty() ? "0" : e.layer;
+                    setWriteNames(arc, e);
                     arc.color = e.color;
-                    arc.lineType = e.lineType;
                     arc.basePoint = e.point1;
                     arc.radious = e.radius;
                     arc.staangle = e.startAngle;
@@ -582,10 +897,8 @@ public:
                     break;
                 }
                 case LC_ENTITY_ELLIPSE: {
-                    DRW_Ellipse ell;
-                    ell.layer = e.layer.empty() ? "0" : e.layer;
+                    setWriteNames(ell, e);
                     ell.color = e.color;
-                    ell.lineType = e.lineType;
                     ell.basePoint = e.point1;
                     ell.secPoint = e.point2;
                     ell.ratio = e.radius;
@@ -595,10 +908,8 @@ public:
                     break;
                 }
                 case LC_ENTITY_TEXT: {
-                    DRW_Text txt;
-                    txt.layer = e.layer.empty() ? "0" : e.layer;
+                    setWriteNames(txt, e);
                     txt.color = e.color;
-                    txt.lineType = e.lineType;
                     txt.basePoint = e.point1;
                     txt.secPoint = e.point1;
                     txt.text = e.text;
@@ -614,10 +925,8 @@ public:
                     break;
                 }
                 case LC_ENTITY_MTEXT: {
-                    DRW_MText mtxt;
-                    mtxt.layer = e.layer.empty() ? "0" : e.layer;
+                    setWriteNames(mtxt, e);
                     mtxt.color = e.color;
-                    mtxt.lineType = e.lineType;
                     mtxt.basePoint = e.point1;
                     mtxt.text = e.text;
                     mtxt.height = e.height > 0 ? e.height : 2.5;
@@ -632,26 +941,23 @@ public:
                     break;
                 }
                 case LC_ENTITY_INSERT: {
-                    DRW_Insert ins;
-                    ins.layer = e.layer.empty() ? "0" : e.layer;
+                    setWriteNames(ins, e);
                     ins.color = e.color;
-                    ins.lineType = e.lineType;
                     ins.name = e.blockName;
                     ins.basePoint = e.point1;
                     ins.xscale = e.scaleX;
                     ins.yscale = e.scaleY;
-                    ins.zscale = 1.0;
+                    ins.zscale = e.scaleZ;
                     ins.angle = e.rotation;
-                    ins.colcount = 1;
-                    ins.rowcount = 1;
-                    ins.colspace = 0.0;
-                    ins.rowspace = 0.0;
+                    ins.colcount = e.columns;
+                    ins.rowcount = e.rows;
+                    ins.colspace = e.columnSpacing;
+                    ins.rowspace = e.rowSpacing;
                     dxfWriter->writeInsert(&ins);
                     break;
                 }
                 case LC_ENTITY_SOLID: {
-                    DRW_Solid sol;
-                    sol.layer = e.layer.empty() ? "0" : e.layer;
+                    setWriteNames(sol, e, false);
                     sol.color = e.color;
                     sol.basePoint = e.point1;
                     sol.secPoint = e.point1;
@@ -661,8 +967,7 @@ public:
                     break;
                 }
                 case LC_ENTITY_TRACE: {
-                    DRW_Trace tr;
-                    tr.layer = e.layer.empty() ? "0" : e.layer;
+                    setWriteNames(tr, e, false);
                     tr.color = e.color;
                     tr.basePoint = e.point1;
                     tr.secPoint = e.point1;
@@ -672,8 +977,7 @@ public:
                     break;
                 }
                 case LC_ENTITY_3DFACE: {
-                    DRW_3Dface face;
-                    face.layer = e.layer.empty() ? "0" : e.layer;
+                    setWriteNames(face, e, false);
                     face.color = e.color;
                     face.basePoint = e.point1;
                     face.secPoint = e.point1;
@@ -870,7 +1174,9 @@ public:
         BlockData bd;
         bd.name = data.name;
         bd.basePoint = {data.bpx, data.bpy, data.bpz};
+        bd.first = doc->blockEntities.size();
         doc->blocks.push_back(bd);
+        doc->blockExtents.addBlock(bd.name, bd.basePoint);
     }
 
     void endBlock() override {}
@@ -898,9 +1204,11 @@ public:
         e.type = LC_ENTITY_ARC;
         e.point1 = {data.cx, data.cy, data.cz};
         e.radius = data.radius;
-        e.startAngle = data.angle1;
-        e.endAngle = data.angle2;
+        /* jwwlib passes arc angles in degrees */
+        e.startAngle = data.angle1 / ARAD;
+        e.endAngle = data.angle2 / ARAD;
         doc->addEntityData(e);
+        addCircleBounds(e.point1, e.radius);
     }
 
     void addCircle(const DL_CircleData& data) override {
@@ -909,6 +1217,7 @@ public:
         e.point1 = {data.cx, data.cy, data.cz};
         e.radius = data.radius;
         doc->addEntityData(e);
+        addCircleBounds(e.point1, e.radius);
     }
 
     void addEllipse(const DL_EllipseData& data) override {
@@ -917,7 +1226,16 @@ public:
         e.point1 = {data.cx, data.cy, data.cz};
         e.point2 = {data.mx, data.my, data.mz};
         e.radius = data.ratio;
+        e.startAngle = data.angle1;
+        e.endAngle = data.angle2;
         doc->addEntityData(e);
+        addCircleBounds(e.point1, std::sqrt(data.mx*data.mx + data.my*data.my));
+    }
+
+    /* Fast bounds of arcs and ellipses, like DocumentImpl::extend() */
+    void addCircleBounds(const DRW_Coord& c, double r) {
+        doc->updateBounds({c.x - r, c.y - r, c.z});
+        doc->updateBounds({c.x + r, c.y + r, c.z});
     }
 
     void addPolyline(const DL_PolylineData& data) override {
@@ -929,6 +1247,7 @@ public:
     }
 
     void addVertex(const DL_VertexData& data) override {
+        doc->addEntityVertex({data.x, data.y, data.z});
         doc->updateBounds({data.x, data.y, data.z});
     }
 
@@ -941,6 +1260,7 @@ public:
     }
 
     void addControlPoint(const DL_ControlPointData& data) override {
+        doc->addEntityVertex({data.x, data.y, data.z});
         doc->updateBounds({data.x, data.y, data.z});
     }
 
@@ -1071,18 +1391,266 @@ public:
     void setVariableDouble(const char* /*key*/, double /*value*/, int /*code*/) override {}
 };
 
+/* ============================================================================
+ * Entity cursor (internal)
+ * ============================================================================ */
+
+/* Thrown from the cursor to unwind the DXF parser after lc_cursor_close() */
+struct CursorClosed {};
+
+/*
+ * Document that hands its entities to the cursor owner instead of keeping
+ * them. The parser runs on its own thread and blocks while `capacity`
+ * entities are waiting; the reader takes them over in batches by swapping
+ * stores, so the two threads do not wake each other for every entity.
+ */
+class CursorImpl : public DocumentImpl {
+public:
+    static constexpr size_t capacity = 1024;
+    static constexpr size_t batch = 128;
+
+    std::thread parser;
+    std::mutex mutex;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+    EntityStore pending;  /* filled by the parser, guarded by mutex */
+    EntityStore ready;    /* batch taken over by lc_cursor_next() */
+    size_t next = 0;      /* next entity of ready to return */
+    bool finished = false;  /* parser has returned */
+    bool failed = false;
+    bool closed = false;    /* lc_cursor_close() was called */
+    std::string error;
+
+    /* Entity last returned by lc_cursor_next(), its strings are in ready */
+    LcEntityInfo info{};
+
+    /* Model space only, block contents are not reported */
+    void addEntityData(const EntityData& e) override {
+        if (currentBlock) return;
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this] { return closed || pending.size() < capacity; });
+        if (closed) {
+            /* dxfRW cleans up when unwound; jwwlib does not, let it finish */
+            if (format == LC_FORMAT_DXF || format == LC_FORMAT_DWG) {
+                throw CursorClosed();
+            }
+            return;
+        }
+        pending.add(e);
+        if (pending.size() == batch) {
+            notEmpty.notify_one();
+        }
+    }
+
+    /* The cursor reports vertex counts only */
+    void addEntityVertex(const DRW_Coord& /*v*/) override {}
+    void addEntityKnots(const std::vector<double>& /*knots*/, const std::vector<double>& /*weights*/) override {}
+
+    /* The stores change hands between threads and intern their own names */
+    DRW_NameTable* readerNames() override {
+        return nullptr;
+    }
+};
+
+/* ============================================================================
+ * Streaming validation (internal)
+ * ============================================================================ */
+
+/* Thrown to unwind the DXF parser once a fail-fast validation found an error */
+struct ValidationStopped {};
+
+/*
+ * Document that validates its entities as they are read instead of
+ * keeping them. Entities collect in the two stores until a reader batch
+ * is full, are checked and dropped; only the tables and block extents are
+ * kept. Checking a batch at a time costs no latency, as the parser reads
+ * a batch ahead before handing it over.
+ */
+class ValidatingImpl : public DocumentImpl {
+public:
+    StreamingValidation validation;
+    size_t modelChecked = 0;   /* entities checked before those in entities */
+    size_t blockChecked = 0;   /* same for blockEntities */
+    size_t layersDefined = 0;  /* layers and blocks passed on to validation */
+    size_t blocksDefined = 0;
+    /* Model space INSERTs read while there were no other bounds, placed by finish() */
+    std::vector<std::pair<std::string, Placement>> unplacedInserts;
+
+    ValidatingImpl(RuleSet rules, bool failFast) : validation(rules, failFast) {}
+
+    void addEntityData(const EntityData& e) override {
+        if (validation.stopped()) return;  /* jwwlib reads on to the end */
+
+        /*
+         * A batch is checked when it is full or the reader moves between
+         * blocks and model space, before the next entity, whose vertices
+         * may follow
+         */
+        bool inBlocks = currentBlock != nullptr;
+        EntityStore& other = inBlocks ? entities : blockEntities;
+        EntityStore& store = inBlocks ? blockEntities : entities;
+        if ((!other.empty() && !checkBatch(!inBlocks)) || (store.size() == readerBatchSize && !checkBatch(inBlocks))) {
+            stop();
+            return;
+        }
+
+        if (inBlocks) {
+            if (currentBlock->count == 0) currentBlock->first = blockChecked + blockEntities.size();
+            EntityData copy = e;
+            copy.layerId = copy.lineTypeId = EntityData::noName;
+            blockEntities.add(copy);
+            currentBlock->count++;
+            return;
+        }
+        if (e.type == LC_ENTITY_INSERT && bounds.empty()) {
+            unplacedInserts.emplace_back(e.blockName, placement(e));
+        }
+        entities.add(e);
+    }
+
+    /* From here on an undefined layer or block is an error as soon as it is checked */
+    void endTables() override {
+        defineNames();
+        if (!validation.endLayers()) stop();
+    }
+
+    void endBlocks() override {
+        defineNames();
+        if (!validation.endBlocks()) stop();
+    }
+
+    void defineNames() {
+        for (; layersDefined < layers.size(); layersDefined++) {
+            validation.defineLayer(layers[layersDefined].name);
+        }
+        for (; blocksDefined < blocks.size(); blocksDefined++) {
+            validation.defineBlock(blocks[blocksDefined].name);
+        }
+    }
+
+    /* Check the entities collected in a store and drop them; false once fail-fast stopped */
+    bool checkBatch(bool inBlocks) {
+        defineNames();
+        EntityStore& store = inBlocks ? blockEntities : entities;
+        size_t& checked = inBlocks ? blockChecked : modelChecked;
+        bool go = validation.check(store, inBlocks, checked);
+        checked += store.size();
+        store.clear();
+        return go;
+    }
+
+    void stop() {
+        /* dxfRW cleans up when unwound; jwwlib does not, let it finish */
+        if (format == LC_FORMAT_DXF || format == LC_FORMAT_DWG) {
+            throw ValidationStopped();
+        }
+    }
+
+    /* Check what is left and report */
+    ValidationReport finish() {
+        if (checkBatch(false)) checkBatch(true);
+        defineNames();
+        if (bounds.empty()) {
+            for (const auto& insert : unplacedInserts) blockExtents.place(bounds, insert.first, insert.second);
+        }
+
+        ValidationInput input;
+        for (const auto& l : layers) input.layers.push_back(l.name);
+        /* Only blocks with entities had their start set */
+        size_t next = 0;
+        for (const auto& b : blocks) {
+            size_t first = b.count ? b.first : next;
+            input.blocks.push_back({b.name, first, b.count});
+            next = first + b.count;
+        }
+        input.entityCount = modelChecked;
+        input.boundsEmpty = bounds.empty();
+        return validation.finish(input);
+    }
+};
+
 /* ============================================================================
  * Helper functions
  * ============================================================================ */
 
-static char* strdup_cpp(const std::string& s) {
+static char* strdup_cpp(std::string_view s) {
     char* result = static_cast<char*>(malloc(s.size() + 1));
     if (result) {
-        std::memcpy(result, s.c_str(), s.size() + 1);
+        std::memcpy(result, s.data(), s.size());
+        result[s.size()] = '\0';
     }
     return result;
 }
 
+/* Strings of entities handed out by a cursor stay owned by the cursor's store */
+static char* borrowString(std::string_view s) {
+    return const_cast<char*>(s.data());
+}
+
+/*
+ * Fill a zeroed LcEntityInfo; `str` either copies or borrows the strings.
+ * `names` holds a string per name ID for the layer, line type and block
+ * name, or is nullptr to take those through `str` as well.
+ */
+static void fillEntityInfo(const EntityData& e, LcEntityInfo& out, LcDetailLevel detail,
+                           char* (*str)(std::string_view), char* const* names) {
+    out.type = e.type;
+    out.layer = names ? names[e.layerId] : str(e.layer);
+    out.color = e.color;
+    out.line_type = names ? names[e.lineTypeId] : str(e.lineType);
+    out.line_weight = e.lineWeight;
+    out.handle = e.handle;
+
+    if (detail < LC_DETAIL_FULL) return;
+
+    /* Fill geometry data based on type */
+    switch (e.type) {
+        case LC_ENTITY_POINT:
+            out.data.point.point = {e.point1.x, e.point1.y, e.point1.z};
+            break;
+        case LC_ENTITY_LINE:
+            out.data.line.start = {e.point1.x, e.point1.y, e.point1.z};
+            out.data.line.end = {e.point2.x, e.point2.y, e.point2.z};
+            break;
+        case LC_ENTITY_CIRCLE:
+            out.data.circle.center = {e.point1.x, e.point1.y, e.point1.z};
+            out.data.circle.radius = e.radius;
+            break;
+        case LC_ENTITY_ARC:
+            out.data.arc.center = {e.point1.x, e.point1.y, e.point1.z};
+            out.data.arc.radius = e.radius;
+            out.data.arc.start_angle = e.startAngle;
+            out.data.arc.end_angle = e.endAngle;
+            break;
+        case LC_ENTITY_TEXT:
+        case LC_ENTITY_MTEXT:
+            out.data.text.text = str(e.text);
+            out.data.text.position = {e.point1.x, e.point1.y, e.point1.z};
+            out.data.text.height = e.height;
+            out.data.text.rotation = e.rotation;
+            break;
+        case LC_ENTITY_INSERT:
+            out.data.insert.block_name = names ? names[e.blockNameId] : str(e.blockName);
+            out.data.insert.position = {e.point1.x, e.point1.y, e.point1.z};
+            out.data.insert.scale_x = e.scaleX;
+            out.data.insert.scale_y = e.scaleY;
+            out.data.insert.rotation = e.rotation;
+            break;
+        case LC_ENTITY_POLYLINE:
+        case LC_ENTITY_LWPOLYLINE:
+            out.data.polyline.vertex_count = e.vertexCount;
+            out.data.polyline.is_closed = e.closed ? 1 : 0;
+            break;
+        case LC_ENTITY_SPLINE:
+            out.data.spline.control_point_count = e.vertexCount;
+            out.data.spline.degree = e.degree;
+            out.data.spline.is_closed = e.closed ? 1 : 0;
+            break;
+        default:
+            break;
+    }
+}
+
 static std::string escapeJson(const std::string& s) {
     std::ostringstream oss;
     for (char c : s) {
@@ -1119,36 +1687,232 @@ static DRW::Version lcVersionToDrw(LcDxfVersion v) {
     }
 }
 
-static const char* entityTypeName(LcEntityType t) {
-    switch (t) {
-        case LC_ENTITY_POINT: return "POINT";
-        case LC_ENTITY_LINE: return "LINE";
-        case LC_ENTITY_CIRCLE: return "CIRCLE";
-        case LC_ENTITY_ARC: return "ARC";
-        case LC_ENTITY_ELLIPSE: return "ELLIPSE";
-        case LC_ENTITY_POLYLINE: return "POLYLINE";
-        case LC_ENTITY_LWPOLYLINE: return "LWPOLYLINE";
-        case LC_ENTITY_SPLINE: return "SPLINE";
-        case LC_ENTITY_TEXT: return "TEXT";
-        case LC_ENTITY_MTEXT: return "MTEXT";
-        case LC_ENTITY_INSERT: return "INSERT";
-        case LC_ENTITY_HATCH: return "HATCH";
-        case LC_ENTITY_DIMENSION: return "DIMENSION";
-        case LC_ENTITY_LEADER: return "LEADER";
-        case LC_ENTITY_SOLID: return "SOLID";
-        case LC_ENTITY_TRACE: return "TRACE";
-        case LC_ENTITY_3DFACE: return "3DFACE";
-        case LC_ENTITY_IMAGE: return "IMAGE";
-        case LC_ENTITY_VIEWPORT: return "VIEWPORT";
-        default: return "UNKNOWN";
+static int parserThreads(const LcOpenOptions* options) {
+    if (!options) return 1;
+    if (options->threads == LC_THREADS_AUTO) {
+        return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
     }
+    return std::max(1, options->threads);
 }
 
-/* ============================================================================
- * C API Implementation
- * ============================================================================ */
+static LcBoundsMode boundsMode(const LcOpenOptions* options) {
+    return options && options->bounds == LC_BOUNDS_REFINED ? LC_BOUNDS_REFINED : LC_BOUNDS_FAST;
+}
 
-extern "C" {
+/* Check that a file exists and has a supported format */
+static bool checkDocumentFile(const char* filename, LcFormat* format) {
+    if (!filename) {
+        g_last_error = "Filename is null";
+        return false;
+    }
+
+    /* Check file exists */
+    std::ifstream f(filename);
+    if (!f.good()) {
+        g_last_error = "File not found: " + std::string(filename);
+        return false;
+    }
+    f.close();
+
+    *format = lc_detect_format(filename);
+    if (*format == LC_FORMAT_UNKNOWN) {
+        g_last_error = "Unsupported file format";
+        return false;
+    }
+    return true;
+}
+
+/* Name of a compression for error messages */
+static const char* compressionName(DRW_Compression c) {
+    return c == DRW_Compression::Zstd ? "zstd" : "gzip";
+}
+
+/* Compression of a file from its magic number */
+static DRW_Compression fileCompression(const std::string& filename) {
+    char magic[4];
+    std::ifstream f(filename, std::ios::binary);
+    f.read(magic, sizeof(magic));
+    return DRW_sniffCompression(magic, static_cast<size_t>(f.gcount()));
+}
+
+/*
+ * Have the DXF reader deliver entities in batches, with IDs from the
+ * document's name table
+ */
+static void setupReader(dxfRW& dxf, DocumentImpl* doc) {
+    DRW_NameTable* names = doc->readerNames();
+    dxf.setNameTable(names);
+    doc->readerInternsNames = names != nullptr;
+    dxf.setBatchSize(readerBatchSize);
+}
+
+/* Parse doc->filename into doc according to doc->format */
+static bool readDocument(DocumentImpl* doc, const LcOpenOptions* options) {
+    bool success = false;
+
+    if (doc->format == LC_FORMAT_DXF || doc->format == LC_FORMAT_DWG) {
+        dxfRW dxf(doc->filename.c_str());
+        dxf.setMemoryMapped(true);
+        dxf.setThreads(parserThreads(options));
+        setupReader(dxf, doc);
+        success = dxf.read(doc, false);
+        if (!success) {
+            DRW_Compression compression = fileCompression(doc->filename);
+            if (!DRW_compressionSupported(compression)) {
+                g_last_error = std::string(compressionName(compression)) +
+                               " compressed DXF is not supported by this build";
+            } else if (compression != DRW_Compression::None) {
+                g_last_error = std::string("Failed to read ") + compressionName(compression) +
+                               " compressed DXF file";
+            } else {
+                g_last_error = "Failed to read DXF file";
+            }
+        }
+    } else {
+        DL_Jww jww;
+        JwwReaderImpl reader;
+        reader.doc = doc;
+        success = jww.in(doc->filename, &reader);
+        if (!success) {
+            g_last_error = "Failed to read JWW file";
+        }
+    }
+
+    return success;
+}
+
+/* Format of a document from its first bytes; anything unrecognised is left to the DXF reader */
+static LcFormat sniffFormat(std::string_view head) {
+    if (head.substr(0, 8) == "JwwData.") return LC_FORMAT_JWW;
+    if (head.substr(0, 4) == "AC10") return LC_FORMAT_DWG;
+    return LC_FORMAT_DXF;
+}
+
+/* Error message for a DXF source that failed to parse */
+static const char* dxfSourceError(const dxfRW& dxf) {
+    /* BAD_OPEN is only reported for compressed data this build can't inflate */
+    return dxf.getError() == DRW::BAD_OPEN ? "Compressed DXF is not supported by this build"
+                                           : "Failed to read DXF data";
+}
+
+/* Parse a stream buffer of the given format into doc */
+static bool readDocumentSource(DocumentImpl* doc, std::streambuf* source, const LcOpenOptions* options) {
+    bool success = false;
+
+    if (doc->format == LC_FORMAT_DXF) {
+        dxfRW dxf(doc->filename.c_str());
+        dxf.setThreads(parserThreads(options));
+        setupReader(dxf, doc);
+        success = dxf.read(doc, false, source);
+        if (!success) {
+            g_last_error = dxfSourceError(dxf);
+        }
+    } else if (doc->format == LC_FORMAT_JWW) {
+        DL_Jww jww;
+        JwwReaderImpl reader;
+        reader.doc = doc;
+        success = jww.in(source, &reader);
+        if (!success) {
+            g_last_error = "Failed to read JWW data";
+        }
+    } else {
+        g_last_error = "Unsupported file format";
+    }
+
+    return success;
+}
+
+/* Serialize doc into a stream buffer; the buffer is synced on success */
+static LcError saveDocument(DocumentImpl* doc, LcFormat format, LcDxfVersion version,
+                            LcDxfFormat dxfFormat, std::streambuf* sink) {
+    if (format == LC_FORMAT_DXF) {
+        dxfRW dxf("");
+        /* Set the dxfWriter pointer so writeEntities() etc. can use it */
+        doc->dxfWriter = &dxf;
+        bool success = dxf.write(doc, lcVersionToDrw(version), dxfFormat == LC_DXF_BINARY, sink);
+        doc->dxfWriter = nullptr;
+        if (!success) {
+            g_last_error = "Failed to write DXF data";
+            return LC_ERR_WRITE_ERROR;
+        }
+        return LC_OK;
+    }
+    if (format == LC_FORMAT_JWW) {
+        return lc_document_save_jww(reinterpret_cast<LcDocument*>(doc), sink);
+    }
+    g_last_error = "Unsupported output format";
+    return LC_ERR_INVALID_FORMAT;
+}
+
+/* LC_DETAIL_SUMMARY info from the summary scanner */
+static LcFileInfo* summaryInfo(const char* filename, const DxfSummary& summary) {
+    auto* info = static_cast<LcFileInfo*>(calloc(1, sizeof(LcFileInfo)));
+    if (!info) return nullptr;
+
+    info->filename = strdup_cpp(filename);
+    info->format = LC_FORMAT_DXF;
+    info->dxf_version = strdup_cpp(summary.dxfVersion);
+    info->layer_count = summary.layerCount;
+    info->block_count = summary.blockCount;
+    for (int i = 0; i < 20; i++) {
+        info->entity_counts[i] = summary.entityCounts[i];
+        info->entity_count += summary.entityCounts[i];
+    }
+    info->bounds.min = {summary.bounds.lo.x, summary.bounds.lo.y, summary.bounds.lo.z};
+    info->bounds.max = {summary.bounds.hi.x, summary.bounds.hi.y, summary.bounds.hi.z};
+    return info;
+}
+
+/* Body of the cursor parser thread */
+static void runCursor(CursorImpl* cursor) {
+    bool success = false;
+    try {
+        success = readDocument(cursor, nullptr);
+    } catch (const CursorClosed&) {
+        success = true;
+    } catch (const std::exception& ex) {
+        g_last_error = ex.what();
+    }
+
+    std::lock_guard<std::mutex> lock(cursor->mutex);
+    cursor->finished = true;
+    cursor->failed = !success;
+    if (!success) {
+        cursor->error = g_last_error;  /* g_last_error is per thread */
+    }
+    cursor->notEmpty.notify_all();
+}
+
+static const char* entityTypeName(LcEntityType t) {
+    switch (t) {
+        case LC_ENTITY_POINT: return "POINT";
+        case LC_ENTITY_LINE: return "LINE";
+        case LC_ENTITY_CIRCLE: return "CIRCLE";
+        case LC_ENTITY_ARC: return "ARC";
+        case LC_ENTITY_ELLIPSE: return "ELLIPSE";
+        case LC_ENTITY_POLYLINE: return "POLYLINE";
+        case LC_ENTITY_LWPOLYLINE: return "LWPOLYLINE";
+        case LC_ENTITY_SPLINE: return "SPLINE";
+        case LC_ENTITY_TEXT: return "TEXT";
+        case LC_ENTITY_MTEXT: return "MTEXT";
+        case LC_ENTITY_INSERT: return "INSERT";
+        case LC_ENTITY_HATCH: return "HATCH";
+        case LC_ENTITY_DIMENSION: return "DIMENSION";
+        case LC_ENTITY_LEADER: return "LEADER";
+        case LC_ENTITY_SOLID: return "SOLID";
+        case LC_ENTITY_TRACE: return "TRACE";
+        case LC_ENTITY_3DFACE: return "3DFACE";
+        case LC_ENTITY_IMAGE: return "IMAGE";
+        case LC_ENTITY_VIEWPORT: return "VIEWPORT";
+        default: return "UNKNOWN";
+    }
+}
+
+/* ============================================================================
+ * C API Implementation
+ * ============================================================================ */
+
+extern "C" {
 
 const char* lc_version(void) {
     static char version[32];
@@ -1167,6 +1931,11 @@ LcFormat lc_detect_format(const char* filename) {
     if (!filename) return LC_FORMAT_UNKNOWN;
 
     std::string fn(filename);
+    /* drawing.dxf.gz and drawing.dxf.zst are compressed DXF */
+    DRW_Compression compression = DRW_compressionFromName(fn);
+    if (compression != DRW_Compression::None) {
+        fn.erase(fn.rfind('.'));
+    }
     size_t dotPos = fn.rfind('.');
     if (dotPos == std::string::npos) return LC_FORMAT_UNKNOWN;
 
@@ -1175,6 +1944,7 @@ LcFormat lc_detect_format(const char* filename) {
     for (char& c : ext) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
 
     if (ext == "dxf") return LC_FORMAT_DXF;
+    if (compression != DRW_Compression::None) return LC_FORMAT_UNKNOWN;
     if (ext == "dwg") return LC_FORMAT_DWG;
     if (ext == "jww") return LC_FORMAT_JWW;
     if (ext == "jwc") return LC_FORMAT_JWC;
@@ -1183,54 +1953,103 @@ LcFormat lc_detect_format(const char* filename) {
 }
 
 LcDocument* lc_document_open(const char* filename) {
-    if (!filename) {
-        g_last_error = "Filename is null";
-        return nullptr;
-    }
+    return lc_document_open_ex(filename, nullptr);
+}
 
-    /* Check file exists */
-    std::ifstream f(filename);
-    if (!f.good()) {
-        g_last_error = "File not found: " + std::string(filename);
+LcDocument* lc_document_open_ex(const char* filename, const LcOpenOptions* options) {
+    LcFormat format;
+    if (!checkDocumentFile(filename, &format)) {
         return nullptr;
     }
-    f.close();
-
-    LcFormat format = lc_detect_format(filename);
 
     auto doc = std::make_unique<DocumentImpl>();
     doc->filename = filename;
     doc->format = format;
 
-    bool success = false;
+    if (!readDocument(doc.get(), options)) {
+        return nullptr;
+    }
+    doc->finishBounds(boundsMode(options));
 
-    if (format == LC_FORMAT_DXF || format == LC_FORMAT_DWG) {
-        dxfRW dxf(filename);
-        success = dxf.read(doc.get(), false);
-        if (!success) {
-            g_last_error = "Failed to read DXF file";
+    return reinterpret_cast<LcDocument*>(doc.release());
+}
+
+/* Read the document of a source; the format is sniffed from its first bytes */
+static bool readSource(DocumentImpl* doc, const LcSource* source, const LcOpenOptions* options) {
+    if (source->name) {
+        doc->filename = source->name;
+    } else if (source->kind == LC_SOURCE_STDIN) {
+        doc->filename = "-";
+    }
+
+    bool success = false;
+    switch (source->kind) {
+        case LC_SOURCE_MEMORY: {
+            if (!source->data && source->size > 0) {
+                g_last_error = "Source data is null";
+                return false;
+            }
+            const char* data = static_cast<const char*>(source->data);
+            doc->format = sniffFormat(std::string_view(data, data ? source->size : 0));
+            if (doc->format == LC_FORMAT_DXF) {
+                /* The DXF reader tokenizes the buffer in place */
+                dxfRW dxf(doc->filename.c_str());
+                dxf.setThreads(parserThreads(options));
+                setupReader(dxf, doc);
+                success = dxf.read(doc, false, data, source->size);
+                if (!success) {
+                    g_last_error = dxfSourceError(dxf);
+                }
+            } else {
+                MemorySource buf(data, source->size);
+                success = readDocumentSource(doc, &buf, options);
+            }
+            break;
         }
-    } else if (format == LC_FORMAT_JWW || format == LC_FORMAT_JWC) {
-        DL_Jww jww;
-        JwwReaderImpl reader;
-        reader.doc = doc.get();
-        success = jww.in(filename, &reader);
-        if (!success) {
-            g_last_error = "Failed to read JWW file";
+        case LC_SOURCE_FD:
+        case LC_SOURCE_STDIN: {
+            int fd = source->kind == LC_SOURCE_STDIN ? 0 : source->fd;
+            if (fd < 0) {
+                g_last_error = "Invalid file descriptor";
+                return false;
+            }
+            setBinaryMode(fd);
+            FdSource buf(fd);
+            doc->format = sniffFormat(buf.peek(8));
+            success = readDocumentSource(doc, &buf, options);
+            if (buf.failed()) {
+                g_last_error = "Failed to read from file descriptor";
+                success = false;
+            }
+            break;
         }
-    } else {
-        g_last_error = "Unsupported file format";
-        return nullptr;
+        default:
+            g_last_error = "Invalid source kind";
+            return false;
     }
 
-    if (!success) {
+    return success;
+}
+
+LcDocument* lc_document_open_source(const LcSource* source, const LcOpenOptions* options) {
+    if (!source) {
+        g_last_error = "Source is null";
         return nullptr;
     }
 
+    auto doc = std::make_unique<DocumentImpl>();
+    if (!readSource(doc.get(), source, options)) {
+        return nullptr;
+    }
+    doc->finishBounds(boundsMode(options));
     return reinterpret_cast<LcDocument*>(doc.release());
 }
 
 LcError lc_document_save(LcDocument* doc, const char* filename, LcDxfVersion version) {
+    return lc_document_save_ex(doc, filename, version, LC_DXF_ASCII);
+}
+
+LcError lc_document_save_ex(LcDocument* doc, const char* filename, LcDxfVersion version, LcDxfFormat format) {
     if (!doc || !filename) {
         g_last_error = "Invalid arguments";
         return LC_ERR_INVALID_ARGUMENT;
@@ -1240,10 +2059,16 @@ LcError lc_document_save(LcDocument* doc, const char* filename, LcDxfVersion ver
     LcFormat outFormat = lc_detect_format(filename);
 
     if (outFormat == LC_FORMAT_DXF) {
+        DRW_Compression compression = DRW_compressionFromName(filename);
+        if (!DRW_compressionSupported(compression)) {
+            g_last_error = std::string(compressionName(compression)) +
+                           " compressed DXF is not supported by this build";
+            return LC_ERR_INVALID_FORMAT;
+        }
         dxfRW dxf(filename);
         /* Set the dxfWriter pointer so writeEntities() etc. can use it */
         impl->dxfWriter = &dxf;
-        bool success = dxf.write(impl, lcVersionToDrw(version), false);
+        bool success = dxf.write(impl, lcVersionToDrw(version), format == LC_DXF_BINARY);
         impl->dxfWriter = nullptr;
         if (!success) {
             g_last_error = "Failed to write DXF file";
@@ -1251,7 +2076,19 @@ LcError lc_document_save(LcDocument* doc, const char* filename, LcDxfVersion ver
         }
     } else if (outFormat == LC_FORMAT_JWW) {
         /* JWW export - see lc_document_save_jww() */
-        return lc_document_save_jww(doc, filename);
+        std::vector<char> buffer(writeBufferSize);
+        std::filebuf file;
+        file.pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        if (!file.open(filename, std::ios::out | std::ios::binary | std::ios::trunc)) {
+            g_last_error = "Failed to open JWW file for writing";
+            return LC_ERR_WRITE_ERROR;
+        }
+        LcError err = lc_document_save_jww(doc, &file);
+        if (!file.close() && err == LC_OK) {
+            g_last_error = "Failed to save JWW file";
+            return LC_ERR_WRITE_ERROR;
+        }
+        return err;
     } else {
         g_last_error = "Unsupported output format";
         return LC_ERR_INVALID_FORMAT;
@@ -1260,25 +2097,148 @@ LcError lc_document_save(LcDocument* doc, const char* filename, LcDxfVersion ver
     return LC_OK;
 }
 
+LcBuffer* lc_document_save_to_buffer(LcDocument* doc, LcFormat format, LcDxfVersion version, LcDxfFormat dxf_format) {
+    if (!doc) {
+        g_last_error = "Invalid arguments";
+        return nullptr;
+    }
+
+    MemorySink sink;
+    if (saveDocument(reinterpret_cast<DocumentImpl*>(doc), format, version, dxf_format, &sink) != LC_OK) {
+        return nullptr;
+    }
+    if (sink.failed()) {
+        g_last_error = "Out of memory";
+        return nullptr;
+    }
+
+    auto* buffer = static_cast<LcBuffer*>(calloc(1, sizeof(LcBuffer)));
+    if (!buffer) {
+        g_last_error = "Out of memory";
+        return nullptr;
+    }
+    /* The sink's block is handed over as is, without a copy */
+    buffer->data = reinterpret_cast<unsigned char*>(sink.release(&buffer->size));
+    return buffer;
+}
+
+void lc_buffer_free(LcBuffer* buffer) {
+    if (buffer) {
+        free(buffer->data);
+        free(buffer);
+    }
+}
+
+LcError lc_document_save_fd(LcDocument* doc, int fd, LcFormat format, LcDxfVersion version, LcDxfFormat dxf_format) {
+    if (!doc || fd < 0) {
+        g_last_error = "Invalid arguments";
+        return LC_ERR_INVALID_ARGUMENT;
+    }
+
+    setBinaryMode(fd);
+    FdSink sink(fd);
+    LcError err = saveDocument(reinterpret_cast<DocumentImpl*>(doc), format, version, dxf_format, &sink);
+    if (err == LC_OK && (sink.pubsync() != 0 || sink.failed())) {
+        g_last_error = "Failed to write to file descriptor";
+        return LC_ERR_WRITE_ERROR;
+    }
+    return err;
+}
+
 void lc_document_close(LcDocument* doc) {
     if (doc) {
         delete reinterpret_cast<DocumentImpl*>(doc);
     }
 }
 
+LcCursor* lc_cursor_open(const char* filename) {
+    LcFormat format;
+    if (!checkDocumentFile(filename, &format)) {
+        return nullptr;
+    }
+
+    auto cursor = std::make_unique<CursorImpl>();
+    cursor->filename = filename;
+    cursor->format = format;
+    cursor->parser = std::thread(runCursor, cursor.get());
+
+    return reinterpret_cast<LcCursor*>(cursor.release());
+}
+
+LcError lc_cursor_next(LcCursor* cursor, const LcEntityInfo** entity) {
+    if (!cursor || !entity) {
+        g_last_error = "Invalid arguments";
+        return LC_ERR_INVALID_ARGUMENT;
+    }
+
+    auto* impl = reinterpret_cast<CursorImpl*>(cursor);
+    if (impl->next == impl->ready.size()) {
+        std::unique_lock<std::mutex> lock(impl->mutex);
+        impl->notEmpty.wait(lock, [impl] { return impl->finished || impl->pending.size() >= CursorImpl::batch; });
+        if (impl->pending.empty()) {
+            *entity = nullptr;
+            if (impl->failed) {
+                g_last_error = impl->error;
+                return LC_ERR_READ_ERROR;
+            }
+            return LC_OK;
+        }
+        impl->ready.swap(impl->pending);
+        impl->pending.clear();
+        impl->next = 0;
+        impl->notFull.notify_one();
+    }
+
+    impl->info = LcEntityInfo{};
+    fillEntityInfo(impl->ready.get(impl->next++), impl->info, LC_DETAIL_FULL, borrowString, nullptr);
+    *entity = &impl->info;
+    return LC_OK;
+}
+
+void lc_cursor_close(LcCursor* cursor) {
+    if (!cursor) return;
+
+    auto* impl = reinterpret_cast<CursorImpl*>(cursor);
+    {
+        std::lock_guard<std::mutex> lock(impl->mutex);
+        impl->closed = true;
+        impl->notFull.notify_all();
+    }
+    impl->parser.join();
+    delete impl;
+}
+
 LcError lc_convert(const char* input_file, const char* output_file, LcDxfVersion dxf_version) {
+    return lc_convert_ex(input_file, output_file, dxf_version, LC_DXF_ASCII);
+}
+
+LcError lc_convert_ex(const char* input_file, const char* output_file, LcDxfVersion dxf_version,
+                      LcDxfFormat dxf_format) {
     LcDocument* doc = lc_document_open(input_file);
     if (!doc) {
         return LC_ERR_READ_ERROR;
     }
 
-    LcError err = lc_document_save(doc, output_file, dxf_version);
+    LcError err = lc_document_save_ex(doc, output_file, dxf_version, dxf_format);
     lc_document_close(doc);
     return err;
 }
 
 LcFileInfo* lc_get_file_info(const char* filename, LcDetailLevel detail) {
-    LcDocument* doc = lc_document_open(filename);
+    return lc_get_file_info_ex(filename, detail, nullptr);
+}
+
+LcFileInfo* lc_get_file_info_ex(const char* filename, LcDetailLevel detail, const LcOpenOptions* options) {
+    /* Summaries of ASCII DXF files come from the group codes alone */
+    if (detail == LC_DETAIL_SUMMARY && boundsMode(options) == LC_BOUNDS_FAST &&
+        lc_detect_format(filename) == LC_FORMAT_DXF) {
+        DxfSummary summary;
+        if (readDxfSummary(filename, &summary)) {
+            return summaryInfo(filename, summary);
+        }
+    }
+
+    LcDocument* doc = lc_document_open_ex(filename, options);
     if (!doc) {
         return nullptr;
     }
@@ -1304,14 +2264,14 @@ LcFileInfo* lc_document_get_info(LcDocument* doc, LcDetailLevel detail) {
     info->entity_count = static_cast<int>(impl->entities.size());
 
     /* Bounds */
-    info->bounds.min = {impl->minBound.x, impl->minBound.y, impl->minBound.z};
-    info->bounds.max = {impl->maxBound.x, impl->maxBound.y, impl->maxBound.z};
+    info->bounds.min = {impl->bounds.lo.x, impl->bounds.lo.y, impl->bounds.lo.z};
+    info->bounds.max = {impl->bounds.hi.x, impl->bounds.hi.y, impl->bounds.hi.z};
 
     /* Entity type counts */
     std::memset(info->entity_counts, 0, sizeof(info->entity_counts));
-    for (const auto& e : impl->entities) {
-        if (e.type < 20) {
-            info->entity_counts[e.type]++;
+    for (uint8_t type : impl->entities.types()) {
+        if (type < 20) {
+            info->entity_counts[type]++;
         }
     }
 
@@ -1339,70 +2299,45 @@ LcFileInfo* lc_document_get_info(LcDocument* doc, LcDetailLevel detail) {
             const auto& b = impl->blocks[i];
             info->blocks[i].name = strdup_cpp(b.name);
             info->blocks[i].base_point = {b.basePoint.x, b.basePoint.y, b.basePoint.z};
-            info->blocks[i].entity_count = static_cast<int>(b.entities.size());
+            info->blocks[i].entity_count = static_cast<int>(b.count);
         }
     }
 
     /* Entity details */
     if (detail >= LC_DETAIL_VERBOSE && !impl->entities.empty()) {
-        info->entities_len = static_cast<int>(impl->entities.size());
-        info->entities = static_cast<LcEntityInfo*>(calloc(info->entities_len, sizeof(LcEntityInfo)));
-        for (int i = 0; i < info->entities_len; i++) {
-            const auto& e = impl->entities[i];
-            info->entities[i].type = e.type;
-            info->entities[i].layer = strdup_cpp(e.layer);
-            info->entities[i].color = e.color;
-            info->entities[i].line_type = strdup_cpp(e.lineType);
-            info->entities[i].line_weight = e.lineWeight;
-            info->entities[i].handle = e.handle;
-
-            if (detail >= LC_DETAIL_FULL) {
-                /* Fill geometry data based on type */
-                switch (e.type) {
-                    case LC_ENTITY_POINT:
-                        info->entities[i].data.point.point = {e.point1.x, e.point1.y, e.point1.z};
-                        break;
-                    case LC_ENTITY_LINE:
-                        info->entities[i].data.line.start = {e.point1.x, e.point1.y, e.point1.z};
-                        info->entities[i].data.line.end = {e.point2.x, e.point2.y, e.point2.z};
-                        break;
-                    case LC_ENTITY_CIRCLE:
-                        info->entities[i].data.circle.center = {e.point1.x, e.point1.y, e.point1.z};
-                        info->entities[i].data.circle.radius = e.radius;
-                        break;
-                    case LC_ENTITY_ARC:
-                        info->entities[i].data.arc.center = {e.point1.x, e.point1.y, e.point1.z};
-                        info->entities[i].data.arc.radius = e.radius;
-                        info->entities[i].data.arc.start_angle = e.startAngle;
-                        info->entities[i].data.arc.end_angle = e.endAngle;
-                        break;
-                    case LC_ENTITY_TEXT:
-                    case LC_ENTITY_MTEXT:
-                        info->entities[i].data.text.text = strdup_cpp(e.text);
-                        info->entities[i].data.text.position = {e.point1.x, e.point1.y, e.point1.z};
-                        info->entities[i].data.text.height = e.height;
-                        info->entities[i].data.text.rotation = e.rotation;
-                        break;
-                    case LC_ENTITY_INSERT:
-                        info->entities[i].data.insert.block_name = strdup_cpp(e.blockName);
-                        info->entities[i].data.insert.position = {e.point1.x, e.point1.y, e.point1.z};
-                        info->entities[i].data.insert.scale_x = e.scaleX;
-                        info->entities[i].data.insert.scale_y = e.scaleY;
-                        info->entities[i].data.insert.rotation = e.rotation;
-                        break;
-                    case LC_ENTITY_POLYLINE:
-                    case LC_ENTITY_LWPOLYLINE:
-                        info->entities[i].data.polyline.vertex_count = e.vertexCount;
-                        info->entities[i].data.polyline.is_closed = e.closed ? 1 : 0;
-                        break;
-                    case LC_ENTITY_SPLINE:
-                        info->entities[i].data.spline.control_point_count = e.vertexCount;
-                        info->entities[i].data.spline.degree = e.degree;
-                        info->entities[i].data.spline.is_closed = e.closed ? 1 : 0;
-                        break;
-                    default:
-                        break;
-                }
+        const EntityStore& store = impl->entities;
+        const DRW_NameTable& names = store.names();
+
+        /* Every name in use is copied once, into a pool behind the entity array */
+        std::vector<size_t> offsets(names.size(), SIZE_MAX);
+        size_t poolSize = 0;
+        auto use = [&](uint32_t id) {
+            if (offsets[id] == SIZE_MAX) {
+                offsets[id] = poolSize;
+                poolSize += names[id].size() + 1;
+            }
+        };
+        for (uint32_t id : store.layers()) use(id);
+        for (uint32_t id : store.lineTypes()) use(id);
+        for (size_t i = 0; i < store.size(); i++) {
+            if (store.types()[i] == LC_ENTITY_INSERT) use(store.blockName(i));
+        }
+
+        size_t arrayBytes = store.size() * sizeof(LcEntityInfo);
+        auto* block = static_cast<char*>(calloc(1, arrayBytes + poolSize));
+        if (block) {
+            char* pool = block + arrayBytes;
+            std::vector<char*> strings(names.size(), nullptr);
+            for (uint32_t id = 0; id < names.size(); id++) {
+                if (offsets[id] == SIZE_MAX) continue;
+                strings[id] = pool + offsets[id];
+                std::memcpy(strings[id], names[id].c_str(), names[id].size() + 1);
+            }
+
+            info->entities_len = static_cast<int>(store.size());
+            info->entities = reinterpret_cast<LcEntityInfo*>(block);
+            for (int i = 0; i < info->entities_len; i++) {
+                fillEntityInfo(store.get(i), info->entities[i], detail, strdup_cpp, strings.data());
             }
         }
     }
@@ -1432,20 +2367,10 @@ void lc_file_info_free(LcFileInfo* info) {
     }
 
     if (info->entities) {
+        /* Layer, line type and block names are pooled in the entities block */
         for (int i = 0; i < info->entities_len; i++) {
-            free(info->entities[i].layer);
-            free(info->entities[i].line_type);
-            /* Free type-specific strings */
-            switch (info->entities[i].type) {
-                case LC_ENTITY_TEXT:
-                case LC_ENTITY_MTEXT:
-                    free(info->entities[i].data.text.text);
-                    break;
-                case LC_ENTITY_INSERT:
-                    free(info->entities[i].data.insert.block_name);
-                    break;
-                default:
-                    break;
+            if (info->entities[i].type == LC_ENTITY_TEXT || info->entities[i].type == LC_ENTITY_MTEXT) {
+                free(info->entities[i].data.text.text);
             }
         }
         free(info->entities);
@@ -1516,11 +2441,17 @@ char* lc_file_info_to_json(const LcFileInfo* info) {
     /* Entities (abbreviated in verbose mode) */
     if (info->entities && info->entities_len > 0) {
         json << ",\n  \"entities\": [\n";
+        /* Entities share their pooled layer names, each one is escaped once */
+        std::unordered_map<const char*, std::string> layerJson;
         for (int i = 0; i < info->entities_len; i++) {
             const auto& e = info->entities[i];
+            auto layer = layerJson.find(e.layer);
+            if (layer == layerJson.end()) {
+                layer = layerJson.emplace(e.layer, escapeJson(e.layer ? e.layer : "")).first;
+            }
             json << "    {";
             json << "\"type\": \"" << entityTypeName(e.type) << "\", ";
-            json << "\"layer\": \"" << escapeJson(e.layer ? e.layer : "") << "\", ";
+            json << "\"layer\": \"" << layer->second << "\", ";
             json << "\"color\": " << e.color << ", ";
             json << "\"handle\": " << e.handle;
             json << "}" << (i < info->entities_len - 1 ? "," : "") << "\n";
@@ -1533,139 +2464,158 @@ char* lc_file_info_to_json(const LcFileInfo* info) {
     return strdup_cpp(json.str());
 }
 
-LcValidationResult* lc_validate(const char* filename) {
-    LcDocument* doc = lc_document_open(filename);
-    if (!doc) {
-        /* Return result with error */
-        auto* result = static_cast<LcValidationResult*>(calloc(1, sizeof(LcValidationResult)));
-        result->is_valid = 0;
-        result->issue_count = 1;
-        result->issues = static_cast<LcValidationIssue*>(calloc(1, sizeof(LcValidationIssue)));
-        result->issues[0].severity = LC_SEVERITY_ERROR;
-        result->issues[0].code = strdup_cpp("FILE_ERROR");
-        result->issues[0].message = strdup_cpp(g_last_error);
-        result->issues[0].location = strdup_cpp(filename);
-        return result;
-    }
-
-    LcValidationResult* result = lc_document_validate(doc);
-    lc_document_close(doc);
+/* Result holding the error of a file that could not be read */
+static LcValidationResult* fileErrorResult(const char* location) {
+    auto* result = static_cast<LcValidationResult*>(calloc(1, sizeof(LcValidationResult)));
+    result->is_valid = 0;
+    result->issue_count = 1;
+    result->issues = static_cast<LcValidationIssue*>(calloc(1, sizeof(LcValidationIssue)));
+    result->issues[0].severity = LC_SEVERITY_ERROR;
+    result->issues[0].code = strdup_cpp("FILE_ERROR");
+    result->issues[0].message = strdup_cpp(g_last_error);
+    result->issues[0].location = strdup_cpp(location ? location : "");
     return result;
 }
 
-LcValidationResult* lc_document_validate(LcDocument* doc) {
-    if (!doc) return nullptr;
-
-    auto* impl = reinterpret_cast<DocumentImpl*>(doc);
+static LcValidationResult* validationResult(const ValidationReport& report, bool stopped) {
     auto* result = static_cast<LcValidationResult*>(calloc(1, sizeof(LcValidationResult)));
-
-    std::vector<LcValidationIssue> issues;
-
-    /* Check for empty drawing */
-    if (impl->entities.empty()) {
-        LcValidationIssue issue;
-        issue.severity = LC_SEVERITY_WARNING;
-        issue.code = strdup_cpp("EMPTY_DRAWING");
-        issue.message = strdup_cpp("Drawing contains no entities");
-        issue.location = strdup_cpp("");
-        issues.push_back(issue);
+    result->is_valid = 1;
+    result->issue_count = static_cast<int>(report.issues.size());
+    if (!report.issues.empty()) {
+        result->issues = static_cast<LcValidationIssue*>(calloc(report.issues.size(), sizeof(LcValidationIssue)));
+        for (size_t i = 0; i < report.issues.size(); i++) {
+            const ValidationIssue& from = report.issues[i];
+            LcValidationIssue& issue = result->issues[i];
+            issue.severity = from.severity;
+            issue.code = strdup_cpp(from.code);
+            issue.message = strdup_cpp(from.message);
+            issue.location = strdup_cpp(from.location);
+            if (from.severity == LC_SEVERITY_ERROR) result->is_valid = 0;
+        }
     }
 
-    /* Check for missing layer 0 */
-    bool hasLayer0 = false;
-    for (const auto& l : impl->layers) {
-        if (l.name == "0") {
-            hasLayer0 = true;
-            break;
+    result->rules_len = static_cast<int>(report.rules.size());
+    if (!report.rules.empty()) {
+        result->rules = static_cast<LcRuleStats*>(calloc(report.rules.size(), sizeof(LcRuleStats)));
+        for (size_t i = 0; i < report.rules.size(); i++) {
+            result->rules[i].name = strdup_cpp(report.rules[i].name);
+            result->rules[i].seconds = report.rules[i].seconds;
+            result->rules[i].issue_count = static_cast<int>(report.rules[i].issues);
         }
     }
-    if (!hasLayer0 && !impl->layers.empty()) {
-        LcValidationIssue issue;
-        issue.severity = LC_SEVERITY_WARNING;
-        issue.code = strdup_cpp("MISSING_LAYER_0");
-        issue.message = strdup_cpp("Standard layer '0' not found");
-        issue.location = strdup_cpp("");
-        issues.push_back(issue);
-    }
+    result->stopped = stopped ? 1 : 0;
 
-    /* Check entity references */
-    std::map<std::string, bool> layerNames;
-    for (const auto& l : impl->layers) {
-        layerNames[l.name] = true;
-    }
+    return result;
+}
 
-    std::map<std::string, bool> blockNames;
-    for (const auto& b : impl->blocks) {
-        blockNames[b.name] = true;
-    }
+/* The selected rules and threads of options, false for an unknown rule name */
+static bool validateOptions(const LcValidateOptions* options, RuleSet* rules, int* threads) {
+    *rules = allRules();
+    *threads = 1;
+    if (!options) return true;
+
+    std::string unknown;
+    if (options->rules && !parseRules(options->rules, rules, &unknown)) {
+        g_last_error = "Unknown validation rule: " + unknown + " (rules: " + ruleNames() + ")";
+        return false;
+    }
+    *threads = options->threads == LC_THREADS_AUTO
+                   ? std::max(1, static_cast<int>(std::thread::hardware_concurrency()))
+                   : std::max(1, options->threads);
+    return true;
+}
 
-    int entityIndex = 0;
-    for (const auto& e : impl->entities) {
-        /* Check layer reference */
-        if (!e.layer.empty() && layerNames.find(e.layer) == layerNames.end()) {
-            LcValidationIssue issue;
-            issue.severity = LC_SEVERITY_ERROR;
-            issue.code = strdup_cpp("UNDEFINED_LAYER");
-            issue.message = strdup_cpp(("Entity references undefined layer: " + e.layer).c_str());
-            issue.location = strdup_cpp(("entity #" + std::to_string(entityIndex)).c_str());
-            issues.push_back(issue);
-        }
+LcValidationResult* lc_validate(const char* filename) {
+    return lc_validate_ex(filename, nullptr);
+}
 
-        /* Check block reference for inserts */
-        if (e.type == LC_ENTITY_INSERT && !e.blockName.empty()) {
-            if (blockNames.find(e.blockName) == blockNames.end()) {
-                LcValidationIssue issue;
-                issue.severity = LC_SEVERITY_ERROR;
-                issue.code = strdup_cpp("UNDEFINED_BLOCK");
-                issue.message = strdup_cpp(("Insert references undefined block: " + e.blockName).c_str());
-                issue.location = strdup_cpp(("entity #" + std::to_string(entityIndex)).c_str());
-                issues.push_back(issue);
-            }
-        }
+/*
+ * Options of a validating read. A fail-fast read parses on one thread: the
+ * parallel parser scans the whole section before the first entity comes out.
+ */
+static LcOpenOptions validatingReadOptions(const LcValidateOptions* options, int threads) {
+    return {options && options->fail_fast ? 1 : threads, LC_BOUNDS_FAST};
+}
 
-        /* Check for invalid geometry */
-        if (e.type == LC_ENTITY_CIRCLE || e.type == LC_ENTITY_ARC) {
-            if (e.radius <= 0.0) {
-                LcValidationIssue issue;
-                issue.severity = LC_SEVERITY_ERROR;
-                issue.code = strdup_cpp("INVALID_RADIUS");
-                issue.message = strdup_cpp("Circle/Arc has invalid radius");
-                issue.location = strdup_cpp(("entity #" + std::to_string(entityIndex)).c_str());
-                issues.push_back(issue);
-            }
-        }
+/* Report of a validating read; a fail-fast stop counts as a complete read */
+static LcValidationResult* streamedResult(ValidatingImpl& doc, bool success) {
+    if (!success) {
+        return fileErrorResult(doc.filename.c_str());
+    }
+    ValidationReport report = doc.finish();
+    return validationResult(report, doc.validation.stopped());
+}
 
-        entityIndex++;
+LcValidationResult* lc_validate_ex(const char* filename, const LcValidateOptions* options) {
+    RuleSet rules;
+    int threads;
+    if (!validateOptions(options, &rules, &threads)) return nullptr;
+
+    LcFormat format;
+    if (!checkDocumentFile(filename, &format)) {
+        return fileErrorResult(filename);
     }
 
-    /* Check bounds validity */
-    if (impl->minBound.x > impl->maxBound.x) {
-        LcValidationIssue issue;
-        issue.severity = LC_SEVERITY_INFO;
-        issue.code = strdup_cpp("INVALID_BOUNDS");
-        issue.message = strdup_cpp("Drawing bounds are invalid (possibly empty drawing)");
-        issue.location = strdup_cpp("");
-        issues.push_back(issue);
+    ValidatingImpl doc(rules, options && options->fail_fast);
+    doc.filename = filename;
+    doc.format = format;
+    LcOpenOptions open = validatingReadOptions(options, threads);
+    bool success;
+    try {
+        success = readDocument(&doc, &open);
+    } catch (const ValidationStopped&) {
+        success = true;
     }
+    return streamedResult(doc, success);
+}
 
-    /* Populate result */
-    result->is_valid = 1;
-    for (const auto& i : issues) {
-        if (i.severity == LC_SEVERITY_ERROR) {
-            result->is_valid = 0;
-            break;
-        }
+LcValidationResult* lc_validate_source(const LcSource* source, const LcValidateOptions* options) {
+    RuleSet rules;
+    int threads;
+    if (!validateOptions(options, &rules, &threads)) return nullptr;
+
+    if (!source) {
+        g_last_error = "Source is null";
+        return fileErrorResult(nullptr);
     }
 
-    result->issue_count = static_cast<int>(issues.size());
-    if (!issues.empty()) {
-        result->issues = static_cast<LcValidationIssue*>(calloc(issues.size(), sizeof(LcValidationIssue)));
-        for (size_t i = 0; i < issues.size(); i++) {
-            result->issues[i] = issues[i];
-        }
+    ValidatingImpl doc(rules, options && options->fail_fast);
+    LcOpenOptions open = validatingReadOptions(options, threads);
+    bool success;
+    try {
+        success = readSource(&doc, source, &open);
+    } catch (const ValidationStopped&) {
+        success = true;
     }
+    return streamedResult(doc, success);
+}
 
-    return result;
+LcValidationResult* lc_document_validate(LcDocument* doc) {
+    return lc_document_validate_ex(doc, nullptr);
+}
+
+LcValidationResult* lc_document_validate_ex(LcDocument* doc, const LcValidateOptions* options) {
+    if (!doc) return nullptr;
+
+    auto* impl = reinterpret_cast<DocumentImpl*>(doc);
+
+    RuleSet rules;
+    int threads;
+    if (!validateOptions(options, &rules, &threads)) return nullptr;
+
+    ValidationInput input;
+    input.model = &impl->entities;
+    input.blockEntities = &impl->blockEntities;
+    for (const auto& l : impl->layers) input.layers.push_back(l.name);
+    for (const auto& b : impl->blocks) input.blocks.push_back({b.name, b.first, b.count});
+    input.entityCount = impl->entities.size();
+    input.boundsEmpty = impl->bounds.empty();
+
+    return validationResult(runValidation(input, rules, threads), false);
+}
+
+const char* lc_validation_rules(void) {
+    return ruleNames();
 }
 
 void lc_validation_result_free(LcValidationResult* result) {
@@ -1679,6 +2629,12 @@ void lc_validation_result_free(LcValidationResult* result) {
         }
         free(result->issues);
     }
+    if (result->rules) {
+        for (int i = 0; i < result->rules_len; i++) {
+            free(result->rules[i].name);
+        }
+        free(result->rules);
+    }
 
     free(result);
 }
@@ -1689,6 +2645,9 @@ char* lc_validation_result_to_json(const LcValidationResult* result) {
     std::ostringstream json;
     json << "{\n";
     json << "  \"is_valid\": " << (result->is_valid ? "true" : "false") << ",\n";
+    if (result->stopped) {
+        json << "  \"stopped\": true,\n";
+    }
     json << "  \"issue_count\": " << result->issue_count << ",\n";
     json << "  \"issues\": [\n";
 
@@ -1703,6 +2662,108 @@ char* lc_validation_result_to_json(const LcValidationResult* result) {
         json << "    }" << (i < result->issue_count - 1 ? "," : "") << "\n";
     }
 
+    json << "  ]";
+    if (result->rules_len > 0) {
+        json << ",\n  \"rules\": [\n";
+        for (int i = 0; i < result->rules_len; i++) {
+            const auto& rule = result->rules[i];
+            json << "    {\"name\": \"" << escapeJson(rule.name ? rule.name : "") << "\", ";
+            json << "\"issue_count\": " << rule.issue_count << ", ";
+            json << "\"time_ms\": " << rule.seconds * 1000.0 << "}";
+            json << (i < result->rules_len - 1 ? "," : "") << "\n";
+        }
+        json << "  ]";
+    }
+    json << "\n}\n";
+
+    return strdup_cpp(json.str());
+}
+
+/* Query result for entity ids[k] at distances[k], or at 0 without distances */
+static LcQueryResult* queryResult(const DocumentImpl* impl, const std::vector<uint32_t>& ids,
+                                  const std::vector<std::pair<uint32_t, double>>* distances) {
+    auto* result = static_cast<LcQueryResult*>(calloc(1, sizeof(LcQueryResult)));
+    size_t count = distances ? distances->size() : ids.size();
+    if (result && count > 0) {
+        result->hits = static_cast<LcQueryHit*>(calloc(count, sizeof(LcQueryHit)));
+        if (!result->hits) {
+            free(result);
+            result = nullptr;
+        }
+    }
+    if (!result) {
+        g_last_error = "Out of memory";
+        return nullptr;
+    }
+
+    const EntityStore& store = impl->entities;
+    const DRW_NameTable& names = store.names();
+    result->hit_count = static_cast<int>(count);
+    for (size_t k = 0; k < count; k++) {
+        uint32_t i = distances ? (*distances)[k].first : ids[k];
+        LcQueryHit& hit = result->hits[k];
+        hit.index = static_cast<int>(i);
+        hit.type = static_cast<LcEntityType>(store.types()[i]);
+        hit.layer = names[store.layers()[i]].c_str();
+        hit.handle = store.get(i).handle;
+        hit.distance = distances ? (*distances)[k].second : 0.0;
+    }
+    return result;
+}
+
+LcQueryResult* lc_document_query_bbox(LcDocument* doc, const LcBoundingBox* window) {
+    if (!doc || !window) {
+        g_last_error = "Invalid arguments";
+        return nullptr;
+    }
+
+    auto* impl = reinterpret_cast<DocumentImpl*>(doc);
+    IndexBox box{std::min(window->min.x, window->max.x), std::min(window->min.y, window->max.y),
+                 std::max(window->min.x, window->max.x), std::max(window->min.y, window->max.y)};
+    std::vector<uint32_t> ids;
+    impl->spatialIndex().search(box, ids);
+    std::sort(ids.begin(), ids.end());
+    return queryResult(impl, ids, nullptr);
+}
+
+LcQueryResult* lc_document_query_nearest(LcDocument* doc, const LcPoint3D* point, int k) {
+    if (!doc || !point || k < 0 || std::isnan(point->x) || std::isnan(point->y)) {
+        g_last_error = "Invalid arguments";
+        return nullptr;
+    }
+
+    auto* impl = reinterpret_cast<DocumentImpl*>(doc);
+    std::vector<std::pair<uint32_t, double>> nearest;
+    impl->spatialIndex().nearest(point->x, point->y, static_cast<size_t>(k), nearest);
+    return queryResult(impl, {}, &nearest);
+}
+
+void lc_query_result_free(LcQueryResult* result) {
+    if (!result) return;
+    /* Layer names belong to the document */
+    free(result->hits);
+    free(result);
+}
+
+char* lc_query_result_to_json(const LcQueryResult* result) {
+    if (!result) return nullptr;
+
+    std::ostringstream json;
+    json << "{\n";
+    json << "  \"hit_count\": " << result->hit_count << ",\n";
+    json << "  \"hits\": [\n";
+
+    for (int i = 0; i < result->hit_count; i++) {
+        const auto& hit = result->hits[i];
+        json << "    {";
+        json << "\"index\": " << hit.index << ", ";
+        json << "\"type\": \"" << entityTypeName(hit.type) << "\", ";
+        json << "\"layer\": \"" << escapeJson(hit.layer ? hit.layer : "") << "\", ";
+        json << "\"handle\": " << hit.handle << ", ";
+        json << "\"distance\": " << hit.distance;
+        json << "}" << (i < result->hit_count - 1 ? "," : "") << "\n";
+    }
+
     json << "  ]\n";
     json << "}\n";
 
@@ -1719,23 +2780,16 @@ void lc_string_free(char* str) {
  * JWW Export Implementation
  * ============================================================================ */
 
-static LcError lc_document_save_jww(LcDocument* doc, const char* filename) {
-    if (!doc || !filename) {
+static LcError lc_document_save_jww(LcDocument* doc, std::streambuf* sink) {
+    if (!doc || !sink) {
         g_last_error = "Invalid arguments";
         return LC_ERR_INVALID_ARGUMENT;
     }
 
     auto* impl = reinterpret_cast<DocumentImpl*>(doc);
 
-    /* Create JWW document for writing */
-    std::string inFileName = "";  /* Empty input file - we're creating new */
-    std::string outFileName = filename;
-    JWWDocument jwwDoc(inFileName, outFileName);
-
-    if (!jwwDoc.ofs || !jwwDoc.ofs->good()) {
-        g_last_error = "Failed to open JWW file for writing";
-        return LC_ERR_WRITE_ERROR;
-    }
+    /* Create JWW document writing to the sink */
+    JWWDocument jwwDoc(nullptr, sink);
 
     /* Initialize header with default values */
     jwwDoc.Header.head = "JwsFileFormat_ver";
@@ -1778,7 +2832,8 @@ static LcError lc_document_save_jww(LcDocument* doc, const char* filename) {
     jwwDoc.SaveDataListCount = 0;
 
     /* Convert entities to JWW format */
-    for (const auto& e : impl->entities) {
+    for (size_t i = 0; i < impl->entities.size(); i++) {
+        const EntityData e = impl->entities.get(i);
         switch (e.type) {
             case LC_ENTITY_POINT: {
                 CDataTen ten;
@@ -1950,8 +3005,8 @@ static LcError lc_document_save_jww(LcDocument* doc, const char* filename) {
         }
     }
 
-    /* Write the JWW file */
-    if (!jwwDoc.Save()) {
+    /* Write the JWW file; the document does not flush a sink it does not own */
+    if (!jwwDoc.Save() || !jwwDoc.ofs->good() || sink->pubsync() != 0) {
         g_last_error = "Failed to save JWW file";
         return LC_ERR_WRITE_ERROR;
     }
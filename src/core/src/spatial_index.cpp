@@ -0,0 +1,175 @@
+/**
+ * cadutil_core - Spatial index
+ */
+
+#include "spatial_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <queue>
+
+namespace {
+
+bool intersects(const IndexBox& a, const IndexBox& b) {
+    return a.minX <= b.maxX && b.minX <= a.maxX && a.minY <= b.maxY && b.minY <= a.maxY;
+}
+
+/* Squared distance from (x, y) to b, 0 inside it */
+double distance2(double x, double y, const IndexBox& b) {
+    double dx = std::max({b.minX - x, x - b.maxX, 0.0});
+    double dy = std::max({b.minY - y, y - b.maxY, 0.0});
+    return dx * dx + dy * dy;
+}
+
+/* Sort key of a box centre; infinite extents must not turn it into NaN */
+double centre(double lo, double hi) {
+    double c = 0.5 * lo + 0.5 * hi;
+    return std::isnan(c) ? 0.0 : c;
+}
+
+} // namespace
+
+void SpatialIndex::build(std::vector<IndexBox> boxes, std::vector<uint32_t> ids) {
+    boxes_ = std::move(boxes);
+    refs_ = std::move(ids);
+    levelEnds_.clear();
+    if (boxes_.empty()) return;
+
+    size_t begin = 0;
+    size_t end = boxes_.size();
+    for (;;) {
+        pack(begin, end);
+        levelEnds_.push_back(end);
+        if (end - begin == 1) break;
+
+        /* One parent per run of nodeSize entries */
+        for (size_t first = begin; first < end; first += nodeSize) {
+            size_t last = std::min(first + nodeSize, end);
+            IndexBox box{HUGE_VAL, HUGE_VAL, -HUGE_VAL, -HUGE_VAL};
+            for (size_t k = first; k < last; k++) {
+                const IndexBox& b = boxes_[k];
+                box.minX = std::min(box.minX, b.minX);
+                box.minY = std::min(box.minY, b.minY);
+                box.maxX = std::max(box.maxX, b.maxX);
+                box.maxY = std::max(box.maxY, b.maxY);
+            }
+            boxes_.push_back(box);
+            refs_.push_back(static_cast<uint32_t>(first));
+        }
+        begin = end;
+        end = boxes_.size();
+    }
+}
+
+void SpatialIndex::pack(size_t begin, size_t end) {
+    size_t n = end - begin;
+    if (n <= nodeSize) return;
+
+    std::vector<double> cx(n);
+    std::vector<double> cy(n);
+    for (size_t k = 0; k < n; k++) {
+        const IndexBox& b = boxes_[begin + k];
+        cx[k] = centre(b.minX, b.maxX);
+        cy[k] = centre(b.minY, b.maxY);
+    }
+
+    /* Ties keep their input order, so the tree does not depend on the sort */
+    std::vector<uint32_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return cx[a] < cx[b] || (cx[a] == cx[b] && a < b);
+    });
+
+    /* About sqrt(nodes) vertical slices of whole nodes each */
+    size_t nodes = (n + nodeSize - 1) / nodeSize;
+    size_t slices = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(nodes))));
+    size_t sliceSize = (nodes + slices - 1) / slices * nodeSize;
+    for (size_t first = 0; first < n; first += sliceSize) {
+        auto last = order.begin() + std::min(first + sliceSize, n);
+        std::sort(order.begin() + first, last, [&](uint32_t a, uint32_t b) {
+            return cy[a] < cy[b] || (cy[a] == cy[b] && a < b);
+        });
+    }
+
+    std::vector<IndexBox> boxes(n);
+    std::vector<uint32_t> refs(n);
+    for (size_t k = 0; k < n; k++) {
+        boxes[k] = boxes_[begin + order[k]];
+        refs[k] = refs_[begin + order[k]];
+    }
+    std::copy(boxes.begin(), boxes.end(), boxes_.begin() + begin);
+    std::copy(refs.begin(), refs.end(), refs_.begin() + begin);
+}
+
+void SpatialIndex::search(const IndexBox& window, std::vector<uint32_t>& out) const {
+    if (levelEnds_.empty() || !intersects(window, boxes_.back())) return;
+    if (levelEnds_.size() == 1) {
+        out.push_back(refs_[0]);
+        return;
+    }
+
+    /* Nodes still to visit with their level, 1 being the nodes above the leaves */
+    std::vector<std::pair<size_t, size_t>> stack;
+    stack.emplace_back(boxes_.size() - 1, levelEnds_.size() - 1);
+    while (!stack.empty()) {
+        auto [node, level] = stack.back();
+        stack.pop_back();
+        size_t first = refs_[node];
+        size_t last = std::min(first + nodeSize, levelEnds_[level - 1]);
+        for (size_t k = first; k < last; k++) {
+            if (!intersects(window, boxes_[k])) continue;
+            if (level == 1) {
+                out.push_back(refs_[k]);
+            } else {
+                stack.emplace_back(k, level - 1);
+            }
+        }
+    }
+}
+
+void SpatialIndex::nearest(double x, double y, size_t k,
+                           std::vector<std::pair<uint32_t, double>>& out) const {
+    if (levelEnds_.empty() || k == 0) return;
+
+    /*
+     * Best first: entries come out of the queue by distance, so an item is
+     * the nearest one left when it does. A node goes before an item at the
+     * same distance, which puts items of equal distance in id order.
+     */
+    struct Entry {
+        double distance2;
+        bool item;
+        uint32_t ref;      /* item id, or node position */
+        size_t level;
+    };
+    auto later = [](const Entry& a, const Entry& b) {
+        if (a.distance2 != b.distance2) return a.distance2 > b.distance2;
+        if (a.item != b.item) return a.item;
+        return a.ref > b.ref;
+    };
+    std::priority_queue<Entry, std::vector<Entry>, decltype(later)> queue(later);
+
+    size_t root = boxes_.size() - 1;
+    size_t rootLevel = levelEnds_.size() - 1;
+    queue.push({distance2(x, y, boxes_[root]), rootLevel == 0,
+                rootLevel == 0 ? refs_[root] : static_cast<uint32_t>(root), rootLevel});
+
+    size_t found = 0;
+    while (!queue.empty() && found < k) {
+        Entry e = queue.top();
+        queue.pop();
+        if (e.item) {
+            out.emplace_back(e.ref, std::sqrt(e.distance2));
+            found++;
+            continue;
+        }
+        size_t first = refs_[e.ref];
+        size_t last = std::min(first + nodeSize, levelEnds_[e.level - 1]);
+        for (size_t c = first; c < last; c++) {
+            bool item = e.level == 1;
+            queue.push({distance2(x, y, boxes_[c]), item,
+                        item ? refs_[c] : static_cast<uint32_t>(c), e.level - 1});
+        }
+    }
+}
@@ -0,0 +1,59 @@
+/**
+ * cadutil_core - Spatial index
+ *
+ * Packed R-tree over the 2D bounding boxes of a document's entities. It is
+ * bulk loaded once with Sort-Tile-Recursive: the boxes are sorted into
+ * vertical slices by their centre X, each slice by centre Y, and runs of
+ * nodeSize boxes become the leaves; every level above is packed the same
+ * way from the nodes below it. The tree lives in two flat arrays, leaves
+ * first and the root last, with no allocation per node.
+ */
+
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+struct IndexBox {
+    double minX;
+    double minY;
+    double maxX;
+    double maxY;
+};
+
+class SpatialIndex {
+public:
+    /* Children per node */
+    static constexpr size_t nodeSize = 16;
+
+    /* Build the tree over item ids[k] with box boxes[k], replacing the old one */
+    void build(std::vector<IndexBox> boxes, std::vector<uint32_t> ids);
+
+    /* Indexed items */
+    size_t size() const { return levelEnds_.empty() ? 0 : levelEnds_[0]; }
+
+    /* Append the items whose box intersects window, in no particular order */
+    void search(const IndexBox& window, std::vector<uint32_t>& out) const;
+
+    /*
+     * Append up to k items nearest to (x, y) with their distance, nearest
+     * first. The distance is the one to the item's box, 0 inside it; equal
+     * distances come in item order.
+     */
+    void nearest(double x, double y, size_t k, std::vector<std::pair<uint32_t, double>>& out) const;
+
+private:
+    /* STR order of the entries [begin, end) of the level being packed */
+    void pack(size_t begin, size_t end);
+
+    std::vector<IndexBox> boxes_;
+    /* Leaf level: item id, levels above: position of the first child */
+    std::vector<uint32_t> refs_;
+    /* End of each level in boxes_, leaves first */
+    std::vector<size_t> levelEnds_;
+};
+
+#endif /* SPATIAL_INDEX_H */
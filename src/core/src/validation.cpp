@@ -0,0 +1,463 @@
+/**
+ * cadutil_core - Validation rules
+ */
+
+#include "validation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/* Entities a slice covers at least, so small drawings stay on one thread */
+const size_t minSliceSize = 16384;
+
+typedef void (*DocumentCheck)(const ValidationInput& input, std::vector<ValidationIssue>& out);
+typedef void (*EntityCheck)(const StoreContext& context, size_t first, size_t last,
+                            uint32_t rule, std::vector<EntityIssue>& out);
+
+/* Either document or entities is set */
+struct Rule {
+    const char* name;
+    const char* code;
+    LcSeverity severity;
+    DocumentCheck document;
+    EntityCheck entities;
+    /* For reference rules, the names that resolve an issue's EntityIssue::name */
+    std::vector<char> StoreContext::*defines;
+};
+
+void emptyDrawing(const ValidationInput& input, std::vector<ValidationIssue>& out) {
+    if (input.entityCount == 0) {
+        out.push_back({LC_SEVERITY_WARNING, nullptr, "Drawing contains no entities", ""});
+    }
+}
+
+void missingLayer0(const ValidationInput& input, std::vector<ValidationIssue>& out) {
+    if (input.layers.empty()) return;
+    if (std::find(input.layers.begin(), input.layers.end(), "0") == input.layers.end()) {
+        out.push_back({LC_SEVERITY_WARNING, nullptr, "Standard layer '0' not found", ""});
+    }
+}
+
+void invalidBounds(const ValidationInput& input, std::vector<ValidationIssue>& out) {
+    if (input.boundsEmpty) {
+        out.push_back({LC_SEVERITY_INFO, nullptr, "Drawing bounds are invalid (possibly empty drawing)", ""});
+    }
+}
+
+void undefinedLayer(const StoreContext& context, size_t first, size_t last,
+                    uint32_t rule, std::vector<EntityIssue>& out) {
+    const std::vector<uint32_t>& layers = context.store->layers();
+    for (size_t i = first; i < last; i++) {
+        if (context.layerDefined[layers[i]]) continue;
+        out.push_back({i, rule, "Entity references undefined layer: " +
+                                    context.store->names()[layers[i]], layers[i]});
+    }
+}
+
+void undefinedBlock(const StoreContext& context, size_t first, size_t last,
+                    uint32_t rule, std::vector<EntityIssue>& out) {
+    const std::vector<uint8_t>& types = context.store->types();
+    for (size_t i = first; i < last; i++) {
+        if (types[i] != LC_ENTITY_INSERT) continue;
+        uint32_t block = context.store->blockName(i);
+        if (context.blockDefined[block]) continue;
+        out.push_back({i, rule, "Insert references undefined block: " +
+                                    context.store->names()[block], block});
+    }
+}
+
+void invalidRadius(const StoreContext& context, size_t first, size_t last,
+                   uint32_t rule, std::vector<EntityIssue>& out) {
+    const std::vector<uint8_t>& types = context.store->types();
+    for (size_t i = first; i < last; i++) {
+        if (types[i] != LC_ENTITY_CIRCLE && types[i] != LC_ENTITY_ARC) continue;
+        if (context.store->radius(i) <= 0) {
+            out.push_back({i, rule, "Circle/Arc has invalid radius"});
+        }
+    }
+}
+
+void invalidEllipse(const StoreContext& context, size_t first, size_t last,
+                    uint32_t rule, std::vector<EntityIssue>& out) {
+    const std::vector<uint8_t>& types = context.store->types();
+    for (size_t i = first; i < last; i++) {
+        if (types[i] != LC_ENTITY_ELLIPSE) continue;
+        /* Centre, major axis end relative to it, axis ratio */
+        StoreRange<double> g = context.store->geometry(i);
+        bool flat = g[3] == 0 && g[4] == 0 && g[5] == 0;
+        if (flat || !(g[6] > 0 && g[6] <= 1)) {
+            out.push_back({i, rule, "Ellipse has a zero major axis or an axis ratio outside (0, 1]"});
+        }
+    }
+}
+
+/* No infinity or NaN in [first, last); v - v is 0 only for finite v */
+bool allFinite(const double* first, const double* last) {
+    bool finite = true;
+    for (const double* v = first; v != last; v++) finite &= (*v - *v == 0);
+    return finite;
+}
+
+void nonFiniteCoordinate(const StoreContext& context, size_t first, size_t last,
+                         uint32_t rule, std::vector<EntityIssue>& out) {
+    /* The slice's scalars are one run; only look per entity when it has a bad value */
+    const EntityStore& store = *context.store;
+    bool geometryFinite = allFinite(store.geometry(first).begin(), store.geometry(last - 1).end());
+    for (size_t i = first; i < last; i++) {
+        bool finite = geometryFinite;
+        if (!finite) {
+            StoreRange<double> geometry = store.geometry(i);
+            finite = allFinite(geometry.begin(), geometry.end());
+        }
+        for (const DRW_Coord& v : store.vertices(i)) finite &= (v.x - v.x == 0 && v.y - v.y == 0 && v.z - v.z == 0);
+        if (!finite) out.push_back({i, rule, "Entity has a non-finite coordinate"});
+    }
+}
+
+void zeroLengthLine(const StoreContext& context, size_t first, size_t last,
+                    uint32_t rule, std::vector<EntityIssue>& out) {
+    const std::vector<uint8_t>& types = context.store->types();
+    for (size_t i = first; i < last; i++) {
+        if (types[i] != LC_ENTITY_LINE) continue;
+        StoreRange<double> g = context.store->geometry(i);
+        if (g[0] == g[3] && g[1] == g[4] && g[2] == g[5]) {
+            out.push_back({i, rule, "Line has zero length"});
+        }
+    }
+}
+
+/* In report order: an entity's issues come out in the order of this table */
+const Rule rules[] = {
+    {"empty-drawing", "EMPTY_DRAWING", LC_SEVERITY_WARNING, emptyDrawing, nullptr, nullptr},
+    {"missing-layer-0", "MISSING_LAYER_0", LC_SEVERITY_WARNING, missingLayer0, nullptr, nullptr},
+    {"undefined-layer", "UNDEFINED_LAYER", LC_SEVERITY_ERROR, nullptr, undefinedLayer,
+     &StoreContext::layerDefined},
+    {"undefined-block", "UNDEFINED_BLOCK", LC_SEVERITY_ERROR, nullptr, undefinedBlock,
+     &StoreContext::blockDefined},
+    {"invalid-radius", "INVALID_RADIUS", LC_SEVERITY_ERROR, nullptr, invalidRadius, nullptr},
+    {"invalid-ellipse", "INVALID_ELLIPSE", LC_SEVERITY_WARNING, nullptr, invalidEllipse, nullptr},
+    {"non-finite-coordinate", "NON_FINITE_COORDINATE", LC_SEVERITY_WARNING, nullptr, nonFiniteCoordinate,
+     nullptr},
+    {"zero-length-line", "ZERO_LENGTH_LINE", LC_SEVERITY_WARNING, nullptr, zeroLengthLine, nullptr},
+    {"invalid-bounds", "INVALID_BOUNDS", LC_SEVERITY_INFO, invalidBounds, nullptr, nullptr},
+};
+
+const uint32_t ruleCount = sizeof(rules) / sizeof(rules[0]);
+
+/* Flag every interned name of store that the document defines */
+StoreContext makeContext(const ValidationInput& input, const EntityStore* store,
+                         const std::vector<ValidationBlock>* blocks) {
+    StoreContext context;
+    context.store = store;
+    context.blocks = blocks;
+    const DRW_NameTable& names = store->names();
+    context.layerDefined.assign(names.size(), 0);
+    context.blockDefined.assign(names.size(), 0);
+    context.layerDefined[0] = context.blockDefined[0] = 1;  /* "" */
+    uint32_t id;
+    for (std::string_view layer : input.layers) {
+        if (names.find(layer, &id)) context.layerDefined[id] = 1;
+    }
+    for (const ValidationBlock& block : input.blocks) {
+        if (names.find(block.name, &id)) context.blockDefined[id] = 1;
+    }
+    return context;
+}
+
+std::string entityLocation(const StoreContext& context, size_t i) {
+    if (!context.blocks) return "entity #" + std::to_string(i);
+    /* The last block starting at or before i; empty blocks before it share its start */
+    const std::vector<ValidationBlock>& blocks = *context.blocks;
+    auto it = std::upper_bound(blocks.begin(), blocks.end(), i,
+                               [](size_t entity, const ValidationBlock& b) { return entity < b.first; });
+    const ValidationBlock& block = *(it - 1);
+    return "block " + std::string(block.name) + " entity #" + std::to_string(i - block.first);
+}
+
+/* Entities [first, last) of one store, with what the entity rules found there */
+struct Slice {
+    const StoreContext* context;
+    size_t first;
+    size_t last;
+    std::vector<EntityIssue> issues;
+    std::vector<double> seconds;  /* per selected entity rule */
+};
+
+/* Back to entity order, an entity's issues in rule order */
+void sortIssues(std::vector<EntityIssue>& issues) {
+    std::stable_sort(issues.begin(), issues.end(), [](const EntityIssue& a, const EntityIssue& b) {
+        return a.entity < b.entity || (a.entity == b.entity && a.rule < b.rule);
+    });
+}
+
+void checkSlice(Slice& slice, const std::vector<uint32_t>& entityRules) {
+    slice.seconds.assign(entityRules.size(), 0.0);
+    for (size_t k = 0; k < entityRules.size(); k++) {
+        Clock::time_point start = Clock::now();
+        rules[entityRules[k]].entities(*slice.context, slice.first, slice.last,
+                                       entityRules[k], slice.issues);
+        slice.seconds[k] = std::chrono::duration<double>(Clock::now() - start).count();
+    }
+    sortIssues(slice.issues);
+}
+
+/* Entity issues of one store, in entity order */
+struct IssueRun {
+    const StoreContext* context;
+    std::vector<EntityIssue>* issues;
+};
+
+/*
+ * Report of the selected rules: the document issues in rule order, with
+ * those of the entities, run after run, in place of the first entity rule
+ */
+ValidationReport assemble(const ValidationInput& input, RuleSet selected, std::vector<double>& seconds,
+                          const std::vector<IssueRun>& runs) {
+    std::vector<size_t> counts(ruleCount, 0);
+    ValidationReport report;
+    bool entitiesReported = false;
+    for (uint32_t r = 0; r < ruleCount; r++) {
+        if (!(selected >> r & 1)) continue;
+        const Rule& rule = rules[r];
+
+        if (rule.document) {
+            size_t first = report.issues.size();
+            Clock::time_point start = Clock::now();
+            rule.document(input, report.issues);
+            seconds[r] = std::chrono::duration<double>(Clock::now() - start).count();
+            for (size_t i = first; i < report.issues.size(); i++) {
+                report.issues[i].severity = rule.severity;
+                report.issues[i].code = rule.code;
+            }
+            counts[r] = report.issues.size() - first;
+        } else if (!entitiesReported) {
+            for (const IssueRun& run : runs) {
+                for (EntityIssue& issue : *run.issues) {
+                    const Rule& raised = rules[issue.rule];
+                    report.issues.push_back({raised.severity, raised.code, std::move(issue.message),
+                                             entityLocation(*run.context, issue.entity)});
+                    counts[issue.rule]++;
+                }
+            }
+            entitiesReported = true;
+        }
+    }
+
+    for (uint32_t r = 0; r < ruleCount; r++) {
+        if (selected >> r & 1) report.rules.push_back({rules[r].name, seconds[r], counts[r]});
+    }
+    return report;
+}
+
+} // namespace
+
+RuleSet allRules() {
+    return (RuleSet(1) << ruleCount) - 1;
+}
+
+const char* ruleNames() {
+    static const std::string names = [] {
+        std::string list;
+        for (const Rule& rule : rules) {
+            if (!list.empty()) list += ',';
+            list += rule.name;
+        }
+        return list;
+    }();
+    return names.c_str();
+}
+
+bool parseRules(std::string_view list, RuleSet* selected, std::string* unknown) {
+    RuleSet set = 0;
+    while (!list.empty()) {
+        size_t comma = list.find(',');
+        std::string_view name = list.substr(0, comma);
+        list = comma == std::string_view::npos ? std::string_view() : list.substr(comma + 1);
+        while (!name.empty() && name.front() == ' ') name.remove_prefix(1);
+        while (!name.empty() && name.back() == ' ') name.remove_suffix(1);
+        if (name.empty()) continue;
+
+        uint32_t r = 0;
+        while (r < ruleCount && name != rules[r].name) r++;
+        if (r == ruleCount) {
+            *unknown = std::string(name);
+            return false;
+        }
+        set |= RuleSet(1) << r;
+    }
+    *selected = set ? set : allRules();
+    return true;
+}
+
+ValidationReport runValidation(const ValidationInput& input, RuleSet selected, int threads) {
+    std::vector<uint32_t> entityRules;
+    for (uint32_t r = 0; r < ruleCount; r++) {
+        if ((selected >> r & 1) && rules[r].entities) entityRules.push_back(r);
+    }
+
+    /* Slices of the model store, then of the block store, a few per thread */
+    StoreContext contexts[2];
+    std::vector<Slice> slices;
+    if (!entityRules.empty()) {
+        contexts[0] = makeContext(input, input.model, nullptr);
+        contexts[1] = makeContext(input, input.blockEntities, &input.blocks);
+        size_t total = input.model->size() + input.blockEntities->size();
+        size_t workers = static_cast<size_t>(std::max(1, threads));
+        size_t sliceSize = std::max(minSliceSize, total / (workers * 4) + 1);
+        for (const StoreContext& context : contexts) {
+            for (size_t first = 0; first < context.store->size(); first += sliceSize) {
+                slices.push_back({&context, first, std::min(first + sliceSize, context.store->size()), {}, {}});
+            }
+        }
+
+        /* Threads take the next unchecked slice until none are left */
+        std::atomic<size_t> next{0};
+        auto work = [&] {
+            for (size_t s; (s = next.fetch_add(1)) < slices.size();) checkSlice(slices[s], entityRules);
+        };
+        std::vector<std::thread> helpers;
+        for (size_t t = 1; t < std::min(workers, slices.size()); t++) helpers.emplace_back(work);
+        work();
+        for (std::thread& helper : helpers) helper.join();
+    }
+
+    std::vector<double> seconds(ruleCount, 0.0);
+    std::vector<IssueRun> runs;
+    for (Slice& slice : slices) {
+        for (size_t k = 0; k < entityRules.size(); k++) seconds[entityRules[k]] += slice.seconds[k];
+        runs.push_back({slice.context, &slice.issues});
+    }
+    return assemble(input, selected, seconds, runs);
+}
+
+StreamingValidation::StreamingValidation(RuleSet rules, bool failFast)
+    : rules_(rules), failFast_(failFast), seconds_(ruleCount, 0.0) {}
+
+/* Names interned after the last check are flagged by refresh() */
+void StreamingValidation::defineLayer(std::string_view name) {
+    uint32_t id;
+    layerNames_.emplace(name);
+    for (StoreContext& context : stores_) {
+        if (context.store && context.store->names().find(name, &id) && id < context.layerDefined.size()) {
+            context.layerDefined[id] = 1;
+        }
+    }
+}
+
+void StreamingValidation::defineBlock(std::string_view name) {
+    uint32_t id;
+    blockNames_.emplace(name);
+    for (StoreContext& context : stores_) {
+        if (context.store && context.store->names().find(name, &id) && id < context.blockDefined.size()) {
+            context.blockDefined[id] = 1;
+        }
+    }
+}
+
+/* Flag the names interned since the last check that are defined already */
+void StreamingValidation::refresh(StoreContext& context, const EntityStore& store) {
+    context.store = &store;
+    const DRW_NameTable& names = store.names();
+    for (size_t id = context.layerDefined.size(); id < names.size(); id++) {
+        const std::string& name = names[static_cast<uint32_t>(id)];
+        context.layerDefined.push_back(name.empty() || layerNames_.count(name));
+        context.blockDefined.push_back(name.empty() || blockNames_.count(name));
+    }
+}
+
+bool StreamingValidation::check(const EntityStore& store, bool inBlocks, size_t offset) {
+    if (stopped_ || store.empty()) return !stopped_;
+    StoreContext& context = stores_[inBlocks];
+    refresh(context, store);
+
+    std::vector<EntityIssue> found;
+    for (uint32_t r = 0; r < ruleCount; r++) {
+        if (!(rules_ >> r & 1) || !rules[r].entities) continue;
+        Clock::time_point start = Clock::now();
+        rules[r].entities(context, 0, store.size(), r, found);
+        seconds_[r] += std::chrono::duration<double>(Clock::now() - start).count();
+    }
+    sortIssues(found);
+
+    bool error = false;
+    for (EntityIssue& issue : found) {
+        issue.entity += offset;
+        const Rule& rule = rules[issue.rule];
+        if (rule.defines && !ended(rule.defines)) {
+            pending_[inBlocks].push_back(std::move(issue));
+        } else {
+            error |= rule.severity == LC_SEVERITY_ERROR;
+            issues_[inBlocks].push_back(std::move(issue));
+        }
+    }
+    stopped_ = failFast_ && error;
+    return !stopped_;
+}
+
+bool StreamingValidation::ended(std::vector<char> StoreContext::*defines) const {
+    return defines == &StoreContext::layerDefined ? layersEnded_ : blocksEnded_;
+}
+
+bool StreamingValidation::settle(std::vector<char> StoreContext::*defines) {
+    if (stopped_) return false;
+    bool error = false;
+    for (int s = 0; s < 2; s++) {
+        const std::vector<char>& defined = stores_[s].*defines;
+        auto kept = std::remove_if(pending_[s].begin(), pending_[s].end(), [&](EntityIssue& issue) {
+            const Rule& rule = rules[issue.rule];
+            if (rule.defines != defines) return false;
+            if (!defined[issue.name]) {
+                error |= rule.severity == LC_SEVERITY_ERROR;
+                issues_[s].push_back(std::move(issue));
+            }
+            return true;
+        });
+        pending_[s].erase(kept, pending_[s].end());
+    }
+    stopped_ = failFast_ && error;
+    return !stopped_;
+}
+
+bool StreamingValidation::endLayers() {
+    layersEnded_ = true;
+    return settle(&StoreContext::layerDefined);
+}
+
+bool StreamingValidation::endBlocks() {
+    blocksEnded_ = true;
+    return settle(&StoreContext::blockDefined);
+}
+
+ValidationReport StreamingValidation::finish(const ValidationInput& input) {
+    /* The references whose name was never defined, unless reading stopped early */
+    std::vector<IssueRun> runs;
+    for (int s = 0; s < 2; s++) {
+        if (!stopped_) {
+            for (EntityIssue& issue : pending_[s]) {
+                const std::vector<char>& defined = stores_[s].*rules[issue.rule].defines;
+                if (!defined[issue.name]) issues_[s].push_back(std::move(issue));
+            }
+        }
+        /* Pending references join the issues out of entity order */
+        sortIssues(issues_[s]);
+        pending_[s].clear();
+        runs.push_back({&stores_[s], &issues_[s]});
+    }
+    stores_[1].blocks = &input.blocks;
+
+    /* A drawing read in part has no document issues to tell */
+    RuleSet selected = rules_;
+    if (stopped_) {
+        for (uint32_t r = 0; r < ruleCount; r++) {
+            if (rules[r].document) selected &= ~(RuleSet(1) << r);
+        }
+    }
+    return assemble(input, selected, seconds_, runs);
+}
@@ -0,0 +1,158 @@
+/**
+ * cadutil_core - Validation rules
+ *
+ * The checks of lc_document_validate() as independent rules. Document
+ * rules look at the tables once; entity rules each run over slices of the
+ * entity stores, on several threads when asked to. Every slice collects
+ * its own issues and the slices are merged in store order, so the result
+ * is the same whatever the number of threads. References are resolved
+ * through per-store tables indexed by interned name ID.
+ *
+ * StreamingValidation runs the same rules while a document is read, for
+ * lc_validate_ex(), and reports the same issues as runValidation() would
+ * on the document read in full.
+ */
+
+#ifndef VALIDATION_H
+#define VALIDATION_H
+
+#include "librecad_core.h"
+#include "entity_store.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+/* Contents of a block: entities [first, first + count) of the block store */
+struct ValidationBlock {
+    std::string_view name;
+    size_t first;
+    size_t count;
+};
+
+/* What the rules see of a document */
+struct ValidationInput {
+    const EntityStore* model = nullptr;
+    const EntityStore* blockEntities = nullptr;
+    std::vector<std::string_view> layers;  /* defined layer names */
+    std::vector<ValidationBlock> blocks;
+    size_t entityCount = 0;  /* model space entities */
+    bool boundsEmpty = false;
+};
+
+struct ValidationIssue {
+    LcSeverity severity;
+    const char* code;
+    std::string message;
+    std::string location;
+};
+
+/* Time spent in a rule, summed over threads, and the issues it raised */
+struct RuleStats {
+    const char* name;
+    double seconds;
+    size_t issues;
+};
+
+struct ValidationReport {
+    std::vector<ValidationIssue> issues;
+    std::vector<RuleStats> rules;  /* the rules that ran, in rule table order */
+};
+
+/* Bit i selects rule i of the rule table */
+typedef uint32_t RuleSet;
+
+/* An entity store with the names defined for it, indexed by interned ID */
+struct StoreContext {
+    const EntityStore* store = nullptr;
+    std::vector<char> layerDefined;
+    std::vector<char> blockDefined;
+    const std::vector<ValidationBlock>* blocks = nullptr;  /* set for the block store */
+};
+
+/* Issue of an entity rule; the location is only spelled out in the report */
+struct EntityIssue {
+    size_t entity;
+    uint32_t rule;
+    std::string message;
+    uint32_t name = 0;  /* the undefined name a reference rule found */
+};
+
+/* Every rule */
+RuleSet allRules();
+
+/* Names of all rules, comma separated, in the order their issues are reported */
+const char* ruleNames();
+
+/*
+ * Rules named in a comma separated list, all of them for an empty list.
+ * Returns false with the name in *unknown when a name is not a rule.
+ */
+bool parseRules(std::string_view list, RuleSet* rules, std::string* unknown);
+
+/* Run the selected rules, the entity rules on up to `threads` threads */
+ValidationReport runValidation(const ValidationInput& input, RuleSet rules, int threads);
+
+/*
+ * Rules evaluated while a document is read: its entities are checked a
+ * batch at a time, after which the reader can drop them. A reference to a
+ * layer or block that is not defined yet stays pending, as the definition
+ * may still follow, and finish() reports it if it never does. Once the
+ * reader has passed the layer or block definitions, such references are
+ * reported when they are checked.
+ */
+class StreamingValidation {
+public:
+    /* With failFast, checking stops at the first error-level issue */
+    StreamingValidation(RuleSet rules, bool failFast);
+
+    /* Layers and blocks, as they are read */
+    void defineLayer(std::string_view name);
+    void defineBlock(std::string_view name);
+
+    /*
+     * Check the entities of the model store, or of the block store with
+     * inBlocks, after the `offset` entities of it checked before. A store
+     * must keep its name table from one check to the next. Returns false
+     * once fail-fast has found an error.
+     */
+    bool check(const EntityStore& store, bool inBlocks, size_t offset);
+
+    /*
+     * Every layer, or every block, has been defined: the pending references
+     * to the others are reported now, and later ones as they are checked.
+     * Returns false once fail-fast has found an error.
+     */
+    bool endLayers();
+    bool endBlocks();
+
+    /* The report; input.model and input.blockEntities are not used */
+    ValidationReport finish(const ValidationInput& input);
+
+    /* Fail-fast found an error: the references still pending are dropped */
+    bool stopped() const { return stopped_; }
+
+private:
+    void refresh(StoreContext& context, const EntityStore& store);
+    /* Whether the names of a reference rule are all defined */
+    bool ended(std::vector<char> StoreContext::*defines) const;
+    /* Report the pending references to names of `defines` still undefined */
+    bool settle(std::vector<char> StoreContext::*defines);
+
+    RuleSet rules_;
+    bool failFast_;
+    bool stopped_ = false;
+    bool layersEnded_ = false;
+    bool blocksEnded_ = false;
+    std::unordered_set<std::string> layerNames_;
+    std::unordered_set<std::string> blockNames_;
+    StoreContext stores_[2];               /* model space, blocks */
+    std::vector<EntityIssue> issues_[2];   /* in entity order */
+    std::vector<EntityIssue> pending_[2];  /* references to names not defined yet */
+    std::vector<double> seconds_;          /* per rule */
+};
+
+#endif /* VALIDATION_H */
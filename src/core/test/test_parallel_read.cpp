@@ -0,0 +1,139 @@
+/**
+ * Regression test for the parallel DXF entity parser
+ *
+ * An exception thrown by the interface while the entities are parsed on
+ * several threads must leave dxfRW::read() like it does on one thread,
+ * with the worker threads stopped, instead of terminating the process.
+ */
+
+#include "libdxfrw.h"
+#include <cstdio>
+#include <string>
+
+static int failures = 0;
+
+static void expect(const char* what, bool ok) {
+    printf("  %s  %s\n", ok ? "ok  " : "FAIL", what);
+    if (!ok) failures++;
+}
+
+struct Thrown {};
+
+/* Interface that counts lines and throws at line number `throwAt` */
+class ThrowingInterface : public DRW_Interface {
+public:
+    explicit ThrowingInterface(long throwAt) : throwAt(throwAt) {}
+
+    long lines = 0;
+
+    void addLine(const DRW_Line&) override {
+        if (lines++ == throwAt) throw Thrown();
+    }
+
+    void addHeader(const DRW_Header*) override {}
+    void addLType(const DRW_LType&) override {}
+    void addLayer(const DRW_Layer&) override {}
+    void addDimStyle(const DRW_Dimstyle&) override {}
+    void addVport(const DRW_Vport&) override {}
+    void addView(const DRW_View&) override {}
+    void addUCS(const DRW_UCS&) override {}
+    void addTextStyle(const DRW_Textstyle&) override {}
+    void addAppId(const DRW_AppId&) override {}
+    void addBlock(const DRW_Block&) override {}
+    void setBlock(const int) override {}
+    void endBlock() override {}
+    void addPoint(const DRW_Point&) override {}
+    void addRay(const DRW_Ray&) override {}
+    void addXline(const DRW_Xline&) override {}
+    void addArc(const DRW_Arc&) override {}
+    void addCircle(const DRW_Circle&) override {}
+    void addEllipse(const DRW_Ellipse&) override {}
+    void addLWPolyline(const DRW_LWPolyline&) override {}
+    void addPolyline(const DRW_Polyline&) override {}
+    void addSpline(const DRW_Spline*) override {}
+    void addKnot(const DRW_Entity&) override {}
+    void addInsert(const DRW_Insert&) override {}
+    void addTrace(const DRW_Trace&) override {}
+    void add3dFace(const DRW_3Dface&) override {}
+    void addSolid(const DRW_Solid&) override {}
+    void addMText(const DRW_MText&) override {}
+    void addText(const DRW_Text&) override {}
+    void addTolerance(const DRW_Tolerance&) override {}
+    void addDimAlign(const DRW_DimAligned*) override {}
+    void addDimLinear(const DRW_DimLinear*) override {}
+    void addDimRadial(const DRW_DimRadial*) override {}
+    void addDimDiametric(const DRW_DimDiametric*) override {}
+    void addDimAngular(const DRW_DimAngular*) override {}
+    void addDimAngular3P(const DRW_DimAngular3p*) override {}
+    void addDimOrdinate(const DRW_DimOrdinate*) override {}
+    void addLeader(const DRW_Leader*) override {}
+    void addHatch(const DRW_Hatch*) override {}
+    void addViewport(const DRW_Viewport&) override {}
+    void addImage(const DRW_Image*) override {}
+    void linkImage(const DRW_ImageDef*) override {}
+    void addComment(const char*) override {}
+    void addPlotSettings(const DRW_PlotSettings*) override {}
+
+    void writeHeader(DRW_Header&) override {}
+    void writeBlocks() override {}
+    void writeBlockRecords() override {}
+    void writeEntities() override {}
+    void writeLTypes() override {}
+    void writeLayers() override {}
+    void writeViews() override {}
+    void writeUCSs() override {}
+    void writeTextstyles() override {}
+    void writeVports() override {}
+    void writeDimstyles() override {}
+    void writeObjects() override {}
+    void writeAppId() override {}
+
+private:
+    long throwAt;
+};
+
+/* A drawing of `count` lines, enough for every thread to get a part */
+static std::string drawing(long count) {
+    std::string dxf = "  0\nSECTION\n  2\nENTITIES\n";
+    for (long i = 0; i < count; i++) {
+        dxf += "  0\nLINE\n  8\n0\n 10\n" + std::to_string(i) + "\n 20\n0\n 11\n" + std::to_string(i + 1) +
+               "\n 21\n1\n";
+    }
+    dxf += "  0\nENDSEC\n  0\nEOF\n";
+    return dxf;
+}
+
+/* Read on `threads` threads; whether the exception of line throwAt came out */
+static bool readThrows(const std::string& dxf, int threads, long throwAt, long* lines) {
+    ThrowingInterface iface(throwAt);
+    dxfRW reader("memory");
+    reader.setThreads(threads);
+    bool thrown = false;
+    try {
+        reader.read(&iface, false, dxf.data(), dxf.size());
+    } catch (const Thrown&) {
+        thrown = true;
+    }
+    *lines = iface.lines;
+    return thrown;
+}
+
+int main() {
+    const long count = 20000;
+    std::string dxf = drawing(count);
+    long lines = 0;
+
+    printf("Parallel read:\n");
+    expect("no exception, every line read", !readThrows(dxf, 4, -1, &lines) && lines == count);
+    expect("exception in the first part", readThrows(dxf, 4, 10, &lines) && lines == 11);
+    /* The later parts are handed over on the calling thread once parsed */
+    expect("exception in the last part", readThrows(dxf, 4, count - 10, &lines) && lines == count - 9);
+    expect("exception on one thread", readThrows(dxf, 1, 10, &lines) && lines == 11);
+
+    if (failures) {
+        printf("\n%d parallel read checks failed\n", failures);
+        return 1;
+    }
+    printf("\nAll parallel read tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,121 @@
+/**
+ * Regression test for the libdxfrw text codec
+ *
+ * Converts known strings between UTF-8 and the DXF code pages, both ways,
+ * including text the code pages cannot represent.
+ */
+
+#include "drw_textcodec.h"
+#include <cstdio>
+#include <string>
+#include <thread>
+
+static int failures = 0;
+
+/* Bytes of s, non-ASCII ones as \xNN */
+static std::string escaped(const std::string& s) {
+    std::string out;
+    for (unsigned char c : s) {
+        if (c >= 0x20 && c < 0x7F) {
+            out += static_cast<char>(c);
+        } else {
+            char hex[8];
+            snprintf(hex, sizeof hex, "\\x%02x", c);
+            out += hex;
+        }
+    }
+    return out;
+}
+
+static void expect(const char* what, const std::string& got, const std::string& expected) {
+    if (got == expected) {
+        printf("  ok    %s\n", what);
+        return;
+    }
+    printf("  FAIL  %s\n        got      %s\n        expected %s\n", what, escaped(got).c_str(),
+           escaped(expected).c_str());
+    failures++;
+}
+
+/* Codec of a pre-2007 DXF file, the code page given by $DWGCODEPAGE */
+static DRW_TextCodec codec(const char* codePage) {
+    DRW_TextCodec c;
+    c.setVersion(DRW::AC1015, true);
+    c.setCodePage(codePage, true);
+    return c;
+}
+
+/* utf8 encodes to native and decodes back to utf8 */
+static void roundTrip(DRW_TextCodec& c, const char* what, const std::string& utf8, const std::string& native) {
+    std::string encoded = c.fromUtf8(utf8);
+    expect((std::string(what) + ": fromUtf8").c_str(), encoded, native);
+    expect((std::string(what) + ": toUtf8").c_str(), c.toUtf8(encoded), utf8);
+
+    /* The move overloads give the same text */
+    expect((std::string(what) + ": fromUtf8 (moved)").c_str(), c.fromUtf8(std::string(utf8)), native);
+    expect((std::string(what) + ": toUtf8 (moved)").c_str(), c.toUtf8(std::string(native)), utf8);
+}
+
+int main() {
+    printf("ASCII:\n");
+    DRW_TextCodec ascii = codec("ANSI_1252");
+    roundTrip(ascii, "plain text", "Layer 0_A-1 (x=2.5)", "Layer 0_A-1 (x=2.5)");
+    DRW_TextCodec sjisAscii = codec("ANSI_932");
+    roundTrip(sjisAscii, "plain text, ANSI_932", "Layer 0_A-1", "Layer 0_A-1");
+    expect("empty string", ascii.toUtf8(std::string()), "");
+
+    printf("ANSI_1252:\n");
+    DRW_TextCodec latin = codec("ANSI_1252");
+    roundTrip(latin, "accents", "caf\xc3\xa9 \xc3\xbc\xc3\x9f", "caf\xe9 \xfc\xdf");
+    roundTrip(latin, "upper half, euro sign", "\xe2\x82\xac 5 \xe2\x80\x93 \xc2\xb0", "\x80 5 \x96 \xb0");
+    expect("\\U+ escape to UTF-8", latin.toUtf8("\\U+00E9x"), "\xc3\xa9x");
+    expect("undefined byte 0x81 dropped", latin.toUtf8("a\x81" "b"), "ab");
+    expect("CP1252 alias", codec("CP1252").toUtf8("\xe9"), "\xc3\xa9");
+
+    printf("ANSI_932 (Shift-JIS):\n");
+    DRW_TextCodec sjis = codec("ANSI_932");
+    roundTrip(sjis, "kanji and ASCII", "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e ABC",
+              "\x93\xfa\x96\x7b\x8c\xea ABC");
+    roundTrip(sjis, "half width katakana", "\xef\xbd\xb1\xef\xbd\xb2", "\xb1\xb2");
+    roundTrip(sjis, "hiragana and full width digit", "\xe3\x81\x82\xef\xbc\x91", "\x82\xa0\x82\x50");
+    expect("\\U+ escape to UTF-8", sjis.toUtf8("\\U+65E5"), "\xe6\x97\xa5");
+
+    printf("Edge cases:\n");
+    /* A lead byte without its trail byte decodes as U+30FB (katakana middle dot) */
+    expect("truncated lead byte", sjis.toUtf8("ab\x93"), "ab\xe3\x83\xbb");
+    expect("lone lead byte", sjis.toUtf8("\x93"), "\xe3\x83\xbb");
+    expect("lead byte with an invalid trail byte", sjis.toUtf8("\x93\x20x"), "\xe3\x83\xbbx");
+    /* Code points a code page cannot hold are written as \U+ escapes */
+    expect("unmappable in ANSI_1252", latin.fromUtf8("x\xe6\x97\xa5y"), "x\\U+65E5y");
+    expect("unmappable in ANSI_932", sjis.fromUtf8("\xc3\xa9"), "\\U+00E9");
+    expect("unmappable outside the BMP", sjis.fromUtf8("a\xf0\x9f\x98\x80" "b"), "a\\U+1F600b");
+    expect("unmappable round trip", latin.toUtf8(latin.fromUtf8("x\xe6\x97\xa5y")), "x\xe6\x97\xa5y");
+    /* Broken UTF-8 input becomes U+FFFD instead of reading past the string */
+    expect("truncated UTF-8 sequence", latin.fromUtf8("a\xc3"), "a\\U+FFFD");
+    expect("truncated UTF-8 sequence, ANSI_932", sjis.fromUtf8("a\xe6\x97"), "a\\U+FFFD");
+    expect("stray continuation byte", latin.fromUtf8("a\x80" "b"), "a\\U+FFFDb");
+
+    printf("Statistics:\n");
+    /* Strings converted by a thread count once it has ended, and on the calling thread */
+    DRW_TextCodec::resetStats();
+    std::thread worker([]() {
+        DRW_TextCodec c = codec("ANSI_1252");
+        for (int i = 0; i < 1000; i++) c.toUtf8("plain");
+        c.toUtf8("caf\xe9");
+    });
+    worker.join();
+    latin.fromUtf8("caf\xc3\xa9");
+    DRW_TextCodec::Stats st = DRW_TextCodec::stats();
+    expect("ASCII strings decoded", std::to_string(st.toUtf8Ascii), "1000");
+    expect("strings decoded by the converter", std::to_string(st.toUtf8Converted), "1");
+    expect("strings encoded by the converter", std::to_string(st.fromUtf8Converted), "1");
+    DRW_TextCodec::resetStats();
+    expect("reset", std::to_string(DRW_TextCodec::stats().toUtf8Ascii), "0");
+
+    if (failures) {
+        printf("\n%d text codec checks failed\n", failures);
+        return 1;
+    }
+    printf("\nAll text codec tests passed!\n");
+    return 0;
+}